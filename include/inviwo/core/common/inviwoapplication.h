@@ -519,6 +519,45 @@ auto dispatchPool(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F,
                                                      std::forward<Args>(args)...);
 }
 
+namespace util {
+
+/**
+ * Wait for all futures of tasks enqueued with dispatchPool. The waiting is done with
+ * ThreadPool::wait, so when called from within a pool task the calling worker keeps running
+ * pending tasks instead of blocking. See ThreadPool::wait for the restrictions that implies.
+ */
+template <typename T>
+void waitForAll(const std::vector<std::future<T>>& futures) {
+    auto& pool = InviwoApplication::getPtr()->getThreadPool();
+    for (const auto& future : futures) {
+        pool.wait(future);
+    }
+}
+
+/**
+ * Call task(i) for all i in [0, tasks) on the thread pool and wait for all of them to finish.
+ * The tasks are run in the calling thread if there is only one task, if there is no
+ * InviwoApplication, or if the pool size is zero.
+ */
+template <typename F>
+void forEachTask(size_t tasks, F&& task) {
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    if (poolSize == 0 || tasks <= 1) {
+        for (size_t i = 0; i < tasks; ++i) task(i);
+        return;
+    }
+
+    std::vector<std::future<void>> futures;
+    futures.reserve(tasks);
+    for (size_t i = 0; i < tasks; ++i) {
+        futures.push_back(dispatchPool([&task, i]() { task(i); }));
+    }
+    waitForAll(futures);
+}
+
+}  // namespace util
+
 template <class T>
 T* InviwoApplication::getSettingsByType() {
     return getTypeFromVector<T>(getModuleSettings());
@@ -30,11 +30,15 @@
 #pragma once
 
 #include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/datatraits.h>
 #include <inviwo/core/datastructures/representationfactory.h>
 #include <inviwo/core/datastructures/representationconverterfactory.h>
 #include <inviwo/core/datastructures/representationfactorymanager.h>
+#include <inviwo/core/util/conversionstatistics.h>
+#include <inviwo/core/util/tracing.h>
 
 #include <typeindex>
+#include <utility>
 #include <mutex>
 #include <unordered_map>
 #include <memory>
@@ -206,6 +210,7 @@ const T* Data<Self, Repr>::getRepresentation() const {
             factory->createOrDefault(std::type_index(typeid(T)), static_cast<const Self*>(this))};
         lock.lock();
         if (!repr) throw Exception("Failed to create default representation", IVW_CONTEXT);
+        ConversionStatistics::addRepresentation(*repr);
         lastValidRepresentation_ = addRepresentationInternal(repr);
     }
 
@@ -221,6 +226,9 @@ const T* Data<Self, Repr>::getRepresentation() const {
 template <typename Self, typename Repr>
 template <typename T>
 const T* Data<Self, Repr>::getValidRepresentation() const {
+    IVW_TRACE_SCOPE_DETAIL("data", "convertRepresentation",
+                           tracing::isEnabled() ? DataTraits<Self>::dataName() : std::string{});
+    ConversionStatistics::Scope conversion;
     auto factory = RepresentationFactoryManager::getRepresentationConverterFactory<Repr>();
     if (auto package = factory->getRepresentationConverter(lastValidRepresentation_->getTypeIndex(),
                                                            std::type_index(typeid(T)))) {
@@ -234,6 +242,7 @@ const T* Data<Self, Repr>::getValidRepresentation() const {
             } else {  // No representation found, create it
                 auto result = converter->createFrom(lastValidRepresentation_);
                 if (!result) throw ConverterException("Converter failed to create", IVW_CONTEXT);
+                ConversionStatistics::addRepresentation(*result);
                 lastValidRepresentation_ = addRepresentationInternal(result);
             }
         }
@@ -286,6 +295,7 @@ void Data<Self, Repr>::copyRepresentationsTo(Data<Self, Repr>* targetData) const
 
     if (lastValidRepresentation_) {
         auto rep = std::shared_ptr<Repr>(lastValidRepresentation_->clone());
+        ConversionStatistics::addRepresentation(*rep);
         targetData->addRepresentation(rep);
     }
 }
@@ -66,6 +66,13 @@ public:
     bool isValid() const;
     void setValid(bool valid);
 
+    /**
+     * A counter that is incremented every time the representation is set valid, i.e. when it is
+     * added to its owner, edited through Data::getEditableRepresentation, or updated by a
+     * converter. Can be used to detect if information derived from the representation is stale.
+     */
+    size_t getVersion() const;
+
 protected:
     DataRepresentation() = default;
     DataRepresentation(const DataFormatBase* format);
@@ -74,6 +81,7 @@ protected:
     void setDataFormat(const DataFormatBase* format);
 
     bool isValid_ = true;
+    size_t version_ = 0;
     const DataFormatBase* dataFormatBase_ = DataUInt8::get();
     const Owner* owner_ = nullptr;
 };
@@ -120,6 +128,12 @@ bool DataRepresentation<Owner>::isValid() const {
 template <typename Owner>
 void DataRepresentation<Owner>::setValid(bool valid) {
     isValid_ = valid;
+    if (valid) ++version_;
+}
+
+template <typename Owner>
+size_t DataRepresentation<Owner>::getVersion() const {
+    return version_;
 }
 
 }  // namespace inviwo
@@ -32,7 +32,12 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/util/glm.h>
 
+#include <algorithm>
+#include <array>
+#include <functional>
 #include <iterator>
+#include <limits>
+#include <type_traits>
 #include <vector>
 
 namespace inviwo {
@@ -73,11 +78,61 @@ protected:
     double maximumBinCount_;
 };
 
+/**
+ * Accumulates the bins and statistics of histograms over values of type T, one histogram per
+ * component of T. Separate parts of the data can be accumulated independently and then merged,
+ * which is used to calculate histograms in parallel, see util::calculateHistograms.
+ *
+ * Scalar integers of at most 16 bits only count the occurrences of each value, and the bins and
+ * statistics are derived from those counts when the histograms are created. Contiguous ranges of
+ * float and double are processed in independent lanes to keep the
+ * loop free of dependencies between consecutive values. Everything else uses a generic loop.
+ */
+template <typename T>
+class HistogramAccumulator {
+public:
+    HistogramAccumulator(dvec2 dataRange, size_t bins);
+
+    template <typename FirstIter, typename LastIter>
+    void add(FirstIter begin, LastIter end);
+
+    void merge(const HistogramAccumulator& other);
+
+    size_t getCount() const { return count_; }
+    size_t getBins() const { return bins_; }
+    dvec2 getDataRange() const { return dataRange_; }
+
+    std::vector<NormalizedHistogram> getHistograms() const;
+
+private:
+    // a double type with the same extent as T
+    using D = typename util::same_extent<T, double>::type;
+    // a size_t type with same extent as T
+    using I = typename util::same_extent<T, size_t>::type;
+
+    static constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
+    static constexpr bool countValues = std::is_integral<T>::value && sizeof(T) <= 2;
+
+    void addFloats(const T* begin, const T* end);
+
+    dvec2 dataRange_;
+    size_t bins_;
+    // The bins of each component, or the count of each value if countValues is true
+    std::array<std::vector<size_t>, extent> counts_;
+    D min_;
+    D max_;
+    D sum_;
+    D sum2_;
+    size_t count_;
+};
+
 class IVW_CORE_API HistogramContainer {
 public:
     HistogramContainer() = default;
     template <typename FirstIter, typename LastIter>
     HistogramContainer(dvec2 range, size_t bins, FirstIter begin, LastIter end);
+    template <typename T>
+    explicit HistogramContainer(const HistogramAccumulator<T>& accumulator);
 
     const NormalizedHistogram& operator[](size_t i) const;
     const NormalizedHistogram& get(size_t i) const;
@@ -94,66 +149,199 @@ private:
     std::vector<NormalizedHistogram> histograms_;
 };
 
-template <typename FirstIter, typename LastIter>
-HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin,
-                                       LastIter end) {
-    using T = typename std::iterator_traits<FirstIter>::value_type;
-
-    // a double type with the same extent as T
-    using D = typename util::same_extent<T, double>::type;
-    // a size_t type with same extent as T
-    using I = typename util::same_extent<T, size_t>::type;
-
-    constexpr size_t extent = util::rank<T>::value > 0 ? util::extent<T>::value : 1;
+template <typename T>
+HistogramAccumulator<T>::HistogramAccumulator(dvec2 dataRange, size_t bins)
+    : dataRange_{dataRange}
+    , bins_{bins}
+    , min_(std::numeric_limits<double>::max())
+    , max_(std::numeric_limits<double>::lowest())
+    , sum_(0)
+    , sum2_(0)
+    , count_(0) {
 
     // check whether number of bins exceeds the data range only if it is an integral type
     if constexpr (!util::is_floating_point<typename util::value_type<T>::type>::value) {
-        bins = std::min(bins, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
+        bins_ = std::min(bins_, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
     }
 
-    std::array<std::vector<double>, extent> histData;
-    for (size_t i = 0; i < extent; ++i) {
-        histData[i].resize(bins, 0.0);
+    if constexpr (countValues) {
+        counts_[0].resize(size_t{1} << (8 * sizeof(T)), 0);
+    } else {
+        for (size_t i = 0; i < extent; ++i) {
+            counts_[i].resize(bins_, 0);
+        }
     }
+}
 
-    D min(std::numeric_limits<double>::max());
-    D max(std::numeric_limits<double>::lowest());
-    D sum(0);
-    D sum2(0);
-    size_t count(0);
-
-    const D rangeMin(dataRange.x);
-    const D rangeScaleFactor(static_cast<double>(bins - 1) / (dataRange.y - dataRange.x));
-
-    for (; begin != end; ++begin) {
+template <typename T>
+template <typename FirstIter, typename LastIter>
+void HistogramAccumulator<T>::add(FirstIter begin, LastIter end) {
+    if constexpr (countValues) {
+        auto values = counts_[0].data();
+        for (; begin != end; ++begin) {
+            ++values[static_cast<size_t>(static_cast<std::make_unsigned_t<T>>(*begin))];
+            count_++;
+        }
+    } else if constexpr (std::is_floating_point<T>::value && std::is_pointer<FirstIter>::value &&
+                         std::is_same<FirstIter, LastIter>::value) {
+        addFloats(begin, end);
+    } else {
+        const D rangeMin(dataRange_.x);
+        const D rangeScaleFactor(static_cast<double>(bins_ - 1) / (dataRange_.y - dataRange_.x));
+
+        for (; begin != end; ++begin) {
+            const auto val = static_cast<D>(*begin);
+
+            min_ = glm::min(min_, val);
+            max_ = glm::max(max_, val);
+            sum_ += val;
+            sum2_ += val * val;
+            count_++;
+
+            const auto ind = static_cast<I>((val - rangeMin) * rangeScaleFactor);
+
+            for (size_t i = 0; i < extent; ++i) {
+                const auto v = util::glmcomp(ind, i);
+                if (v < bins_) {
+                    counts_[i][v]++;
+                }
+            }
+        }
+    }
+}
 
-        const auto val = static_cast<D>(*begin);
+template <typename T>
+void HistogramAccumulator<T>::addFloats(const T* begin, const T* end) {
+    if constexpr (std::is_floating_point<T>::value) {
+        constexpr size_t lanes = 4;
+        const double rangeMin = dataRange_.x;
+        const double rangeScaleFactor =
+            static_cast<double>(bins_ - 1) / (dataRange_.y - dataRange_.x);
+        const double bins = static_cast<double>(bins_);
+        auto counts = counts_[0].data();
+
+        std::array<double, lanes> min;
+        std::array<double, lanes> max;
+        std::array<double, lanes> sum;
+        std::array<double, lanes> sum2;
+        min.fill(min_);
+        max.fill(max_);
+        sum.fill(0.0);
+        sum2.fill(0.0);
+
+        const auto bin = [&](double val) {
+            // Truncate towards zero like the generic path, NaN is rejected
+            const double ind = (val - rangeMin) * rangeScaleFactor;
+            if (ind > -1.0 && ind < bins) ++counts[static_cast<size_t>(ind)];
+        };
+
+        const size_t size = static_cast<size_t>(end - begin);
+        size_t i = 0;
+        for (; i + lanes <= size; i += lanes) {
+            for (size_t l = 0; l < lanes; ++l) {
+                const double val = static_cast<double>(begin[i + l]);
+                min[l] = val < min[l] ? val : min[l];
+                max[l] = val > max[l] ? val : max[l];
+                sum[l] += val;
+                sum2[l] += val * val;
+            }
+            for (size_t l = 0; l < lanes; ++l) {
+                bin(static_cast<double>(begin[i + l]));
+            }
+        }
+        for (; i < size; ++i) {
+            const double val = static_cast<double>(begin[i]);
+            min[0] = val < min[0] ? val : min[0];
+            max[0] = val > max[0] ? val : max[0];
+            sum[0] += val;
+            sum2[0] += val * val;
+            bin(val);
+        }
 
-        min = glm::min(min, val);
-        max = glm::max(max, val);
-        sum += val;
-        sum2 += val * val;
-        count++;
+        for (size_t l = 0; l < lanes; ++l) {
+            min_ = std::min(min_, min[l]);
+            max_ = std::max(max_, max[l]);
+            sum_ += sum[l];
+            sum2_ += sum2[l];
+        }
+        count_ += size;
+    }
+}
 
-        const auto ind = static_cast<I>((val - rangeMin) * rangeScaleFactor);
+template <typename T>
+void HistogramAccumulator<T>::merge(const HistogramAccumulator& other) {
+    for (size_t i = 0; i < extent; ++i) {
+        std::transform(counts_[i].begin(), counts_[i].end(), other.counts_[i].begin(),
+                       counts_[i].begin(), std::plus<size_t>{});
+    }
+    min_ = glm::min(min_, other.min_);
+    max_ = glm::max(max_, other.max_);
+    sum_ += other.sum_;
+    sum2_ += other.sum2_;
+    count_ += other.count_;
+}
 
-        for (size_t i = 0; i < extent; ++i) {
-            const auto v = util::glmcomp(ind, i);
-            if (v < bins) {
-                histData[i][v]++;
+template <typename T>
+std::vector<NormalizedHistogram> HistogramAccumulator<T>::getHistograms() const {
+    std::array<std::vector<double>, extent> histData;
+    D min = min_;
+    D max = max_;
+    D sum = sum_;
+    D sum2 = sum2_;
+
+    if constexpr (countValues) {
+        const double rangeMin = dataRange_.x;
+        const double rangeScaleFactor =
+            static_cast<double>(bins_ - 1) / (dataRange_.y - dataRange_.x);
+        histData[0].resize(bins_, 0.0);
+
+        const auto& values = counts_[0];
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (values[i] == 0) continue;
+            const auto count = static_cast<double>(values[i]);
+            const auto val =
+                static_cast<double>(static_cast<T>(static_cast<std::make_unsigned_t<T>>(i)));
+            min = std::min(min, val);
+            max = std::max(max, val);
+            sum += count * val;
+            sum2 += count * val * val;
+
+            const double ind = (val - rangeMin) * rangeScaleFactor;
+            if (ind > -1.0 && ind < static_cast<double>(bins_)) {
+                histData[0][static_cast<size_t>(ind)] += count;
             }
         }
+    } else {
+        for (size_t i = 0; i < extent; ++i) {
+            histData[i].assign(counts_[i].begin(), counts_[i].end());
+        }
     }
 
-    const auto dcount = static_cast<double>(count);
+    const auto dcount = static_cast<double>(count_);
     const auto mean = sum / dcount;
     const auto stddev = glm::sqrt((dcount * sum2 - sum * sum) / (dcount * (dcount - D{1})));
 
+    std::vector<NormalizedHistogram> histograms;
     for (size_t i = 0; i < extent; ++i) {
-        histograms_.emplace_back(dataRange, std::move(histData[i]), util::glmcomp(min, i),
-                                 util::glmcomp(max, i), util::glmcomp(mean, i),
-                                 util::glmcomp(stddev, i));
+        histograms.emplace_back(dataRange_, std::move(histData[i]), util::glmcomp(min, i),
+                                util::glmcomp(max, i), util::glmcomp(mean, i),
+                                util::glmcomp(stddev, i));
     }
+    return histograms;
 }
 
+template <typename FirstIter, typename LastIter>
+HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter begin,
+                                       LastIter end) {
+    using T = typename std::iterator_traits<FirstIter>::value_type;
+
+    HistogramAccumulator<T> accumulator(dataRange, bins);
+    accumulator.add(begin, end);
+    histograms_ = accumulator.getHistograms();
+}
+
+template <typename T>
+HistogramContainer::HistogramContainer(const HistogramAccumulator<T>& accumulator)
+    : histograms_{accumulator.getHistograms()} {}
+
 }  // namespace inviwo
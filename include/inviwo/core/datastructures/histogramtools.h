@@ -33,6 +33,7 @@
 #include <inviwo/core/util/dispatcher.h>
 #include <inviwo/core/util/glm.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/image/layerram.h>
 
 #include <atomic>
 #include <memory>
@@ -56,12 +57,20 @@ public:
 
     void whenDone(std::function<void(const HistogramContainer&)> callback);
 
+    /**
+     * Large volumes are first sampled sparsely, and then more densely in a few passes, before the
+     * full histogram is calculated. The callback is called with the histograms of each such pass,
+     * but not with the final histograms, use whenDone for those.
+     */
+    void whenUpdated(std::function<void(const HistogramContainer&)> callback);
+
     size_t getBins() const { return bins_; }
     dvec2 getDataRange() const { return dataRange_; }
 
 private:
     std::weak_ptr<HistogramContainer> container_;
     Dispatcher<void(const HistogramContainer&)> callbacks_;
+    Dispatcher<void(const HistogramContainer&)> updateCallbacks_;
     std::vector<std::shared_ptr<std::function<void(const HistogramContainer&)>>> callbackHandles_;
     std::shared_ptr<std::atomic<bool>> stop_;
     bool done = false;
@@ -96,4 +105,27 @@ private:
     mutable std::shared_ptr<HistogramContainer> histograms_;
 };
 
+namespace util {
+
+/**
+ * Calculate the histograms of the volume, one per channel, using the thread pool. The data is
+ * split into one chunk per pool thread, the chunks are accumulated into separate bins that are
+ * merged at the end, see HistogramAccumulator. If called from within a pool task the calling
+ * thread helps out while waiting.
+ * @param volume the data
+ * @param dataRange the range covered by the bins
+ * @param bins number of bins
+ * @param stride only use every stride-th voxel, to quickly get an approximate histogram
+ */
+IVW_CORE_API HistogramContainer calculateHistograms(const VolumeRAM& volume, dvec2 dataRange,
+                                                    size_t bins, size_t stride = 1);
+
+/**
+ * Calculate the histograms of the layer, one per channel, see the volume overload.
+ */
+IVW_CORE_API HistogramContainer calculateHistograms(const LayerRAM& layer, dvec2 dataRange,
+                                                    size_t bins, size_t stride = 1);
+
+}  // namespace util
+
 }  // namespace inviwo
@@ -111,6 +111,9 @@ public:
     std::unique_ptr<std::vector<unsigned char>> getAsCodedBuffer(
         const std::string& fileExtension) const;
 
+    static const std::string classIdentifier;
+    static const std::string dataName;
+
 private:
     friend class LayerRepresentation;
 
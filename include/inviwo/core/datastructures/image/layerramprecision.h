@@ -52,10 +52,20 @@ public:
                       const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                       InterpolationType interpolation = InterpolationType::Linear,
                       const Wrapping2D& wrap = wrapping2d::clampAll);
+    /**
+     * Create a layer using memory that is owned by someone else, for example a NumPy array. The
+     * layer will not delete data, but keeps dataOwner alive for as long as data is used.
+     * Copies of the layer will always allocate and copy the data.
+     */
+    LayerRAMPrecision(T* data, std::shared_ptr<const void> dataOwner, size2_t dimensions,
+                      LayerType type = LayerType::Color,
+                      const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                      InterpolationType interpolation = InterpolationType::Linear,
+                      const Wrapping2D& wrap = wrapping2d::clampAll);
     LayerRAMPrecision(const LayerRAMPrecision<T>& rhs);
     LayerRAMPrecision<T>& operator=(const LayerRAMPrecision<T>& that);
     virtual LayerRAMPrecision<T>* clone() const override;
-    virtual ~LayerRAMPrecision() = default;
+    virtual ~LayerRAMPrecision();
 
     T* getDataTyped();
     const T* getDataTyped() const;
@@ -63,6 +73,24 @@ public:
     virtual void* getData() override;
     virtual const void* getData() const override;
     virtual void setData(void* data, size2_t dimensions) override;
+    /**
+     * Replace the data with memory that is owned by dataOwner, see the corresponding constructor.
+     */
+    void setData(T* data, std::shared_ptr<const void> dataOwner, size2_t dimensions);
+
+    /**
+     * Share the data with someone else without copying it, for example as a NumPy array. The
+     * returned pointer keeps the data alive even if the layer is changed or destroyed. The data
+     * is copy-on-write from then on, the next non-const access to the data makes a private copy
+     * first, so changes to the layer are never seen through the returned pointer. Data that is
+     * not owned by the layer and has no data owner is copied once.
+     */
+    std::shared_ptr<const T> shareData();
+    /**
+     * Returns true if the data is shared, and will be copied on the next non-const access.
+     * @see shareData
+     */
+    bool isCopyOnWrite() const;
 
     /**
      * Resize the representation to dimension. This is destructive, the data will not be
@@ -101,8 +129,13 @@ public:
     virtual void setFromNormalizedDVec4(const size2_t& pos, dvec4 val) override;
 
 private:
+    void detach();
+
     size2_t dimensions_;
+    bool ownsDataPtr_ = true;
+    bool copyOnWrite_ = false;  // The data is shared and has to be copied before modification
     std::unique_ptr<T[]> data_;
+    std::shared_ptr<const void> dataOwner_;  // Keeps external data alive when !ownsDataPtr_
     SwizzleMask swizzleMask_;
     InterpolationType interpolation_;
     Wrapping2D wrapping_;
@@ -154,6 +187,20 @@ LayerRAMPrecision<T>::LayerRAMPrecision(T* data, size2_t dimensions, LayerType t
     }
 }
 
+template <typename T>
+LayerRAMPrecision<T>::LayerRAMPrecision(T* data, std::shared_ptr<const void> dataOwner,
+                                        size2_t dimensions, LayerType type,
+                                        const SwizzleMask& swizzleMask,
+                                        InterpolationType interpolation, const Wrapping2D& wrapping)
+    : LayerRAM(type, DataFormat<T>::get())
+    , dimensions_(dimensions)
+    , ownsDataPtr_(false)
+    , data_(data)
+    , dataOwner_(std::move(dataOwner))
+    , swizzleMask_(swizzleMask)
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {}
+
 template <typename T>
 LayerRAMPrecision<T>::LayerRAMPrecision(const LayerRAMPrecision<T>& rhs)
     : LayerRAM(rhs)
@@ -174,6 +221,10 @@ LayerRAMPrecision<T>& LayerRAMPrecision<T>::operator=(const LayerRAMPrecision<T>
         auto data = std::make_unique<T[]>(dim.x * dim.y);
         std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * sizeof(T));
         data_.swap(data);
+        if (!ownsDataPtr_) data.release();
+        ownsDataPtr_ = true;
+        copyOnWrite_ = false;
+        dataOwner_.reset();
 
         dimensions_ = that.dimensions_;
         swizzleMask_ = that.swizzleMask_;
@@ -183,6 +234,11 @@ LayerRAMPrecision<T>& LayerRAMPrecision<T>::operator=(const LayerRAMPrecision<T>
     return *this;
 }
 
+template <typename T>
+LayerRAMPrecision<T>::~LayerRAMPrecision() {
+    if (!ownsDataPtr_) data_.release();
+}
+
 template <typename T>
 LayerRAMPrecision<T>* LayerRAMPrecision<T>::clone() const {
     return new LayerRAMPrecision<T>(*this);
@@ -190,6 +246,7 @@ LayerRAMPrecision<T>* LayerRAMPrecision<T>::clone() const {
 
 template <typename T>
 T* inviwo::LayerRAMPrecision<T>::getDataTyped() {
+    detach();
     return data_.get();
 }
 
@@ -200,6 +257,7 @@ const T* inviwo::LayerRAMPrecision<T>::getDataTyped() const {
 
 template <typename T>
 void* LayerRAMPrecision<T>::getData() {
+    detach();
     return data_.get();
 }
 template <typename T>
@@ -212,6 +270,61 @@ void inviwo::LayerRAMPrecision<T>::setData(void* d, size2_t dimensions) {
     std::unique_ptr<T[]> data(static_cast<T*>(d));
     data_.swap(data);
     std::swap(dimensions_, dimensions);
+
+    if (!ownsDataPtr_) data.release();
+    ownsDataPtr_ = true;
+    copyOnWrite_ = false;
+    dataOwner_.reset();
+}
+
+template <typename T>
+void LayerRAMPrecision<T>::setData(T* d, std::shared_ptr<const void> dataOwner,
+                                   size2_t dimensions) {
+    std::unique_ptr<T[]> data(d);
+    data_.swap(data);
+    std::swap(dimensions_, dimensions);
+
+    if (!ownsDataPtr_) data.release();
+    ownsDataPtr_ = false;
+    copyOnWrite_ = false;
+    dataOwner_ = std::move(dataOwner);
+}
+
+template <typename T>
+std::shared_ptr<const T> LayerRAMPrecision<T>::shareData() {
+    if (ownsDataPtr_) {
+        // Hand the data over to a shared owner
+        dataOwner_ = std::shared_ptr<T[]>(data_.get());
+        ownsDataPtr_ = false;
+    } else if (!dataOwner_) {
+        // Nothing guarantees the lifetime of the data, share a copy instead
+        const auto size = dimensions_.x * dimensions_.y;
+        std::shared_ptr<T[]> copy(new T[size]);
+        std::copy(data_.get(), data_.get() + size, copy.get());
+        data_.release();
+        data_.reset(copy.get());
+        dataOwner_ = std::move(copy);
+    }
+    copyOnWrite_ = true;
+    return std::shared_ptr<const T>(dataOwner_, data_.get());
+}
+
+template <typename T>
+bool LayerRAMPrecision<T>::isCopyOnWrite() const {
+    return copyOnWrite_;
+}
+
+template <typename T>
+void LayerRAMPrecision<T>::detach() {
+    if (!copyOnWrite_) return;
+    const auto size = dimensions_.x * dimensions_.y;
+    std::unique_ptr<T[]> data(new T[size]);
+    std::copy(data_.get(), data_.get() + size, data.get());
+    data_.swap(data);
+    if (!ownsDataPtr_) data.release();
+    ownsDataPtr_ = true;
+    copyOnWrite_ = false;
+    dataOwner_.reset();
 }
 
 template <typename T>
@@ -220,6 +333,10 @@ void LayerRAMPrecision<T>::setDimensions(size2_t dimensions) {
         auto data = std::make_unique<T[]>(dimensions.x * dimensions.y);
         data_.swap(data);
         std::swap(dimensions, dimensions_);
+        if (!ownsDataPtr_) data.release();
+        ownsDataPtr_ = true;
+        copyOnWrite_ = false;
+        dataOwner_.reset();
     }
 }
 
@@ -280,21 +397,25 @@ dvec4 LayerRAMPrecision<T>::getAsDVec4(const size2_t& pos) const {
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDouble(const size2_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec2(const size2_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec3(const size2_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromDVec4(const size2_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
@@ -320,21 +441,25 @@ dvec4 LayerRAMPrecision<T>::getAsNormalizedDVec4(const size2_t& pos) const {
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDouble(const size2_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec2(const size2_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec3(const size2_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void LayerRAMPrecision<T>::setFromNormalizedDVec4(const size2_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
@@ -0,0 +1,97 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * \ingroup datastructures
+ * \class BrickCache
+ * \brief A thread safe least recently used cache of volume bricks with a bounded memory budget.
+ *
+ * Bricks are identified by an index and loaded on demand using the provided loader. When the
+ * total size of the cached bricks exceeds the budget, the least recently used bricks are dropped.
+ * Bricks that are still in use elsewhere stay alive through their shared_ptr, so the memory used
+ * is the budget plus the bricks currently being held by callers.
+ */
+class IVW_CORE_API BrickCache {
+public:
+    using Loader = std::function<std::shared_ptr<const VolumeRAM>()>;
+
+    explicit BrickCache(size_t maxBytes);
+    BrickCache(const BrickCache&) = delete;
+    BrickCache& operator=(const BrickCache&) = delete;
+
+    /**
+     * Return the brick for index, calling load if it is not in the cache. The loader is called
+     * without holding the lock, to allow several bricks to be loaded concurrently.
+     */
+    std::shared_ptr<const VolumeRAM> get(size_t index, const Loader& load);
+
+    /**
+     * Return the brick for index if it is in the cache, nullptr otherwise.
+     */
+    std::shared_ptr<const VolumeRAM> find(size_t index);
+
+    void setMaxBytes(size_t maxBytes);
+    size_t getMaxBytes() const;
+    /**
+     * The number of bytes used by the cached bricks
+     */
+    size_t getBytes() const;
+    /**
+     * The number of cached bricks
+     */
+    size_t size() const;
+    void clear();
+
+private:
+    using Entry = std::pair<size_t, std::shared_ptr<const VolumeRAM>>;
+    void evict();
+
+    mutable std::mutex mutex_;
+    size_t maxBytes_;
+    size_t bytes_ = 0;
+    std::list<Entry> lru_;  // most recently used first
+    std::unordered_map<size_t, std::list<Entry>::iterator> entries_;
+};
+
+}  // namespace inviwo
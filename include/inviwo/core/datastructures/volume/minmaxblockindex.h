@@ -0,0 +1,126 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glmvec.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <vector>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * \ingroup datastructures
+ * \brief A min-max index over blocks of cells of a scalar volume, used for empty space skipping.
+ *
+ * The cells of the volume, i.e. the boxes between 2x2x2 neighboring voxels, are grouped into
+ * blocks of blockSize^3 cells. For each block the minimum and maximum value of all voxels
+ * touched by its cells are stored. Neighboring blocks hence share one layer of voxels. An
+ * algorithm looking for a value, like an isosurface extraction, can skip all cells of a block
+ * whose range does not contain the value.
+ *
+ * NaN values are recorded as a range of [-inf, inf], such that blocks containing NaNs are never
+ * skipped. Only the first channel of the volume is considered.
+ *
+ * The index of a VolumeRAM is usually retrieved through VolumeRAM::getMinMaxBlockIndex which
+ * caches it until the representation is modified.
+ */
+class IVW_CORE_API MinMaxBlockIndex {
+public:
+    static constexpr size_t defaultBlockSize = 8;
+
+    /**
+     * Calculate the index for the given volume, the calculation is run in parallel on the
+     * thread pool if an InviwoApplication is available.
+     */
+    explicit MinMaxBlockIndex(const VolumeRAM& volume, size_t blockSize = defaultBlockSize);
+
+    /**
+     * Dimensions of the indexed volume, in voxels
+     */
+    const size3_t& getVolumeDimensions() const { return dims_; }
+    size_t getBlockSize() const { return blockSize_; }
+    /**
+     * Number of blocks along each axis, enough to cover all dims - 1 cells.
+     */
+    const size3_t& getNumberOfBlocks() const { return numBlocks_; }
+
+    /**
+     * The block containing the given cell, which is identified by its lowest voxel
+     */
+    size3_t getBlock(const size3_t& cell) const { return cell / blockSize_; }
+
+    /**
+     * The range of the voxels [lower, upper] in the given block, this includes the voxels
+     * shared with the neighboring blocks.
+     */
+    std::pair<size3_t, size3_t> getVoxelRange(const size3_t& block) const;
+
+    /**
+     * Minimum and maximum value of all the voxels in the given block
+     */
+    const dvec2& getRange(const size3_t& block) const { return ranges_[index_(block)]; }
+    /**
+     * Minimum and maximum value of the whole volume
+     */
+    const dvec2& getRange() const { return range_; }
+
+    /**
+     * Test if any voxel of the block can have the value \p value, i.e. min <= value <= max
+     */
+    bool contains(const size3_t& block, double value) const {
+        const auto& r = getRange(block);
+        return r.x <= value && value <= r.y;
+    }
+
+    /**
+     * Test if the block can contain a crossing of \p value, i.e. a voxel with a value less than
+     * \p value and another voxel with a value greater than or equal to it. With \p invert the
+     * comparisons are flipped to greater than, and less than or equal. This matches the
+     * classification of the voxels in marching cubes.
+     */
+    bool crosses(const size3_t& block, double value, bool invert = false) const {
+        const auto& r = getRange(block);
+        return invert ? (r.x <= value && value < r.y) : (r.x < value && value <= r.y);
+    }
+
+private:
+    size3_t dims_;
+    size_t blockSize_;
+    size3_t numBlocks_;
+    util::IndexMapper3D index_;
+    std::vector<dvec2> ranges_;
+    dvec2 range_;
+};
+
+}  // namespace inviwo
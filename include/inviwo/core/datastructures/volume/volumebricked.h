@@ -0,0 +1,192 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/datastructures/volume/brickcache.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <string>
+#include <memory>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * \ingroup datastructures
+ * \class VolumeBricked
+ * \brief An out-of-core volume representation backed by a bricked file on disk.
+ *
+ * The volume is split into bricks of equal size that are stored one after another in a file, see
+ * util::writeBrickedVolume. Bricks are read on demand and kept in a BrickCache with a bounded
+ * memory budget, which makes it possible to work with volumes that are larger than the available
+ * memory. Clones share the same cache.
+ *
+ * Voxels can be accessed individually with the same getAs* functions as a VolumeRAM, or a
+ * subregion can be extracted into a VolumeRAM with getRegion. Converting to a VolumeRAM will
+ * read the whole volume.
+ */
+class IVW_CORE_API VolumeBricked : public VolumeRepresentation {
+public:
+    static constexpr size_t defaultCacheSize = size_t{512} * 1024 * 1024;
+
+    /**
+     * Voxel access that keeps the brick of the last accessed voxel. Consecutive accesses within
+     * the same brick do not go through the BrickCache, which is locked on every lookup. Use it
+     * for runs of nearby voxels, e.g. the corners of a trilinear sample. An Accessor is not
+     * thread safe, use one per thread.
+     */
+    class IVW_CORE_API Accessor {
+    public:
+        explicit Accessor(const VolumeBricked& volume);
+
+        double getAsDouble(const size3_t& pos);
+        dvec2 getAsDVec2(const size3_t& pos);
+        dvec3 getAsDVec3(const size3_t& pos);
+        dvec4 getAsDVec4(const size3_t& pos);
+
+        double getAsNormalizedDouble(const size3_t& pos);
+        dvec2 getAsNormalizedDVec2(const size3_t& pos);
+        dvec3 getAsNormalizedDVec3(const size3_t& pos);
+        dvec4 getAsNormalizedDVec4(const size3_t& pos);
+
+    private:
+        /**
+         * The brick containing pos, pos is changed to the position within the brick
+         */
+        const VolumeRAM& brick(size3_t& pos);
+
+        const VolumeBricked* volume_;
+        size3_t current_;
+        std::shared_ptr<const VolumeRAM> brick_;
+    };
+
+    /**
+     * Open a bricked volume file. Only the header is read here.
+     * @throws DataReaderException if the file could not be opened or is not a bricked volume file.
+     */
+    explicit VolumeBricked(const std::string& file, size_t cacheSize = defaultCacheSize,
+                           const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                           InterpolationType interpolation = InterpolationType::Linear,
+                           const Wrapping3D& wrapping = wrapping3d::clampAll);
+    VolumeBricked(const VolumeBricked& rhs) = default;
+    VolumeBricked& operator=(const VolumeBricked& that) = default;
+    virtual VolumeBricked* clone() const override;
+    virtual ~VolumeBricked() = default;
+
+    virtual std::type_index getTypeIndex() const override final;
+
+    virtual void setDimensions(size3_t dimensions) override;
+    virtual const size3_t& getDimensions() const override;
+
+    virtual void setSwizzleMask(const SwizzleMask& mask) override;
+    virtual SwizzleMask getSwizzleMask() const override;
+
+    virtual void setInterpolation(InterpolationType interpolation) override;
+    virtual InterpolationType getInterpolation() const override;
+
+    virtual void setWrapping(const Wrapping3D& wrapping) override;
+    virtual Wrapping3D getWrapping() const override;
+
+    const std::string& getFileName() const;
+    const size3_t& getBrickDimensions() const;
+    /**
+     * The number of bricks along each axis
+     */
+    size3_t getBrickCount() const;
+
+    /**
+     * Get the brick with the given brick coordinate, i.e. the brick containing the voxels from
+     * brick * getBrickDimensions() to (brick + 1) * getBrickDimensions(). Bricks at the upper
+     * border of the volume are padded with zeros.
+     */
+    std::shared_ptr<const VolumeRAM> getBrick(const size3_t& brick) const;
+
+    /**
+     * Read the region [offset, offset + extent) into a new VolumeRAM.
+     * @throws RangeException if the region is not inside the volume.
+     */
+    std::shared_ptr<VolumeRAM> getRegion(const size3_t& offset, const size3_t& extent) const;
+
+    /**
+     * Access a single voxel. Each call looks up the brick in the BrickCache, use an Accessor for
+     * many voxels.
+     */
+    double getAsDouble(const size3_t& pos) const;
+    dvec2 getAsDVec2(const size3_t& pos) const;
+    dvec3 getAsDVec3(const size3_t& pos) const;
+    dvec4 getAsDVec4(const size3_t& pos) const;
+
+    double getAsNormalizedDouble(const size3_t& pos) const;
+    dvec2 getAsNormalizedDVec2(const size3_t& pos) const;
+    dvec3 getAsNormalizedDVec3(const size3_t& pos) const;
+    dvec4 getAsNormalizedDVec4(const size3_t& pos) const;
+
+    BrickCache& getCache() const;
+
+private:
+    std::string file_;
+    size3_t dimensions_;
+    size3_t brickDimensions_;
+    size_t dataOffset_;
+    std::shared_ptr<BrickCache> cache_;
+    SwizzleMask swizzleMask_;
+    InterpolationType interpolation_;
+    Wrapping3D wrapping_;
+};
+
+namespace util {
+
+/**
+ * Write a volume to a bricked volume file that can be opened by VolumeBricked.
+ * The file consists of a header followed by the bricks in x, y, z order. Each brick is stored
+ * linearized and has the full brick dimensions, bricks at the upper borders are padded with zeros.
+ * @param data linearized volume data with the given dimensions and format
+ * @param dimensions of the volume
+ * @param format of the volume data
+ * @param file path to the file to write
+ * @param brickDimensions size of the bricks
+ * @throws DataWriterException if the format is not supported or the file could not be written.
+ */
+IVW_CORE_API void writeBrickedVolume(const void* data, const size3_t& dimensions,
+                                     const DataFormatBase* format, const std::string& file,
+                                     const size3_t& brickDimensions = size3_t{64});
+
+/**
+ * Convenience overload writing a VolumeRAM, see above.
+ */
+IVW_CORE_API void writeBrickedVolume(const VolumeRAM& volume, const std::string& file,
+                                     const size3_t& brickDimensions = size3_t{64});
+
+}  // namespace util
+
+}  // namespace inviwo
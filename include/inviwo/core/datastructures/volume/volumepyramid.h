@@ -0,0 +1,191 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/util/glmvec.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * The filter used to combine the 2x2x2 voxels of a finer level into one voxel of the next
+ * coarser level in a VolumePyramid.
+ */
+enum class DownsamplingKernel {
+    Nearest,  ///< Use the first voxel, keeps the original values
+    Average,  ///< Average of the voxels, a box filter
+    Minimum,  ///< Component wise minimum, keeps thin dark features
+    Maximum   ///< Component wise maximum, keeps thin bright features, suitable for MIP
+};
+
+template <class Elem, class Traits>
+std::basic_ostream<Elem, Traits>& operator<<(std::basic_ostream<Elem, Traits>& ss,
+                                             DownsamplingKernel kernel) {
+    switch (kernel) {
+        case DownsamplingKernel::Nearest:
+            ss << "Nearest";
+            break;
+        case DownsamplingKernel::Average:
+            ss << "Average";
+            break;
+        case DownsamplingKernel::Minimum:
+            ss << "Minimum";
+            break;
+        case DownsamplingKernel::Maximum:
+            ss << "Maximum";
+            break;
+    }
+    return ss;
+}
+
+/**
+ * \ingroup datastructures
+ * \class VolumePyramid
+ * \brief A multiresolution representation of a volume holding a level of detail pyramid.
+ *
+ * Level 0 is the full resolution volume and each following level has half the dimensions of the
+ * previous one, rounded up. Levels are either kept in memory or loaded on demand using a Loader,
+ * which makes it possible to deliver a coarse level quickly and load the finer ones later.
+ * The levels are never modified once created, clones share the loaded levels but load missing
+ * levels independently.
+ *
+ * Converting to a VolumeRAM gives a copy of level 0.
+ * @see util::createVolumePyramid
+ */
+class IVW_CORE_API VolumePyramid : public VolumeRepresentation {
+public:
+    using Loader = std::function<std::shared_ptr<VolumeRAM>()>;
+
+    /**
+     * Create a pyramid from levels in memory, ordered from finest to coarsest.
+     * @param levels the levels, level 0 being the full resolution volume. Must not be empty.
+     * @param kernel that was used to create the levels
+     */
+    VolumePyramid(std::vector<std::shared_ptr<VolumeRAM>> levels, DownsamplingKernel kernel,
+                  const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                  InterpolationType interpolation = InterpolationType::Linear,
+                  const Wrapping3D& wrapping = wrapping3d::clampAll);
+    /**
+     * Create a pyramid where the levels are loaded on demand.
+     * @param format of the levels
+     * @param levelDimensions the dimensions of each level, ordered from finest to coarsest, level
+     * 0 being the full resolution volume. Must not be empty.
+     * @param loaders one loader for each level
+     * @param kernel that was used to create the levels
+     */
+    VolumePyramid(const DataFormatBase* format, std::vector<size3_t> levelDimensions,
+                  std::vector<Loader> loaders, DownsamplingKernel kernel,
+                  const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                  InterpolationType interpolation = InterpolationType::Linear,
+                  const Wrapping3D& wrapping = wrapping3d::clampAll);
+    VolumePyramid(const VolumePyramid& rhs);
+    VolumePyramid& operator=(const VolumePyramid& that);
+    virtual VolumePyramid* clone() const override;
+    virtual ~VolumePyramid() = default;
+
+    virtual std::type_index getTypeIndex() const override final;
+
+    virtual void setDimensions(size3_t dimensions) override;
+    virtual const size3_t& getDimensions() const override;
+
+    virtual void setSwizzleMask(const SwizzleMask& mask) override;
+    virtual SwizzleMask getSwizzleMask() const override;
+
+    virtual void setInterpolation(InterpolationType interpolation) override;
+    virtual InterpolationType getInterpolation() const override;
+
+    virtual void setWrapping(const Wrapping3D& wrapping) override;
+    virtual Wrapping3D getWrapping() const override;
+
+    size_t getNumberOfLevels() const;
+    const size3_t& getLevelDimensions(size_t level) const;
+    DownsamplingKernel getKernel() const;
+
+    /**
+     * Get a level, loading it if needed. This function is thread safe, the loading is done
+     * without holding the lock so the same level might be loaded more than once concurrently,
+     * only the first result is kept.
+     */
+    std::shared_ptr<const VolumeRAM> getLevel(size_t level) const;
+    bool isLevelLoaded(size_t level) const;
+
+private:
+    struct Level {
+        size3_t dimensions;
+        Loader loader;
+        mutable std::shared_ptr<const VolumeRAM> ram;  ///< Guarded by mutex_, set by getLevel
+    };
+    std::vector<Level> copyLevels() const;
+
+    DownsamplingKernel kernel_;
+    mutable std::mutex mutex_;
+    std::vector<Level> levels_;
+    SwizzleMask swizzleMask_;
+    InterpolationType interpolation_;
+    Wrapping3D wrapping_;
+};
+
+namespace util {
+
+/**
+ * Create a new volume with half the dimensions of the input, rounded up, where each voxel is
+ * computed from the corresponding 2x2x2 voxels using the given kernel. Averages of integer types
+ * are rounded to the nearest value. The work is distributed over the thread pool.
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> downsample(const VolumeRAM& volume,
+                                                   DownsamplingKernel kernel);
+
+/**
+ * Create the downsampled levels of a pyramid by repeatedly downsampling the volume until all
+ * dimensions are at most minDimension. The full resolution volume is not included.
+ */
+IVW_CORE_API std::vector<std::shared_ptr<VolumeRAM>> createPyramidLevels(
+    const VolumeRAM& volume, DownsamplingKernel kernel = DownsamplingKernel::Average,
+    size_t minDimension = 32);
+
+/**
+ * Create a pyramid with volume as level 0, see createPyramidLevels.
+ */
+IVW_CORE_API std::shared_ptr<VolumePyramid> createVolumePyramid(
+    std::shared_ptr<VolumeRAM> volume, DownsamplingKernel kernel = DownsamplingKernel::Average,
+    size_t minDimension = 32);
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -31,11 +31,15 @@
 
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/datastructures/volume/minmaxblockindex.h>
 #include <inviwo/core/datastructures/histogram.h>
 #include <inviwo/core/util/glm.h>
 #include <inviwo/core/util/formats.h>
 #include <inviwo/core/util/formatdispatching.h>
 
+#include <memory>
+#include <mutex>
+
 namespace inviwo {
 
 class HistogramCalculationState;
@@ -97,6 +101,16 @@ public:
 
     virtual std::type_index getTypeIndex() const override final;
 
+    /**
+     * Returns a MinMaxBlockIndex of the volume, used to skip parts of the volume that can not
+     * contain a value. The index is calculated on first use and then cached until the version of
+     * the representation changes, see DataRepresentation::getVersion. Note that modifications
+     * made through a pointer kept from an earlier call to Data::getEditableRepresentation are not
+     * detected.
+     */
+    std::shared_ptr<const MinMaxBlockIndex> getMinMaxBlockIndex(
+        size_t blockSize = MinMaxBlockIndex::defaultBlockSize) const;
+
     /**
      * Dispatch functionality to retrieve the actual underlaying VolumeRamPrecision.
      * The dispatcher takes a generic lambda as argument. Code will be instantiated for all the
@@ -151,6 +165,23 @@ public:
     template <typename Result, template <class> class Predicate = dispatching::filter::All,
               typename Callable, typename... Args>
     auto dispatch(Callable&& callable, Args&&... args) const -> Result;
+
+private:
+    // The cached index is not shared between copies
+    struct MinMaxBlockIndexCache {
+        MinMaxBlockIndexCache() = default;
+        MinMaxBlockIndexCache(const MinMaxBlockIndexCache&) {}
+        MinMaxBlockIndexCache& operator=(const MinMaxBlockIndexCache&) {
+            std::unique_lock<std::mutex> lock{mutex};
+            index.reset();
+            return *this;
+        }
+
+        std::mutex mutex;
+        size_t version = 0;
+        std::shared_ptr<const MinMaxBlockIndex> index;
+    };
+    mutable MinMaxBlockIndexCache minMaxBlockIndex_;
 };
 
 class Volume;
@@ -33,6 +33,8 @@
 #include <inviwo/core/datastructures/representationconverter.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumebricked.h>
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 
 namespace inviwo {
@@ -46,4 +48,25 @@ public:
                         std::shared_ptr<VolumeRAM> destination) const override;
 };
 
+class IVW_CORE_API VolumeBricked2RAMConverter
+    : public RepresentationConverterType<VolumeRepresentation, VolumeBricked, VolumeRAM> {
+public:
+    virtual std::shared_ptr<VolumeRAM> createFrom(
+        std::shared_ptr<const VolumeBricked> source) const override;
+    virtual void update(std::shared_ptr<const VolumeBricked> source,
+                        std::shared_ptr<VolumeRAM> destination) const override;
+};
+
+/**
+ * Creates a VolumeRAM with a copy of level 0 of the pyramid.
+ */
+class IVW_CORE_API VolumePyramid2RAMConverter
+    : public RepresentationConverterType<VolumeRepresentation, VolumePyramid, VolumeRAM> {
+public:
+    virtual std::shared_ptr<VolumeRAM> createFrom(
+        std::shared_ptr<const VolumePyramid> source) const override;
+    virtual void update(std::shared_ptr<const VolumePyramid> source,
+                        std::shared_ptr<VolumeRAM> destination) const override;
+};
+
 }  // namespace inviwo
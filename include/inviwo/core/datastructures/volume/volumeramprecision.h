@@ -51,6 +51,15 @@ public:
                        const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                        InterpolationType interpolation = InterpolationType::Linear,
                        const Wrapping3D& wrapping = wrapping3d::clampAll);
+    /**
+     * Create a volume using memory that is owned by someone else, for example a memory mapped
+     * file. The volume will not delete data, but keeps dataOwner alive for as long as data is used.
+     * Copies of the volume will always allocate and copy the data.
+     */
+    VolumeRAMPrecision(T* data, std::shared_ptr<const void> dataOwner, size3_t dimensions,
+                       const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                       InterpolationType interpolation = InterpolationType::Linear,
+                       const Wrapping3D& wrapping = wrapping3d::clampAll);
     VolumeRAMPrecision(const VolumeRAMPrecision<T>& rhs);
     VolumeRAMPrecision<T>& operator=(const VolumeRAMPrecision<T>& that);
     virtual VolumeRAMPrecision<T>* clone() const override;
@@ -66,6 +75,24 @@ public:
     virtual const void* getData(size_t) const override;
 
     virtual void setData(void* data, size3_t dimensions) override;
+    /**
+     * Replace the data with memory that is owned by dataOwner, see the corresponding constructor.
+     */
+    void setData(T* data, std::shared_ptr<const void> dataOwner, size3_t dimensions);
+
+    /**
+     * Share the data with someone else without copying it, for example as a NumPy array. The
+     * returned pointer keeps the data alive even if the volume is changed or destroyed. The data
+     * is copy-on-write from then on, the next non-const access to the data makes a private copy
+     * first, so changes to the volume are never seen through the returned pointer. Data that is
+     * not owned by the volume and has no data owner is copied once.
+     */
+    std::shared_ptr<const T> shareData();
+    /**
+     * Returns true if the data is shared, and will be copied on the next non-const access.
+     * @see shareData
+     */
+    bool isCopyOnWrite() const;
 
     virtual void removeDataOwnership() override;
 
@@ -109,9 +136,13 @@ public:
     virtual size_t getNumberOfBytes() const override;
 
 private:
+    void detach();
+
     size3_t dimensions_;
     bool ownsDataPtr_;
+    bool copyOnWrite_ = false;  // The data is shared and has to be copied before modification
     std::unique_ptr<T[]> data_;
+    std::shared_ptr<const void> dataOwner_;  // Keeps external data alive when !ownsDataPtr_
     SwizzleMask swizzleMask_;
     InterpolationType interpolation_;
     Wrapping3D wrapping_;
@@ -132,6 +163,20 @@ IVW_CORE_API std::shared_ptr<VolumeRAM> createVolumeRAM(
     InterpolationType interpolation = InterpolationType::Linear,
     const Wrapping3D& wrapping = wrapping3d::clampAll);
 
+/**
+ * Factory for volumes using external memory.
+ * Creates an VolumeRAM with data type specified by format that uses dataPtr without taking
+ * ownership of it. Instead dataOwner is kept alive for as long as the volume uses dataPtr.
+ *
+ * @return nullptr if no valid format was specified.
+ * @see VolumeRAMPrecision(T*, std::shared_ptr<const void>, size3_t, ...)
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> createVolumeRAM(
+    const size3_t& dimensions, const DataFormatBase* format, void* dataPtr,
+    std::shared_ptr<const void> dataOwner, const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+    InterpolationType interpolation = InterpolationType::Linear,
+    const Wrapping3D& wrapping = wrapping3d::clampAll);
+
 template <typename T>
 VolumeRAMPrecision<T>::VolumeRAMPrecision(size3_t dimensions, const SwizzleMask& swizzleMask,
                                           InterpolationType interpolation,
@@ -157,6 +202,20 @@ VolumeRAMPrecision<T>::VolumeRAMPrecision(T* data, size3_t dimensions,
     , interpolation_{interpolation}
     , wrapping_{wrapping} {}
 
+template <typename T>
+VolumeRAMPrecision<T>::VolumeRAMPrecision(T* data, std::shared_ptr<const void> dataOwner,
+                                          size3_t dimensions, const SwizzleMask& swizzleMask,
+                                          InterpolationType interpolation,
+                                          const Wrapping3D& wrapping)
+    : VolumeRAM(DataFormat<T>::get())
+    , dimensions_(dimensions)
+    , ownsDataPtr_(false)
+    , data_(data)
+    , dataOwner_(std::move(dataOwner))
+    , swizzleMask_(swizzleMask)
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {}
+
 template <typename T>
 VolumeRAMPrecision<T>::VolumeRAMPrecision(const VolumeRAMPrecision<T>& rhs)
     : VolumeRAM(rhs)
@@ -179,7 +238,10 @@ VolumeRAMPrecision<T>& VolumeRAMPrecision<T>::operator=(const VolumeRAMPrecision
         std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * dim.z * sizeof(T));
         data_.swap(data);
         std::swap(dim, dimensions_);
+        if (!ownsDataPtr_) data.release();
         ownsDataPtr_ = true;
+        copyOnWrite_ = false;
+        dataOwner_.reset();
         swizzleMask_ = that.swizzleMask_;
         interpolation_ = that.interpolation_;
         wrapping_ = that.wrapping_;
@@ -204,11 +266,13 @@ const T* inviwo::VolumeRAMPrecision<T>::getDataTyped() const {
 
 template <typename T>
 T* inviwo::VolumeRAMPrecision<T>::getDataTyped() {
+    detach();
     return data_.get();
 }
 
 template <typename T>
 void* VolumeRAMPrecision<T>::getData() {
+    detach();
     return data_.get();
 }
 template <typename T>
@@ -218,6 +282,7 @@ const void* VolumeRAMPrecision<T>::getData() const {
 
 template <typename T>
 void* VolumeRAMPrecision<T>::getData(size_t pos) {
+    detach();
     return data_.get() + pos;
 }
 
@@ -234,6 +299,58 @@ void VolumeRAMPrecision<T>::setData(void* d, size3_t dimensions) {
 
     if (!ownsDataPtr_) data.release();
     ownsDataPtr_ = true;
+    copyOnWrite_ = false;
+    dataOwner_.reset();
+}
+
+template <typename T>
+void VolumeRAMPrecision<T>::setData(T* d, std::shared_ptr<const void> dataOwner,
+                                    size3_t dimensions) {
+    std::unique_ptr<T[]> data(d);
+    data_.swap(data);
+    std::swap(dimensions_, dimensions);
+
+    if (!ownsDataPtr_) data.release();
+    ownsDataPtr_ = false;
+    copyOnWrite_ = false;
+    dataOwner_ = std::move(dataOwner);
+}
+
+template <typename T>
+std::shared_ptr<const T> VolumeRAMPrecision<T>::shareData() {
+    if (ownsDataPtr_) {
+        // Hand the data over to a shared owner
+        dataOwner_ = std::shared_ptr<T[]>(data_.get());
+        ownsDataPtr_ = false;
+    } else if (!dataOwner_) {
+        // Nothing guarantees the lifetime of the data, share a copy instead
+        const auto size = dimensions_.x * dimensions_.y * dimensions_.z;
+        std::shared_ptr<T[]> copy(new T[size]);
+        std::copy(data_.get(), data_.get() + size, copy.get());
+        data_.release();
+        data_.reset(copy.get());
+        dataOwner_ = std::move(copy);
+    }
+    copyOnWrite_ = true;
+    return std::shared_ptr<const T>(dataOwner_, data_.get());
+}
+
+template <typename T>
+bool VolumeRAMPrecision<T>::isCopyOnWrite() const {
+    return copyOnWrite_;
+}
+
+template <typename T>
+void VolumeRAMPrecision<T>::detach() {
+    if (!copyOnWrite_) return;
+    const auto size = dimensions_.x * dimensions_.y * dimensions_.z;
+    std::unique_ptr<T[]> data(new T[size]);
+    std::copy(data_.get(), data_.get() + size, data.get());
+    data_.swap(data);
+    if (!ownsDataPtr_) data.release();
+    ownsDataPtr_ = true;
+    copyOnWrite_ = false;
+    dataOwner_.reset();
 }
 
 template <typename T>
@@ -259,6 +376,8 @@ void VolumeRAMPrecision<T>::setDimensions(size3_t dimensions) {
         dimensions_ = dimensions;
         if (!ownsDataPtr_) data.release();
         ownsDataPtr_ = true;
+        copyOnWrite_ = false;
+        dataOwner_.reset();
     }
 }
 
@@ -314,21 +433,25 @@ dvec4 VolumeRAMPrecision<T>::getAsDVec4(const size3_t& pos) const {
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDouble(const size3_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec2(const size3_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec3(const size3_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromDVec4(const size3_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert<T>(val);
 }
 
@@ -354,21 +477,25 @@ dvec4 VolumeRAMPrecision<T>::getAsNormalizedDVec4(const size3_t& pos) const {
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDouble(const size3_t& pos, double val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec2(const size3_t& pos, dvec2 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec3(const size3_t& pos, dvec3 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
 template <typename T>
 void VolumeRAMPrecision<T>::setFromNormalizedDVec4(const size3_t& pos, dvec4 val) {
+    detach();
     data_[posToIndex(pos, dimensions_)] = util::glm_convert_normalized<T>(val);
 }
 
@@ -0,0 +1,80 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <string>
+#include <cstddef>
+
+namespace inviwo {
+
+/**
+ * \class MemoryMappedFile
+ * \brief A read only, copy-on-write memory mapping of a part of a file.
+ *
+ * The mapped pages are only read from disk when they are accessed. The memory is writable, but
+ * writes only modify a private copy of the touched pages and never the file itself.
+ */
+class IVW_CORE_API MemoryMappedFile {
+public:
+    /**
+     * Map size bytes of file starting at offset.
+     * @throws FileException if the file could not be opened or mapped, or if it is smaller than
+     * offset + size.
+     */
+    MemoryMappedFile(const std::string& file, size_t offset, size_t size);
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    ~MemoryMappedFile();
+
+    void* data() { return data_; }
+    const void* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    /**
+     * Hint that the given range will be accessed soon, the pages will then be read ahead of time.
+     */
+    void prefetch(size_t offset, size_t size) const;
+
+    /**
+     * The offsets of a mapping have to be a multiple of the allocation granularity. That is handled
+     * internally, but can be useful to know when choosing offsets.
+     */
+    static size_t allocationGranularity();
+
+private:
+    void* mapping_ = nullptr;  // start of the whole mapping
+    size_t mappingSize_ = 0;
+    void* data_ = nullptr;  // start of the requested range
+    size_t size_ = 0;
+};
+
+}  // namespace inviwo
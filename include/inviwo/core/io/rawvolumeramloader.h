@@ -41,10 +41,17 @@
 
 namespace inviwo {
 
+class MemoryMappedFile;
+
 /**
  * \class RawVolumeRAMLoader
  * \brief A loader of raw files. Used to create VolumeRAM representations.
  * This class us used by the DatVolumeSequenceReader, IvfVolumeReader and RawVolumeReader.
+ *
+ * When the byte order of the file matches the in memory layout, the file is memory mapped and the
+ * VolumeRAM will use the mapped memory directly. No data is then read until it is accessed, and
+ * pages that are not modified can be dropped by the OS under memory pressure. Otherwise, or if the
+ * mapping fails, the whole file is read into a newly allocated buffer.
  */
 
 class IVW_CORE_API RawVolumeRAMLoader : public DiskRepresentationLoader<VolumeRepresentation> {
@@ -57,6 +64,9 @@ public:
                                       const VolumeRepresentation& src) const override;
 
 private:
+    bool canMap(const DataFormatBase* format) const;
+    std::shared_ptr<MemoryMappedFile> map(size_t bytes) const;
+
     std::string rawFile_;
     size_t offset_;
     bool littleEndian_;
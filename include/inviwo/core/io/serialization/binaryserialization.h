@@ -0,0 +1,66 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/io/serialization/serializebase.h>
+
+#include <iosfwd>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Write the element tree of \p doc to \p stream in the compact binary serialization format.
+ * The tree is streamed node by node while it is traversed, element and attribute names and short
+ * attribute values are interned and written only once, later occurrences are written as an index.
+ * Declarations and comments are not stored.
+ * @see readBinarySerialization
+ */
+IVW_CORE_API void writeBinarySerialization(const TxDocument& doc, std::ostream& stream);
+
+/**
+ * Returns true if the next bytes of \p stream start a binary serialization. Only peeks at the
+ * stream, nothing is extracted.
+ */
+IVW_CORE_API bool isBinarySerialization(std::istream& stream);
+
+/**
+ * Read a binary serialization written by writeBinarySerialization from \p stream and append
+ * the element tree to \p doc. Only the bytes of the serialization are extracted, \p stream is
+ * left at the first byte after it.
+ * @throws SerializationException if the stream does not contain a valid binary serialization.
+ */
+IVW_CORE_API void readBinarySerialization(std::istream& stream, TxDocument& doc);
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -77,6 +77,13 @@ private:
 
 enum class SerializationTarget { Node, Attribute };
 
+/**
+ * The encoding used when writing a serialization. Xml is human readable, Binary is a compact
+ * encoding of the same element tree that is much faster to write and read.
+ * @see util::writeBinarySerialization
+ */
+enum class SerializationFormat { Xml, Binary };
+
 class NodeSwitch;
 class Serializable;
 
@@ -80,6 +80,14 @@ public:
      * @throws SerializationException
      */
     virtual void writeFile(std::ostream& stream, bool format = false);
+    /**
+     * \brief Writes serialized data to stream using the given encoding.
+     *
+     * @param stream Stream to be written to, should be opened in binary mode for Binary.
+     * @param format The encoding to use, Xml output is formatted.
+     * @throws SerializationException
+     */
+    virtual void writeFile(std::ostream& stream, SerializationFormat format);
 
     // std containers
     template <typename T>
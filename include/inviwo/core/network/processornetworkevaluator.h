@@ -34,12 +34,38 @@
 #include <inviwo/core/processors/processorobserver.h>
 #include <inviwo/core/network/processornetworkevaluationobserver.h>
 #include <inviwo/core/network/evaluationerrorhandler.h>
+#include <inviwo/core/network/topologicalorder.h>
+#include <inviwo/core/network/processorstatistics.h>
+
+#include <chrono>
+#include <vector>
 
 namespace inviwo {
 
 class Processor;
 class ProcessorNetwork;
 
+/**
+ * Timings of a network evaluation. All times are relative to the start of the evaluation.
+ * The processor pointers are only valid until the network is modified.
+ */
+struct IVW_CORE_API EvaluationTiming {
+    using duration = std::chrono::high_resolution_clock::duration;
+    struct Entry {
+        Processor* processor;
+        duration start;
+        duration end;
+        bool concurrent;  //< true if the processor was processed on the thread pool
+    };
+
+    duration total{0};
+    /// Processors that were processed during the evaluation, in the order they finished
+    std::vector<Entry> processors;
+    /// The chain of connected processors with the longest accumulated process time
+    std::vector<Processor*> criticalPath;
+    duration criticalPathTime{0};
+};
+
 class IVW_CORE_API ProcessorNetworkEvaluator : public ProcessorNetworkObserver,
                                                public ProcessorObserver,
                                                public ProcessorNetworkEvaluationObservable {
@@ -50,6 +76,28 @@ public:
     virtual ~ProcessorNetworkEvaluator() = default;
     void setExceptionHandler(EvaluationErrorHandler handler);
 
+    /**
+     * Enable or disable parallel evaluation. In parallel mode the processors are evaluated in
+     * dependency order, and the process() function of processors that opt in with
+     * Tags::Concurrent, and are not tagged with Tags::GL, Tags::CL, or Tags::PY, is run on the
+     * thread pool as soon as all their predecessors are done. All other processors, and all other
+     * evaluation steps like initializeResources and inport onChange callbacks, are run on the
+     * calling thread. Parallel evaluation is off by default.
+     */
+    void setParallelEvaluation(bool parallel);
+    bool getParallelEvaluation() const;
+
+    /**
+     * Timings of the last evaluation, only recorded when parallel evaluation is enabled
+     */
+    const EvaluationTiming& getLastEvaluationTiming() const;
+
+    /**
+     * Accumulated per processor statistics of all evaluations
+     */
+    ProcessorStatistics& getStatistics();
+    const ProcessorStatistics& getStatistics() const;
+
 private:
     // ProcessorNetworkObserver overrides
     virtual void onProcessorNetworkEvaluateRequest() override;
@@ -60,17 +108,41 @@ private:
     virtual void onProcessorNetworkDidRemoveConnection(const PortConnection& connection) override;
 
     // ProcessorObserver overrides
+    virtual void onProcessorInvalidationBegin(Processor*) override;
     virtual void onProcessorSinkChanged(Processor*) override;
     virtual void onProcessorActiveConnectionsChanged(Processor*) override;
 
     void requestEvaluate();
     void evaluate();
+    void updateSorted();
+    void evaluateSerial();
+    void evaluateParallel();
+
+    // evaluation steps shared by the serial and parallel evaluation
+    bool prepare(Processor* processor);
+    void process(Processor* processor);
+    void finish(Processor* processor);
+    void notReady(Processor* processor);
+
+    // predecessors of each processor in processorsSorted_ as indices into processorsSorted_
+    std::vector<std::vector<size_t>> predecessors() const;
+    void updateCriticalPath(const std::vector<std::vector<size_t>>& predecessors);
 
     ProcessorNetwork* processorNetwork_;
-    // the sorted list of processors obtained through topological sorting
+    // all processors in topological order, maintained incrementally as the network changes
+    TopologicalOrder order_;
+    // set when the order needs to be rebuilt, we do that instead of incremental updates while
+    // deserializing
+    bool orderDirty_;
+    // the sorted list of processors that need evaluation, updated lazily from order_
     std::vector<Processor*> processorsSorted_;
+    bool sortedDirty_;
     bool evaulationQueued_;
+    bool parallel_;
     EvaluationErrorHandler exceptionHandler_;
+    EvaluationTiming timing_;
+    ProcessorStatistics statistics_;
+    std::chrono::high_resolution_clock::time_point evaluationStart_;
 };
 
 }  // namespace inviwo
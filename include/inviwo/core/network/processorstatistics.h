@@ -0,0 +1,148 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/conversionstatistics.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace inviwo {
+
+class Processor;
+
+/**
+ * Collects per processor performance statistics during network evaluation. The
+ * ProcessorNetworkEvaluator records the time of each process() call, and the number of
+ * invalidations of each processor. Representation conversions and copies done by a processor
+ * while it is processing are attributed to it, with the time they took and the number of bytes of
+ * the created representations. Conversions triggered outside of process(), e.g. in inport onChange
+ * callbacks or by canvases, are not counted.
+ *
+ * The statistics are keyed by processor identifier and are kept after the processor is removed.
+ * Use reset() to start over.
+ * @see ProcessorNetworkEvaluator::getStatistics
+ */
+class IVW_CORE_API ProcessorStatistics {
+public:
+    using clock = ConversionStatistics::clock;
+    using duration = clock::duration;
+
+    /**
+     * Number of bins in the process time histogram. Bin 0 counts process times below 1 µs, bin i
+     * counts times in [2^(i-1), 2^i) µs, and the last bin all times above that.
+     */
+    static constexpr size_t histogramBins = 24;
+
+    struct IVW_CORE_API Entry {
+        std::string identifier;
+        std::string classIdentifier;
+
+        size_t processCount = 0;
+        duration processTime{0};  ///< accumulated time of all process() calls
+        duration minProcessTime = duration::max();
+        duration maxProcessTime{0};
+        std::array<size_t, histogramBins> histogram{};
+
+        size_t invalidationCount = 0;
+
+        size_t conversionCount = 0;
+        duration conversionTime{0};
+        size_t bytesAllocated = 0;
+
+        duration meanProcessTime() const;
+        /**
+         * Estimate the given quantile (0 to 1) of the process time from the histogram. The result
+         * is the upper edge of the bin containing the quantile.
+         */
+        duration processTimeQuantile(double q) const;
+    };
+
+    ProcessorStatistics() = default;
+    ProcessorStatistics(const ProcessorStatistics&) = delete;
+    ProcessorStatistics& operator=(const ProcessorStatistics&) = delete;
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+
+    void reset();
+
+    /**
+     * Statistics for all processors, sorted by accumulated process time, largest first.
+     */
+    std::vector<Entry> getEntries() const;
+    std::optional<Entry> getEntry(const std::string& identifier) const;
+
+    void writeJson(std::ostream& os) const;
+    void writeCsv(std::ostream& os) const;
+
+    void addInvalidation(Processor* processor);
+
+    /**
+     * Measures one process() call of a processor. While alive, it is the ConversionStatistics of
+     * the calling thread, and representation conversions done on the thread are attributed to the
+     * processor.
+     */
+    class IVW_CORE_API ProcessScope : public ConversionStatistics {
+    public:
+        ProcessScope(ProcessorStatistics& statistics, Processor* processor);
+        virtual ~ProcessScope();
+
+        virtual void addConversion(clock::duration time) override;
+        virtual void addAllocation(size_t bytes) override;
+
+    private:
+        ProcessorStatistics* statistics_;
+        Processor* processor_;
+        // A processor might wait for the pool while processing, and the pool might run the
+        // process() of another processor on this thread while waiting.
+        ConversionStatistics* previous_ = nullptr;
+        clock::time_point start_;
+        size_t conversionCount_ = 0;
+        duration conversionTime_{0};
+        size_t bytesAllocated_ = 0;
+    };
+
+private:
+    Entry& entry(Processor* processor);
+
+    mutable std::mutex mutex_;
+    std::atomic<bool> enabled_{true};
+    std::unordered_map<std::string, Entry> entries_;
+};
+
+}  // namespace inviwo
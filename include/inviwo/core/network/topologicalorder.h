@@ -0,0 +1,93 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+
+namespace inviwo {
+
+class Processor;
+
+/**
+ * \brief Incrementally maintained topological order of the processors in a network
+ *
+ * The order contains all processors and respects all port connections. Adding a processor or
+ * removing a connection keeps the order valid as is. Adding a connection that violates the order
+ * only reorders the processors in the affected region between the two connected processors,
+ * following the dynamic topological sort algorithm by Pearce and Kelly (A Dynamic Topological
+ * Sort Algorithm for Directed Acyclic Graphs, ACM J. Exp. Algorithmics 2006).
+ * When many changes are made at once, as during deserialization, it is cheaper to rebuild the
+ * whole order once using rebuild().
+ */
+class IVW_CORE_API TopologicalOrder {
+public:
+    TopologicalOrder() = default;
+
+    /**
+     * Build the order from scratch for the given processors and their connections.
+     */
+    void rebuild(const std::vector<Processor*>& processors);
+
+    void addProcessor(Processor* processor);
+    void removeProcessor(Processor* processor);
+    /**
+     * Update the order after a connection from an outport of processor from to an inport of
+     * processor to has been added.
+     */
+    void addConnection(Processor* from, Processor* to);
+
+    bool contains(Processor* processor) const;
+
+    /**
+     * Get all processors in topological order.
+     */
+    std::vector<Processor*> getProcessors() const;
+
+    /**
+     * Get all processors that are sinks or that are connected to a sink through active
+     * connections, in topological order. This is the set of processors that need to be evaluated.
+     * @see util::topologicalSortFiltered
+     */
+    std::vector<Processor*> getSinkConnectedProcessors() const;
+
+private:
+    void compact();
+
+    // order_ can contain nullptr for removed processors, they are cleared out by compact()
+    std::vector<Processor*> order_;
+    std::unordered_map<Processor*, size_t> index_;
+    size_t removed_ = 0;
+};
+
+}  // namespace inviwo
@@ -91,7 +91,9 @@ public:
      *      The same refPath should be given when loading. Most often this should be the path to the
      *      saved file.
      * \param exceptionHandler A callback for handling errors.
-     * \param mode to indicate if we are saving to disk or undo-stack
+     * \param mode to indicate if we are saving to disk or undo-stack. Undo states are written
+     *      using the binary encoding, see SerializationFormat, and the stream should be opened in
+     *      binary mode. Both encodings are detected automatically by load().
      */
     void save(std::ostream& stream, const std::string& refPath,
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler(),
@@ -64,6 +64,14 @@ public:
     static const Tag CPU;
     static const Tag PY;
 
+    /**
+     * Marks a processor whose process() may be run on the thread pool during parallel network
+     * evaluation. The processor guarantees that process() only reads its inports and properties
+     * and sets its outports. It must not modify any properties, touch any widgets, or wait for
+     * the main thread, e.g. with dispatchFront(...).wait().
+     */
+    static const Tag Concurrent;
+
 private:
     std::string tag_;
 };
@@ -117,6 +125,7 @@ public:
     static const Tags CL;
     static const Tags CPU;
     static const Tags PY;
+    static const Tags Concurrent;
 
     friend inline bool operator==(const Tags& lhs, const Tags& rhs) {
         return lhs.tags_ == rhs.tags_;
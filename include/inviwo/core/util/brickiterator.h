@@ -125,7 +125,7 @@ public:
         return *this;
     }
     BrickIterator operator++(int) {
-        auto it = this;
+        auto it = *this;
         operator++();
         return it;
     }
@@ -146,13 +146,13 @@ public:
         return *this;
     }
     BrickIterator operator--(int) {
-        auto it = this;
+        auto it = *this;
         operator--();
         return it;
     }
 
-    reference operator*() const { return (iterator_ + im_(start_ + current_)).operator*(); }
-    pointer operator->() const { return (iterator_ + im_(start_ + current_)).operator->(); }
+    reference operator*() const { return *(iterator_ + im_(start_ + current_)); }
+    pointer operator->() const { return &*(iterator_ + im_(start_ + current_)); }
 
     bool operator==(const BrickIterator& rhs) const { return current_ == rhs.current_; }
     bool operator!=(const BrickIterator& rhs) const { return current_ != rhs.current_; }
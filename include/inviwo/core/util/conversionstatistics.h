@@ -0,0 +1,117 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/detected.h>
+
+#include <chrono>
+#include <utility>
+
+namespace inviwo {
+
+/**
+ * Interface for collecting statistics about the representation conversions done on a thread.
+ * Data reports its conversions and the representations it creates to the collector of the calling
+ * thread, if any. This keeps Data independent of who is collecting.
+ * @see ProcessorStatistics
+ * @see Data::getRepresentation
+ */
+class IVW_CORE_API ConversionStatistics {
+public:
+    using clock = std::chrono::high_resolution_clock;
+
+    ConversionStatistics() = default;
+    ConversionStatistics(const ConversionStatistics&) = delete;
+    ConversionStatistics& operator=(const ConversionStatistics&) = delete;
+    virtual ~ConversionStatistics() = default;
+
+    virtual void addConversion(clock::duration time) = 0;
+    virtual void addAllocation(size_t bytes) = 0;
+
+    /**
+     * The collector of the calling thread, or nullptr if there is none.
+     */
+    static ConversionStatistics* current();
+    /**
+     * Set the collector of the calling thread, returns the previous collector.
+     */
+    static ConversionStatistics* setCurrent(ConversionStatistics* statistics);
+
+    /**
+     * Measures a representation conversion. Does nothing if there is no collector on the calling
+     * thread, nested conversions are only counted once.
+     */
+    class IVW_CORE_API Scope {
+    public:
+        Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        ~Scope();
+
+    private:
+        ConversionStatistics* statistics_;
+        bool outermost_;
+        clock::time_point start_;
+    };
+
+    /**
+     * Report the number of bytes of data held by a created representation to the collector of
+     * the calling thread, if any. The size is estimated for representations that have dimensions,
+     * like volumes and layers, or a size, like buffers.
+     */
+    template <typename Repr>
+    static void addRepresentation(const Repr& repr);
+
+private:
+    template <typename R>
+    using dimensionsType = decltype(std::declval<R>().getDimensions());
+    template <typename R>
+    using sizeType = decltype(std::declval<R>().getSize());
+
+    int conversionDepth_ = 0;
+};
+
+template <typename Repr>
+void ConversionStatistics::addRepresentation(const Repr& repr) {
+    auto statistics = current();
+    if (!statistics) return;
+
+    size_t count = 0;
+    if constexpr (util::is_detected_v<dimensionsType, Repr>) {
+        const auto dims = repr.getDimensions();
+        count = 1;
+        for (int i = 0; i < static_cast<int>(dims.length()); ++i) count *= dims[i];
+    } else if constexpr (util::is_detected_v<sizeType, Repr>) {
+        count = repr.getSize();
+    }
+    statistics->addAllocation(count * repr.getDataFormat()->getSize());
+}
+
+}  // namespace inviwo
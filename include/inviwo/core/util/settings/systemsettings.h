@@ -32,6 +32,7 @@
 #include <inviwo/core/util/settings/settings.h>
 #include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/buttonproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/stringproperty.h>
 
@@ -51,6 +52,7 @@ public:
     StringProperty workspaceAuthor_;
     TemplateOptionProperty<UsageMode> applicationUsageMode_;
     IntSizeTProperty poolSize_;
+    BoolProperty parallelNetworkEvaluation_;
     BoolProperty enablePortInspectors_;
     IntProperty portInspectorSize_;
     BoolProperty enableTouchProperty_;
@@ -66,6 +68,9 @@ public:
     BoolProperty redirectCout_;
     BoolProperty redirectCerr_;
 
+    BoolProperty enableTracing_;
+    ButtonProperty exportTrace_;
+
     static size_t defaultPoolSize();
 
     std::unique_ptr<LogStream> cout_;
@@ -31,6 +31,12 @@
 
 #include <inviwo/core/datastructures/spatialdata.h>
 #include <inviwo/core/datastructures/datatraits.h>
+#include <inviwo/core/util/assertion.h>
+
+#include <tcb/span.hpp>
+
+#include <algorithm>
+#include <array>
 
 namespace inviwo {
 
@@ -54,6 +60,22 @@ public:
     virtual Vector<DataDims, T> sample(const Vector<SpatialDims, double> &pos, Space space) const;
     virtual Vector<DataDims, T> sample(const Vector<SpatialDims, float> &pos, Space space) const;
 
+    /**
+     * Sample many positions at once, result[i] is the sample at positions[i]. This avoids one
+     * virtual call per position, and samplers can override sampleDataSpaceBatch with a faster
+     * implementation. The positions are in the space given in the constructor.
+     * @param positions positions to sample
+     * @param result output, has to be at least as large as positions
+     */
+    void sample(util::span<const Vector<SpatialDims, double>> positions,
+                util::span<Vector<DataDims, T>> result) const;
+    /**
+     * Sample many positions given in \p space at once.
+     * @see sample(util::span<const Vector<SpatialDims, double>>, util::span<Vector<DataDims, T>>)
+     */
+    void sample(util::span<const Vector<SpatialDims, double>> positions,
+                util::span<Vector<DataDims, T>> result, Space space) const;
+
     virtual bool withinBounds(const Vector<SpatialDims, double> &pos) const;
     virtual bool withinBounds(const Vector<SpatialDims, float> &pos) const;
 
@@ -69,6 +91,12 @@ public:
 protected:
     virtual Vector<DataDims, T> sampleDataSpace(const Vector<SpatialDims, double> &pos) const = 0;
     virtual bool withinBoundsDataSpace(const Vector<SpatialDims, double> &pos) const = 0;
+    /**
+     * Batched sampling in data space, the default implementation calls sampleDataSpace for each
+     * position.
+     */
+    virtual void sampleDataSpaceBatch(util::span<const Vector<SpatialDims, double>> positions,
+                                      util::span<Vector<DataDims, T>> result) const;
 
     Space space_;
     const SpatialEntity<SpatialDims> &spatialEntity_;
@@ -136,6 +164,50 @@ Vector<DataDims, T> SpatialSampler<SpatialDims, DataDims, T>::sample(
     }
 }
 
+template <unsigned int SpatialDims, unsigned int DataDims, typename T>
+void SpatialSampler<SpatialDims, DataDims, T>::sample(
+    util::span<const Vector<SpatialDims, double>> positions,
+    util::span<Vector<DataDims, T>> result) const {
+    sample(positions, result, space_);
+}
+
+template <unsigned int SpatialDims, unsigned int DataDims, typename T>
+void SpatialSampler<SpatialDims, DataDims, T>::sample(
+    util::span<const Vector<SpatialDims, double>> positions,
+    util::span<Vector<DataDims, T>> result, Space space) const {
+    IVW_ASSERT(result.size() >= positions.size(), "Result has to fit all positions");
+    if (space == Space::Data) {
+        sampleDataSpaceBatch(positions, result);
+        return;
+    }
+
+    const Matrix<SpatialDims + 1, double> m =
+        space == space_
+            ? transform_
+            : Matrix<SpatialDims + 1, double>{
+                  spatialEntity_.getCoordinateTransformer().getMatrix(space, Space::Data)};
+
+    // Transform the positions in chunks to avoid allocating
+    constexpr size_t chunkSize = 64;
+    std::array<Vector<SpatialDims, double>, chunkSize> chunk;
+    for (size_t begin = 0; begin < positions.size(); begin += chunkSize) {
+        const auto count = std::min(chunkSize, positions.size() - begin);
+        for (size_t i = 0; i < count; ++i) {
+            const auto p = m * Vector<SpatialDims + 1, double>(positions[begin + i], 1.0);
+            chunk[i] = Vector<SpatialDims, double>(p) / p[SpatialDims];
+        }
+        sampleDataSpaceBatch(util::span<const Vector<SpatialDims, double>>(chunk.data(), count),
+                             result.subspan(begin, count));
+    }
+}
+
+template <unsigned int SpatialDims, unsigned int DataDims, typename T>
+void SpatialSampler<SpatialDims, DataDims, T>::sampleDataSpaceBatch(
+    util::span<const Vector<SpatialDims, double>> positions,
+    util::span<Vector<DataDims, T>> result) const {
+    for (size_t i = 0; i < positions.size(); ++i) result[i] = sampleDataSpace(positions[i]);
+}
+
 template <unsigned int SpatialDims, unsigned int DataDims, typename T>
 bool SpatialSampler<SpatialDims, DataDims, T>::withinBounds(
     const Vector<SpatialDims, float> &pos) const {
@@ -61,7 +61,7 @@
 #include <warn/push>
 #include <warn/ignore/all>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <thread>
 #include <mutex>
@@ -70,12 +70,67 @@
 #include <functional>
 #include <stdexcept>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <type_traits>
 #include <warn/pop>
 
 namespace inviwo {
 
+/**
+ * \brief A work-stealing thread pool
+ *
+ * Every worker owns a task deque. Tasks enqueued from within a worker thread (nested tasks) are
+ * pushed to the back of that worker's own deque and popped LIFO by the owner, while idle workers
+ * steal from the front of other workers' deques. Tasks enqueued from other threads go to a shared
+ * injection queue. This keeps the common case, a worker producing and consuming its own tasks,
+ * free of contention on a single shared lock.
+ *
+ * Tasks are stored in a small-buffer Task type, so that most functors, including the
+ * packaged_task created by enqueue, are stored without an additional heap allocation.
+ */
 class IVW_CORE_API ThreadPool {
 public:
+    /**
+     * A move only type erased void() functor with an inline buffer for small functors. Functors
+     * that do not fit in the buffer, or that can throw on move, are stored on the heap.
+     */
+    class IVW_CORE_API Task {
+    public:
+        static constexpr size_t bufferSize = 64;
+
+        Task() = default;
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+        Task(F&& f);
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        Task(Task&& rhs) noexcept;
+        Task& operator=(Task&& rhs) noexcept;
+        ~Task();
+
+        void operator()() { ops_->invoke(&buffer_); }
+        explicit operator bool() const { return ops_ != nullptr; }
+
+    private:
+        struct Ops {
+            void (*invoke)(void*);
+            void (*move)(void* dst, void* src);  // move construct dst from src and destroy src
+            void (*destroy)(void*);
+        };
+        template <typename F>
+        static constexpr bool storeInline = sizeof(F) <= bufferSize &&
+                                            alignof(F) <= alignof(std::max_align_t) &&
+                                            std::is_nothrow_move_constructible_v<F>;
+        template <typename F>
+        static const Ops* inlineOps();
+        template <typename F>
+        static const Ops* heapOps();
+
+        std::aligned_storage_t<bufferSize, alignof(std::max_align_t)> buffer_;
+        const Ops* ops_ = nullptr;
+    };
+
     ThreadPool(size_t threads, std::function<void()> onThreadStart = []() {},
                std::function<void()> onThreadStop = []() {});
     ~ThreadPool();
@@ -92,6 +147,31 @@ public:
      */
     void enqueueRaw(std::function<void()> f);
 
+    /**
+     * Enqueue a task. The task may not throw exceptions.
+     */
+    void enqueueTask(Task task);
+
+    /**
+     * Wait for the future to become ready. When called from one of the pool's worker threads,
+     * pending tasks are run while waiting. This makes it safe for a task to enqueue nested tasks
+     * and wait for them, without tying up the worker thread.
+     *
+     * The tasks run while waiting are not limited to the ones the future depends on, any pending
+     * task of the pool can run on the stack of the caller. A worker must therefore not hold any
+     * lock while calling wait, since an unrelated task that takes the same lock would deadlock,
+     * and deeply nested waits can grow the stack of the worker accordingly. When there is nothing
+     * to run the worker sleeps until a task is enqueued or finishes, instead of spinning. From
+     * other threads this is a plain future.wait().
+     */
+    template <typename T>
+    void wait(const std::future<T>& future);
+
+    /**
+     * Returns true if the calling thread is one of the pool's worker threads.
+     */
+    bool isWorkerThread() const;
+
     size_t trySetSize(size_t size);
     size_t getSize() const;
 
@@ -106,6 +186,12 @@ private:
         Done      //< Worker is waiting to be joined.
     };
 
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+    using Queues = std::vector<std::shared_ptr<TaskQueue>>;
+
     struct Worker {
         Worker(ThreadPool& pool);
         Worker(const Worker&) = delete;
@@ -115,41 +201,113 @@ private:
         ~Worker();
 
         std::atomic<State> state;  //< State of the worker
+        std::shared_ptr<TaskQueue> queue;
         std::thread thread;
     };
+
+    /**
+     * Run one pending task on the calling worker thread, if there is any.
+     * @return true if a task was run, false if there were no tasks or if the calling thread is not
+     * a worker of this pool.
+     */
+    bool runPendingTask();
+    /**
+     * Block the calling worker until a task is enqueued or until an other task has finished.
+     * Returns early if isReady() is true.
+     */
+    void sleepUntilProgress(const std::function<bool()>& isReady);
+    void taskFinished();
+    Task pop(Worker& worker);
+    void publishQueues();
+    void notifySleeping(bool all);
+
     // need to keep track of threads so we can join them
     std::vector<std::unique_ptr<Worker>> workers;
 
-    // the task queue
-    std::queue<std::function<void()>> tasks;
+    // the worker queues, published as an immutable snapshot that is replaced when the pool
+    // is resized. Accessed using std::atomic_load / std::atomic_store.
+    std::shared_ptr<const Queues> queues_;
+
+    // the injection queue for tasks enqueued from non worker threads
+    TaskQueue injection_;
 
-    // synchronization
-    std::mutex queue_mutex;
+    // number of enqueued tasks not yet started
+    std::atomic<size_t> pending_;
+
+    // synchronization for idle workers
+    std::atomic<size_t> sleeping_;
+    std::mutex sleep_mutex;
     std::condition_variable condition;
 
+    // synchronization for workers waiting on a future, see wait()
+    std::atomic<size_t> finished_;
+    std::atomic<size_t> waiting_;
+    std::condition_variable finishedCondition_;
+
     // Thread start end exit actions
     std::function<void()> onThreadStart_;
     std::function<void()> onThreadStop_;
 };
 
+template <typename F, typename>
+ThreadPool::Task::Task(F&& f) {
+    using Fun = std::decay_t<F>;
+    if constexpr (storeInline<Fun>) {
+        new (&buffer_) Fun(std::forward<F>(f));
+        ops_ = inlineOps<Fun>();
+    } else {
+        new (&buffer_) Fun*(new Fun(std::forward<F>(f)));
+        ops_ = heapOps<Fun>();
+    }
+}
+
+template <typename F>
+auto ThreadPool::Task::inlineOps() -> const Ops* {
+    static constexpr Ops ops{
+        [](void* buff) { (*static_cast<F*>(buff))(); },
+        [](void* dst, void* src) {
+            new (dst) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        },
+        [](void* buff) { static_cast<F*>(buff)->~F(); }};
+    return &ops;
+}
+
+template <typename F>
+auto ThreadPool::Task::heapOps() -> const Ops* {
+    static constexpr Ops ops{[](void* buff) { (**static_cast<F**>(buff))(); },
+                             [](void* dst, void* src) {
+                                 new (dst) F*(*static_cast<F**>(src));
+                             },
+                             [](void* buff) { delete *static_cast<F**>(buff); }};
+    return &ops;
+}
+
 // add new work item to the pool
 template <class F, class... Args>
 auto ThreadPool::enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
     using return_type = std::invoke_result_t<F, Args...>;
 
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
-        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    std::packaged_task<return_type()> task{
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...)};
 
-    std::future<return_type> res = task->get_future();
+    std::future<return_type> res = task.get_future();
+    enqueueTask(Task{std::move(task)});
+    return res;
+}
 
-    if (workers.empty()) {
-        (*task)();  // No worker threads, just run the task.
-    } else {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.emplace([task]() { (*task)(); });
+template <typename T>
+void ThreadPool::wait(const std::future<T>& future) {
+    if (!isWorkerThread()) {
+        future.wait();
+        return;
+    }
+    const auto isReady = [&future]() {
+        return future.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+    };
+    while (!isReady()) {
+        if (!runPendingTask()) sleepUntilProgress(isReady);
     }
-    condition.notify_one();
-    return res;
 }
 
 }  // namespace inviwo
@@ -0,0 +1,160 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace inviwo {
+
+/**
+ * Low overhead event tracing. Scopes are recorded into per-thread ring buffers, each guarded by its
+ * own mutex that is only contended while the events are exported. Categories and names have to be
+ * string literals, only the pointers are stored. An optional detail string, e.g. a processor
+ * identifier, is copied into the event. When tracing is disabled a scope only costs a relaxed
+ * atomic load. The recorded events can be exported in the Chrome trace event format which can be
+ * opened in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Tracing can be toggled at runtime from the SystemSettings.
+ *
+ * Example:
+ * \code{.cpp}
+ * void MyProcessor::process() {
+ *     tracing::Scope trace{"myprocessor", "computeSomething", getIdentifier()};
+ *     ...
+ * }
+ * \endcode
+ */
+namespace tracing {
+
+/**
+ * Number of events kept for each thread, older events are overwritten.
+ */
+constexpr size_t bufferCapacity = size_t{1} << 14;
+constexpr size_t maxDetailLength = 47;
+
+struct Event {
+    const char* category;
+    const char* name;
+    std::int64_t start;     ///< nanoseconds since the tracing epoch
+    std::int64_t duration;  ///< nanoseconds
+    char detail[maxDetailLength + 1];
+};
+
+namespace detail {
+IVW_CORE_API extern std::atomic<bool> enabled;
+
+IVW_CORE_API std::int64_t now();
+IVW_CORE_API void record(const char* category, const char* name, std::int64_t start,
+                         std::int64_t end, const char* detail);
+}  // namespace detail
+
+inline bool isEnabled() { return detail::enabled.load(std::memory_order_relaxed); }
+IVW_CORE_API void setEnabled(bool enabled);
+
+/**
+ * Discard all events recorded so far
+ */
+IVW_CORE_API void clear();
+
+/**
+ * Set the name of the calling thread as shown in the exported trace.
+ */
+IVW_CORE_API void setThreadName(std::string_view name);
+
+/**
+ * Write all recorded events in the Chrome trace event format (JSON).
+ */
+IVW_CORE_API void writeChromeTrace(std::ostream& os);
+
+/**
+ * Write all recorded events in the Chrome trace event format to a file.
+ * @throw FileException if the file can not be opened.
+ */
+IVW_CORE_API void writeChromeTrace(const std::string& filename);
+
+/**
+ * RAII helper that records the time from construction to destruction as one event.
+ */
+class Scope {
+public:
+    template <size_t N, size_t M>
+    Scope(const char (&category)[N], const char (&name)[M]) {
+        if (isEnabled()) {
+            detail_[0] = '\0';
+            begin(category, name);
+        }
+    }
+    template <size_t N, size_t M>
+    Scope(const char (&category)[N], const char (&name)[M], std::string_view detail) {
+        if (isEnabled()) {
+            const auto size = std::min(detail.size(), maxDetailLength);
+            std::memcpy(detail_, detail.data(), size);
+            detail_[size] = '\0';
+            begin(category, name);
+        }
+    }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+    ~Scope() {
+        if (category_) detail::record(category_, name_, start_, detail::now(), detail_);
+    }
+
+private:
+    void begin(const char* category, const char* name) {
+        category_ = category;
+        name_ = name;
+        start_ = detail::now();
+    }
+
+    const char* category_ = nullptr;
+    const char* name_ = nullptr;
+    std::int64_t start_ = 0;
+    char detail_[maxDetailLength + 1];  // only initialized when enabled
+};
+
+}  // namespace tracing
+
+#define IVW_TRACE_CONCAT_PART1(x, y) x##y
+#define IVW_TRACE_CONCAT_PART2(x, y) IVW_TRACE_CONCAT_PART1(x, y)
+#define IVW_TRACE_SCOPE(category, name) \
+    ::inviwo::tracing::Scope IVW_TRACE_CONCAT_PART2(ivwTraceScope, __LINE__)(category, name)
+#define IVW_TRACE_SCOPE_DETAIL(category, name, detail)                                         \
+    ::inviwo::tracing::Scope IVW_TRACE_CONCAT_PART2(ivwTraceScope, __LINE__)(category, name, \
+                                                                              detail)
+
+}  // namespace inviwo
@@ -0,0 +1,146 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/glm.h>
+
+#include <tcb/span.hpp>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * Number of positions that sampleTrilinear processes together.
+ */
+constexpr size_t trilinearBlockSize = 32;
+
+/**
+ * Trilinear interpolation of a volume at many positions. For each position the result is the same
+ * as from VolumeDoubleSampler::sampleDataSpace: positions are in data space, positions outside of
+ * [0,1] give zero, and voxels are converted to Result using util::glm_convert.
+ *
+ * The positions are processed in blocks of trilinearBlockSize. Each block does three passes. The
+ * first computes indices and interpolants, the second gathers the eight corner voxels, and the
+ * third does the interpolation. The first and last passes work on one array per component, so the
+ * compiler can vectorize them. The voxel type is a template argument, which avoids the virtual
+ * getAsDVec calls of VolumeRAM.
+ *
+ * @param data voxel data of a volume with the given dimensions, x is the fastest index
+ * @param dims volume dimensions
+ * @param positions positions in data space
+ * @param result output, has to be at least as large as positions
+ */
+template <typename Result, typename T>
+void sampleTrilinear(const T* data, size3_t dims, util::span<const dvec3> positions,
+                     util::span<Result> result) {
+    constexpr size_t N = util::extent<Result>::value == 0 ? 1 : util::extent<Result>::value;
+    constexpr size_t B = trilinearBlockSize;
+
+    const double sx = static_cast<double>(dims.x - 1);
+    const double sy = static_cast<double>(dims.y - 1);
+    const double sz = static_cast<double>(dims.z - 1);
+    const size_t strideY = dims.x;
+    const size_t strideZ = dims.x * dims.y;
+
+    alignas(64) double tx[B], ty[B], tz[B];
+    alignas(64) size_t base[B], dx[B], dy[B], dz[B];
+    alignas(64) bool inside[B];
+    alignas(64) double corners[8][N][B];
+    alignas(64) double blended[N][B];
+
+    for (size_t begin = 0; begin < positions.size(); begin += B) {
+        const size_t count = std::min(B, positions.size() - begin);
+        const dvec3* pos = positions.data() + begin;
+
+        // Pass 1: indices and interpolants
+        for (size_t i = 0; i < count; ++i) {
+            const auto& p = pos[i];
+            inside[i] = p.x >= 0.0 && p.y >= 0.0 && p.z >= 0.0 && p.x <= 1.0 && p.y <= 1.0 &&
+                        p.z <= 1.0;
+            // Use the origin for positions outside to keep the indices valid
+            const double px = inside[i] ? p.x * sx : 0.0;
+            const double py = inside[i] ? p.y * sy : 0.0;
+            const double pz = inside[i] ? p.z * sz : 0.0;
+            const auto ix = static_cast<size_t>(px);
+            const auto iy = static_cast<size_t>(py);
+            const auto iz = static_cast<size_t>(pz);
+            tx[i] = px - static_cast<double>(ix);
+            ty[i] = py - static_cast<double>(iy);
+            tz[i] = pz - static_cast<double>(iz);
+            // Neighbors outside of the volume are clamped to the last voxel
+            dx[i] = ix + 1 < dims.x ? 1 : 0;
+            dy[i] = iy + 1 < dims.y ? strideY : 0;
+            dz[i] = iz + 1 < dims.z ? strideZ : 0;
+            base[i] = ix + iy * strideY + iz * strideZ;
+        }
+
+        // Pass 2: gather the corner voxels, in the order used by Interpolation::trilinear
+        for (size_t i = 0; i < count; ++i) {
+            const size_t offsets[8] = {0,
+                                       dx[i],
+                                       dy[i],
+                                       dx[i] + dy[i],
+                                       dz[i],
+                                       dx[i] + dz[i],
+                                       dy[i] + dz[i],
+                                       dx[i] + dy[i] + dz[i]};
+            for (size_t c = 0; c < 8; ++c) {
+                const auto voxel = util::glm_convert<Result>(data[base[i] + offsets[c]]);
+                for (size_t k = 0; k < N; ++k) corners[c][k][i] = util::glmcomp(voxel, k);
+            }
+        }
+
+        // Pass 3: interpolation, same operations as glm::mix
+        const auto mix = [](double a, double b, double t) { return a + t * (b - a); };
+        for (size_t k = 0; k < N; ++k) {
+            for (size_t i = 0; i < count; ++i) {
+                const double l1 = mix(corners[0][k][i], corners[1][k][i], tx[i]);
+                const double l2 = mix(corners[2][k][i], corners[3][k][i], tx[i]);
+                const double l3 = mix(corners[4][k][i], corners[5][k][i], tx[i]);
+                const double l4 = mix(corners[6][k][i], corners[7][k][i], tx[i]);
+                const double b1 = mix(l1, l2, ty[i]);
+                const double b2 = mix(l3, l4, ty[i]);
+                blended[k][i] = inside[i] ? mix(b1, b2, tz[i]) : 0.0;
+            }
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            auto& r = result[begin + i];
+            for (size_t k = 0; k < N; ++k) util::glmcomp(r, k) = blended[k][i];
+        }
+    }
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -84,9 +84,7 @@ void forEachVoxelParallel(const size3_t dims, C callback, size_t jobs = 0) {
         }));
     }
 
-    for (const auto &e : futures) {
-        e.wait();
-    }
+    util::waitForAll(futures);
 }
 template <typename C>
 void forEachVoxelParallel(const VolumeRAM &v, C callback, size_t jobs = 0) {
@@ -35,13 +35,76 @@
 #include <inviwo/core/util/interpolation.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumebricked.h>
 
 #include <inviwo/core/util/spatialsampler.h>
+#include <inviwo/core/util/trilinearsampling.h>
 
 namespace inviwo {
 
+namespace detail {
+
+/**
+ * Formats sampled by the batched trilinear kernel in VolumeDoubleSampler, half, float, and
+ * unsigned integer formats of up to 32 bits.
+ */
+template <typename Format>
+struct BatchSampledFormats
+    : std::integral_constant<bool, Format::compsize <= 4 &&
+                                       (Format::numtype == NumericType::Float ||
+                                        Format::numtype == NumericType::UnsignedInteger)> {};
+
+inline bool isBatchSampledFormat(const DataFormatBase *format) {
+    return format->getPrecision() <= 32 &&
+           (format->getNumericType() == NumericType::Float ||
+            format->getNumericType() == NumericType::UnsignedInteger);
+}
+
+/**
+ * Reads a voxel as a Vector<N, double> from a VolumeRAM or a VolumeBricked::Accessor
+ */
+template <unsigned int N>
+struct VoxelGetter;
+
+template <>
+struct VoxelGetter<1> {
+    template <typename Source>
+    static Vector<1, double> get(Source &source, const size3_t &pos) {
+        return source.getAsDouble(pos);
+    }
+};
+template <>
+struct VoxelGetter<2> {
+    template <typename Source>
+    static Vector<2, double> get(Source &source, const size3_t &pos) {
+        return source.getAsDVec2(pos);
+    }
+};
+template <>
+struct VoxelGetter<3> {
+    template <typename Source>
+    static Vector<3, double> get(Source &source, const size3_t &pos) {
+        return source.getAsDVec3(pos);
+    }
+};
+template <>
+struct VoxelGetter<4> {
+    template <typename Source>
+    static Vector<4, double> get(Source &source, const size3_t &pos) {
+        return source.getAsDVec4(pos);
+    }
+};
+
+}  // namespace detail
+
 /**
  * \class VolumeDoubleSampler
+ * Samples the VolumeRAM representation of the volume. If the volume only has a VolumeBricked
+ * representation the bricks are sampled directly, without loading the whole volume. The brick
+ * is then looked up once per sample, or once per run of samples in the same brick for batched
+ * sampling, through a VolumeBricked::Accessor.
+ * Batched sampling, see SpatialSampler::sample(util::span, util::span), of half, float, and
+ * unsigned integer volumes uses util::sampleTrilinear.
  */
 template <unsigned int DataDims>
 class VolumeDoubleSampler : public SpatialSampler<3, DataDims, double> {
@@ -57,10 +120,21 @@ public:
     virtual bool withinBoundsDataSpace(const dvec3 &pos) const override;
 
 protected:
+    virtual void sampleDataSpaceBatch(util::span<const dvec3> positions,
+                                      util::span<Vector<DataDims, double>> result) const override;
+
     Vector<DataDims, double> getVoxel(const size3_t &pos) const;
 
+    /**
+     * Trilinear interpolation of the voxels around pos, in data space, read using
+     * detail::VoxelGetter from source.
+     */
+    template <typename Source>
+    Vector<DataDims, double> sampleVoxels(Source &source, const dvec3 &pos) const;
+
     std::shared_ptr<const Volume> volume_;
     const VolumeRAM *ram_;
+    const VolumeBricked *bricked_;
     size3_t dims_;
 };
 
@@ -76,54 +150,82 @@ VolumeDoubleSampler<DataDims>::VolumeDoubleSampler(std::shared_ptr<const Volume>
 template <unsigned int DataDims>
 VolumeDoubleSampler<DataDims>::VolumeDoubleSampler(const Volume &vol, CoordinateSpace space)
     : SpatialSampler<3, DataDims, double>(vol, space)
-    , ram_(vol.getRepresentation<VolumeRAM>())
-    , dims_(vol.getDimensions()) {}
+    , ram_(nullptr)
+    , bricked_(nullptr)
+    , dims_(vol.getDimensions()) {
+    if (!vol.hasRepresentation<VolumeRAM>() && vol.hasRepresentation<VolumeBricked>()) {
+        bricked_ = vol.getRepresentation<VolumeBricked>();
+    } else {
+        ram_ = vol.getRepresentation<VolumeRAM>();
+    }
+}
 
 template <unsigned int DataDims>
 Vector<DataDims, double> VolumeDoubleSampler<DataDims>::sampleDataSpace(const dvec3 &pos) const {
     if (!withinBoundsDataSpace(pos)) {
         return Vector<DataDims, double>(0.0);
     }
+    if (bricked_) {
+        VolumeBricked::Accessor accessor(*bricked_);
+        return sampleVoxels(accessor, pos);
+    }
+    return sampleVoxels(*ram_, pos);
+}
+
+template <unsigned int DataDims>
+template <typename Source>
+Vector<DataDims, double> VolumeDoubleSampler<DataDims>::sampleVoxels(Source &source,
+                                                                     const dvec3 &pos) const {
     const dvec3 samplePos = pos * dvec3(dims_ - size3_t(1));
     const size3_t indexPos = size3_t(samplePos);
     const dvec3 interpolants = samplePos - dvec3(indexPos);
 
+    const auto voxel = [&](const size3_t &offset) {
+        const auto p = glm::clamp(indexPos + offset, size3_t(0), dims_ - size3_t(1));
+        return detail::VoxelGetter<DataDims>::get(source, p);
+    };
+
     Vector<DataDims, double> samples[8];
-    samples[0] = getVoxel(indexPos);
-    samples[1] = getVoxel(indexPos + size3_t(1, 0, 0));
-    samples[2] = getVoxel(indexPos + size3_t(0, 1, 0));
-    samples[3] = getVoxel(indexPos + size3_t(1, 1, 0));
+    samples[0] = voxel(size3_t(0, 0, 0));
+    samples[1] = voxel(size3_t(1, 0, 0));
+    samples[2] = voxel(size3_t(0, 1, 0));
+    samples[3] = voxel(size3_t(1, 1, 0));
 
-    samples[4] = getVoxel(indexPos + size3_t(0, 0, 1));
-    samples[5] = getVoxel(indexPos + size3_t(1, 0, 1));
-    samples[6] = getVoxel(indexPos + size3_t(0, 1, 1));
-    samples[7] = getVoxel(indexPos + size3_t(1, 1, 1));
+    samples[4] = voxel(size3_t(0, 0, 1));
+    samples[5] = voxel(size3_t(1, 0, 1));
+    samples[6] = voxel(size3_t(0, 1, 1));
+    samples[7] = voxel(size3_t(1, 1, 1));
 
     return Interpolation<Vector<DataDims, double>>::trilinear(samples, interpolants);
 }
 
-template <>
-inline Vector<1, double> VolumeDoubleSampler<1>::getVoxel(const size3_t &pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDouble(p);
-}
-
-template <>
-inline Vector<2, double> VolumeDoubleSampler<2>::getVoxel(const size3_t &pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDVec2(p);
-}
-
-template <>
-inline Vector<3, double> VolumeDoubleSampler<3>::getVoxel(const size3_t &pos) const {
-    const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDVec3(p);
+template <unsigned int DataDims>
+void VolumeDoubleSampler<DataDims>::sampleDataSpaceBatch(
+    util::span<const dvec3> positions, util::span<Vector<DataDims, double>> result) const {
+    if (bricked_) {
+        // Consecutive positions are usually close, keep the brick between the samples
+        VolumeBricked::Accessor accessor(*bricked_);
+        for (size_t i = 0; i < positions.size(); ++i) {
+            result[i] = withinBoundsDataSpace(positions[i])
+                            ? sampleVoxels(accessor, positions[i])
+                            : Vector<DataDims, double>(0.0);
+        }
+        return;
+    }
+    if (!detail::isBatchSampledFormat(ram_->getDataFormat())) {
+        SpatialSampler<3, DataDims, double>::sampleDataSpaceBatch(positions, result);
+        return;
+    }
+    ram_->dispatch<void, detail::BatchSampledFormats>([&](auto vrprecision) {
+        util::sampleTrilinear(vrprecision->getDataTyped(), dims_, positions, result);
+    });
 }
 
-template <>
-inline Vector<4, double> VolumeDoubleSampler<4>::getVoxel(const size3_t &pos) const {
+template <unsigned int DataDims>
+Vector<DataDims, double> VolumeDoubleSampler<DataDims>::getVoxel(const size3_t &pos) const {
     const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
-    return ram_->getAsDVec4(p);
+    return bricked_ ? detail::VoxelGetter<DataDims>::get(*bricked_, p)
+                    : detail::VoxelGetter<DataDims>::get(*ram_, p);
 }
 
 template <unsigned int DataDims>
@@ -60,12 +60,31 @@ namespace util {
  * interval [0,1], useful for progress bars
  * @param maskingCallback optional callback to test whether current cell should be evaluated or not
  * (return true to include current cell)
+ *
+ * The volume is split into slabs along z that are processed in parallel on the thread pool, and
+ * then merged into one mesh where the vertices on the slab boundaries are shared. The callbacks
+ * can therefore be called from any thread, the progressCallback is never called concurrently but
+ * the maskingCallback might be.
  */
 
 IVW_MODULE_BASE_API std::shared_ptr<Mesh> marchingCubesOpt(
     std::shared_ptr<const Volume> volume, double iso, const vec4 &color, bool invert, bool enclose,
     std::function<void(float)> progressCallback = nullptr,
     std::function<bool(const size3_t &)> maskingCallback = nullptr);
+
+namespace detail {
+
+/**
+ * Marching cubes as above using the given number of slabs. The slabs are processed on the thread
+ * pool if there is one, otherwise one after another.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Mesh> marchingCubesOpt(
+    std::shared_ptr<const Volume> volume, double iso, const vec4 &color, bool invert, bool enclose,
+    std::function<void(float)> progressCallback,
+    std::function<bool(const size3_t &)> maskingCallback, size_t numberOfSlabs);
+
+}  // namespace detail
+
 }  // namespace util
 
 namespace marching {
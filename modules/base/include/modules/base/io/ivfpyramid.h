@@ -0,0 +1,89 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * The pyramid of an ivf file is stored next to it in a file with the extension "ivp", listing
+ * the format and dimensions of each level, and one raw file per downsampled level. Level 0 is the
+ * raw file of the ivf file itself. The size and modification time of the ivf file are recorded
+ * so that a pyramid left behind by an older version of the volume is not used.
+ */
+IVW_MODULE_BASE_API std::string ivfPyramidFile(const std::string& ivfFile);
+
+/**
+ * Write the downsampled levels of a pyramid for the volume stored in ivfFile. The levels are
+ * written to raw files named as the ivf file with a level suffix.
+ * @param levels the downsampled levels, i.e. excluding the full resolution volume
+ * @param kernel used to create the levels
+ * @param ivfFile the ivf file of the full resolution volume
+ * @param overwrite existing files
+ * @throws DataWriterException if the ivf file does not exist, if any of the files exist and
+ * overwrite is false, or if the files could not be written.
+ * @see util::createPyramidLevels
+ */
+IVW_MODULE_BASE_API void writeIvfPyramid(const std::vector<std::shared_ptr<VolumeRAM>>& levels,
+                                         DownsamplingKernel kernel, const std::string& ivfFile,
+                                         bool overwrite = false);
+
+/**
+ * Write the levels 1 and up of pyramid, see above.
+ */
+IVW_MODULE_BASE_API void writeIvfPyramid(const VolumePyramid& pyramid, const std::string& ivfFile,
+                                         bool overwrite = false);
+
+/**
+ * Read the pyramid belonging to ivfFile if there is one. The downsampled levels are loaded on
+ * demand using memory mapping where possible.
+ * @param ivfFile the ivf file of the full resolution volume
+ * @param level0 loader for the full resolution volume
+ * @return the pyramid or nullptr if there is no pyramid file, if the ivf file has changed since
+ * the pyramid was written, or if the format, the dimensions or the file size of any level does not
+ * match the volume.
+ */
+IVW_MODULE_BASE_API std::shared_ptr<VolumePyramid> readIvfPyramid(
+    const std::string& ivfFile, VolumePyramid::Loader level0, const size3_t& dimensions,
+    const DataFormatBase* format, const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+    InterpolationType interpolation = InterpolationType::Linear,
+    const Wrapping3D& wrapping = wrapping3d::clampAll);
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -38,8 +38,11 @@
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/properties/fileproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/compositeproperty.h>
 #include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/ports/volumeport.h>
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
 #include <inviwo/core/util/fileextension.h>
 
 namespace inviwo {
@@ -57,6 +60,10 @@ class InviwoApplication;
  *
  * ### Properties
  *   * __File name__ File to load.
+ *   * __Progressive Loading__ If the volume has a pyramid, output the coarsest level right away
+ *     and then refine it in the background until the full resolution volume is loaded.
+ *   * __Downsampling Kernel__ Kernel used by __Create Pyramid__.
+ *   * __Create Pyramid__ Create and save a pyramid next to the loaded ivf file.
  */
 class IVW_MODULE_BASE_API VolumeSource : public Processor {
 public:
@@ -65,13 +72,16 @@ public:
     static const ProcessorInfo processorInfo_;
 
     VolumeSource(InviwoApplication* app, const std::string& file = "");
-    virtual ~VolumeSource() = default;
+    virtual ~VolumeSource();
 
     virtual void deserialize(Deserializer& d) override;
     virtual void process() override;
 
 private:
     void load(bool deserialize = false);
+    void startProgressive(std::shared_ptr<Volume> volume);
+    void loadLevel(std::shared_ptr<Volume> volume, const VolumePyramid* pyramid, size_t level);
+    void createPyramid();
 
     InviwoApplication* app_;
     std::shared_ptr<VolumeSequence> volumes_;
@@ -85,6 +95,17 @@ private:
     VolumeInformationProperty information_;
     SequenceTimerProperty volumeSequence_;
 
+    CompositeProperty levelOfDetail_;
+    BoolProperty progressive_;
+    TemplateOptionProperty<DownsamplingKernel> kernel_;
+    ButtonProperty createPyramid_;
+
+    // Background jobs hold weak references to these tokens, alive_ expires when the processor is
+    // deleted and progressiveRequest_ is replaced for each new progressive load
+    std::shared_ptr<const bool> alive_ = std::make_shared<const bool>(true);
+    std::shared_ptr<const bool> progressiveRequest_ = std::make_shared<const bool>(true);
+    size_t backgroundJobs_ = 0;
+    std::shared_ptr<Volume> progressiveVolume_;
     bool deserialized_ = false;
     bool loadingFailed_ = false;
 };
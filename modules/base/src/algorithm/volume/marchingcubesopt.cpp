@@ -30,6 +30,7 @@
 #include <modules/base/algorithm/volume/marchingcubesopt.h>
 #include <modules/base/algorithm/volume/surfaceextraction.h>
 #include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/common/inviwoapplication.h>
 
 #include <modules/base/datastructures/disjointsets.h>
 #include <glm/gtx/normal.hpp>
@@ -37,6 +38,7 @@
 #include <algorithm>
 #include <limits>
 #include <bitset>
+#include <mutex>
 
 namespace inviwo {
 
@@ -253,7 +255,7 @@ public:
         cache[zCacheNext].resize(dim.x);
     }
 
-    std::pair<size_t, bool> find(const size3_t &ind, int edge, const size_t &val) {
+    std::pair<uint32_t, bool> find(const size3_t &ind, int edge, const uint32_t &val) {
         switch (edge) {
             case 0:
                 if (ind.z == 0 && ind.y == 0) {
@@ -355,7 +357,7 @@ public:
 
 private:
     util::IndexMapper2D cIm;
-    std::array<std::vector<size_t>, 6> cache;
+    std::array<std::vector<uint32_t>, 6> cache;
     std::array<size_t, 8> pos;
 };
 
@@ -429,13 +431,150 @@ template <typename T, typename IsoTest>
 const std::array<OffsetIndexMasks, 4> Index<T, IsoTest>::oim_ = {
     {{0, 1, {0, 0, 0}}, {3, 2, {0, 1, 0}}, {4, 5, {0, 0, 1}}, {7, 6, {0, 1, 1}}}};
 
+/**
+ * The result of running marching cubes over a slab of cells [z0, z1). Vertices on the bottom and
+ * top planes of the slab are also created by the neighboring slabs, they are recorded together
+ * with a key of their edge within the plane to be able to merge the slabs.
+ */
+struct Slab {
+    size_t z0;
+    size_t z1;
+
+    std::vector<vec3> positions;
+    std::vector<vec3> normals;
+    std::vector<uint32_t> indices;
+
+    std::vector<std::pair<size_t, uint32_t>> bottom;
+    std::vector<std::pair<size_t, uint32_t>> top;
+    // Number of vertices created in the first layer of cells, only those can be on the bottom
+    uint32_t firstLayerEnd = 0;
+
+    // Filled in when merging
+    std::vector<uint32_t> firstLayerRemap;
+    std::vector<std::pair<uint32_t, uint32_t>> shared;
+    uint32_t offset = 0;
+    uint32_t sharedCount = 0;
+    size_t indexOffset = 0;
+
+    uint32_t remap(uint32_t i) const {
+        return i < firstLayerEnd ? firstLayerRemap[i] : offset + i - sharedCount;
+    }
+};
+
+// Key of a cube edge in the bottom (0-3) or top (8-11) face of the cell at ind, within the plane
+size_t planeKey(const size3_t &ind, const size2_t &dim, int edge) {
+    const util::IndexMapper2D im(dim);
+    switch (edge % 8) {
+        case 0:
+            return 2 * im(ind.x, ind.y);
+        case 1:
+            return 2 * im(ind.x + 1, ind.y) + 1;
+        case 2:
+            return 2 * im(ind.x, ind.y + 1);
+        case 3:
+        default:
+            return 2 * im(ind.x, ind.y) + 1;
+    }
+}
+
+/**
+ * Merge the slabs into the output buffers. Vertices shared between neighboring slabs are only
+ * kept from the lower slab, and the normal contributions of the upper slab are added to those.
+ */
+void mergeSlabs(std::vector<Slab> &slabs, std::vector<vec3> &positions,
+                std::vector<vec3> &normals, std::vector<uint32_t> &indices) {
+    if (slabs.size() == 1) {
+        positions = std::move(slabs.front().positions);
+        normals = std::move(slabs.front().normals);
+        indices = std::move(slabs.front().indices);
+        return;
+    }
+
+    constexpr auto npos = std::numeric_limits<uint32_t>::max();
+    const auto byKey = [](const auto &a, const auto &b) { return a.first < b.first; };
+
+    // Assign global indices, only the first layer of each slab needs an explicit remapping
+    uint32_t offset = 0;
+    size_t indexOffset = 0;
+    std::vector<std::pair<size_t, uint32_t>> prevTop;
+    for (auto &slab : slabs) {
+        slab.firstLayerRemap.assign(slab.firstLayerEnd, npos);
+        std::sort(slab.bottom.begin(), slab.bottom.end(), byKey);
+
+        auto top = prevTop.begin();
+        for (const auto &[key, local] : slab.bottom) {
+            top = std::lower_bound(top, prevTop.end(), std::make_pair(key, uint32_t{0}), byKey);
+            if (top != prevTop.end() && top->first == key) {
+                slab.firstLayerRemap[local] = top->second;
+                slab.shared.emplace_back(top->second, local);
+            }
+        }
+        slab.sharedCount = static_cast<uint32_t>(slab.shared.size());
+        slab.offset = offset;
+        for (auto &i : slab.firstLayerRemap) {
+            if (i == npos) i = offset++;
+        }
+        offset = slab.offset + static_cast<uint32_t>(slab.positions.size()) - slab.sharedCount;
+        slab.indexOffset = indexOffset;
+        indexOffset += slab.indices.size();
+
+        prevTop.clear();
+        for (const auto &[key, local] : slab.top) {
+            prevTop.emplace_back(key, slab.remap(local));
+        }
+        std::sort(prevTop.begin(), prevTop.end(), byKey);
+    }
+
+    positions.resize(offset);
+    normals.resize(offset);
+    indices.resize(indexOffset);
+
+    const auto copy = [&](Slab &slab) {
+        const auto size = static_cast<uint32_t>(slab.positions.size());
+        for (uint32_t i = 0; i < size; ++i) {
+            const auto g = slab.remap(i);
+            if (i < slab.firstLayerEnd && g < slab.offset) continue;  // shared
+            positions[g] = slab.positions[i];
+            normals[g] = slab.normals[i];
+        }
+        std::transform(slab.indices.begin(), slab.indices.end(),
+                       indices.begin() + slab.indexOffset,
+                       [&](uint32_t i) { return slab.remap(i); });
+    };
+
+    util::forEachTask(slabs.size(), [&](size_t i) { copy(slabs[i]); });
+
+    for (const auto &slab : slabs) {
+        for (const auto &[g, local] : slab.shared) {
+            normals[g] += slab.normals[local];
+        }
+    }
+}
+
 }  // namespace
 
 namespace util {
+
 std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, double iso,
                                        const vec4 &color, bool invert, bool enclose,
                                        std::function<void(float)> progressCallback,
                                        std::function<bool(const size3_t &)> maskingCallback) {
+    // Slabs thinner than this are not worth the extra vertices on the slab boundaries
+    constexpr size_t minSlabSize = 16;
+    const size_t cells = volume->getDimensions().z > 1 ? volume->getDimensions().z - 1 : 0;
+    const size_t threads = InviwoApplication::isInitialized()
+                               ? InviwoApplication::getPtr()->getPoolSize()
+                               : size_t{0};
+    const size_t slabs = std::max(size_t{1}, std::min(threads, cells / minSlabSize));
+
+    return detail::marchingCubesOpt(volume, iso, color, invert, enclose, progressCallback,
+                                    maskingCallback, slabs);
+}
+
+std::shared_ptr<Mesh> detail::marchingCubesOpt(
+    std::shared_ptr<const Volume> volume, double iso, const vec4 &color, bool invert, bool enclose,
+    std::function<void(float)> progressCallback,
+    std::function<bool(const size3_t &)> maskingCallback, size_t numberOfSlabs) {
 
     auto indexBuffer = std::make_shared<IndexBuffer>();
     auto vertexBuffer = std::make_shared<Buffer<vec3>>();
@@ -452,13 +591,28 @@ std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, dou
 
     if (progressCallback) progressCallback(0.0f);
 
-    const auto mc = [&](auto ram, auto isoTest, auto mapValue) {
+    const size3_t dim{volume->getDimensions()};
+    const size3_t dim1 = dim - size3_t{1, 1, 1};
+
+    std::vector<Slab> slabs(std::max(size_t{1}, std::min(numberOfSlabs, dim1.z)));
+    for (size_t i = 0; i < slabs.size(); ++i) {
+        slabs[i].z0 = (dim1.z * i) / slabs.size();
+        slabs[i].z1 = (dim1.z * (i + 1)) / slabs.size();
+    }
+
+    // Blocks of cells that can not intersect the iso surface are skipped
+    const auto blocks = volume->getRepresentation<VolumeRAM>()->getMinMaxBlockIndex();
+    const size_t blockSize = blocks->getBlockSize();
+
+    // The slabs report progress concurrently, serialize the calls to the callback
+    std::mutex progressMutex;
+    size_t layersDone = 0;
+
+    const auto mc = [&](auto ram, auto isoTest, auto mapValue, Slab &slab) {
         using T = util::PrecisionValueType<decltype(ram)>;
         static const marching::Config cube{};
 
         const T *src = ram->getDataTyped();
-        const size3_t dim{volume->getDimensions()};
-        const size3_t dim1 = dim - size3_t{1, 1, 1};
         const util::IndexMapper3D im(dim);
 
         const auto dr = dvec3(1.0) / dvec3{glm::max(size3_t{1}, (dim - size3_t{1}))};
@@ -484,6 +638,16 @@ std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, dou
             return r0 + t * (r1 - r0);
         };
 
+        auto &positions = slab.positions;
+        auto &normals = slab.normals;
+        auto &indices = slab.indices;
+        const bool recordBottom = slab.z0 != 0;
+        const bool recordTop = slab.z1 != dim1.z;
+        const size2_t planeDim{dim.x, dim.y};
+
+        // The iso value as seen by the isoTest
+        const auto tiso = util::glm_convert<double>(util::glm_convert<T>(iso));
+
         VCache vcache(size2_t{dim.x, dim.y});
         Index<T, decltype(isoTest)> index(src, im, isoTest);
         size3_t ind;
@@ -492,7 +656,8 @@ std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, dou
         const float err =
             static_cast<float>(4.0 * glm::epsilon<double>() * glm::epsilon<double>() * dr.x * dr.y);
 
-        for (ind.z = 0, pos.z = 0.0; ind.z < dim1.z; ++ind.z, pos.z += dr.z) {
+        for (ind.z = slab.z0, pos.z = dr.z * static_cast<double>(slab.z0); ind.z < slab.z1;
+             ++ind.z, pos.z += dr.z) {
             vcache.incZ();
             for (ind.y = 0, pos.y = 0.0; ind.y < dim1.y; ++ind.y, pos.y += dr.y) {
                 ind.x = 0;
@@ -500,18 +665,35 @@ std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, dou
                 vcache.incY();
                 index.init(cInd);
                 for (pos.x = 0.0; ind.x < dim1.x; ++ind.x, pos.x += dr.x) {
+                    if (ind.x % blockSize == 0 &&
+                        !blocks->crosses(blocks->getBlock(ind), tiso, invert)) {
+                        // All cells of the block are trivial, continue at the next block
+                        const size_t next = std::min(ind.x + blockSize, dim1.x);
+                        index.init(cInd + next);
+                        ind.x = next - 1;
+                        pos.x = dr.x * static_cast<double>(ind.x);
+                        continue;
+                    }
                     index.update(cInd + ind.x);
                     if (index == 0 || index == 255) continue;
                     if (maskingCallback && !maskingCallback(ind)) continue;
 
-                    std::array<size_t, 12> inds;
+                    // The cache works in slab local coordinates
+                    const size3_t local{ind.x, ind.y, ind.z - slab.z0};
+                    std::array<uint32_t, 12> inds;
                     for (const auto edge : cube.caseEdges[index]) {
-                        const auto c = vcache.find(ind, edge, positions.size());
+                        const auto c =
+                            vcache.find(local, edge, static_cast<uint32_t>(positions.size()));
                         inds[edge] = c.first;
                         if (c.second) {
                             const auto vertex = interpolate(ind, pos, edge);
                             positions.emplace_back(vertex);
                             normals.emplace_back(0.0f, 0.0f, 0.0f);
+                            if (recordBottom && local.z == 0 && edge < 4) {
+                                slab.bottom.emplace_back(planeKey(ind, planeDim, edge), c.first);
+                            } else if (recordTop && ind.z + 1 == slab.z1 && edge >= 8) {
+                                slab.top.emplace_back(planeKey(ind, planeDim, edge), c.first);
+                            }
                         }
                     }
                     for (const auto &tri : cube.caseTriangles[index]) {
@@ -523,38 +705,57 @@ std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, dou
                         }
                         n = glm::normalize(n);
                         for (int v = 0; v < 3; ++v) {
-                            indices.push_back(static_cast<uint32_t>(inds[tri[v]]));
+                            indices.push_back(inds[tri[v]]);
                             normals[inds[tri[v]]] += n;
                         }
                     }
                     vcache.incX(cube.caseIncrements[index]);
                 }
             }
+            if (ind.z == slab.z0) slab.firstLayerEnd = static_cast<uint32_t>(positions.size());
             if (progressCallback) {
-                progressCallback(static_cast<float>(ind.z + 1) / static_cast<float>(dim.z - 1));
+                std::unique_lock<std::mutex> lock{progressMutex};
+                ++layersDone;
+                progressCallback(static_cast<float>(layersDone) / static_cast<float>(dim.z - 1));
             }
         }
+    };
 
-        if (enclose) {
-            marching::encloseSurfce(src, dim, indexRAM, positions, normals, iso, invert, dr.x, dr.y,
-                                    dr.z);
+    const auto process = [&](Slab &slab) {
+        if (invert) {
+            volume->getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Scalars>(
+                [&](auto ram) {
+                    using ValueType = util::PrecisionValueType<decltype(ram)>;
+                    mc(ram,
+                       [tiso = util::glm_convert<ValueType>(iso)](auto &&val) {
+                           return val > tiso;
+                       },
+                       [iso](auto &&val) { return util::glm_convert<double>(val) - iso; }, slab);
+                });
+        } else {
+            volume->getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Scalars>(
+                [&](auto ram) {
+                    using ValueType = util::PrecisionValueType<decltype(ram)>;
+                    mc(ram,
+                       [tiso = util::glm_convert<ValueType>(iso)](auto &&val) {
+                           return val < tiso;
+                       },
+                       [iso](auto &&val) { return -(util::glm_convert<double>(val) - iso); },
+                       slab);
+                });
         }
     };
-    if (invert) {
-        volume->getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Scalars>(
-            [&](auto ram) {
-                using ValueType = util::PrecisionValueType<decltype(ram)>;
-                mc(ram,
-                   [tiso = util::glm_convert<ValueType>(iso)](auto &&val) { return val > tiso; },
-                   [iso](auto &&val) { return util::glm_convert<double>(val) - iso; });
-            });
-    } else {
+
+    util::forEachTask(slabs.size(), [&](size_t i) { process(slabs[i]); });
+
+    mergeSlabs(slabs, positions, normals, indices);
+
+    if (enclose) {
         volume->getRepresentation<VolumeRAM>()->dispatch<void, dispatching::filter::Scalars>(
             [&](auto ram) {
-                using ValueType = util::PrecisionValueType<decltype(ram)>;
-                mc(ram,
-                   [tiso = util::glm_convert<ValueType>(iso)](auto &&val) { return val < tiso; },
-                   [iso](auto &&val) { return -(util::glm_convert<double>(val) - iso); });
+                const auto dr = dvec3(1.0) / dvec3{glm::max(size3_t{1}, (dim - size3_t{1}))};
+                marching::encloseSurfce(ram->getDataTyped(), dim, indexRAM, positions, normals,
+                                        iso, invert, dr.x, dr.y, dr.z);
             });
     }
 
@@ -579,6 +780,7 @@ std::shared_ptr<Mesh> marchingCubesOpt(std::shared_ptr<const Volume> volume, dou
 
     return mesh;
 }
+
 }  // namespace util
 
 }  // namespace inviwo
@@ -187,6 +187,10 @@ std::shared_ptr<Mesh> marchingtetrahedron(std::shared_ptr<const Volume> volume,
         dy = 1.0 / static_cast<double>(std::max(size_t(1), (dim.y - 1)));
         dz = 1.0 / static_cast<double>(std::max(size_t(1), (dim.z - 1)));
 
+        // Blocks where all voxels are on the same side of the iso value are skipped
+        const auto blocks = ram->getMinMaxBlockIndex();
+        const size_t blockSize = blocks->getBlockSize();
+
         const auto volSize = dim.x * dim.y * dim.z;
         indexBuffer->getDataContainer().reserve(volSize * 6);
         positions.reserve(volSize * 6);
@@ -195,6 +199,10 @@ std::shared_ptr<Mesh> marchingtetrahedron(std::shared_ptr<const Volume> volume,
         for (size_t k = 0; k < dim.z - 1; k++) {
             for (size_t j = 0; j < dim.y - 1; j++) {
                 for (size_t i = 0; i < dim.x - 1; i++) {
+                    if (i % blockSize == 0 && !blocks->contains(blocks->getBlock({i, j, k}), iso)) {
+                        i += blockSize - 1;
+                        continue;
+                    }
                     if (!maskingCallback({i, j, k})) continue;
                     double x = dx * i;
                     double y = dy * j;
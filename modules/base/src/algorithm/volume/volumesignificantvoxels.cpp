@@ -30,6 +30,7 @@
 #include <modules/base/algorithm/volume/volumesignificantvoxels.h>
 #include <inviwo/core/common/inviwo.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/indexmapper.h>
 
 #include <algorithm>
 
@@ -41,15 +42,54 @@ size_t util::volumeSignificantVoxels(const VolumeRAM* volume, IgnoreSpecialValue
 
         const auto data = vr->getDataTyped();
         const auto dim = vr->getDimensions();
-        const auto size = dim.x * dim.y * dim.z;
 
-        if (ignore == IgnoreSpecialValues::Yes) {
-            return std::count_if(data, data + size, [](const auto& v) {
+        const auto significant = [ignore](const auto& v) {
+            if (ignore == IgnoreSpecialValues::Yes) {
                 return util::all(v != v + ValueType(1)) && util::any(v != ValueType(0));
-            });
+            } else {
+                return util::any(v != ValueType(0));
+            }
+        };
+
+        if constexpr (util::rank<ValueType>::value == 0) {
+            // Use the min-max block index to skip blocks that only contain zeros, and to count
+            // blocks without zeros directly. The blocks of the index share their boundary voxels,
+            // here each voxel is assigned to the block of the cell it is the lowest corner of.
+            const auto blocks = vr->getMinMaxBlockIndex();
+            const auto bs = blocks->getBlockSize();
+            const auto numBlocks = blocks->getNumberOfBlocks();
+            const util::IndexMapper3D im(dim);
+
+            size_t count = 0;
+            size3_t block;
+            for (block.z = 0; block.z < numBlocks.z; ++block.z) {
+                for (block.y = 0; block.y < numBlocks.y; ++block.y) {
+                    for (block.x = 0; block.x < numBlocks.x; ++block.x) {
+                        const auto range = blocks->getRange(block);
+                        if (range.x == 0.0 && range.y == 0.0) continue;
+
+                        const size3_t lower = block * bs;
+                        const size3_t upper{block.x + 1 == numBlocks.x ? dim.x : lower.x + bs,
+                                            block.y + 1 == numBlocks.y ? dim.y : lower.y + bs,
+                                            block.z + 1 == numBlocks.z ? dim.z : lower.z + bs};
+
+                        if (ignore == IgnoreSpecialValues::No && (range.x > 0.0 || range.y < 0.0)) {
+                            count += glm::compMul(upper - lower);
+                            continue;
+                        }
+                        for (size_t z = lower.z; z < upper.z; ++z) {
+                            for (size_t y = lower.y; y < upper.y; ++y) {
+                                const auto row = data + im(0, y, z);
+                                count += std::count_if(row + lower.x, row + upper.x, significant);
+                            }
+                        }
+                    }
+                }
+            }
+            return count;
         } else {
-            return std::count_if(data, data + size,
-                                 [](const auto& v) { return util::any(v != ValueType(0)); });
+            const auto size = dim.x * dim.y * dim.z;
+            return std::count_if(data, data + size, significant);
         }
     });
 }
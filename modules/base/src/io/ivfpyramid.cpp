@@ -0,0 +1,198 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/io/ivfpyramid.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/io/serialization/serialization.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <cstdint>
+
+namespace inviwo {
+
+namespace {
+
+std::int64_t fileSize(const std::string& file) {
+    auto in = filesystem::ifstream(file, std::ios::in | std::ios::binary | std::ios::ate);
+    return in ? static_cast<std::int64_t>(in.tellg()) : -1;
+}
+
+std::int64_t fileTime(const std::string& file) {
+    return static_cast<std::int64_t>(filesystem::fileModificationTime(file));
+}
+
+void writePyramid(const std::vector<const VolumeRAM*>& levels, DownsamplingKernel kernel,
+                  const std::string& ivfFile, bool overwrite) {
+    const auto pyramidFile = util::ivfPyramidFile(ivfFile);
+    const auto fileName = filesystem::getFileNameWithoutExtension(ivfFile);
+    const auto fileDirectory = filesystem::getFileDirectory(ivfFile);
+
+    if (levels.empty()) {
+        throw DataWriterException("Error: No pyramid levels to write",
+                                  IVW_CONTEXT_CUSTOM("writeIvfPyramid"));
+    }
+    if (!filesystem::fileExists(ivfFile)) {
+        throw DataWriterException("Error: Could not find the volume file: " + ivfFile,
+                                  IVW_CONTEXT_CUSTOM("writeIvfPyramid"));
+    }
+
+    std::vector<std::string> rawFiles;
+    std::vector<size3_t> dimensions;
+    for (size_t level = 0; level < levels.size(); ++level) {
+        rawFiles.push_back(fileName + ".level" + toString(level + 1) + ".raw");
+        dimensions.push_back(levels[level]->getDimensions());
+    }
+
+    if (!overwrite) {
+        for (const auto& file : rawFiles) {
+            if (filesystem::fileExists(fileDirectory + "/" + file)) {
+                throw DataWriterException("Error: Output file: " + file + " already exists",
+                                          IVW_CONTEXT_CUSTOM("writeIvfPyramid"));
+            }
+        }
+        if (filesystem::fileExists(pyramidFile)) {
+            throw DataWriterException("Error: Output file: " + pyramidFile + " already exists",
+                                      IVW_CONTEXT_CUSTOM("writeIvfPyramid"));
+        }
+    }
+
+    for (size_t level = 0; level < levels.size(); ++level) {
+        const auto rawPath = fileDirectory + "/" + rawFiles[level];
+        if (auto fout = filesystem::ofstream(rawPath, std::ios::out | std::ios::binary)) {
+            fout.write(static_cast<const char*>(levels[level]->getData()),
+                       levels[level]->getNumberOfBytes());
+        } else {
+            throw DataWriterException("Error: Could not write to raw file: " + rawPath,
+                                      IVW_CONTEXT_CUSTOM("writeIvfPyramid"));
+        }
+    }
+
+    Serializer s(pyramidFile);
+    s.serialize("Kernel", kernel);
+    s.serialize("Format", levels.front()->getDataFormatString());
+    s.serialize("SourceSize", fileSize(ivfFile));
+    s.serialize("SourceModified", fileTime(ivfFile));
+    s.serialize("LevelDimensions", dimensions, "Dimension");
+    s.serialize("LevelFiles", rawFiles, "RawFile");
+    s.writeFile();
+}
+
+}  // namespace
+
+std::string util::ivfPyramidFile(const std::string& ivfFile) {
+    return filesystem::replaceFileExtension(ivfFile, "ivp");
+}
+
+void util::writeIvfPyramid(const std::vector<std::shared_ptr<VolumeRAM>>& levels,
+                           DownsamplingKernel kernel, const std::string& ivfFile, bool overwrite) {
+    std::vector<const VolumeRAM*> rams;
+    for (const auto& level : levels) rams.push_back(level.get());
+    writePyramid(rams, kernel, ivfFile, overwrite);
+}
+
+void util::writeIvfPyramid(const VolumePyramid& pyramid, const std::string& ivfFile,
+                           bool overwrite) {
+    std::vector<std::shared_ptr<const VolumeRAM>> levels;
+    std::vector<const VolumeRAM*> rams;
+    for (size_t level = 1; level < pyramid.getNumberOfLevels(); ++level) {
+        levels.push_back(pyramid.getLevel(level));
+        rams.push_back(levels.back().get());
+    }
+    writePyramid(rams, pyramid.getKernel(), ivfFile, overwrite);
+}
+
+std::shared_ptr<VolumePyramid> util::readIvfPyramid(const std::string& ivfFile,
+                                                    VolumePyramid::Loader level0,
+                                                    const size3_t& dimensions,
+                                                    const DataFormatBase* format,
+                                                    const SwizzleMask& swizzleMask,
+                                                    InterpolationType interpolation,
+                                                    const Wrapping3D& wrapping) {
+    const auto pyramidFile = ivfPyramidFile(ivfFile);
+    if (!filesystem::fileExists(pyramidFile)) return nullptr;
+    const auto fileDirectory = filesystem::getFileDirectory(ivfFile);
+
+    Deserializer d(pyramidFile);
+    DownsamplingKernel kernel{DownsamplingKernel::Average};
+    std::string formatName;
+    std::int64_t sourceSize = -1;
+    std::int64_t sourceModified = -1;
+    std::vector<size3_t> levelDimensions;
+    std::vector<std::string> rawFiles;
+    d.deserialize("Kernel", kernel);
+    d.deserialize("Format", formatName);
+    d.deserialize("SourceSize", sourceSize);
+    d.deserialize("SourceModified", sourceModified);
+    d.deserialize("LevelDimensions", levelDimensions, "Dimension");
+    d.deserialize("LevelFiles", rawFiles, "RawFile");
+
+    // The pyramid is stale if the ivf file has been written after the pyramid was created, or if
+    // any of the levels does not match the volume
+    const auto matches = [&]() {
+        if (sourceSize != fileSize(ivfFile) || sourceModified != fileTime(ivfFile)) return false;
+        if (formatName != format->getString()) return false;
+        if (levelDimensions.empty() || levelDimensions.size() != rawFiles.size()) return false;
+        size3_t expected = dimensions;
+        for (size_t level = 0; level < levelDimensions.size(); ++level) {
+            expected = (expected + size3_t{1}) / size3_t{2};
+            const auto bytes = glm::compMul(expected) * format->getSize();
+            if (levelDimensions[level] != expected ||
+                fileSize(fileDirectory + "/" + rawFiles[level]) !=
+                    static_cast<std::int64_t>(bytes)) {
+                return false;
+            }
+        }
+        return true;
+    };
+    if (!matches()) {
+        LogWarnCustom("readIvfPyramid",
+                      "Ignoring pyramid that does not match the volume: " << pyramidFile);
+        return nullptr;
+    }
+
+    std::vector<VolumePyramid::Loader> loaders{std::move(level0)};
+    for (size_t level = 0; level < rawFiles.size(); ++level) {
+        loaders.push_back([rawFile = fileDirectory + "/" + rawFiles[level],
+                           disk = VolumeDisk(levelDimensions[level], format, swizzleMask,
+                                             interpolation, wrapping)]() {
+            RawVolumeRAMLoader loader(rawFile, 0, true);
+            return std::static_pointer_cast<VolumeRAM>(loader.createRepresentation(disk));
+        });
+    }
+    levelDimensions.insert(levelDimensions.begin(), dimensions);
+    return std::make_shared<VolumePyramid>(format, std::move(levelDimensions), std::move(loaders),
+                                           kernel, swizzleMask, interpolation, wrapping);
+}
+
+}  // namespace inviwo
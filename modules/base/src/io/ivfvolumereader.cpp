@@ -28,8 +28,10 @@
  *********************************************************************************/
 
 #include <modules/base/io/ivfvolumereader.h>
+#include <modules/base/io/ivfpyramid.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumebricked.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/io/datareaderexception.h>
@@ -53,6 +55,7 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
     Deserializer d(filePath);
 
     std::string rawFile;
+    std::string brickedFile;
     size3_t dimensions{0u};
     size_t byteOffset = 0u;
     const DataFormatBase* format = nullptr;
@@ -61,6 +64,7 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
     d.registerFactory(InviwoApplication::getPtr()->getMetaDataFactory());
     d.deserialize("RawFile", rawFile);
     rawFile = fileDirectory + "/" + rawFile;
+    d.deserialize("BrickedFile", brickedFile);
     d.deserialize("ByteOffset", byteOffset);
     std::string formatFlag;
     d.deserialize("Format", formatFlag);
@@ -90,12 +94,35 @@ std::shared_ptr<Volume> IvfVolumeReader::readData(const std::string& filePath) {
 
     volume->getMetaDataMap()->deserialize(d);
     littleEndian = volume->getMetaData<BoolMetaData>("LittleEndian", littleEndian);
+
+    if (!brickedFile.empty()) {
+        auto vb = std::make_shared<VolumeBricked>(fileDirectory + "/" + brickedFile,
+                                                  VolumeBricked::defaultCacheSize, swizzleMask,
+                                                  interpolation, wrapping);
+        if (vb->getDimensions() != dimensions || vb->getDataFormat() != format) {
+            throw DataReaderException("Error: Bricked file does not match: " + filePath,
+                                      IVW_CONTEXT);
+        }
+        volume->addRepresentation(vb);
+        return volume;
+    }
+
     auto vd = std::make_shared<VolumeDisk>(filePath, dimensions, format, swizzleMask, interpolation,
                                            wrapping);
 
     auto loader = std::make_unique<RawVolumeRAMLoader>(rawFile, byteOffset, littleEndian);
-    vd->setLoader(loader.release());
 
+    // The disk representation is added last to make it the valid one, the pyramid only serves
+    // the downsampled levels to those who ask for them.
+    auto level0 = [disk = *vd, loader = std::shared_ptr<RawVolumeRAMLoader>(loader->clone())]() {
+        return std::static_pointer_cast<VolumeRAM>(loader->createRepresentation(disk));
+    };
+    if (auto pyramid = util::readIvfPyramid(filePath, level0, dimensions, format, swizzleMask,
+                                            interpolation, wrapping)) {
+        volume->addRepresentation(pyramid);
+    }
+
+    vd->setLoader(loader.release());
     volume->addRepresentation(vd);
     return volume;
 }
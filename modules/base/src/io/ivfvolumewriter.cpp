@@ -28,9 +28,12 @@
  *********************************************************************************/
 
 #include <modules/base/io/ivfvolumewriter.h>
+#include <modules/base/io/ivfpyramid.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
 #include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/datastructures/representationconverter.h>
 
 namespace inviwo {
 
@@ -85,6 +88,17 @@ void IvfVolumeWriter::writeData(const Volume* volume, const std::string filePath
     } else {
         throw DataWriterException("Error: Could not write to raw file: " + rawPath, IVW_CONTEXT);
     }
+
+    // A pyramid that has been invalidated by an edit of the volume can not be converted to and
+    // is left out
+    if (volume->hasRepresentation<VolumePyramid>() &&
+        volume->getRepresentation<VolumePyramid>()->getNumberOfLevels() > 1) {
+        try {
+            util::writeIvfPyramid(*volume->getRepresentation<VolumePyramid>(), filePath,
+                                  overwrite_);
+        } catch (const ConverterException&) {
+        }
+    }
 }
 
 }  // namespace inviwo
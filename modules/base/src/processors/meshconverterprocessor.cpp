@@ -34,11 +34,11 @@ namespace inviwo {
 
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
 const ProcessorInfo MeshConverterProcessor::processorInfo_{
-    "org.inviwo.MeshConverter",  // Class identifier
-    "Mesh Converter",            // Display name
-    "Mesh Operation",            // Category
-    CodeState::Stable,           // Code state
-    Tags::CPU,                   // Tags
+    "org.inviwo.MeshConverter",    // Class identifier
+    "Mesh Converter",              // Display name
+    "Mesh Operation",              // Category
+    CodeState::Stable,             // Code state
+    Tags::CPU | Tags::Concurrent,  // Tags
 };
 const ProcessorInfo MeshConverterProcessor::getProcessorInfo() const { return processorInfo_; }
 
@@ -38,7 +38,7 @@ const ProcessorInfo TrianglesToWireframe::processorInfo_{
     "Triangles To Wireframe",           // Display name
     "Mesh Operation",                   // Category
     CodeState::Stable,                  // Code state
-    Tags::CPU,                          // Tags
+    Tags::CPU | Tags::Concurrent,       // Tags
 };
 const ProcessorInfo TrianglesToWireframe::getProcessorInfo() const { return processorInfo_; }
 
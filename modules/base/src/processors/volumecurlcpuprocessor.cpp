@@ -38,7 +38,7 @@ const ProcessorInfo VolumeCurlCPUProcessor::processorInfo_{
     "Volume Curl",                        // Display name
     "Volume Operation",                   // Category
     CodeState::Stable,                    // Code state
-    Tags::CPU,                            // Tags
+    Tags::CPU | Tags::Concurrent,         // Tags
 };
 const ProcessorInfo VolumeCurlCPUProcessor::getProcessorInfo() const { return processorInfo_; }
 
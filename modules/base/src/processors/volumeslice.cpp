@@ -34,6 +34,7 @@
 
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/volume/volumebricked.h>
 #include <inviwo/core/datastructures/image/imageram.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 
@@ -135,12 +136,26 @@ void VolumeSlice::process() {
             break;
     }
 
+    const auto axis = static_cast<CartesianCoordinateAxis>(sliceAlongAxis_.get());
+    auto slice = static_cast<size_t>(sliceNumber_.get() - 1);
+
+    // For out-of-core volumes only read the bricks intersecting the slice into a volume that is
+    // one voxel thick along the slice axis.
+    std::shared_ptr<const VolumeRAM> sliceRAM;
+    if (!vol->hasRepresentation<VolumeRAM>() && vol->hasRepresentation<VolumeBricked>()) {
+        const auto axisIndex = static_cast<int>(axis);
+        size3_t offset{0};
+        size3_t extent{dims};
+        offset[axisIndex] = std::min(slice, dims[axisIndex] - 1);
+        extent[axisIndex] = 1;
+        sliceRAM = vol->getRepresentation<VolumeBricked>()->getRegion(offset, extent);
+        slice = 0;
+    }
+
     auto image =
-        vol->getRepresentation<VolumeRAM>()
+        (sliceRAM ? sliceRAM.get() : vol->getRepresentation<VolumeRAM>())
             ->dispatch<std::shared_ptr<Image>, dispatching::filter::All>(
-                [axis = static_cast<CartesianCoordinateAxis>(sliceAlongAxis_.get()),
-                 slice = static_cast<size_t>(sliceNumber_.get() - 1),
-                 &cache = imageCache_](const auto vrprecision) {
+                [axis, slice, &cache = imageCache_](const auto vrprecision) {
                     using T = util::PrecisionValueType<decltype(vrprecision)>;
 
                     const T* voldata = vrprecision->getDataTyped();
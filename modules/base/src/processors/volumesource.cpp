@@ -29,6 +29,7 @@
 
 #include <modules/base/processors/volumesource.h>
 #include <modules/base/processors/datasource.h>
+#include <modules/base/io/ivfpyramid.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/raiiutils.h>
@@ -65,11 +66,23 @@ VolumeSource::VolumeSource(InviwoApplication* app, const std::string& file)
     , reload_("reload", "Reload data")
     , basis_("Basis", "Basis and offset")
     , information_("Information", "Data information")
-    , volumeSequence_("Sequence", "Sequence") {
+    , volumeSequence_("Sequence", "Sequence")
+    , levelOfDetail_("levelOfDetail", "Level of Detail")
+    , progressive_("progressive", "Progressive Loading", false)
+    , kernel_("kernel", "Downsampling Kernel",
+              {{"nearest", "Nearest", DownsamplingKernel::Nearest},
+               {"average", "Average", DownsamplingKernel::Average},
+               {"minimum", "Minimum", DownsamplingKernel::Minimum},
+               {"maximum", "Maximum", DownsamplingKernel::Maximum}},
+              1)
+    , createPyramid_("createPyramid", "Create Pyramid") {
 
     addPort(outport_);
-    addProperties(file_, reader_, reload_, information_, basis_, volumeSequence_);
+    levelOfDetail_.addProperties(progressive_, kernel_, createPyramid_);
+    addProperties(file_, reader_, reload_, information_, basis_, volumeSequence_, levelOfDetail_);
     volumeSequence_.setVisible(false);
+    levelOfDetail_.setCollapsed(true);
+    createPyramid_.onChange([this]() { createPyramid(); });
 
     util::updateFilenameFilters<Volume, VolumeSequence>(*app_->getDataReaderFactory(), file_,
                                                         reader_);
@@ -147,10 +160,125 @@ void VolumeSource::load(bool deserialize) {
     }
 }
 
+namespace {
+
+// A volume holding a copy of a pyramid level, with the transformations of the full volume
+std::shared_ptr<Volume> levelVolume(const Volume& volume, const VolumeRAM& level) {
+    auto result = std::make_shared<Volume>(std::shared_ptr<VolumeRepresentation>(level.clone()));
+    result->setModelMatrix(volume.getModelMatrix());
+    result->setWorldMatrix(volume.getWorldMatrix());
+    result->dataMap_ = volume.dataMap_;
+    result->copyMetaDataFrom(volume);
+    return result;
+}
+
+}  // namespace
+
+VolumeSource::~VolumeSource() {
+    // Jobs that are still running will not call back into a deleted processor
+    if (backgroundJobs_ > 0) notifyObserversFinishBackgroundWork(this, backgroundJobs_);
+}
+
+void VolumeSource::startProgressive(std::shared_ptr<Volume> volume) {
+    // Jobs of a previous request will see their token expire and stop
+    progressiveRequest_ = std::make_shared<const bool>(true);
+    progressiveVolume_.reset();
+    if (!progressive_ || !volume || !volume->hasRepresentation<VolumePyramid>() ||
+        volume->hasRepresentation<VolumeRAM>()) {
+        return;
+    }
+
+    const auto pyramid = volume->getRepresentation<VolumePyramid>();
+    if (pyramid->getNumberOfLevels() < 2) return;
+
+    // The coarsest level is small, load it right away so that the full volume is never put on the
+    // outport before it has been converted here on the main thread
+    const auto coarsest = pyramid->getNumberOfLevels() - 1;
+    progressiveVolume_ = levelVolume(*volume, *pyramid->getLevel(coarsest));
+    loadLevel(volume, pyramid, coarsest - 1);
+}
+
+void VolumeSource::loadLevel(std::shared_ptr<Volume> volume, const VolumePyramid* pyramid,
+                             size_t level) {
+    ++backgroundJobs_;
+    notifyObserversStartBackgroundWork(this, 1);
+    // The pool job only uses the pyramid, which is thread safe, and never touches the processor.
+    // The processor is only used on the main thread after checking that it is still alive.
+    dispatchPool([this, alive = std::weak_ptr<const bool>(alive_),
+                  request = std::weak_ptr<const bool>(progressiveRequest_), volume, pyramid,
+                  level]() {
+        std::shared_ptr<Volume> result;
+        std::string error;
+        if (!request.expired()) {  // Skip the loading if a new request was started
+            try {
+                const auto ram = pyramid->getLevel(level);
+                if (level > 0) result = levelVolume(*volume, *ram);
+            } catch (const Exception& e) {
+                error = e.getMessage();
+            }
+        }
+
+        dispatchFront([this, alive, request, volume, pyramid, level, result, error]() {
+            if (alive.expired()) return;
+            --backgroundJobs_;
+            notifyObserversFinishBackgroundWork(this, 1);
+            if (request.expired()) return;
+            if (!error.empty()) {
+                LogProcessorError("Could not load level " << level << ": " << error);
+                return;
+            }
+            // Level 0 is already loaded in the pyramid, converting it here on the main thread
+            // only copies it into the volume that is then put on the outport
+            if (level == 0) volume->getRepresentation<VolumeRAM>();
+            progressiveVolume_ = result;
+            invalidate(InvalidationLevel::InvalidOutput);
+            if (level > 0) loadLevel(volume, pyramid, level - 1);
+        });
+    });
+}
+
+void VolumeSource::createPyramid() {
+    if (!volumes_ || volumes_->size() != 1 || !(*volumes_)[0] ||
+        filesystem::getFileExtension(file_.get()) != "ivf") {
+        LogProcessorWarn("Pyramids can only be created for volumes loaded from ivf files");
+        return;
+    }
+
+    // The volume is on the outport, get the representation here on the main thread. The volume
+    // is captured to keep the representation alive.
+    const auto volume = (*volumes_)[0];
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+
+    ++backgroundJobs_;
+    notifyObserversStartBackgroundWork(this, 1);
+    dispatchPool([this, alive = std::weak_ptr<const bool>(alive_), volume, ram,
+                  kernel = kernel_.get(), file = file_.get()]() {
+        std::string error;
+        try {
+            const auto levels = util::createPyramidLevels(*ram, kernel);
+            util::writeIvfPyramid(levels, kernel, file, true);
+        } catch (const Exception& e) {
+            error = e.getMessage();
+        }
+
+        dispatchFront([this, alive, error]() {
+            if (alive.expired()) return;
+            --backgroundJobs_;
+            notifyObserversFinishBackgroundWork(this, 1);
+            if (error.empty()) {
+                reload_.pressButton();
+            } else {
+                LogProcessorError("Could not create pyramid: " << error);
+            }
+        });
+    });
+}
+
 void VolumeSource::process() {
     if (file_.isModified() || reload_.isModified() || reader_.isModified()) {
         load(deserialized_);
         deserialized_ = false;
+        startProgressive(volumes_ && volumes_->size() == 1 ? (*volumes_)[0] : nullptr);
     }
 
     if (volumes_ && !volumes_->empty()) {
@@ -161,7 +289,14 @@ void VolumeSource::process() {
         basis_.updateEntity(*(*volumes_)[index]);
         information_.updateVolume(*(*volumes_)[index]);
 
-        outport_.setData((*volumes_)[index]);
+        if (progressiveVolume_) {
+            progressiveVolume_->setModelMatrix((*volumes_)[index]->getModelMatrix());
+            progressiveVolume_->setWorldMatrix((*volumes_)[index]->getWorldMatrix());
+            progressiveVolume_->dataMap_ = (*volumes_)[index]->dataMap_;
+            outport_.setData(progressiveVolume_);
+        } else {
+            outport_.setData((*volumes_)[index]);
+        }
     } else {
         outport_.detachData();
     }
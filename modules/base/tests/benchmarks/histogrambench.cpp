@@ -0,0 +1,208 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/datastructures/histogramtools.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <benchmark/benchmark.h>
+
+#include <limits>
+#include <random>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+constexpr size_t bins = 2048;
+
+template <typename T>
+dvec2 dataRange() {
+    if constexpr (std::is_floating_point<T>::value) {
+        return dvec2{0.0, 1.0};
+    } else {
+        return dvec2{DataFormat<T>::lowest(), DataFormat<T>::max()};
+    }
+}
+
+template <typename T>
+std::shared_ptr<VolumeRAMPrecision<T>> makeVolume(size_t size) {
+    auto volume = std::make_shared<VolumeRAMPrecision<T>>(size3_t{size});
+    std::mt19937 gen(42);
+    const auto range = dataRange<T>();
+    std::uniform_real_distribution<double> dist(range.x, range.y);
+    auto data = volume->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(volume->getDimensions()); ++i) {
+        data[i] = static_cast<T>(dist(gen));
+    }
+    return volume;
+}
+
+void setCounters(benchmark::State& state) {
+    const auto voxels = static_cast<double>(state.range(0) * state.range(0) * state.range(0));
+    state.counters["Voxels"] = voxels;
+    state.counters["Rate"] = benchmark::Counter(voxels * static_cast<double>(state.iterations()),
+                                                benchmark::Counter::kIsRate);
+}
+
+/**
+ * The previous HistogramContainer constructor, a serial loop through a generic iterator. Kept here
+ * as a reference.
+ */
+template <typename T>
+std::vector<double> previous(dvec2 dataRange, size_t bins, const T* begin, const T* end) {
+    if constexpr (std::is_integral<T>::value) {
+        bins = std::min(bins, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
+    }
+    std::vector<double> histData(bins, 0.0);
+
+    double min(std::numeric_limits<double>::max());
+    double max(std::numeric_limits<double>::lowest());
+    double sum(0);
+    double sum2(0);
+    size_t count(0);
+
+    const double rangeMin(dataRange.x);
+    const double rangeScaleFactor(static_cast<double>(bins - 1) / (dataRange.y - dataRange.x));
+
+    for (; begin != end; ++begin) {
+        const auto val = static_cast<double>(*begin);
+        min = glm::min(min, val);
+        max = glm::max(max, val);
+        sum += val;
+        sum2 += val * val;
+        count++;
+
+        const auto ind = static_cast<size_t>((val - rangeMin) * rangeScaleFactor);
+        if (ind < bins) {
+            histData[ind]++;
+        }
+    }
+    benchmark::DoNotOptimize(min);
+    benchmark::DoNotOptimize(max);
+    benchmark::DoNotOptimize(sum);
+    benchmark::DoNotOptimize(sum2);
+    benchmark::DoNotOptimize(count);
+    return histData;
+}
+
+template <typename T>
+void generic(benchmark::State& state) {
+    const auto volume = makeVolume<T>(static_cast<size_t>(state.range(0)));
+    const auto begin = volume->getDataTyped();
+    const auto end = begin + glm::compMul(volume->getDimensions());
+    for (auto _ : state) {
+        auto histogram = previous(dataRange<T>(), bins, begin, end);
+        benchmark::DoNotOptimize(histogram);
+    }
+    setCounters(state);
+}
+
+template <typename T>
+void serial(benchmark::State& state) {
+    const auto volume = makeVolume<T>(static_cast<size_t>(state.range(0)));
+    const auto begin = volume->getDataTyped();
+    const auto end = begin + glm::compMul(volume->getDimensions());
+    for (auto _ : state) {
+        HistogramContainer histograms(dataRange<T>(), bins, begin, end);
+        benchmark::DoNotOptimize(histograms);
+    }
+    setCounters(state);
+}
+
+template <typename T>
+void parallel(benchmark::State& state) {
+    const auto volume = makeVolume<T>(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto histograms = util::calculateHistograms(*volume, dataRange<T>(), bins);
+        benchmark::DoNotOptimize(histograms);
+    }
+    setCounters(state);
+}
+
+}  // namespace
+
+static void HistogramGenericUInt8(benchmark::State& state) { generic<unsigned char>(state); }
+static void HistogramSerialUInt8(benchmark::State& state) { serial<unsigned char>(state); }
+static void HistogramParallelUInt8(benchmark::State& state) { parallel<unsigned char>(state); }
+
+static void HistogramGenericUInt16(benchmark::State& state) { generic<unsigned short>(state); }
+static void HistogramSerialUInt16(benchmark::State& state) { serial<unsigned short>(state); }
+static void HistogramParallelUInt16(benchmark::State& state) { parallel<unsigned short>(state); }
+
+static void HistogramGenericFloat(benchmark::State& state) { generic<float>(state); }
+static void HistogramSerialFloat(benchmark::State& state) { serial<float>(state); }
+static void HistogramParallelFloat(benchmark::State& state) { parallel<float>(state); }
+
+BENCHMARK(HistogramGenericUInt8)
+    ->RangeMultiplier(2)
+    ->Range(64, 512)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(HistogramSerialUInt8)
+    ->RangeMultiplier(2)
+    ->Range(64, 512)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(HistogramParallelUInt8)
+    ->RangeMultiplier(2)
+    ->Range(64, 512)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(HistogramGenericUInt16)
+    ->RangeMultiplier(2)
+    ->Range(64, 512)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(HistogramSerialUInt16)
+    ->RangeMultiplier(2)
+    ->Range(64, 512)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(HistogramParallelUInt16)
+    ->RangeMultiplier(2)
+    ->Range(64, 512)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK(HistogramGenericFloat)
+    ->RangeMultiplier(2)
+    ->Range(64, 512)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(HistogramSerialFloat)
+    ->RangeMultiplier(2)
+    ->Range(64, 512)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(HistogramParallelFloat)
+    ->RangeMultiplier(2)
+    ->Range(64, 512)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+#include <warn/pop>
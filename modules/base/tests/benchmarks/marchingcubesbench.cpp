@@ -27,11 +27,8 @@
  *
  *********************************************************************************/
 
-#ifdef _MSC_VER
-#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
-#endif
-
 #include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
 #include <modules/base/algorithm/volume/volumegeneration.h>
 
 #include <modules/base/algorithm/volume/marchingcubes.h>
@@ -130,12 +127,39 @@ static void MiniNew(benchmark::State& state) {
     state.counters["Voxels"] = state.range(0) * state.range(0) * state.range(0);
 }
 
+// Large volumes, serial versus slab parallel marching cubes, 8 bit data to keep the memory down
+static void LargeSphere(benchmark::State& state, size_t slabs) {
+    auto v = std::shared_ptr<Volume>(util::makeSphericalVolume<unsigned char>(
+        size3_t{static_cast<size_t>(state.range(0))}));
+    v->getRepresentation<VolumeRAM>();
+
+    size_t triangles = 0;
+    for (auto _ : state) {
+        auto mesh = slabs == 0
+                        ? util::marchingCubesOpt(v, 127.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false)
+                        : util::detail::marchingCubesOpt(v, 127.5, {0.5f, 0.0f, 0.0f, 1.0f},
+                                                         false, false, nullptr, nullptr, slabs);
+        triangles = mesh->getIndexBuffers().front().second->getSize() / 3;
+        benchmark::ClobberMemory();
+    }
+    state.counters["Triangles"] = static_cast<double>(triangles);
+    state.counters["TrianglesRate"] =
+        benchmark::Counter(static_cast<double>(triangles * state.iterations()),
+                           benchmark::Counter::kIsRate);
+}
+
+static void LargeSphereSerial(benchmark::State& state) { LargeSphere(state, 1); }
+static void LargeSphereParallel(benchmark::State& state) { LargeSphere(state, 0); }
+
 BENCHMARK(SphereOld)->RangeMultiplier(2)->Range(8, 8 << 5);
 BENCHMARK(SphereNew)->RangeMultiplier(2)->Range(8, 8 << 6);
 
 BENCHMARK(RippleOld)->RangeMultiplier(2)->Range(8, 8 << 4);
 BENCHMARK(RippleNew)->RangeMultiplier(2)->Range(8, 8 << 5);
 
+BENCHMARK(LargeSphereSerial)->Arg(512)->Arg(1024)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(LargeSphereParallel)->Arg(512)->Arg(1024)->Unit(benchmark::kMillisecond)->UseRealTime();
+
 // BENCHMARK(MiniOld)->RangeMultiplier(2)->Range(8, 8 << 5);
 // BENCHMARK(MiniNew)->RangeMultiplier(2)->Range(8, 8 << 5);
 
@@ -144,12 +168,4 @@ BENCHMARK(RippleNew)->RangeMultiplier(2)->Range(8, 8 << 5);
 
 // BENCHMARK(SphereNew)->Arg(5);
 
-int main(int argc, char** argv) {
-
-    benchmark::Initialize(&argc, argv);
-    benchmark::RunSpecifiedBenchmarks();
-
-    return 0;
-}
-
 #include <warn/pop>
@@ -335,4 +335,32 @@ TEST(Marchingcubes, sphere) {
     */
 }
 
+TEST(Marchingcubes, slabs) {
+    for (auto& vol : {std::shared_ptr<Volume>(util::makeSphericalVolume(size3_t{37, 29, 41})),
+                      std::shared_ptr<Volume>(util::makeRippleVolume(size3_t{33, 33, 50}))}) {
+        auto serial = util::detail::marchingCubesOpt(vol, 0.5, {1.0f, 0.0f, 0.0f, 1.0f}, false,
+                                                     false, nullptr, nullptr, 1);
+        auto& pos1 = getBufferData<vec3>(*serial, 0);
+        auto& normals1 = getBufferData<vec3>(*serial, 3);
+        auto& ind1 = getBufferIndexData(*serial, 0);
+        ASSERT_FALSE(ind1.empty());
+
+        for (size_t slabs : {2, 3, 7, 40}) {
+            auto mesh = util::detail::marchingCubesOpt(vol, 0.5, {1.0f, 0.0f, 0.0f, 1.0f}, false,
+                                                       false, nullptr, nullptr, slabs);
+            auto& pos2 = getBufferData<vec3>(*mesh, 0);
+            auto& normals2 = getBufferData<vec3>(*mesh, 3);
+            auto& ind2 = getBufferIndexData(*mesh, 0);
+
+            // Shared vertices on the slab boundaries are merged, giving the same mesh
+            ASSERT_EQ(pos1.size(), pos2.size()) << slabs;
+            EXPECT_EQ(ind1, ind2) << slabs;
+            for (size_t i = 0; i < pos1.size(); ++i) {
+                EXPECT_NEAR(0.0f, glm::distance(pos1[i], pos2[i]), 1.0e-5f) << slabs;
+                EXPECT_NEAR(0.0f, glm::distance(normals1[i], normals2[i]), 1.0e-4f) << slabs;
+            }
+        }
+    }
+}
+
 }  // namespace inviwo
@@ -0,0 +1,76 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/processors/trianglestowireframe.h>
+
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+
+#include <thread>
+
+namespace inviwo {
+
+TEST(TrianglesToWireframe, ConcurrentProcess) {
+    // The processor is tagged to be processed on the thread pool during parallel evaluation
+    EXPECT_EQ(1, TrianglesToWireframe::processorInfo_.tags.getMatches(Tags::Concurrent));
+
+    auto mesh = std::make_shared<Mesh>();
+    mesh->addBuffer(BufferType::PositionAttrib,
+                    std::make_shared<Buffer<vec3>>(std::make_shared<BufferRAMPrecision<vec3>>(
+                        std::vector<vec3>{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}})));
+    mesh->addIndices(Mesh::MeshInfo(DrawType::Triangles, ConnectivityType::None),
+                     util::makeIndexBuffer({0, 1, 2, 2, 1, 3}));
+
+    MeshOutport outport("outport");
+    TrianglesToWireframe processor;
+    processor.getInport("mesh")->connectTo(&outport);
+    outport.setData(mesh);
+
+    // Process on an other thread, as the network evaluator does for concurrent processors
+    std::thread thread([&processor]() { processor.process(); });
+    thread.join();
+
+    const auto wireframePort = static_cast<MeshOutport*>(processor.getOutport("wireframe"));
+    ASSERT_TRUE(wireframePort->hasData());
+    const auto wireframe = wireframePort->getData();
+    ASSERT_EQ(1, wireframe->getNumberOfIndicies());
+    EXPECT_EQ(DrawType::Lines, wireframe->getIndexMeshInfo(0).dt);
+    EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 1, 2, 2, 0, 2, 1, 1, 3, 3, 2}),
+              wireframe->getIndices(0)->getRAMRepresentation()->getDataContainer());
+    ASSERT_EQ(1, wireframe->getNumberOfBuffers());
+    EXPECT_NE(mesh->getBuffer(0), wireframe->getBuffer(0)) << "buffers are copied";
+}
+
+}  // namespace inviwo
@@ -31,10 +31,9 @@
 
 #include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
 #include <modules/brushingandlinking/datastructures/indexlist.h>
+#include <modules/brushingandlinking/datastructures/indexsnapshot.h>
 #include <inviwo/core/properties/invalidationlevel.h>
 
-#include <unordered_set>
-
 namespace inviwo {
 
 class BrushingAndLinkingInport;
@@ -65,23 +64,31 @@ public:
 
     bool isColumnSelected(size_t column) const;
 
-    void setSelected(const BrushingAndLinkingInport* src, const std::unordered_set<size_t>& idx);
+    void setSelected(const BrushingAndLinkingInport* src, const IndexSnapshot& idx);
     void clearSelected();
 
-    void setFiltered(const BrushingAndLinkingInport* src, const std::unordered_set<size_t>& idx);
+    void setFiltered(const BrushingAndLinkingInport* src, const IndexSnapshot& idx);
     void clearFiltered();
 
     void setSelectedColumn(const BrushingAndLinkingInport* src,
-                           const std::unordered_set<size_t>& columnIndices);
+                           const IndexSnapshot& columnIndices);
     void clearColumns();
 
-    const std::unordered_set<size_t>& getSelectedIndices() const;
-    const std::unordered_set<size_t>& getFilteredIndices() const;
-    const std::unordered_set<size_t>& getSelectedColumns() const;
+    const BitSet& getSelectedIndices() const;
+    const BitSet& getFilteredIndices() const;
+    const BitSet& getSelectedColumns() const;
+
+    /*
+     * Shared snapshots of the current indices. The version of a snapshot only changes when the
+     * indices are updated, use util::delta to find what changed between two snapshots.
+     */
+    const IndexSnapshot& getSelectionSnapshot() const;
+    const IndexSnapshot& getFilterSnapshot() const;
+    const IndexSnapshot& getColumnSelectionSnapshot() const;
 
 private:
-    std::unordered_set<size_t> selected_;
-    std::unordered_set<size_t> selectedColumns_;
+    IndexSnapshot selected_;
+    IndexSnapshot selectedColumns_;
     IndexList filtered_;  // Use IndexList to be able to remove filtered rows on port disconnection
     std::shared_ptr<std::function<void()>> onFilteringChangeCallback_;
 
@@ -92,7 +99,7 @@ private:
 inline bool BrushingAndLinkingManager::isFiltered(size_t idx) const { return filtered_.has(idx); }
 
 inline bool BrushingAndLinkingManager::isSelected(size_t idx) const {
-    return selected_.find(idx) != selected_.end();
+    return selected_->contains(idx);
 }
 
 }  // namespace inviwo
@@ -0,0 +1,194 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <unordered_set>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \brief A compressed set of indices, modeled after Roaring bitmaps.
+ *
+ * The indices are split into chunks of 2^16 consecutive indices. Each non-empty chunk keeps its
+ * indices in the container that is most compact for it:
+ *   * __Array__ a sorted array of 16 bit offsets, used for sparse chunks of at most 4096 indices.
+ *   * __Bitmap__ a bitmap of 2^16 bits, used for dense chunks.
+ *   * __Run__ a sorted list of runs of consecutive indices. Created by insertRange and
+ *     runOptimize, and kept by union with other runs.
+ *
+ * Union, intersection and difference work chunk by chunk, mostly on whole 64 bit words, which
+ * makes combining selections of millions of indices cheap compared to hash sets. Consumers that
+ * work on contiguous rows can use forEachRange instead of testing every index.
+ */
+class IVW_MODULE_BRUSHINGANDLINKING_API BitSet {
+public:
+    class IVW_MODULE_BRUSHINGANDLINKING_API const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const size_t*;
+        using reference = size_t;
+
+        const_iterator() = default;
+        size_t operator*() const { return value_; }
+        const_iterator& operator++();
+        const_iterator operator++(int);
+        bool operator==(const const_iterator& rhs) const {
+            return chunk_ == rhs.chunk_ && value_ == rhs.value_;
+        }
+        bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); }
+
+    private:
+        friend BitSet;
+        const_iterator(const BitSet* set, size_t chunk);
+        void first();
+
+        const BitSet* set_ = nullptr;
+        size_t chunk_ = 0;
+        size_t pos_ = 0;  // position in an array, or index of the current run
+        size_t value_ = 0;
+    };
+    using iterator = const_iterator;
+    using value_type = size_t;
+
+    BitSet() = default;
+    BitSet(std::initializer_list<size_t> indices);
+    explicit BitSet(const std::unordered_set<size_t>& indices);
+    template <typename InputIt>
+    BitSet(InputIt begin, InputIt end);
+
+    /**
+     * The number of indices in the set
+     */
+    size_t size() const;
+    bool empty() const { return chunks_.empty(); }
+    bool contains(size_t idx) const;
+    size_t count(size_t idx) const { return contains(idx) ? 1 : 0; }
+
+    void insert(size_t idx);
+    template <typename InputIt>
+    void insert(InputIt begin, InputIt end);
+    /**
+     * Insert all indices in [begin, end). Chunks that were empty or already used runs will use
+     * runs afterwards.
+     */
+    void insertRange(size_t begin, size_t end);
+    void erase(size_t idx);
+    void clear() { chunks_.clear(); }
+
+    BitSet& operator|=(const BitSet& rhs);
+    BitSet& operator&=(const BitSet& rhs);
+    /**
+     * Remove all indices in \p rhs from this set
+     */
+    BitSet& operator-=(const BitSet& rhs);
+
+    bool operator==(const BitSet& rhs) const;
+    bool operator!=(const BitSet& rhs) const { return !(*this == rhs); }
+
+    /**
+     * Convert chunks to run containers where that is more compact
+     */
+    void runOptimize();
+
+    /**
+     * Call \p func with every maximal range [begin, end) of consecutive indices in the set, in
+     * increasing order.
+     */
+    void forEachRange(const std::function<void(size_t, size_t)>& func) const;
+
+    /**
+     * The number of bytes used by the containers, excluding the bookkeeping of the chunks
+     */
+    size_t getContainerSizeInBytes() const;
+
+    std::vector<size_t> toVector() const;
+    std::unordered_set<size_t> toUnorderedSet() const;
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, chunks_.size()); }
+
+    static constexpr size_t chunkSize = size_t{1} << 16;
+    static constexpr size_t maxArraySize = 4096;
+    static constexpr size_t bitmapWords = chunkSize / 64;
+
+private:
+    struct Chunk {
+        enum class Type { Array, Bitmap, Run };
+
+        Chunk(size_t aKey = 0) : key{aKey} {}
+        bool contains(uint16_t low) const;
+        void toBitmap(uint64_t* words) const;
+        void setBitmap(std::vector<uint64_t> words);
+        void insert(uint16_t low);
+        void erase(uint16_t low);
+        void shrinkRuns();
+        size_t runCount() const;
+
+        size_t key;
+        Type type = Type::Array;
+        size_t cardinality = 0;
+        std::vector<uint16_t> array;
+        std::vector<uint64_t> bitmap;
+        std::vector<std::pair<uint16_t, uint16_t>> runs;  // inclusive [first, last]
+    };
+
+    Chunk* findChunk(size_t key);
+    const Chunk* findChunk(size_t key) const;
+    Chunk& getOrAddChunk(size_t key);
+
+    std::vector<Chunk> chunks_;  // sorted by key
+};
+
+template <typename InputIt>
+BitSet::BitSet(InputIt begin, InputIt end) {
+    insert(begin, end);
+}
+
+template <typename InputIt>
+void BitSet::insert(InputIt begin, InputIt end) {
+    for (auto it = begin; it != end; ++it) {
+        insert(static_cast<size_t>(*it));
+    }
+}
+
+inline BitSet operator|(BitSet lhs, const BitSet& rhs) { return lhs |= rhs; }
+inline BitSet operator&(BitSet lhs, const BitSet& rhs) { return lhs &= rhs; }
+inline BitSet operator-(BitSet lhs, const BitSet& rhs) { return lhs -= rhs; }
+
+}  // namespace inviwo
@@ -30,15 +30,18 @@
 #pragma once
 
 #include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
+#include <modules/brushingandlinking/datastructures/indexsnapshot.h>
 #include <inviwo/core/util/dispatcher.h>
 
 #include <unordered_map>
-#include <unordered_set>
 
 namespace inviwo {
 class BrushingAndLinkingInport;
 class BrushingAndLinkingManager;
 
+/**
+ * \brief Keeps the indices set by several sources and their union
+ */
 class IVW_MODULE_BRUSHINGANDLINKING_API IndexList {
 public:
     IndexList() = default;
@@ -46,22 +49,22 @@ public:
     size_t getSize() const;
     bool has(size_t idx) const;
 
-    void set(const BrushingAndLinkingInport *src, const std::unordered_set<size_t> &incices);
+    void set(const BrushingAndLinkingInport *src, const IndexSnapshot &indices);
     void remove(const BrushingAndLinkingInport *src);
 
     std::shared_ptr<std::function<void()>> onChange(std::function<void()> V);
 
     void update();
     void clear();
-    const std::unordered_set<size_t> &getIndices() const { return indices_; }
+    const BitSet &getIndices() const { return *indices_; }
+    const IndexSnapshot &getSnapshot() const { return indices_; }
 
 private:
-    std::unordered_map<const BrushingAndLinkingInport *, std::unordered_set<size_t>>
-        indicesBySource_;
-    std::unordered_set<size_t> indices_;
+    std::unordered_map<const BrushingAndLinkingInport *, IndexSnapshot> indicesBySource_;
+    IndexSnapshot indices_;
     Dispatcher<void()> onUpdate_;
 };
 
-inline bool IndexList::has(size_t idx) const { return indices_.find(idx) != indices_.end(); }
+inline bool IndexList::has(size_t idx) const { return indices_->contains(idx); }
 
 }  // namespace inviwo
@@ -0,0 +1,86 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
+#include <modules/brushingandlinking/datastructures/bitset.h>
+
+#include <memory>
+
+namespace inviwo {
+
+/**
+ * \brief An immutable, shared and versioned set of indices.
+ *
+ * Copying a snapshot only copies a pointer to the shared BitSet, which makes it possible to pass
+ * selections through events, ports and the BrushingAndLinkingManager without copying the
+ * indices. Every snapshot created from a BitSet gets a new unique version, a consumer can
+ * compare versions to see if a selection has changed and use util::delta to find the indices
+ * that were added or removed since the snapshot it saw last.
+ */
+class IVW_MODULE_BRUSHINGANDLINKING_API IndexSnapshot {
+public:
+    /**
+     * An empty snapshot, all empty snapshots created this way share version 0
+     */
+    IndexSnapshot();
+    explicit IndexSnapshot(BitSet indices);
+
+    const BitSet& get() const { return *indices_; }
+    const BitSet& operator*() const { return *indices_; }
+    const BitSet* operator->() const { return indices_.get(); }
+
+    size_t getVersion() const { return version_; }
+
+private:
+    std::shared_ptr<const BitSet> indices_;
+    size_t version_;
+};
+
+/**
+ * \brief The change between two sets of indices
+ */
+struct IVW_MODULE_BRUSHINGANDLINKING_API IndexDelta {
+    BitSet added;
+    BitSet removed;
+
+    bool empty() const { return added.empty() && removed.empty(); }
+};
+
+namespace util {
+
+/**
+ * The indices added and removed going from \p previous to \p current
+ */
+IVW_MODULE_BRUSHINGANDLINKING_API IndexDelta delta(const BitSet& previous, const BitSet& current);
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -30,11 +30,10 @@
 #pragma once
 
 #include <modules/brushingandlinking/brushingandlinkingmoduledefine.h>
+#include <modules/brushingandlinking/datastructures/indexsnapshot.h>
 #include <inviwo/core/interaction/events/event.h>
 #include <inviwo/core/util/constexprhash.h>
 
-#include <unordered_set>
-
 namespace inviwo {
 
 class BrushingAndLinkingInport;
@@ -43,15 +42,18 @@ class BrushingAndLinkingInport;
  */
 class IVW_MODULE_BRUSHINGANDLINKING_API BrushingAndLinkingEvent : public Event {
 public:
-    BrushingAndLinkingEvent(const BrushingAndLinkingInport* src,
-                            const std::unordered_set<size_t>& indices);
+    BrushingAndLinkingEvent(const BrushingAndLinkingInport* src, IndexSnapshot indices);
     virtual ~BrushingAndLinkingEvent() = default;
 
     virtual BrushingAndLinkingEvent* clone() const override;
 
     const BrushingAndLinkingInport* getSource() const;
 
-    const std::unordered_set<size_t>& getIndices() const;
+    const BitSet& getIndices() const;
+    /**
+     * The shared snapshot of the indices, can be kept or forwarded without copying the indices
+     */
+    const IndexSnapshot& getSnapshot() const;
 
     virtual uint64_t hash() const override;
     static constexpr uint64_t chash() {
@@ -65,7 +67,7 @@ protected:
 
 private:
     const BrushingAndLinkingInport* source_;
-    const std::unordered_set<size_t>& indices_;
+    IndexSnapshot indices_;
 };
 
 }  // namespace inviwo
@@ -49,26 +49,39 @@ public:
     BrushingAndLinkingInport(std::string identifier);
     virtual ~BrushingAndLinkingInport() = default;
 
-    void sendFilterEvent(const std::unordered_set<size_t> &indices);
+    /**
+     * Send the indices as a new snapshot, pass an rvalue to avoid copying the indices.
+     */
+    void sendFilterEvent(BitSet indices);
+    /**
+     * Send an existing snapshot, the indices are shared and not copied.
+     */
+    void sendFilterEvent(IndexSnapshot indices);
 
-    void sendSelectionEvent(const std::unordered_set<size_t> &indices);
+    void sendSelectionEvent(BitSet indices);
+    void sendSelectionEvent(IndexSnapshot indices);
 
-    void sendColumnSelectionEvent(const std::unordered_set<size_t> &indices);
+    void sendColumnSelectionEvent(BitSet indices);
+    void sendColumnSelectionEvent(IndexSnapshot indices);
 
     bool isFiltered(size_t idx) const;
     bool isSelected(size_t idx) const;
 
     bool isColumnSelected(size_t idx) const;
 
-    const std::unordered_set<size_t> &getSelectedIndices() const;
-    const std::unordered_set<size_t> &getFilteredIndices() const;
-    const std::unordered_set<size_t> &getSelectedColumns() const;
+    const BitSet &getSelectedIndices() const;
+    const BitSet &getFilteredIndices() const;
+    const BitSet &getSelectedColumns() const;
+
+    const IndexSnapshot &getSelectionSnapshot() const;
+    const IndexSnapshot &getFilterSnapshot() const;
+    const IndexSnapshot &getColumnSelectionSnapshot() const;
 
     virtual std::string getClassIdentifier() const override;
 
-    std::unordered_set<size_t> filterCache_;
-    std::unordered_set<size_t> selectionCache_;
-    std::unordered_set<size_t> selectionColumnCache_;
+    IndexSnapshot filterCache_;
+    IndexSnapshot selectionCache_;
+    IndexSnapshot selectionColumnCache_;
 };
 
 class IVW_MODULE_BRUSHINGANDLINKING_API BrushingAndLinkingOutport
@@ -111,7 +124,7 @@ inline bool BrushingAndLinkingInport::isFiltered(size_t idx) const {
     if (isConnected()) {
         return getData()->isFiltered(idx);
     } else {
-        return filterCache_.find(idx) != filterCache_.end();
+        return filterCache_->contains(idx);
     }
 }
 
@@ -119,7 +132,7 @@ inline bool BrushingAndLinkingInport::isSelected(size_t idx) const {
     if (isConnected()) {
         return getData()->isSelected(idx);
     } else {
-        return selectionCache_.find(idx) != selectionCache_.end();
+        return selectionCache_->contains(idx);
     }
 }
 
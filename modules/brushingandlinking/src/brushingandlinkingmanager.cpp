@@ -48,7 +48,7 @@ BrushingAndLinkingManager::BrushingAndLinkingManager(Processor* p,
 
 BrushingAndLinkingManager::~BrushingAndLinkingManager() {}
 
-size_t BrushingAndLinkingManager::getNumberOfSelected() const { return selected_.size(); }
+size_t BrushingAndLinkingManager::getNumberOfSelected() const { return selected_->size(); }
 
 size_t BrushingAndLinkingManager::getNumberOfFiltered() const { return filtered_.getSize(); }
 
@@ -57,47 +57,57 @@ void BrushingAndLinkingManager::remove(const BrushingAndLinkingInport* src) {
 }
 
 bool BrushingAndLinkingManager::isColumnSelected(size_t idx) const {
-    return selectedColumns_.find(idx) != selectedColumns_.end();
+    return selectedColumns_->contains(idx);
 }
 
 void BrushingAndLinkingManager::setSelected(const BrushingAndLinkingInport*,
-                                            const std::unordered_set<size_t>& indices) {
+                                            const IndexSnapshot& indices) {
+    if (indices.getVersion() == selected_.getVersion()) return;
     selected_ = indices;
     owner_->invalidate(invalidationLevel_);
 }
 
 void BrushingAndLinkingManager::clearSelected() {
-    selected_.clear();
+    selected_ = IndexSnapshot{};
     owner_->invalidate(invalidationLevel_);
 }
 
 void BrushingAndLinkingManager::setFiltered(const BrushingAndLinkingInport* src,
-                                            const std::unordered_set<size_t>& indices) {
+                                            const IndexSnapshot& indices) {
     filtered_.set(src, indices);
 }
 
 void BrushingAndLinkingManager::clearFiltered() { filtered_.clear(); }
 
 void BrushingAndLinkingManager::setSelectedColumn(const BrushingAndLinkingInport*,
-                                                  const std::unordered_set<size_t>& indices) {
+                                                  const IndexSnapshot& indices) {
+    if (indices.getVersion() == selectedColumns_.getVersion()) return;
     selectedColumns_ = indices;
     owner_->invalidate(invalidationLevel_);
 }
 
 void BrushingAndLinkingManager::clearColumns() {
-    selected_.clear();
+    selected_ = IndexSnapshot{};
     owner_->invalidate(invalidationLevel_);
 }
 
-const std::unordered_set<size_t>& BrushingAndLinkingManager::getSelectedIndices() const {
-    return selected_;
-}
+const BitSet& BrushingAndLinkingManager::getSelectedIndices() const { return *selected_; }
 
-const std::unordered_set<size_t>& BrushingAndLinkingManager::getFilteredIndices() const {
+const BitSet& BrushingAndLinkingManager::getFilteredIndices() const {
     return filtered_.getIndices();
 }
 
-const std::unordered_set<size_t>& BrushingAndLinkingManager::getSelectedColumns() const {
+const BitSet& BrushingAndLinkingManager::getSelectedColumns() const {
+    return *selectedColumns_;
+}
+
+const IndexSnapshot& BrushingAndLinkingManager::getSelectionSnapshot() const { return selected_; }
+
+const IndexSnapshot& BrushingAndLinkingManager::getFilterSnapshot() const {
+    return filtered_.getSnapshot();
+}
+
+const IndexSnapshot& BrushingAndLinkingManager::getColumnSelectionSnapshot() const {
     return selectedColumns_;
 }
 
@@ -0,0 +1,631 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/brushingandlinking/datastructures/bitset.h>
+#include <inviwo/core/util/stdextensions.h>
+
+#include <algorithm>
+#include <bitset>
+#include <limits>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace inviwo {
+
+namespace {
+
+constexpr uint64_t allBits = std::numeric_limits<uint64_t>::max();
+
+size_t popcount(uint64_t word) { return std::bitset<64>(word).count(); }
+
+size_t countTrailingZeros(uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<size_t>(index);
+#else
+    return static_cast<size_t>(__builtin_ctzll(word));
+#endif
+}
+
+// Set the bits [begin, end)
+void setBits(uint64_t* words, size_t begin, size_t end) {
+    if (begin >= end) return;
+    const size_t first = begin / 64;
+    const size_t last = (end - 1) / 64;
+    const uint64_t firstMask = allBits << (begin % 64);
+    const uint64_t lastMask = allBits >> (63 - (end - 1) % 64);
+    if (first == last) {
+        words[first] |= firstMask & lastMask;
+    } else {
+        words[first] |= firstMask;
+        std::fill(words + first + 1, words + last, allBits);
+        words[last] |= lastMask;
+    }
+}
+
+// The first set bit at or after pos, or BitSet::chunkSize if there is none
+size_t nextSetBit(const std::vector<uint64_t>& words, size_t pos) {
+    if (pos >= BitSet::chunkSize) return BitSet::chunkSize;
+    size_t w = pos / 64;
+    uint64_t word = words[w] & (allBits << (pos % 64));
+    while (word == 0) {
+        if (++w == BitSet::bitmapWords) return BitSet::chunkSize;
+        word = words[w];
+    }
+    return w * 64 + countTrailingZeros(word);
+}
+
+// The first unset bit at or after pos, or BitSet::chunkSize if there is none
+size_t nextUnsetBit(const std::vector<uint64_t>& words, size_t pos) {
+    if (pos >= BitSet::chunkSize) return BitSet::chunkSize;
+    size_t w = pos / 64;
+    uint64_t word = ~words[w] & (allBits << (pos % 64));
+    while (word == 0) {
+        if (++w == BitSet::bitmapWords) return BitSet::chunkSize;
+        word = ~words[w];
+    }
+    return w * 64 + countTrailingZeros(word);
+}
+
+using Runs = std::vector<std::pair<uint16_t, uint16_t>>;
+
+// The first run starting after low, the run before it is the only one that can contain low
+Runs::const_iterator runAfter(const Runs& runs, uint16_t low) {
+    return std::upper_bound(runs.begin(), runs.end(), low,
+                            [](uint16_t val, const auto& run) { return val < run.first; });
+}
+
+size_t runsCardinality(const Runs& runs) {
+    size_t sum = 0;
+    for (const auto& run : runs) sum += size_t{run.second} - run.first + 1;
+    return sum;
+}
+
+// Union of two sorted lists of runs, touching runs are joined
+Runs mergeRuns(const Runs& a, const Runs& b) {
+    Runs all;
+    all.reserve(a.size() + b.size());
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(all));
+    Runs res;
+    for (const auto& run : all) {
+        if (!res.empty() && size_t{run.first} <= size_t{res.back().second} + 1) {
+            res.back().second = std::max(res.back().second, run.second);
+        } else {
+            res.push_back(run);
+        }
+    }
+    return res;
+}
+
+Runs intersectRuns(const Runs& a, const Runs& b) {
+    Runs res;
+    auto ia = a.begin();
+    auto ib = b.begin();
+    while (ia != a.end() && ib != b.end()) {
+        const auto first = std::max(ia->first, ib->first);
+        const auto last = std::min(ia->second, ib->second);
+        if (first <= last) res.emplace_back(first, last);
+        if (ia->second < ib->second) {
+            ++ia;
+        } else {
+            ++ib;
+        }
+    }
+    return res;
+}
+
+// Call func(begin, end) for each range of consecutive offsets in the chunk
+template <typename Chunk, typename Func>
+void forEachChunkRange(const Chunk& chunk, Func func) {
+    switch (chunk.type) {
+        case Chunk::Type::Array: {
+            size_t begin = chunk.array.front();
+            size_t end = begin + 1;
+            for (auto it = chunk.array.begin() + 1; it != chunk.array.end(); ++it) {
+                if (*it != end) {
+                    func(begin, end);
+                    begin = *it;
+                }
+                end = size_t{*it} + 1;
+            }
+            func(begin, end);
+            break;
+        }
+        case Chunk::Type::Bitmap: {
+            size_t begin = nextSetBit(chunk.bitmap, 0);
+            while (begin < BitSet::chunkSize) {
+                const size_t end = nextUnsetBit(chunk.bitmap, begin);
+                func(begin, end);
+                begin = nextSetBit(chunk.bitmap, end);
+            }
+            break;
+        }
+        case Chunk::Type::Run:
+            for (const auto& run : chunk.runs) func(run.first, size_t{run.second} + 1);
+            break;
+    }
+}
+
+}  // namespace
+
+bool BitSet::Chunk::contains(uint16_t low) const {
+    switch (type) {
+        case Type::Array:
+            return std::binary_search(array.begin(), array.end(), low);
+        case Type::Bitmap:
+            return (bitmap[low / 64] >> (low % 64)) & 1;
+        case Type::Run: {
+            const auto it = runAfter(runs, low);
+            return it != runs.begin() && low <= std::prev(it)->second;
+        }
+    }
+    return false;
+}
+
+void BitSet::Chunk::toBitmap(uint64_t* words) const {
+    switch (type) {
+        case Type::Array:
+            for (auto low : array) words[low / 64] |= uint64_t{1} << (low % 64);
+            break;
+        case Type::Bitmap:
+            for (size_t i = 0; i < bitmapWords; ++i) words[i] |= bitmap[i];
+            break;
+        case Type::Run:
+            for (const auto& run : runs) setBits(words, run.first, size_t{run.second} + 1);
+            break;
+    }
+}
+
+void BitSet::Chunk::setBitmap(std::vector<uint64_t> words) {
+    cardinality = 0;
+    for (auto word : words) cardinality += popcount(word);
+    array.clear();
+    runs.clear();
+    if (cardinality <= maxArraySize) {
+        type = Type::Array;
+        array.reserve(cardinality);
+        for (size_t w = 0; w < bitmapWords; ++w) {
+            for (uint64_t word = words[w]; word != 0; word &= word - 1) {
+                array.push_back(static_cast<uint16_t>(w * 64 + countTrailingZeros(word)));
+            }
+        }
+        bitmap = std::vector<uint64_t>{};
+    } else {
+        type = Type::Bitmap;
+        bitmap = std::move(words);
+    }
+}
+
+void BitSet::Chunk::insert(uint16_t low) {
+    switch (type) {
+        case Type::Array: {
+            auto it = std::lower_bound(array.begin(), array.end(), low);
+            if (it != array.end() && *it == low) return;
+            if (array.size() < maxArraySize) {
+                array.insert(it, low);
+                ++cardinality;
+                return;
+            }
+            break;
+        }
+        case Type::Bitmap: {
+            const uint64_t bit = uint64_t{1} << (low % 64);
+            if (!(bitmap[low / 64] & bit)) {
+                bitmap[low / 64] |= bit;
+                ++cardinality;
+            }
+            return;
+        }
+        case Type::Run:
+            if (contains(low)) return;
+            runs = mergeRuns(runs, {{low, low}});
+            ++cardinality;
+            shrinkRuns();
+            return;
+    }
+    std::vector<uint64_t> words(bitmapWords, 0);
+    toBitmap(words.data());
+    words[low / 64] |= uint64_t{1} << (low % 64);
+    setBitmap(std::move(words));
+}
+
+void BitSet::Chunk::erase(uint16_t low) {
+    switch (type) {
+        case Type::Array: {
+            auto it = std::lower_bound(array.begin(), array.end(), low);
+            if (it != array.end() && *it == low) {
+                array.erase(it);
+                --cardinality;
+            }
+            return;
+        }
+        case Type::Bitmap: {
+            const uint64_t bit = uint64_t{1} << (low % 64);
+            if (bitmap[low / 64] & bit) {
+                bitmap[low / 64] &= ~bit;
+                if (--cardinality <= maxArraySize) setBitmap(std::move(bitmap));
+            }
+            return;
+        }
+        case Type::Run: {
+            const auto it = runs.begin() + std::distance(runs.cbegin(), runAfter(runs, low));
+            if (it == runs.begin() || low > std::prev(it)->second) return;
+            const auto run = std::prev(it);
+            if (run->first == run->second) {
+                runs.erase(run);
+            } else if (run->first == low) {
+                ++run->first;
+            } else if (run->second == low) {
+                --run->second;
+            } else {
+                const auto last = run->second;
+                run->second = static_cast<uint16_t>(low - 1);
+                runs.insert(it, {static_cast<uint16_t>(low + 1), last});
+            }
+            --cardinality;
+            shrinkRuns();
+            return;
+        }
+    }
+}
+
+void BitSet::Chunk::shrinkRuns() {
+    // Switch to an array or a bitmap when the runs use more memory
+    const size_t otherBytes = cardinality <= maxArraySize ? 2 * cardinality : 8 * bitmapWords;
+    if (4 * runs.size() > otherBytes) {
+        std::vector<uint64_t> words(bitmapWords, 0);
+        toBitmap(words.data());
+        setBitmap(std::move(words));
+    }
+}
+
+size_t BitSet::Chunk::runCount() const {
+    size_t count = 0;
+    forEachChunkRange(*this, [&](size_t, size_t) { ++count; });
+    return count;
+}
+
+BitSet::BitSet(std::initializer_list<size_t> indices) { insert(indices.begin(), indices.end()); }
+
+BitSet::BitSet(const std::unordered_set<size_t>& indices) {
+    // Insert in order to append to the containers
+    std::vector<size_t> sorted(indices.begin(), indices.end());
+    std::sort(sorted.begin(), sorted.end());
+    insert(sorted.begin(), sorted.end());
+}
+
+auto BitSet::findChunk(size_t key) -> Chunk* {
+    auto it = std::lower_bound(chunks_.begin(), chunks_.end(), key,
+                               [](const Chunk& chunk, size_t k) { return chunk.key < k; });
+    return it != chunks_.end() && it->key == key ? &*it : nullptr;
+}
+
+auto BitSet::findChunk(size_t key) const -> const Chunk* {
+    return const_cast<BitSet*>(this)->findChunk(key);
+}
+
+auto BitSet::getOrAddChunk(size_t key) -> Chunk& {
+    // Fast path for inserting in increasing order
+    if (!chunks_.empty() && chunks_.back().key == key) return chunks_.back();
+    auto it = std::lower_bound(chunks_.begin(), chunks_.end(), key,
+                               [](const Chunk& chunk, size_t k) { return chunk.key < k; });
+    if (it != chunks_.end() && it->key == key) return *it;
+    return *chunks_.insert(it, Chunk{key});
+}
+
+size_t BitSet::size() const {
+    size_t sum = 0;
+    for (const auto& chunk : chunks_) sum += chunk.cardinality;
+    return sum;
+}
+
+bool BitSet::contains(size_t idx) const {
+    const auto chunk = findChunk(idx / chunkSize);
+    return chunk && chunk->contains(static_cast<uint16_t>(idx % chunkSize));
+}
+
+void BitSet::insert(size_t idx) {
+    getOrAddChunk(idx / chunkSize).insert(static_cast<uint16_t>(idx % chunkSize));
+}
+
+void BitSet::insertRange(size_t begin, size_t end) {
+    if (begin >= end) return;
+    for (size_t key = begin / chunkSize; key <= (end - 1) / chunkSize; ++key) {
+        const size_t base = key * chunkSize;
+        const size_t lo = std::max(begin, base) - base;
+        const size_t hi = std::min(end, base + chunkSize) - base;
+        const Runs run{{static_cast<uint16_t>(lo), static_cast<uint16_t>(hi - 1)}};
+
+        auto& chunk = getOrAddChunk(key);
+        if (chunk.cardinality == 0 || chunk.type == Chunk::Type::Run || hi - lo == chunkSize) {
+            chunk.runs = chunk.cardinality == 0 || hi - lo == chunkSize
+                             ? run
+                             : mergeRuns(chunk.runs, run);
+            chunk.type = Chunk::Type::Run;
+            chunk.cardinality = runsCardinality(chunk.runs);
+            chunk.array = std::vector<uint16_t>{};
+            chunk.bitmap = std::vector<uint64_t>{};
+        } else {
+            std::vector<uint64_t> words(bitmapWords, 0);
+            chunk.toBitmap(words.data());
+            setBits(words.data(), lo, hi);
+            chunk.setBitmap(std::move(words));
+        }
+    }
+}
+
+void BitSet::erase(size_t idx) {
+    const size_t key = idx / chunkSize;
+    if (auto chunk = findChunk(key)) {
+        chunk->erase(static_cast<uint16_t>(idx % chunkSize));
+        if (chunk->cardinality == 0) {
+            chunks_.erase(chunks_.begin() + std::distance(chunks_.data(), chunk));
+        }
+    }
+}
+
+BitSet& BitSet::operator|=(const BitSet& rhs) {
+    std::vector<Chunk> res;
+    res.reserve(chunks_.size() + rhs.chunks_.size());
+    auto a = chunks_.begin();
+    auto b = rhs.chunks_.begin();
+    while (a != chunks_.end() || b != rhs.chunks_.end()) {
+        if (b == rhs.chunks_.end() || (a != chunks_.end() && a->key < b->key)) {
+            res.push_back(std::move(*a++));
+        } else if (a == chunks_.end() || b->key < a->key) {
+            res.push_back(*b++);
+        } else {
+            Chunk& chunk = *a;
+            if (chunk.type == Chunk::Type::Run && b->type == Chunk::Type::Run) {
+                chunk.runs = mergeRuns(chunk.runs, b->runs);
+                chunk.cardinality = runsCardinality(chunk.runs);
+            } else if (chunk.type == Chunk::Type::Array && b->type == Chunk::Type::Array &&
+                       chunk.cardinality + b->cardinality <= maxArraySize) {
+                std::vector<uint16_t> merged;
+                merged.reserve(chunk.cardinality + b->cardinality);
+                std::set_union(chunk.array.begin(), chunk.array.end(), b->array.begin(),
+                               b->array.end(), std::back_inserter(merged));
+                chunk.array = std::move(merged);
+                chunk.cardinality = chunk.array.size();
+            } else {
+                std::vector<uint64_t> words(bitmapWords, 0);
+                chunk.toBitmap(words.data());
+                b->toBitmap(words.data());
+                chunk.setBitmap(std::move(words));
+            }
+            res.push_back(std::move(chunk));
+            ++a;
+            ++b;
+        }
+    }
+    chunks_ = std::move(res);
+    return *this;
+}
+
+BitSet& BitSet::operator&=(const BitSet& rhs) {
+    std::vector<Chunk> res;
+    auto b = rhs.chunks_.begin();
+    for (auto& chunk : chunks_) {
+        while (b != rhs.chunks_.end() && b->key < chunk.key) ++b;
+        if (b == rhs.chunks_.end()) break;
+        if (b->key != chunk.key) continue;
+
+        if (chunk.type == Chunk::Type::Array) {
+            util::erase_remove_if(chunk.array, [&](uint16_t low) { return !b->contains(low); });
+            chunk.cardinality = chunk.array.size();
+        } else if (b->type == Chunk::Type::Array) {
+            std::vector<uint16_t> array;
+            std::copy_if(b->array.begin(), b->array.end(), std::back_inserter(array),
+                         [&](uint16_t low) { return chunk.contains(low); });
+            chunk.type = Chunk::Type::Array;
+            chunk.array = std::move(array);
+            chunk.cardinality = chunk.array.size();
+            chunk.bitmap = std::vector<uint64_t>{};
+            chunk.runs.clear();
+        } else if (chunk.type == Chunk::Type::Run && b->type == Chunk::Type::Run) {
+            chunk.runs = intersectRuns(chunk.runs, b->runs);
+            chunk.cardinality = runsCardinality(chunk.runs);
+        } else {
+            std::vector<uint64_t> words(bitmapWords, 0);
+            std::vector<uint64_t> other(bitmapWords, 0);
+            chunk.toBitmap(words.data());
+            b->toBitmap(other.data());
+            for (size_t i = 0; i < bitmapWords; ++i) words[i] &= other[i];
+            chunk.setBitmap(std::move(words));
+        }
+        if (chunk.cardinality > 0) res.push_back(std::move(chunk));
+    }
+    chunks_ = std::move(res);
+    return *this;
+}
+
+BitSet& BitSet::operator-=(const BitSet& rhs) {
+    auto b = rhs.chunks_.begin();
+    for (auto& chunk : chunks_) {
+        while (b != rhs.chunks_.end() && b->key < chunk.key) ++b;
+        if (b == rhs.chunks_.end()) break;
+        if (b->key != chunk.key) continue;
+
+        if (chunk.type == Chunk::Type::Array) {
+            util::erase_remove_if(chunk.array, [&](uint16_t low) { return b->contains(low); });
+            chunk.cardinality = chunk.array.size();
+        } else {
+            std::vector<uint64_t> words(bitmapWords, 0);
+            std::vector<uint64_t> other(bitmapWords, 0);
+            chunk.toBitmap(words.data());
+            b->toBitmap(other.data());
+            for (size_t i = 0; i < bitmapWords; ++i) words[i] &= ~other[i];
+            chunk.setBitmap(std::move(words));
+        }
+    }
+    util::erase_remove_if(chunks_, [](const Chunk& chunk) { return chunk.cardinality == 0; });
+    return *this;
+}
+
+bool BitSet::operator==(const BitSet& rhs) const {
+    return size() == rhs.size() && std::equal(begin(), end(), rhs.begin());
+}
+
+void BitSet::runOptimize() {
+    for (auto& chunk : chunks_) {
+        const size_t runBytes = 4 * chunk.runCount();
+        const size_t otherBytes =
+            chunk.cardinality <= maxArraySize ? 2 * chunk.cardinality : 8 * bitmapWords;
+        if (runBytes < otherBytes && chunk.type != Chunk::Type::Run) {
+            Runs runs;
+            forEachChunkRange(chunk, [&](size_t begin, size_t end) {
+                runs.emplace_back(static_cast<uint16_t>(begin), static_cast<uint16_t>(end - 1));
+            });
+            chunk.type = Chunk::Type::Run;
+            chunk.runs = std::move(runs);
+            chunk.array = std::vector<uint16_t>{};
+            chunk.bitmap = std::vector<uint64_t>{};
+        } else if (runBytes >= otherBytes && chunk.type == Chunk::Type::Run) {
+            std::vector<uint64_t> words(bitmapWords, 0);
+            chunk.toBitmap(words.data());
+            chunk.setBitmap(std::move(words));
+        }
+    }
+}
+
+void BitSet::forEachRange(const std::function<void(size_t, size_t)>& func) const {
+    // Join ranges that continue across chunk boundaries
+    size_t begin = 0;
+    size_t end = 0;
+    for (const auto& chunk : chunks_) {
+        const size_t base = chunk.key * chunkSize;
+        forEachChunkRange(chunk, [&](size_t lo, size_t hi) {
+            if (end != begin && end == base + lo) {
+                end = base + hi;
+            } else {
+                if (end != begin) func(begin, end);
+                begin = base + lo;
+                end = base + hi;
+            }
+        });
+    }
+    if (end != begin) func(begin, end);
+}
+
+size_t BitSet::getContainerSizeInBytes() const {
+    size_t bytes = 0;
+    for (const auto& chunk : chunks_) {
+        bytes += chunk.array.size() * sizeof(uint16_t) + chunk.bitmap.size() * sizeof(uint64_t) +
+                 chunk.runs.size() * sizeof(std::pair<uint16_t, uint16_t>);
+    }
+    return bytes;
+}
+
+std::vector<size_t> BitSet::toVector() const {
+    std::vector<size_t> res;
+    res.reserve(size());
+    forEachRange([&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) res.push_back(i);
+    });
+    return res;
+}
+
+std::unordered_set<size_t> BitSet::toUnorderedSet() const {
+    std::unordered_set<size_t> res;
+    res.reserve(size());
+    forEachRange([&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) res.insert(i);
+    });
+    return res;
+}
+
+BitSet::const_iterator::const_iterator(const BitSet* set, size_t chunk)
+    : set_{set}, chunk_{chunk} {
+    if (chunk_ < set_->chunks_.size()) first();
+}
+
+void BitSet::const_iterator::first() {
+    const auto& chunk = set_->chunks_[chunk_];
+    const size_t base = chunk.key * chunkSize;
+    pos_ = 0;
+    switch (chunk.type) {
+        case Chunk::Type::Array:
+            value_ = base + chunk.array.front();
+            break;
+        case Chunk::Type::Bitmap:
+            value_ = base + nextSetBit(chunk.bitmap, 0);
+            break;
+        case Chunk::Type::Run:
+            value_ = base + chunk.runs.front().first;
+            break;
+    }
+}
+
+auto BitSet::const_iterator::operator++() -> const_iterator& {
+    const auto& chunk = set_->chunks_[chunk_];
+    const size_t base = chunk.key * chunkSize;
+    const size_t low = value_ - base;
+    switch (chunk.type) {
+        case Chunk::Type::Array:
+            if (++pos_ < chunk.array.size()) {
+                value_ = base + chunk.array[pos_];
+                return *this;
+            }
+            break;
+        case Chunk::Type::Bitmap: {
+            const size_t next = nextSetBit(chunk.bitmap, low + 1);
+            if (next < chunkSize) {
+                value_ = base + next;
+                return *this;
+            }
+            break;
+        }
+        case Chunk::Type::Run:
+            if (low < chunk.runs[pos_].second) {
+                ++value_;
+                return *this;
+            } else if (++pos_ < chunk.runs.size()) {
+                value_ = base + chunk.runs[pos_].first;
+                return *this;
+            }
+            break;
+    }
+    if (++chunk_ < set_->chunks_.size()) {
+        first();
+    } else {
+        value_ = 0;
+    }
+    return *this;
+}
+
+auto BitSet::const_iterator::operator++(int) -> const_iterator {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+}
+
+}  // namespace inviwo
@@ -32,10 +32,9 @@
 
 namespace inviwo {
 
-size_t IndexList::getSize() const { return indices_.size(); }
+size_t IndexList::getSize() const { return indices_->size(); }
 
-void IndexList::set(const BrushingAndLinkingInport *src,
-                    const std::unordered_set<size_t> &indices) {
+void IndexList::set(const BrushingAndLinkingInport *src, const IndexSnapshot &indices) {
     indicesBySource_[src] = indices;
     update();
 }
@@ -50,23 +49,29 @@ std::shared_ptr<std::function<void()>> IndexList::onChange(std::function<void()>
 }
 
 void IndexList::update() {
-    indices_.clear();
-
-    using T = std::unordered_map<const BrushingAndLinkingInport *,
-                                 std::unordered_set<size_t>>::value_type;
+    using T = std::unordered_map<const BrushingAndLinkingInport *, IndexSnapshot>::value_type;
     util::map_erase_remove_if(indicesBySource_, [](const T &p) {
         return !p.first->isConnected() ||
-               p.second.empty();  // remove if port is disconnected or if the set is empty
+               p.second->empty();  // remove if port is disconnected or if the set is empty
     });
 
-    for (auto p : indicesBySource_) {
-        indices_.insert(p.second.begin(), p.second.end());
+    if (indicesBySource_.empty()) {
+        indices_ = IndexSnapshot{};
+    } else if (indicesBySource_.size() == 1) {
+        // Share the snapshot of the only source, no need to copy it
+        indices_ = indicesBySource_.begin()->second;
+    } else {
+        BitSet indices;
+        for (const auto &p : indicesBySource_) {
+            indices |= *p.second;
+        }
+        indices_ = IndexSnapshot{std::move(indices)};
     }
     onUpdate_.invoke();
 }
 
 void IndexList::clear() {
-    indices_.clear();
+    indices_ = IndexSnapshot{};
     update();
 }
 
@@ -32,13 +32,12 @@
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/interaction/events/eventutil.h>
 
-#include <algorithm>
 
 namespace inviwo {
 
 BrushingAndLinkingEvent::BrushingAndLinkingEvent(const BrushingAndLinkingInport* src,
-                                                 const std::unordered_set<size_t>& indices)
-    : source_(src), indices_(indices) {}
+                                                 IndexSnapshot indices)
+    : source_(src), indices_(std::move(indices)) {}
 
 BrushingAndLinkingEvent* BrushingAndLinkingEvent::clone() const {
     return new BrushingAndLinkingEvent(*this);
@@ -48,7 +47,9 @@ const inviwo::BrushingAndLinkingInport* BrushingAndLinkingEvent::getSource() con
     return source_;
 }
 
-const std::unordered_set<size_t>& BrushingAndLinkingEvent::getIndices() const { return indices_; }
+const BitSet& BrushingAndLinkingEvent::getIndices() const { return *indices_; }
+
+const IndexSnapshot& BrushingAndLinkingEvent::getSnapshot() const { return indices_; }
 
 uint64_t BrushingAndLinkingEvent::hash() const { return chash(); }
 
@@ -59,13 +60,15 @@ void BrushingAndLinkingEvent::print(std::ostream& os) const {
 void BrushingAndLinkingEvent::printEvent(const std::string& eventType, std::ostream& os) const {
     using namespace std::string_literals;
 
-    std::vector<size_t> indices(indices_.begin(), indices_.end());
-    std::sort(indices.begin(), indices.end());
     const std::string indicesStr = [&]() -> std::string {
-        if (indices.empty()) return "none"s;
-        std::string str = joinString(indices.begin(),
-                                     indices.begin() + std::min<size_t>(indices.size(), 10), ", ");
-        if (indices_.size() > 10) {
+        if (indices_->empty()) return "none"s;
+        // The indices are already sorted, only look at the first ten
+        std::vector<size_t> indices;
+        for (auto it = indices_->begin(); it != indices_->end() && indices.size() < 10; ++it) {
+            indices.push_back(*it);
+        }
+        std::string str = joinString(indices.begin(), indices.end(), ", ");
+        if (indices_->size() > 10) {
             str.append("...");
         }
         return str;
@@ -32,8 +32,8 @@
 namespace inviwo {
 
 ColumnSelectionEvent::ColumnSelectionEvent(const BrushingAndLinkingInport* src,
-                                           const std::unordered_set<size_t>& indices)
-    : BrushingAndLinkingEvent(src, indices) {}
+                                           IndexSnapshot indices)
+    : BrushingAndLinkingEvent(src, std::move(indices)) {}
 
 void ColumnSelectionEvent::print(std::ostream& os) const { printEvent("ColumnSelectionEvent", os); }
 
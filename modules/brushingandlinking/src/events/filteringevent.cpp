@@ -31,9 +31,8 @@
 
 namespace inviwo {
 
-FilteringEvent::FilteringEvent(const BrushingAndLinkingInport* src,
-                               const std::unordered_set<size_t>& indices)
-    : BrushingAndLinkingEvent(src, indices) {}
+FilteringEvent::FilteringEvent(const BrushingAndLinkingInport* src, IndexSnapshot indices)
+    : BrushingAndLinkingEvent(src, std::move(indices)) {}
 
 void FilteringEvent::print(std::ostream& os) const { printEvent("FilteringEvent", os); }
 
@@ -31,9 +31,8 @@
 
 namespace inviwo {
 
-SelectionEvent::SelectionEvent(const BrushingAndLinkingInport* src,
-                               const std::unordered_set<size_t>& indices)
-    : BrushingAndLinkingEvent(src, indices) {}
+SelectionEvent::SelectionEvent(const BrushingAndLinkingInport* src, IndexSnapshot indices)
+    : BrushingAndLinkingEvent(src, std::move(indices)) {}
 
 void SelectionEvent::print(std::ostream& os) const { printEvent("SelectionEvent", os); }
 
@@ -41,35 +41,47 @@ BrushingAndLinkingInport::BrushingAndLinkingInport(std::string identifier)
     });
 }
 
-void BrushingAndLinkingInport::sendFilterEvent(const std::unordered_set<size_t> &indices) {
-    if (filterCache_.size() == 0 && indices.size() == 0) return;
-    filterCache_ = indices;
+void BrushingAndLinkingInport::sendFilterEvent(BitSet indices) {
+    sendFilterEvent(IndexSnapshot{std::move(indices)});
+}
+
+void BrushingAndLinkingInport::sendFilterEvent(IndexSnapshot indices) {
+    if (filterCache_->empty() && indices->empty()) return;
+    filterCache_ = std::move(indices);
     FilteringEvent event(this, filterCache_);
     propagateEvent(&event, nullptr);
 }
 
-void BrushingAndLinkingInport::sendSelectionEvent(const std::unordered_set<size_t> &indices) {
+void BrushingAndLinkingInport::sendSelectionEvent(BitSet indices) {
+    sendSelectionEvent(IndexSnapshot{std::move(indices)});
+}
+
+void BrushingAndLinkingInport::sendSelectionEvent(IndexSnapshot indices) {
     bool noRemoteSelections = false;
     if (isConnected() && hasData()) {
         noRemoteSelections = getData()->getSelectedIndices().empty();
     }
-    if (selectionCache_.empty() && indices.empty() && noRemoteSelections) {
+    if (selectionCache_->empty() && indices->empty() && noRemoteSelections) {
         return;
     }
-    selectionCache_ = indices;
+    selectionCache_ = std::move(indices);
     SelectionEvent event(this, selectionCache_);
     propagateEvent(&event, nullptr);
 }
 
-void BrushingAndLinkingInport::sendColumnSelectionEvent(const std::unordered_set<size_t> &indices) {
+void BrushingAndLinkingInport::sendColumnSelectionEvent(BitSet indices) {
+    sendColumnSelectionEvent(IndexSnapshot{std::move(indices)});
+}
+
+void BrushingAndLinkingInport::sendColumnSelectionEvent(IndexSnapshot indices) {
     bool noRemoteSelections = false;
     if (isConnected() && hasData()) {
         noRemoteSelections = getData()->getSelectedColumns().empty();
     }
-    if (selectionColumnCache_.empty() && indices.empty() && noRemoteSelections) {
+    if (selectionColumnCache_->empty() && indices->empty() && noRemoteSelections) {
         return;
     }
-    selectionColumnCache_ = indices;
+    selectionColumnCache_ = std::move(indices);
     ColumnSelectionEvent event(this, selectionColumnCache_);
     propagateEvent(&event, nullptr);
 }
@@ -78,29 +90,53 @@ bool BrushingAndLinkingInport::isColumnSelected(size_t idx) const {
     if (isConnected()) {
         return getData()->isColumnSelected(idx);
     } else {
-        return selectionColumnCache_.find(idx) != selectionColumnCache_.end();
+        return selectionColumnCache_->contains(idx);
     }
 }
 
-const std::unordered_set<size_t> &BrushingAndLinkingInport::getSelectedIndices() const {
+const BitSet &BrushingAndLinkingInport::getSelectedIndices() const {
     if (isConnected()) {
         return getData()->getSelectedIndices();
     } else {
-        return selectionCache_;
+        return *selectionCache_;
     }
 }
 
-const std::unordered_set<size_t> &BrushingAndLinkingInport::getFilteredIndices() const {
+const BitSet &BrushingAndLinkingInport::getFilteredIndices() const {
     if (isConnected()) {
         return getData()->getFilteredIndices();
     } else {
-        return filterCache_;
+        return *filterCache_;
     }
 }
 
-const std::unordered_set<size_t> &BrushingAndLinkingInport::getSelectedColumns() const {
+const BitSet &BrushingAndLinkingInport::getSelectedColumns() const {
     if (isConnected()) {
         return getData()->getSelectedColumns();
+    } else {
+        return *selectionColumnCache_;
+    }
+}
+
+const IndexSnapshot &BrushingAndLinkingInport::getSelectionSnapshot() const {
+    if (isConnected()) {
+        return getData()->getSelectionSnapshot();
+    } else {
+        return selectionCache_;
+    }
+}
+
+const IndexSnapshot &BrushingAndLinkingInport::getFilterSnapshot() const {
+    if (isConnected()) {
+        return getData()->getFilterSnapshot();
+    } else {
+        return filterCache_;
+    }
+}
+
+const IndexSnapshot &BrushingAndLinkingInport::getColumnSelectionSnapshot() const {
+    if (isConnected()) {
+        return getData()->getColumnSelectionSnapshot();
     } else {
         return selectionColumnCache_;
     }
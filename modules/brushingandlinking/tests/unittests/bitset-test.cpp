@@ -0,0 +1,144 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/brushingandlinking/datastructures/bitset.h>
+
+#include <set>
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<std::pair<size_t, size_t>> ranges(const BitSet& bs) {
+    std::vector<std::pair<size_t, size_t>> res;
+    bs.forEachRange([&](size_t begin, size_t end) { res.emplace_back(begin, end); });
+    return res;
+}
+
+}  // namespace
+
+TEST(BitSet, InsertErase) {
+    BitSet bs{5, 3, 70000, 3};
+    EXPECT_EQ(3u, bs.size());
+    EXPECT_TRUE(bs.contains(3));
+    EXPECT_TRUE(bs.contains(70000));
+    EXPECT_FALSE(bs.contains(4));
+    EXPECT_EQ(std::vector<size_t>({3, 5, 70000}), bs.toVector());
+
+    bs.erase(5);
+    bs.erase(6);
+    EXPECT_EQ(std::vector<size_t>({3, 70000}), std::vector<size_t>(bs.begin(), bs.end()));
+
+    bs.erase(3);
+    bs.erase(70000);
+    EXPECT_TRUE(bs.empty());
+    EXPECT_EQ(bs.begin(), bs.end());
+}
+
+TEST(BitSet, Ranges) {
+    BitSet bs;
+    bs.insertRange(10, 200000);
+    bs.insert(5);
+    bs.insert(200000);
+    EXPECT_EQ(199991u + 1u, bs.size());
+    EXPECT_EQ((std::vector<std::pair<size_t, size_t>>{{5, 6}, {10, 200001}}), ranges(bs));
+
+    // A full chunk and the runs are much smaller than the bitmaps
+    EXPECT_LT(bs.getContainerSizeInBytes(), 100u);
+
+    bs.erase(100000);
+    EXPECT_EQ((std::vector<std::pair<size_t, size_t>>{{5, 6}, {10, 100000}, {100001, 200001}}),
+              ranges(bs));
+    EXPECT_FALSE(bs.contains(100000));
+    EXPECT_TRUE(bs.contains(99999));
+}
+
+TEST(BitSet, SetOperations) {
+    const BitSet a{1, 2, 3, 100000};
+    BitSet b;
+    b.insertRange(2, 70000);
+
+    EXPECT_EQ(BitSet({1, 100000}), a - b);
+    EXPECT_EQ(BitSet({2, 3}), a & b);
+
+    auto u = a | b;
+    EXPECT_EQ(70000u, u.size());
+    EXPECT_EQ((std::vector<std::pair<size_t, size_t>>{{1, 70000}, {100000, 100001}}), ranges(u));
+}
+
+TEST(BitSet, Random) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> dist(0, 300000);
+
+    for (int iter = 0; iter < 10; ++iter) {
+        BitSet a;
+        BitSet b;
+        std::set<size_t> sa;
+        std::set<size_t> sb;
+        for (int i = 0; i < 20000; ++i) {
+            const auto va = dist(rng);
+            a.insert(va);
+            sa.insert(va);
+            // Denser values for b to get bitmap containers
+            const auto vb = dist(rng) / 4;
+            b.insert(vb);
+            sb.insert(vb);
+        }
+        const auto begin = dist(rng);
+        const auto end = begin + dist(rng) / 2;
+        b.insertRange(begin, end);
+        for (auto i = begin; i < end; ++i) sb.insert(i);
+        if (iter % 2 == 0) b.runOptimize();
+
+        EXPECT_EQ(sa, std::set<size_t>(a.begin(), a.end()));
+        EXPECT_EQ(sb, std::set<size_t>(b.begin(), b.end()));
+        EXPECT_EQ(sb.size(), b.size());
+
+        std::set<size_t> su = sa;
+        su.insert(sb.begin(), sb.end());
+        const auto u = a | b;
+        EXPECT_EQ(su, std::set<size_t>(u.begin(), u.end()));
+
+        std::set<size_t> si;
+        std::set<size_t> sd;
+        for (auto v : sa) (sb.count(v) ? si : sd).insert(v);
+        const auto i = a & b;
+        const auto d = a - b;
+        EXPECT_EQ(si, std::set<size_t>(i.begin(), i.end()));
+        EXPECT_EQ(sd, std::set<size_t>(d.begin(), d.end()));
+    }
+}
+
+}  // namespace inviwo
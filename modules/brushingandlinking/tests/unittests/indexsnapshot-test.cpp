@@ -0,0 +1,68 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/brushingandlinking/datastructures/indexsnapshot.h>
+
+namespace inviwo {
+
+TEST(IndexSnapshot, SharedAndVersioned) {
+    const IndexSnapshot empty;
+    EXPECT_EQ(0u, empty.getVersion());
+    EXPECT_TRUE(empty->empty());
+
+    const IndexSnapshot a{BitSet{1, 2, 3}};
+    const IndexSnapshot b{BitSet{1, 2, 3}};
+    EXPECT_NE(0u, a.getVersion());
+    EXPECT_NE(a.getVersion(), b.getVersion());
+    EXPECT_EQ(*a, *b);
+
+    const IndexSnapshot copy = a;
+    EXPECT_EQ(a.getVersion(), copy.getVersion());
+    EXPECT_EQ(&a.get(), &copy.get());
+}
+
+TEST(IndexSnapshot, Delta) {
+    const IndexSnapshot prev{BitSet{1, 2, 3, 100000}};
+    const IndexSnapshot next{BitSet{2, 3, 4, 5}};
+
+    const auto delta = util::delta(*prev, *next);
+    EXPECT_FALSE(delta.empty());
+    EXPECT_EQ(BitSet({4, 5}), delta.added);
+    EXPECT_EQ(BitSet({1, 100000}), delta.removed);
+
+    EXPECT_TRUE(util::delta(*next, *next).empty());
+    EXPECT_EQ(*prev, util::delta(BitSet{}, *prev).added);
+}
+
+}  // namespace inviwo
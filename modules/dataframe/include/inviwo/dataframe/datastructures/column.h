@@ -38,6 +38,10 @@
 #include <inviwo/core/util/exception.h>
 
 #include <inviwo/dataframe/datastructures/datapoint.h>
+#include <inviwo/dataframe/datastructures/columnstatistics.h>
+
+#include <memory>
+#include <mutex>
 
 namespace inviwo {
 
@@ -80,8 +84,23 @@ public:
     virtual std::string getAsString(size_t idx) const = 0;
     virtual std::shared_ptr<DataPointBase> get(size_t idx, bool getStringsAsStrings) const = 0;
 
+    /**
+     * Statistics of all values in the column. They are computed in parallel on first use and
+     * then shared by all callers until the column is modified. Any non-const access to the
+     * buffer counts as a modification, changes made later through a buffer obtained earlier are
+     * not detected.
+     */
+    std::shared_ptr<const ColumnStatistics> getStatistics() const;
+
 protected:
     Column() = default;
+
+    void invalidateStatistics();
+    virtual ColumnStatistics computeStatistics() const;
+
+private:
+    mutable std::mutex statisticsMutex_;
+    mutable std::shared_ptr<const ColumnStatistics> statistics_;
 };
 
 /**
@@ -155,8 +174,14 @@ public:
 
     virtual size_t getSize() const override;
 
-    auto begin() { return buffer_->getEditableRAMRepresentation()->getDataContainer().begin(); }
-    auto end() { return buffer_->getEditableRAMRepresentation()->getDataContainer().end(); }
+    auto begin() {
+        invalidateStatistics();
+        return buffer_->getEditableRAMRepresentation()->getDataContainer().begin();
+    }
+    auto end() {
+        invalidateStatistics();
+        return buffer_->getEditableRAMRepresentation()->getDataContainer().end();
+    }
     auto begin() const { return buffer_->getRAMRepresentation()->getDataContainer().begin(); }
     auto end() const { return buffer_->getRAMRepresentation()->getDataContainer().end(); }
 
@@ -180,6 +205,17 @@ protected:
 class IVW_MODULE_DATAFRAME_API CategoricalColumn : public TemplateColumn<std::uint32_t> {
 public:
     CategoricalColumn(const std::string &header);
+    /**
+     * Create a column from already mapped values, every value in \p data has to be an index into
+     * \p categories.
+     */
+    CategoricalColumn(const std::string &header, std::vector<std::uint32_t> data,
+                      std::vector<std::string> categories);
+    /**
+     * Create a column from a buffer of already mapped values, see above.
+     */
+    CategoricalColumn(const std::string &header, std::shared_ptr<Buffer<std::uint32_t>> buffer,
+                      std::vector<std::string> categories);
     CategoricalColumn(const CategoricalColumn &rhs) = default;
     CategoricalColumn(CategoricalColumn &&rhs) = default;
 
@@ -214,6 +250,9 @@ public:
      */
     const std::vector<std::string> &getCategories() const { return lookUpTable_; }
 
+protected:
+    virtual ColumnStatistics computeStatistics() const override;
+
 private:
     virtual glm::uint32_t addOrGetID(const std::string &str);
 
@@ -242,6 +281,7 @@ TemplateColumn<T> &TemplateColumn<T>::operator=(const TemplateColumn<T> &rhs) {
     if (this != &rhs) {
         header_ = rhs.getHeader();
         buffer_ = std::shared_ptr<Buffer<T>>(rhs.getTypedBuffer()->clone());
+        invalidateStatistics();
     }
     return *this;
 }
@@ -251,6 +291,7 @@ TemplateColumn<T> &TemplateColumn<T>::operator=(TemplateColumn<T> &&rhs) {
     if (this != &rhs) {
         header_ = std::move(rhs.header_);
         buffer_ = std::move(rhs.buffer_);
+        invalidateStatistics();
     }
     return *this;
 }
@@ -272,6 +313,7 @@ void TemplateColumn<T>::setHeader(const std::string &header) {
 
 template <typename T>
 void TemplateColumn<T>::add(const T &value) {
+    invalidateStatistics();
     buffer_->getEditableRAMRepresentation()->add(value);
 }
 
@@ -311,11 +353,13 @@ void add(Buffer<T> * /*buffer*/, const std::string &value) {
 
 template <typename T>
 void TemplateColumn<T>::add(const std::string &value) {
+    invalidateStatistics();
     detail::add<T>(buffer_.get(), value);
 }
 
 template <typename T>
 void TemplateColumn<T>::set(size_t idx, const T &value) {
+    invalidateStatistics();
     buffer_->getEditableRAMRepresentation()->set(idx, value);
 }
 
@@ -351,6 +395,7 @@ dvec4 TemplateColumn<T>::getAsDVec4(size_t idx) const {
 
 template <typename T>
 void TemplateColumn<T>::setBuffer(std::shared_ptr<Buffer<T>> buffer) {
+    invalidateStatistics();
     buffer_ = buffer;
 }
 
@@ -373,6 +418,7 @@ T TemplateColumn<T>::operator[](const size_t idx) const {
 
 template <typename T>
 std::shared_ptr<BufferBase> TemplateColumn<T>::getBuffer() {
+    invalidateStatistics();
     return buffer_;
 }
 
@@ -383,6 +429,7 @@ std::shared_ptr<const BufferBase> TemplateColumn<T>::getBuffer() const {
 
 template <typename T>
 std::shared_ptr<Buffer<T>> TemplateColumn<T>::getTypedBuffer() {
+    invalidateStatistics();
     return buffer_;
 }
 
@@ -0,0 +1,116 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inviwo {
+
+class IVW_MODULE_DATAFRAME_API ExpressionException : public Exception {
+public:
+    ExpressionException(const std::string &message = "",
+                        ExceptionContext context = ExceptionContext())
+        : Exception(message, context) {}
+    virtual ~ExpressionException() throw() {}
+};
+
+/**
+ * \class ColumnExpression
+ * \brief An expression over the columns of a DataFrame that is evaluated for all rows at once.
+ *
+ * The syntax is close to the one of C:
+ *   * numbers, e.g. `3`, `0.5`, `1e-3`
+ *   * columns, either as an identifier, `sepalLength`, or in double quotes, `"Column 1"`
+ *   * arithmetic `+ - * / % ^`, where `^` is the power operator
+ *   * comparisons `< <= > >= == !=`, and logical operators `&& || !`, which result in 1 or 0
+ *   * the functions `abs, ceil, cos, exp, floor, isnan, log, sin, sqrt, tan` and
+ *     `max, min, pow`
+ *   * strings in single quotes, which can only be compared to categorical columns using `==` or
+ *     `!=`, e.g. `species == 'setosa'`
+ *
+ * All values are doubles. Missing values (NaN) propagate through arithmetic and are treated as
+ * false by the logical operators and the filter. The referenced columns have to be scalar.
+ *
+ * The expression is parsed once, and turned into a sequence of simple operations when it is
+ * evaluated on a DataFrame. The rows are processed in chunks, where each operation is a tight loop
+ * over a chunk of values that the compiler can vectorize, and the chunks are distributed over the
+ * thread pool.
+ */
+class IVW_MODULE_DATAFRAME_API ColumnExpression {
+public:
+    /**
+     * @throws ExpressionException if the expression is not valid
+     */
+    explicit ColumnExpression(std::string_view expression);
+
+    const std::string &getExpression() const;
+    /**
+     * Returns the names of the columns used in the expression
+     */
+    const std::vector<std::string> &getColumns() const;
+
+    /**
+     * Evaluate the expression for each row of \p dataFrame.
+     * @throws ExpressionException if a column is missing or not scalar, or if a string is
+     * compared to a column that is not categorical
+     */
+    std::vector<double> evaluate(const DataFrame &dataFrame) const;
+
+    /**
+     * Returns the rows of \p dataFrame where the expression is true, i.e. not zero and not NaN,
+     * in increasing order.
+     * @see evaluate
+     */
+    std::vector<std::uint32_t> filter(const DataFrame &dataFrame) const;
+
+    /**
+     * Evaluate the expression into a new float column with the given \p header.
+     * @see evaluate
+     */
+    std::shared_ptr<TemplateColumn<float>> createColumn(const DataFrame &dataFrame,
+                                                        const std::string &header) const;
+
+    struct Node;
+
+private:
+    std::string expression_;
+    std::vector<std::string> columns_;
+    std::shared_ptr<const Node> root_;
+};
+
+}  // namespace inviwo
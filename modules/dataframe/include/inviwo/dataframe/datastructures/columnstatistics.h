@@ -0,0 +1,86 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+
+#include <limits>
+#include <vector>
+
+namespace inviwo {
+
+class BufferBase;
+
+/**
+ * \brief Summary statistics of a Column
+ *
+ * Computed in parallel chunks by Column::getStatistics() and cached in the column until it is
+ * modified. Missing values (NaN) and infinite values are counted as missing but otherwise
+ * ignored. Only scalar columns have statistics, for other columns count is zero and all values
+ * are NaN.
+ */
+struct IVW_MODULE_DATAFRAME_API ColumnStatistics {
+    static constexpr size_t sketchBins = 4096;
+
+    size_t count = 0;    //! Number of values, excluding missing values
+    size_t missing = 0;  //! Number of missing values (NaN or infinite)
+    double min = std::numeric_limits<double>::quiet_NaN();
+    double max = std::numeric_limits<double>::quiet_NaN();
+    double mean = std::numeric_limits<double>::quiet_NaN();
+    double stddev = std::numeric_limits<double>::quiet_NaN();  //! Population standard deviation
+    /**
+     * Number of distinct values, only computed for categorical columns, zero otherwise
+     */
+    size_t distinct = 0;
+    /**
+     * A histogram of all values using sketchBins bins over [min, max], used for quantiles
+     */
+    std::vector<size_t> sketch;
+
+    /**
+     * The approximate \p q quantile, \p q in [0, 1]. Quantile 0 and 1 are the exact min and max,
+     * in between the error is less than (max - min) / sketchBins.
+     */
+    double quantile(double q) const;
+    std::vector<double> quantiles(const std::vector<double>& qs) const;
+};
+
+namespace util {
+
+/**
+ * Compute the statistics of all values in \p buffer in parallel. If \p categories is not zero
+ * the values are treated as category indices and the distinct indices are counted as well.
+ */
+IVW_MODULE_DATAFRAME_API ColumnStatistics columnStatistics(const BufferBase& buffer,
+                                                           size_t categories = 0);
+
+}  // namespace util
+
+}  // namespace inviwo
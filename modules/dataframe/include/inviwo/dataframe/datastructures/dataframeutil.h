@@ -54,6 +54,13 @@ combineDataFrames(std::vector<std::shared_ptr<DataFrame>> histogramTimeDataFrame
 
 std::string IVW_MODULE_DATAFRAME_API createToolTipForRow(const DataFrame &dataframe, size_t rowId);
 
+/**
+ * Create a new DataFrame with the given \p rows of \p dataframe, in the given order. The index
+ * column is recreated and categorical columns keep their categories.
+ */
+std::shared_ptr<DataFrame> IVW_MODULE_DATAFRAME_API
+selectRows(const DataFrame &dataframe, const std::vector<std::uint32_t> &rows);
+
 }  // namespace dataframeutil
 
 }  // namespace inviwo
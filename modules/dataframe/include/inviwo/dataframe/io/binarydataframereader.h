@@ -0,0 +1,135 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/io/datareader.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+class BufferRAM;
+
+/**
+ * \class BinaryDataFrameReader
+ * \ingroup dataio
+ * Reads a DataFrame from the binary columnar format written by
+ * dataframeutil::writeBinaryDataFrame (*.ivdf).
+ *
+ * Only the file header is read when the DataFrame is created. The buffer of each column has a
+ * BufferDisk representation, and the values of a column are read from the file the first time a
+ * BufferRAM, or any representation converted from it, is requested. Opening a file with many
+ * columns hence only costs the columns that are actually used.
+ *
+ * File layout, all values are stored in native byte order:
+ *   * "IVDF", uint32 version, uint32 byte order mark, uint32 reserved
+ *   * the values of each column, each column starts at a 64 byte aligned offset
+ *   * header: uint64 block size, uint32 column count, and for each column: string name,
+ *     uint32 DataFormatId, uint8 categorical, uint32 category count and the category strings if
+ *     categorical, uint64 offset, uint64 rows, and for each block of rows the min and max of
+ *     every component as 4 + 4 doubles.
+ *   * uint64 offset of the header, "IVDF"
+ *
+ * Strings are stored as a uint32 length followed by the characters. The index column is not
+ * stored, it is recreated by the reader.
+ */
+class IVW_MODULE_DATAFRAME_API BinaryDataFrameReader : public DataReaderType<DataFrame> {
+public:
+    static constexpr std::array<char, 4> magic{{'I', 'V', 'D', 'F'}};
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::uint32_t byteOrderMark = 0x01020304;
+
+    struct ColumnInfo {
+        std::string header;
+        const DataFormatBase* format = nullptr;
+        bool categorical = false;
+        std::vector<std::string> categories;
+        size_t offset = 0;
+        size_t rows = 0;
+        /// Component wise min and max of each block of rows, NaN values are ignored
+        std::vector<dvec4> blockMin;
+        std::vector<dvec4> blockMax;
+
+        /**
+         * The blocks of rows that may contain values of \p component in [\p min, \p max].
+         * The other blocks, including blocks with only missing values, can be skipped.
+         */
+        std::vector<size_t> blocksInRange(double min, double max, size_t component = 0) const;
+    };
+    struct FileInfo {
+        size_t blockSize = 0;
+        std::vector<ColumnInfo> columns;
+    };
+
+    BinaryDataFrameReader();
+    BinaryDataFrameReader(const BinaryDataFrameReader&) = default;
+    BinaryDataFrameReader(BinaryDataFrameReader&&) noexcept = default;
+    BinaryDataFrameReader& operator=(const BinaryDataFrameReader&) = default;
+    BinaryDataFrameReader& operator=(BinaryDataFrameReader&&) noexcept = default;
+    virtual BinaryDataFrameReader* clone() const override;
+    virtual ~BinaryDataFrameReader() = default;
+    using DataReaderType<DataFrame>::readData;
+
+    /**
+     * Create a DataFrame from \p fileName, the column values are loaded on first use.
+     * @throws FileException if the file cannot be accessed
+     * @throws DataReaderException if the file is not a valid DataFrame file
+     */
+    virtual std::shared_ptr<DataFrame> readData(const std::string& fileName) override;
+
+    /**
+     * Read only the header of \p fileName, i.e. the columns and their block statistics.
+     * @throws FileException if the file cannot be accessed
+     * @throws DataReaderException if the file is not a valid DataFrame file
+     */
+    static FileInfo readInfo(const std::string& fileName);
+
+    /**
+     * Read the values of a single block of rows of a column, without loading the rest of it.
+     * Together with ColumnInfo::blocksInRange this makes it possible to only read the parts of a
+     * column that match a filter.
+     * @param fileName the file that \p info was read from
+     * @param info of the file, see readInfo
+     * @param column index of the column in info.columns
+     * @param block index of the block, rows [block * blockSize, (block + 1) * blockSize)
+     * @throws RangeException if the column or block is out of range
+     * @throws FileException if the file cannot be accessed
+     * @throws DataReaderException if the values could not be read
+     */
+    static std::shared_ptr<BufferRAM> readBlock(const std::string& fileName, const FileInfo& info,
+                                                size_t column, size_t block);
+};
+
+}  // namespace inviwo
@@ -74,7 +74,9 @@ public:
     using DataReaderType<DataFrame>::readData;
 
     /**
-     * read a CSV file from a file
+     * read a CSV file from a file. The file is memory mapped and split into chunks at record
+     * boundaries, which are parsed in parallel on the thread pool directly into the columns. The
+     * result is the same as for readData(std::istream&).
      *
      * @param fileName   name of the input CSV file
      * @return a DataFrame containing the CSV data
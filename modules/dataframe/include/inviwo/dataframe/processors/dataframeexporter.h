@@ -51,10 +51,12 @@ namespace inviwo {
 
 /** \docpage{org.inviwo.DataFrameExporter, DataFrame Exporter}
  * ![](org.inviwo.DataFrameExporter.png?classIdentifier=org.inviwo.DataFrameExporter)
- * This processor exports a DataFrame into a CSV or XML file.
+ * This processor exports a DataFrame into a CSV, XML, or binary Inviwo DataFrame (ivdf) file.
+ * The binary format can be opened without parsing and loads columns on demand, see
+ * BinaryDataFrameReader.
  *
  * ### Inports
- *   * __<Inport>__ source DataFrame which is saved as CSV or XML file
+ *   * __<Inport>__ source DataFrame which is saved as CSV, XML, or ivdf file
  *
  */
 
@@ -74,6 +76,7 @@ protected:
 private:
     void exportAsCSV(bool separateVectorTypesIntoColumns = true);
     void exportAsXML();
+    void exportAsBinary();
 
     DataInport<DataFrame> dataFrame_;
 
@@ -87,6 +90,7 @@ private:
 
     static FileExtension csvExtension_;
     static FileExtension xmlExtension_;
+    static FileExtension ivdfExtension_;
 
     bool export_;
 };
@@ -31,9 +31,40 @@
 
 namespace inviwo {
 
+std::shared_ptr<const ColumnStatistics> Column::getStatistics() const {
+    {
+        std::scoped_lock lock{statisticsMutex_};
+        if (statistics_) return statistics_;
+    }
+    // Compute without holding the lock, the computation might wait for pool tasks that in turn
+    // ask for the statistics.
+    auto statistics = std::make_shared<const ColumnStatistics>(computeStatistics());
+    std::scoped_lock lock{statisticsMutex_};
+    if (!statistics_) statistics_ = std::move(statistics);
+    return statistics_;
+}
+
+void Column::invalidateStatistics() {
+    std::scoped_lock lock{statisticsMutex_};
+    statistics_.reset();
+}
+
+ColumnStatistics Column::computeStatistics() const { return util::columnStatistics(*getBuffer()); }
+
 CategoricalColumn::CategoricalColumn(const std::string &header)
     : TemplateColumn<std::uint32_t>(header) {}
 
+CategoricalColumn::CategoricalColumn(const std::string &header, std::vector<std::uint32_t> data,
+                                     std::vector<std::string> categories)
+    : TemplateColumn<std::uint32_t>(header, std::move(data))
+    , lookUpTable_(std::move(categories)) {}
+
+CategoricalColumn::CategoricalColumn(const std::string &header,
+                                     std::shared_ptr<Buffer<std::uint32_t>> buffer,
+                                     std::vector<std::string> categories)
+    : TemplateColumn<std::uint32_t>(header, std::move(buffer))
+    , lookUpTable_(std::move(categories)) {}
+
 CategoricalColumn *CategoricalColumn::clone() const { return new CategoricalColumn(*this); }
 
 std::string CategoricalColumn::getAsString(size_t idx) const {
@@ -59,6 +90,10 @@ void CategoricalColumn::add(const std::string &value) {
     getTypedBuffer()->getEditableRAMRepresentation()->add(id);
 }
 
+ColumnStatistics CategoricalColumn::computeStatistics() const {
+    return util::columnStatistics(*getBuffer(), lookUpTable_.size());
+}
+
 glm::uint32_t CategoricalColumn::addOrGetID(const std::string &str) {
     auto it = std::find(lookUpTable_.begin(), lookUpTable_.end(), str);
     if (it != lookUpTable_.end()) {
@@ -0,0 +1,695 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/datastructures/columnexpression.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <functional>
+#include <locale>
+#include <sstream>
+#include <unordered_map>
+
+namespace inviwo {
+
+struct ColumnExpression::Node {
+    enum class Op {
+        Constant,
+        Column,
+        String,
+        Neg,
+        Not,
+        Add,
+        Sub,
+        Mul,
+        Div,
+        Mod,
+        Pow,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Equal,
+        NotEqual,
+        And,
+        Or,
+        Abs,
+        Ceil,
+        Cos,
+        Exp,
+        Floor,
+        IsNaN,
+        Log,
+        Max,
+        Min,
+        Sin,
+        Sqrt,
+        Tan
+    };
+
+    Op op = Op::Constant;
+    double value = 0.0;  // Constant
+    std::string name;    // Column and String
+    size_t pos = 0;      // position in the expression, for error messages
+    std::vector<Node> args;
+};
+
+namespace {
+
+using Node = ColumnExpression::Node;
+using Op = Node::Op;
+
+// Number of rows processed by each operation at a time
+constexpr size_t chunkSize = 1024;
+// Number of chunks evaluated by each task on the thread pool
+constexpr size_t chunksPerTask = 64;
+
+struct Function {
+    std::string_view name;
+    Op op;
+    size_t arity;
+};
+constexpr std::array<Function, 13> functions{{{"abs", Op::Abs, 1},
+                                              {"ceil", Op::Ceil, 1},
+                                              {"cos", Op::Cos, 1},
+                                              {"exp", Op::Exp, 1},
+                                              {"floor", Op::Floor, 1},
+                                              {"isnan", Op::IsNaN, 1},
+                                              {"log", Op::Log, 1},
+                                              {"max", Op::Max, 2},
+                                              {"min", Op::Min, 2},
+                                              {"pow", Op::Pow, 2},
+                                              {"sin", Op::Sin, 1},
+                                              {"sqrt", Op::Sqrt, 1},
+                                              {"tan", Op::Tan, 1}}};
+
+Node makeNode(Op op, size_t pos) {
+    Node node;
+    node.op = op;
+    node.pos = pos;
+    return node;
+}
+
+bool truth(double x) { return !std::isnan(x) && x != 0.0; }
+
+/**
+ * Calls \p callable with a function object implementing \p op for a pair of values. Unary
+ * operations ignore the second value.
+ */
+template <typename Callable>
+void withOperation(Op op, Callable&& callable) {
+    // clang-format off
+    switch (op) {
+        case Op::Neg: return callable([](double a, double) { return -a; });
+        case Op::Not: return callable([](double a, double) { return truth(a) ? 0.0 : 1.0; });
+        case Op::Add: return callable([](double a, double b) { return a + b; });
+        case Op::Sub: return callable([](double a, double b) { return a - b; });
+        case Op::Mul: return callable([](double a, double b) { return a * b; });
+        case Op::Div: return callable([](double a, double b) { return a / b; });
+        case Op::Mod: return callable([](double a, double b) { return std::fmod(a, b); });
+        case Op::Pow: return callable([](double a, double b) { return std::pow(a, b); });
+        case Op::Less: return callable([](double a, double b) { return a < b ? 1.0 : 0.0; });
+        case Op::LessEqual: return callable([](double a, double b) { return a <= b ? 1.0 : 0.0; });
+        case Op::Greater: return callable([](double a, double b) { return a > b ? 1.0 : 0.0; });
+        case Op::GreaterEqual:
+            return callable([](double a, double b) { return a >= b ? 1.0 : 0.0; });
+        case Op::Equal: return callable([](double a, double b) { return a == b ? 1.0 : 0.0; });
+        case Op::NotEqual: return callable([](double a, double b) { return a != b ? 1.0 : 0.0; });
+        case Op::And:
+            return callable([](double a, double b) { return truth(a) && truth(b) ? 1.0 : 0.0; });
+        case Op::Or:
+            return callable([](double a, double b) { return truth(a) || truth(b) ? 1.0 : 0.0; });
+        case Op::Abs: return callable([](double a, double) { return std::abs(a); });
+        case Op::Ceil: return callable([](double a, double) { return std::ceil(a); });
+        case Op::Cos: return callable([](double a, double) { return std::cos(a); });
+        case Op::Exp: return callable([](double a, double) { return std::exp(a); });
+        case Op::Floor: return callable([](double a, double) { return std::floor(a); });
+        case Op::IsNaN: return callable([](double a, double) { return std::isnan(a) ? 1.0 : 0.0; });
+        case Op::Log: return callable([](double a, double) { return std::log(a); });
+        case Op::Max: return callable([](double a, double b) { return std::fmax(a, b); });
+        case Op::Min: return callable([](double a, double b) { return std::fmin(a, b); });
+        case Op::Sin: return callable([](double a, double) { return std::sin(a); });
+        case Op::Sqrt: return callable([](double a, double) { return std::sqrt(a); });
+        case Op::Tan: return callable([](double a, double) { return std::tan(a); });
+        case Op::Constant:
+        case Op::Column:
+        case Op::String:
+        default:
+            throw ExpressionException("Not an operation", IVW_CONTEXT_CUSTOM("ColumnExpression"));
+    }
+    // clang-format on
+}
+
+class Parser {
+public:
+    explicit Parser(std::string_view expression) : expr_{expression} {}
+
+    Node parse() {
+        auto node = operand(parseOr());
+        skipSpace();
+        if (pos_ != expr_.size()) error("Unexpected '" + std::string(1, expr_[pos_]) + "'", pos_);
+        return node;
+    }
+
+    std::vector<std::string> columns;
+
+private:
+    [[noreturn]] void error(const std::string& message, size_t pos) const {
+        throw ExpressionException(message + " at position " + std::to_string(pos + 1) + " in \"" +
+                                      std::string(expr_) + "\"",
+                                  IVW_CONTEXT_CUSTOM("ColumnExpression"));
+    }
+
+    void skipSpace() {
+        while (pos_ < expr_.size() && std::isspace(static_cast<unsigned char>(expr_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    bool accept(std::string_view token) {
+        skipSpace();
+        if (expr_.substr(pos_, token.size()) == token) {
+            pos_ += token.size();
+            return true;
+        }
+        return false;
+    }
+
+    void expect(std::string_view token) {
+        if (!accept(token)) {
+            if (pos_ == expr_.size()) error("Expected '" + std::string(token) + "'", pos_);
+            error("Expected '" + std::string(token) + "' but found '" +
+                      std::string(1, expr_[pos_]) + "'",
+                  pos_);
+        }
+    }
+
+    void check(const Node& node) const {
+        if (node.op == Op::String) {
+            error("A string can only be compared to a categorical column", node.pos);
+        }
+    }
+
+    Node operand(Node node) const {
+        check(node);
+        return node;
+    }
+
+    // Creates a node for op, and folds it into a constant if all arguments are constant
+    Node operation(Op op, size_t pos, std::vector<Node> args) const {
+        for (const auto& arg : args) check(arg);
+        if (std::all_of(args.begin(), args.end(),
+                        [](const Node& arg) { return arg.op == Op::Constant; })) {
+            const auto a = args[0].value;
+            const auto b = args.size() > 1 ? args[1].value : a;
+            auto node = makeNode(Op::Constant, pos);
+            withOperation(op, [&](auto f) { node.value = f(a, b); });
+            return node;
+        }
+        auto node = makeNode(op, pos);
+        node.args = std::move(args);
+        return node;
+    }
+
+    Node binary(Op op, size_t pos, Node lhs, Node rhs) const {
+        std::vector<Node> args;
+        args.push_back(std::move(lhs));
+        args.push_back(std::move(rhs));
+        return operation(op, pos, std::move(args));
+    }
+
+    // Comparisons between a categorical column and a string are resolved during evaluation
+    Node compare(Op op, size_t pos, Node lhs, Node rhs) const {
+        if (rhs.op == Op::String && lhs.op != Op::String) std::swap(lhs, rhs);
+        if (lhs.op == Op::String) {
+            if (rhs.op != Op::Column) check(lhs);
+            auto node = makeNode(op, pos);
+            node.args.push_back(std::move(rhs));
+            node.args.push_back(std::move(lhs));
+            return node;
+        }
+        return binary(op, pos, std::move(lhs), std::move(rhs));
+    }
+
+    Node parseOr() {
+        auto lhs = parseAnd();
+        for (auto pos = pos_; accept("||"); pos = pos_) {
+            lhs = binary(Op::Or, pos, std::move(lhs), parseAnd());
+        }
+        return lhs;
+    }
+
+    Node parseAnd() {
+        auto lhs = parseComparison();
+        for (auto pos = pos_; accept("&&"); pos = pos_) {
+            lhs = binary(Op::And, pos, std::move(lhs), parseComparison());
+        }
+        return lhs;
+    }
+
+    Node parseComparison() {
+        auto lhs = parseSum();
+        while (true) {
+            skipSpace();
+            const auto pos = pos_;
+            if (accept("<=")) {
+                lhs = binary(Op::LessEqual, pos, std::move(lhs), parseSum());
+            } else if (accept(">=")) {
+                lhs = binary(Op::GreaterEqual, pos, std::move(lhs), parseSum());
+            } else if (accept("==")) {
+                lhs = compare(Op::Equal, pos, std::move(lhs), parseSum());
+            } else if (accept("!=")) {
+                lhs = compare(Op::NotEqual, pos, std::move(lhs), parseSum());
+            } else if (accept("<")) {
+                lhs = binary(Op::Less, pos, std::move(lhs), parseSum());
+            } else if (accept(">")) {
+                lhs = binary(Op::Greater, pos, std::move(lhs), parseSum());
+            } else {
+                return lhs;
+            }
+        }
+    }
+
+    Node parseSum() {
+        auto lhs = parseProduct();
+        while (true) {
+            skipSpace();
+            const auto pos = pos_;
+            if (accept("+")) {
+                lhs = binary(Op::Add, pos, std::move(lhs), parseProduct());
+            } else if (accept("-")) {
+                lhs = binary(Op::Sub, pos, std::move(lhs), parseProduct());
+            } else {
+                return lhs;
+            }
+        }
+    }
+
+    Node parseProduct() {
+        auto lhs = parseUnary();
+        while (true) {
+            skipSpace();
+            const auto pos = pos_;
+            if (accept("*")) {
+                lhs = binary(Op::Mul, pos, std::move(lhs), parseUnary());
+            } else if (accept("/")) {
+                lhs = binary(Op::Div, pos, std::move(lhs), parseUnary());
+            } else if (accept("%")) {
+                lhs = binary(Op::Mod, pos, std::move(lhs), parseUnary());
+            } else {
+                return lhs;
+            }
+        }
+    }
+
+    Node parseUnary() {
+        skipSpace();
+        const auto pos = pos_;
+        if (accept("-")) {
+            std::vector<Node> args;
+            args.push_back(parseUnary());
+            return operation(Op::Neg, pos, std::move(args));
+        } else if (accept("+")) {
+            return operand(parseUnary());
+        } else if (expr_.substr(pos_, 2) != "!=" && accept("!")) {
+            std::vector<Node> args;
+            args.push_back(parseUnary());
+            return operation(Op::Not, pos, std::move(args));
+        }
+        return parsePower();
+    }
+
+    // Right associative and binds tighter than unary minus, i.e. -2^2 = -4 and 2^-1 = 0.5
+    Node parsePower() {
+        auto base = parsePrimary();
+        skipSpace();
+        const auto pos = pos_;
+        if (accept("^")) return binary(Op::Pow, pos, std::move(base), parseUnary());
+        return base;
+    }
+
+    Node parsePrimary() {
+        skipSpace();
+        const auto pos = pos_;
+        if (pos_ == expr_.size()) error("Unexpected end of expression", pos_);
+
+        const char ch = expr_[pos_];
+        if (accept("(")) {
+            auto node = parseOr();
+            expect(")");
+            return node;
+        } else if (std::isdigit(static_cast<unsigned char>(ch)) || ch == '.') {
+            return parseNumber();
+        } else if (ch == '"' || ch == '\'') {
+            auto node = makeNode(ch == '"' ? Op::Column : Op::String, pos);
+            node.name = parseQuoted(ch);
+            if (node.op == Op::Column) addColumn(node.name);
+            return node;
+        } else if (std::isalpha(static_cast<unsigned char>(ch)) || ch == '_') {
+            const auto name = parseIdentifier();
+            if (accept("(")) return parseFunction(name, pos);
+            auto node = makeNode(Op::Column, pos);
+            node.name = std::string(name);
+            addColumn(node.name);
+            return node;
+        }
+        error("Unexpected '" + std::string(1, ch) + "'", pos_);
+    }
+
+    Node parseNumber() {
+        const auto begin = pos_;
+        const auto digits = [&]() {
+            const auto start = pos_;
+            while (pos_ < expr_.size() && std::isdigit(static_cast<unsigned char>(expr_[pos_]))) {
+                ++pos_;
+            }
+            return pos_ - start;
+        };
+        auto count = digits();
+        if (pos_ < expr_.size() && expr_[pos_] == '.') {
+            ++pos_;
+            count += digits();
+        }
+        if (count == 0) error("Invalid number", begin);
+        if (pos_ < expr_.size() && (expr_[pos_] == 'e' || expr_[pos_] == 'E')) {
+            ++pos_;
+            if (pos_ < expr_.size() && (expr_[pos_] == '+' || expr_[pos_] == '-')) ++pos_;
+            if (digits() == 0) error("Invalid number", begin);
+        }
+
+        std::istringstream stream{std::string(expr_.substr(begin, pos_ - begin))};
+        stream.imbue(std::locale::classic());
+        auto node = makeNode(Op::Constant, begin);
+        stream >> node.value;
+        return node;
+    }
+
+    std::string parseQuoted(char quote) {
+        const auto begin = pos_++;
+        std::string str;
+        while (pos_ < expr_.size()) {
+            const char ch = expr_[pos_++];
+            if (ch != quote) {
+                str += ch;
+            } else if (pos_ < expr_.size() && expr_[pos_] == quote) {
+                // a doubled quote is an escaped quote
+                str += ch;
+                ++pos_;
+            } else {
+                return str;
+            }
+        }
+        error("Missing closing " + std::string(1, quote), begin);
+    }
+
+    std::string_view parseIdentifier() {
+        const auto begin = pos_;
+        while (pos_ < expr_.size() && (std::isalnum(static_cast<unsigned char>(expr_[pos_])) ||
+                                       expr_[pos_] == '_')) {
+            ++pos_;
+        }
+        return expr_.substr(begin, pos_ - begin);
+    }
+
+    Node parseFunction(std::string_view name, size_t pos) {
+        const auto it = std::find_if(functions.begin(), functions.end(),
+                                     [&](const Function& f) { return f.name == name; });
+        if (it == functions.end()) error("Unknown function '" + std::string(name) + "'", pos);
+
+        std::vector<Node> args;
+        if (!accept(")")) {
+            do {
+                args.push_back(parseOr());
+            } while (accept(","));
+            expect(")");
+        }
+        if (args.size() != it->arity) {
+            error("Function '" + std::string(name) + "' takes " + std::to_string(it->arity) +
+                      (it->arity == 1 ? " argument" : " arguments"),
+                  pos);
+        }
+        return operation(it->op, pos, std::move(args));
+    }
+
+    void addColumn(const std::string& name) {
+        if (std::find(columns.begin(), columns.end(), name) == columns.end()) {
+            columns.push_back(name);
+        }
+    }
+
+    std::string_view expr_;
+    size_t pos_ = 0;
+};
+
+using Loader = std::function<void(size_t begin, size_t count, double* dst)>;
+
+struct Instruction {
+    Op op;
+    size_t dst;
+    size_t a;  // register, or loader for Op::Column
+    size_t b;
+};
+
+/**
+ * The expression as a sequence of instructions over registers, each holding a chunk of values.
+ */
+struct Program {
+    std::vector<Instruction> code;
+    std::vector<std::pair<size_t, double>> constants;
+    std::vector<Loader> loaders;
+    size_t registers = 0;
+    size_t result = 0;
+    size_t rows = 0;
+};
+
+class Compiler {
+public:
+    explicit Compiler(const DataFrame& dataFrame) : dataFrame_{dataFrame} {
+        program_.rows = dataFrame.getNumberOfRows();
+    }
+
+    Program compile(const Node& root) {
+        program_.result = compile(root, -1.0);
+        return std::move(program_);
+    }
+
+private:
+    size_t compile(const Node& node, double constant) {
+        switch (node.op) {
+            case Op::Constant:
+                program_.constants.emplace_back(program_.registers, node.value);
+                return program_.registers++;
+            case Op::Column:
+                return load(node.name);
+            case Op::String:
+                program_.constants.emplace_back(program_.registers, constant);
+                return program_.registers++;
+            case Op::Equal:
+            case Op::NotEqual:
+                if (node.args[1].op == Op::String) {
+                    const auto& column = getColumn(node.args[0].name);
+                    auto categorical = dynamic_cast<const CategoricalColumn*>(&column);
+                    if (!categorical) {
+                        throw ExpressionException("Column \"" + column.getHeader() +
+                                                      "\" is not categorical and can not be "
+                                                      "compared to '" +
+                                                      node.args[1].name + "'",
+                                                  IVW_CONTEXT);
+                    }
+                    // Strings that are not a category of the column will never match any row
+                    const auto& categories = categorical->getCategories();
+                    const auto it =
+                        std::find(categories.begin(), categories.end(), node.args[1].name);
+                    const double index =
+                        it == categories.end()
+                            ? -1.0
+                            : static_cast<double>(std::distance(categories.begin(), it));
+                    return emit(node.op, compile(node.args[0], -1.0),
+                                compile(node.args[1], index));
+                }
+                [[fallthrough]];
+            default: {
+                const auto a = compile(node.args[0], -1.0);
+                const auto b = node.args.size() > 1 ? compile(node.args[1], -1.0) : a;
+                return emit(node.op, a, b);
+            }
+        }
+    }
+
+    size_t emit(Op op, size_t a, size_t b) {
+        program_.code.push_back({op, program_.registers, a, b});
+        return program_.registers++;
+    }
+
+    const Column& getColumn(const std::string& name) const {
+        auto column = dataFrame_.getColumn(name);
+        if (!column) {
+            throw ExpressionException("Column \"" + name + "\" not found", IVW_CONTEXT);
+        }
+        return *column;
+    }
+
+    size_t load(const std::string& name) {
+        if (auto it = loaded_.find(name); it != loaded_.end()) return it->second;
+
+        const auto& column = getColumn(name);
+        auto buffer = column.getBuffer();
+        if (buffer->getDataFormat()->getComponents() != 1) {
+            throw ExpressionException("Column \"" + name + "\" is not scalar", IVW_CONTEXT);
+        }
+        if (buffer->getSize() != program_.rows) {
+            throw ExpressionException("Column \"" + name + "\" has " +
+                                          std::to_string(buffer->getSize()) + " rows, expected " +
+                                          std::to_string(program_.rows),
+                                      IVW_CONTEXT);
+        }
+        program_.loaders.push_back(
+            buffer->getRepresentation<BufferRAM>()->dispatch<Loader, dispatching::filter::Scalars>(
+                [](auto br) -> Loader {
+                    const auto* data = br->getDataContainer().data();
+                    return [data](size_t begin, size_t count, double* dst) {
+                        for (size_t i = 0; i < count; ++i) {
+                            dst[i] = static_cast<double>(data[begin + i]);
+                        }
+                    };
+                }));
+
+        program_.code.push_back({Op::Column, program_.registers, program_.loaders.size() - 1, 0});
+        loaded_[name] = program_.registers;
+        return program_.registers++;
+    }
+
+    const DataFrame& dataFrame_;
+    Program program_;
+    std::unordered_map<std::string, size_t> loaded_;
+};
+
+/**
+ * Evaluates \p program for the rows [begin, end) and passes the result of each chunk to \p sink
+ */
+template <typename Sink>
+void execute(const Program& program, size_t begin, size_t end, Sink&& sink) {
+    std::vector<double> registers(program.registers * chunkSize);
+    const auto reg = [&](size_t i) { return registers.data() + i * chunkSize; };
+    for (const auto& [r, value] : program.constants) {
+        std::fill(reg(r), reg(r) + chunkSize, value);
+    }
+
+    for (size_t chunk = begin; chunk < end; chunk += chunkSize) {
+        const auto count = std::min(chunkSize, end - chunk);
+        for (const auto& instr : program.code) {
+            double* dst = reg(instr.dst);
+            if (instr.op == Op::Column) {
+                program.loaders[instr.a](chunk, count, dst);
+            } else {
+                const double* a = reg(instr.a);
+                const double* b = reg(instr.b);
+                withOperation(instr.op, [&](auto f) {
+                    for (size_t i = 0; i < count; ++i) dst[i] = f(a[i], b[i]);
+                });
+            }
+        }
+        sink(chunk, count, static_cast<const double*>(reg(program.result)));
+    }
+}
+
+size_t taskCount(const Program& program) {
+    constexpr size_t taskSize = chunkSize * chunksPerTask;
+    return (program.rows + taskSize - 1) / taskSize;
+}
+
+/**
+ * Evaluates \p program for all rows, split into taskCount(program) tasks that run on the thread
+ * pool. The result of each chunk is passed to \p sink together with the index of the task.
+ */
+template <typename Sink>
+void run(const Program& program, Sink&& sink) {
+    constexpr size_t taskSize = chunkSize * chunksPerTask;
+    const auto tasks = taskCount(program);
+    const auto runTask = [&](size_t task) {
+        execute(program, task * taskSize, std::min(program.rows, (task + 1) * taskSize),
+                [&](size_t begin, size_t count, const double* values) {
+                    sink(task, begin, count, values);
+                });
+    };
+    util::forEachTask(tasks, runTask);
+}
+
+}  // namespace
+
+ColumnExpression::ColumnExpression(std::string_view expression) : expression_{expression} {
+    Parser parser{expression_};
+    root_ = std::make_shared<const Node>(parser.parse());
+    columns_ = std::move(parser.columns);
+}
+
+const std::string& ColumnExpression::getExpression() const { return expression_; }
+
+const std::vector<std::string>& ColumnExpression::getColumns() const { return columns_; }
+
+std::vector<double> ColumnExpression::evaluate(const DataFrame& dataFrame) const {
+    const auto program = Compiler{dataFrame}.compile(*root_);
+    std::vector<double> result(program.rows);
+    run(program, [&](size_t, size_t begin, size_t count, const double* values) {
+        std::copy(values, values + count, result.begin() + static_cast<std::ptrdiff_t>(begin));
+    });
+    return result;
+}
+
+std::vector<std::uint32_t> ColumnExpression::filter(const DataFrame& dataFrame) const {
+    const auto program = Compiler{dataFrame}.compile(*root_);
+    std::vector<std::vector<std::uint32_t>> taskRows(taskCount(program));
+    run(program, [&](size_t task, size_t begin, size_t count, const double* values) {
+        auto& rows = taskRows[task];
+        for (size_t i = 0; i < count; ++i) {
+            if (truth(values[i])) rows.push_back(static_cast<std::uint32_t>(begin + i));
+        }
+    });
+
+    std::vector<std::uint32_t> rows;
+    for (const auto& r : taskRows) rows.insert(rows.end(), r.begin(), r.end());
+    return rows;
+}
+
+std::shared_ptr<TemplateColumn<float>> ColumnExpression::createColumn(
+    const DataFrame& dataFrame, const std::string& header) const {
+    const auto program = Compiler{dataFrame}.compile(*root_);
+    std::vector<float> data(program.rows);
+    run(program, [&](size_t, size_t begin, size_t count, const double* values) {
+        std::transform(values, values + count, data.begin() + static_cast<std::ptrdiff_t>(begin),
+                       [](double value) { return static_cast<float>(value); });
+    });
+    return std::make_shared<TemplateColumn<float>>(header, std::move(data));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,189 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/datastructures/columnstatistics.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <type_traits>
+
+namespace inviwo {
+
+namespace {
+
+constexpr size_t taskSize = size_t{1} << 16;
+
+/**
+ * Count, extent and the sum of squared deviations from the mean of a chunk of values, merged
+ * pairwise to avoid the cancellation of a single sum of squares
+ */
+struct Moments {
+    size_t count = 0;
+    size_t missing = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    void merge(const Moments& rhs) {
+        missing += rhs.missing;
+        if (rhs.count == 0) return;
+        const auto n = static_cast<double>(count + rhs.count);
+        const auto delta = rhs.mean - mean;
+        mean += delta * static_cast<double>(rhs.count) / n;
+        m2 += rhs.m2 +
+              delta * delta * static_cast<double>(count) * static_cast<double>(rhs.count) / n;
+        count += rhs.count;
+        min = std::min(min, rhs.min);
+        max = std::max(max, rhs.max);
+    }
+};
+
+template <typename T>
+ColumnStatistics computeStatistics(const std::vector<T>& data, size_t categories) {
+    const auto rows = data.size();
+    const auto tasks = (rows + taskSize - 1) / taskSize;
+    const auto value = [&](size_t i) { return static_cast<double>(data[i]); };
+
+    std::mutex mutex;
+    std::vector<Moments> moments(tasks);
+    std::vector<bool> used(categories, false);
+    util::forEachTask(tasks, [&](size_t task) {
+        const auto begin = task * taskSize;
+        const auto end = std::min(rows, begin + taskSize);
+        auto& m = moments[task];
+        double sum = 0.0;
+        for (size_t i = begin; i < end; ++i) {
+            const auto v = value(i);
+            if (!std::isfinite(v)) continue;
+            ++m.count;
+            sum += v;
+            m.min = std::min(m.min, v);
+            m.max = std::max(m.max, v);
+        }
+        m.missing = (end - begin) - m.count;
+        if (m.count == 0) return;
+        m.mean = sum / static_cast<double>(m.count);
+        for (size_t i = begin; i < end; ++i) {
+            const auto v = value(i);
+            if (std::isfinite(v)) m.m2 += (v - m.mean) * (v - m.mean);
+        }
+
+        if constexpr (std::is_integral_v<T>) {
+            if (categories == 0) return;
+            std::vector<bool> localUsed(categories, false);
+            for (size_t i = begin; i < end; ++i) {
+                if (static_cast<size_t>(data[i]) < categories) {
+                    localUsed[static_cast<size_t>(data[i])] = true;
+                }
+            }
+            std::scoped_lock lock{mutex};
+            for (size_t c = 0; c < categories; ++c) {
+                if (localUsed[c]) used[c] = true;
+            }
+        }
+    });
+
+    Moments total;
+    for (const auto& m : moments) total.merge(m);
+
+    ColumnStatistics stats;
+    stats.count = total.count;
+    stats.missing = total.missing;
+    stats.distinct = static_cast<size_t>(std::count(used.begin(), used.end(), true));
+    if (total.count == 0) return stats;
+
+    stats.min = total.min;
+    stats.max = total.max;
+    stats.mean = total.mean;
+    stats.stddev = std::sqrt(total.m2 / static_cast<double>(total.count));
+
+    constexpr auto bins = ColumnStatistics::sketchBins;
+    const auto scale =
+        stats.max > stats.min ? static_cast<double>(bins) / (stats.max - stats.min) : 0.0;
+    stats.sketch.assign(bins, 0);
+    util::forEachTask(tasks, [&](size_t task) {
+        const auto begin = task * taskSize;
+        const auto end = std::min(rows, begin + taskSize);
+        std::vector<size_t> local(bins, 0);
+        for (size_t i = begin; i < end; ++i) {
+            const auto v = value(i);
+            if (!std::isfinite(v)) continue;
+            ++local[std::min(bins - 1, static_cast<size_t>((v - stats.min) * scale))];
+        }
+        std::scoped_lock lock{mutex};
+        for (size_t bin = 0; bin < bins; ++bin) stats.sketch[bin] += local[bin];
+    });
+
+    return stats;
+}
+
+}  // namespace
+
+double ColumnStatistics::quantile(double q) const {
+    if (count == 0) return std::numeric_limits<double>::quiet_NaN();
+    if (q <= 0.0) return min;
+    if (q >= 1.0) return max;
+
+    // Find the bin holding the value of the given rank and interpolate linearly within it
+    const auto rank = q * static_cast<double>(count);
+    const auto width = (max - min) / static_cast<double>(sketch.size());
+    double cumulative = 0.0;
+    for (size_t bin = 0; bin < sketch.size(); ++bin) {
+        const auto binCount = static_cast<double>(sketch[bin]);
+        if (binCount > 0.0 && cumulative + binCount >= rank) {
+            const auto t = (rank - cumulative) / binCount;
+            return std::clamp(min + (static_cast<double>(bin) + t) * width, min, max);
+        }
+        cumulative += binCount;
+    }
+    return max;
+}
+
+std::vector<double> ColumnStatistics::quantiles(const std::vector<double>& qs) const {
+    std::vector<double> res;
+    res.reserve(qs.size());
+    std::transform(qs.begin(), qs.end(), std::back_inserter(res),
+                   [&](double q) { return quantile(q); });
+    return res;
+}
+
+ColumnStatistics util::columnStatistics(const BufferBase& buffer, size_t categories) {
+    if (buffer.getDataFormat()->getComponents() != 1) return {};
+    return buffer.getRepresentation<BufferRAM>()
+        ->dispatch<ColumnStatistics, dispatching::filter::Scalars>([&](auto ram) {
+            return computeStatistics(ram->getDataContainer(), categories);
+        });
+}
+
+}  // namespace inviwo
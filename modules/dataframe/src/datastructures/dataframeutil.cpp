@@ -178,6 +178,37 @@ std::string createToolTipForRow(const DataFrame& dataframe, size_t rowId) {
     return doc;
 }
 
+std::shared_ptr<DataFrame> selectRows(const DataFrame& dataframe,
+                                      const std::vector<std::uint32_t>& rows) {
+    const auto gather = [&](const auto& data) {
+        std::vector<typename std::decay_t<decltype(data)>::value_type> selected;
+        selected.reserve(rows.size());
+        for (auto row : rows) selected.push_back(data[row]);
+        return selected;
+    };
+
+    auto result = std::make_shared<DataFrame>();
+    for (const auto& col : dataframe) {
+        if (col == dataframe.getIndexColumn()) continue;
+
+        if (auto cc = dynamic_cast<const CategoricalColumn*>(col.get())) {
+            const auto& data = cc->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+            result->addColumn(std::make_shared<CategoricalColumn>(cc->getHeader(), gather(data),
+                                                                  cc->getCategories()));
+        } else {
+            result->addColumn(
+                col->getBuffer()->getRepresentation<BufferRAM>()->dispatch<std::shared_ptr<Column>>(
+                    [&](auto typed) -> std::shared_ptr<Column> {
+                        using ValueType = util::PrecisionValueType<decltype(typed)>;
+                        return std::make_shared<TemplateColumn<ValueType>>(
+                            col->getHeader(), gather(typed->getDataContainer()));
+                    }));
+        }
+    }
+    result->updateIndexBuffer();
+    return result;
+}
+
 }  // namespace dataframeutil
 
 }  // namespace inviwo
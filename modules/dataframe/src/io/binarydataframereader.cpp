@@ -0,0 +1,262 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/io/binarydataframereader.h>
+#include <inviwo/core/datastructures/buffer/bufferdisk.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
+#include <fstream>
+
+namespace inviwo {
+
+namespace {
+
+/**
+ * Fill \p ram with the values stored at \p offset in \p fileName
+ */
+void readValues(const std::string& fileName, size_t offset, BufferRAM& ram) {
+    auto in = filesystem::ifstream(fileName, std::ios::in | std::ios::binary);
+    if (!in.is_open()) {
+        throw FileException("Could not open file \"" + fileName + "\"",
+                            IVW_CONTEXT_CUSTOM("BinaryDataFrameReader"));
+    }
+    in.seekg(static_cast<std::streamoff>(offset));
+    in.read(static_cast<char*>(ram.getData()),
+            static_cast<std::streamsize>(ram.getSize() * ram.getSizeOfElement()));
+    if (!in) {
+        throw DataReaderException("Could not read column data from \"" + fileName + "\"",
+                                  IVW_CONTEXT_CUSTOM("BinaryDataFrameReader"));
+    }
+}
+
+template <typename T>
+T read(std::istream& in) {
+    T value{};
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+std::string readString(std::istream& in, size_t maxSize) {
+    const auto size = read<std::uint32_t>(in);
+    if (!in || size > maxSize) {
+        in.setstate(std::ios::failbit);
+        return {};
+    }
+    std::string str(size, '\0');
+    in.read(&str[0], size);
+    return str;
+}
+
+/**
+ * Reads the values of a single column into a BufferRAM.
+ */
+class ColumnLoader : public DiskRepresentationLoader<BufferRepresentation> {
+public:
+    ColumnLoader(const std::string& fileName, size_t offset)
+        : fileName_{fileName}, offset_{offset} {}
+    virtual ColumnLoader* clone() const override { return new ColumnLoader(*this); }
+
+    virtual std::shared_ptr<BufferRepresentation> createRepresentation(
+        const BufferRepresentation& src) const override {
+        auto ram = createBufferRAM(src.getSize(), src.getDataFormat(), src.getBufferUsage(),
+                                   src.getBufferTarget());
+        read(*ram);
+        return ram;
+    }
+    virtual void updateRepresentation(std::shared_ptr<BufferRepresentation> dest,
+                                      const BufferRepresentation& src) const override {
+        auto ram = std::static_pointer_cast<BufferRAM>(dest);
+        if (ram->getSize() != src.getSize()) ram->setSize(src.getSize());
+        read(*ram);
+    }
+
+private:
+    void read(BufferRAM& ram) const { readValues(fileName_, offset_, ram); }
+
+    std::string fileName_;
+    size_t offset_;
+};
+
+template <typename T>
+std::shared_ptr<Buffer<T>> createDiskBuffer(const BinaryDataFrameReader::ColumnInfo& info,
+                                            const std::string& fileName) {
+    auto disk = std::make_shared<BufferDisk>(fileName, info.rows, info.format);
+    disk->setLoader(new ColumnLoader(fileName, info.offset));
+    auto buffer = std::make_shared<Buffer<T>>(info.rows);
+    buffer->addRepresentation(disk);
+    return buffer;
+}
+
+struct ColumnDispatcher {
+    template <typename Result, typename Format>
+    Result operator()(const BinaryDataFrameReader::ColumnInfo& info, const std::string& fileName) {
+        using T = typename Format::type;
+        return std::make_shared<TemplateColumn<T>>(info.header,
+                                                   createDiskBuffer<T>(info, fileName));
+    }
+};
+
+}  // namespace
+
+std::vector<size_t> BinaryDataFrameReader::ColumnInfo::blocksInRange(double min, double max,
+                                                                    size_t component) const {
+    std::vector<size_t> blocks;
+    if (component >= format->getComponents()) return blocks;
+    for (size_t i = 0; i < blockMin.size(); ++i) {
+        if (blockMax[i][component] >= min && blockMin[i][component] <= max) blocks.push_back(i);
+    }
+    return blocks;
+}
+
+BinaryDataFrameReader::BinaryDataFrameReader() {
+    addExtension(FileExtension("ivdf", "Inviwo DataFrame"));
+}
+
+BinaryDataFrameReader* BinaryDataFrameReader::clone() const {
+    return new BinaryDataFrameReader(*this);
+}
+
+std::shared_ptr<DataFrame> BinaryDataFrameReader::readData(const std::string& fileName) {
+    const auto info = readInfo(fileName);
+
+    auto dataFrame = std::make_shared<DataFrame>();
+    for (const auto& col : info.columns) {
+        if (col.categorical) {
+            dataFrame->addColumn(std::make_shared<CategoricalColumn>(
+                col.header, createDiskBuffer<std::uint32_t>(col, fileName), col.categories));
+        } else {
+            dataFrame->addColumn(
+                dispatching::dispatch<std::shared_ptr<Column>, dispatching::filter::All>(
+                    col.format->getId(), ColumnDispatcher{}, col, fileName));
+        }
+    }
+    dataFrame->updateIndexBuffer();
+    return dataFrame;
+}
+
+std::shared_ptr<BufferRAM> BinaryDataFrameReader::readBlock(const std::string& fileName,
+                                                           const FileInfo& info, size_t column,
+                                                           size_t block) {
+    if (column >= info.columns.size()) {
+        throw RangeException("Column " + toString(column) + " is out of range",
+                             IVW_CONTEXT_CUSTOM("BinaryDataFrameReader"));
+    }
+    const auto& col = info.columns[column];
+    const auto begin = block * info.blockSize;
+    if (block >= col.blockMin.size() || begin >= col.rows) {
+        throw RangeException("Block " + toString(block) + " is out of range",
+                             IVW_CONTEXT_CUSTOM("BinaryDataFrameReader"));
+    }
+    const auto rows = std::min(info.blockSize, col.rows - begin);
+
+    auto ram = createBufferRAM(rows, col.format, BufferUsage::Static, BufferTarget::Data);
+    readValues(fileName, col.offset + begin * col.format->getSize(), *ram);
+    return ram;
+}
+
+auto BinaryDataFrameReader::readInfo(const std::string& fileName) -> FileInfo {
+    auto in = filesystem::ifstream(fileName, std::ios::in | std::ios::binary);
+    if (!in.is_open()) {
+        throw FileException("Could not open file \"" + fileName + "\"", IVW_CONTEXT);
+    }
+    const auto fail = [&](const std::string& reason) {
+        throw DataReaderException("Invalid DataFrame file \"" + fileName + "\": " + reason,
+                                  IVW_CONTEXT);
+    };
+
+    in.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<size_t>(in.tellg());
+    constexpr size_t footerSize = sizeof(std::uint64_t) + magic.size();
+    if (fileSize < 4 * sizeof(std::uint32_t) + footerSize) fail("file too small");
+
+    in.seekg(0, std::ios::beg);
+    if (read<std::array<char, 4>>(in) != magic) fail("missing file signature");
+    if (read<std::uint32_t>(in) > version) fail("unsupported version");
+    if (read<std::uint32_t>(in) != byteOrderMark) fail("mismatching byte order");
+
+    in.seekg(static_cast<std::streamoff>(fileSize - footerSize));
+    const auto headerOffset = static_cast<size_t>(read<std::uint64_t>(in));
+    if (read<std::array<char, 4>>(in) != magic) fail("missing file signature");
+    if (headerOffset > fileSize - footerSize) fail("invalid header offset");
+    const size_t headerSize = fileSize - footerSize - headerOffset;
+
+    in.seekg(static_cast<std::streamoff>(headerOffset));
+    FileInfo info;
+    info.blockSize = static_cast<size_t>(read<std::uint64_t>(in));
+    const auto columnCount = read<std::uint32_t>(in);
+    if (!in || info.blockSize == 0 || columnCount > headerSize) fail("invalid header");
+    info.columns.resize(columnCount);
+
+    for (auto& col : info.columns) {
+        col.header = readString(in, headerSize);
+        const auto formatId = read<std::uint32_t>(in);
+        col.categorical = read<std::uint8_t>(in) != 0;
+        if (col.categorical) {
+            const auto count = read<std::uint32_t>(in);
+            if (!in || count > headerSize) fail("truncated header");
+            col.categories.resize(count);
+            for (auto& category : col.categories) category = readString(in, headerSize);
+        }
+        col.offset = static_cast<size_t>(read<std::uint64_t>(in));
+        col.rows = static_cast<size_t>(read<std::uint64_t>(in));
+        if (!in) fail("truncated header");
+
+        if (formatId == 0 ||
+            formatId >= static_cast<std::uint32_t>(DataFormatId::NumberOfFormats)) {
+            fail("unknown format of column \"" + col.header + "\"");
+        }
+        col.format = DataFormatBase::get(static_cast<DataFormatId>(formatId));
+        if (col.categorical && col.format != DataUInt32::get()) {
+            fail("categorical column \"" + col.header + "\" is not of type UInt32");
+        }
+        if (col.offset > headerOffset ||
+            col.rows > (headerOffset - col.offset) / col.format->getSize()) {
+            fail("column \"" + col.header + "\" is out of bounds");
+        }
+
+        const auto blocks = (col.rows + info.blockSize - 1) / info.blockSize;
+        if (blocks > headerSize / (2 * sizeof(dvec4))) fail("truncated header");
+        col.blockMin.reserve(blocks);
+        col.blockMax.reserve(blocks);
+        for (size_t i = 0; i < blocks; ++i) {
+            col.blockMin.push_back(read<dvec4>(in));
+            col.blockMax.push_back(read<dvec4>(in));
+        }
+        if (!in) fail("truncated header");
+    }
+    return info;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,160 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/io/binarydataframewriter.h>
+#include <inviwo/dataframe/io/binarydataframereader.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <fstream>
+#include <limits>
+#include <tuple>
+
+namespace inviwo {
+
+namespace dataframeutil {
+
+namespace {
+
+constexpr size_t alignment = 64;
+
+template <typename T>
+void write(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeString(std::ostream& out, const std::string& str) {
+    write(out, static_cast<std::uint32_t>(str.size()));
+    out.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+/**
+ * Component wise min and max of each block of rows, NaN values are ignored.
+ */
+std::pair<std::vector<dvec4>, std::vector<dvec4>> blockRanges(const BufferRAM& ram,
+                                                              size_t blockSize) {
+    return ram.dispatch<std::pair<std::vector<dvec4>, std::vector<dvec4>>>([&](auto br) {
+        using ValueType = util::PrecisionValueType<decltype(br)>;
+        constexpr size_t components = util::flat_extent<ValueType>::value;
+        const auto& data = br->getDataContainer();
+
+        std::pair<std::vector<dvec4>, std::vector<dvec4>> ranges;
+        for (size_t begin = 0; begin < data.size(); begin += blockSize) {
+            const auto end = std::min(begin + blockSize, data.size());
+            dvec4 min{0.0};
+            dvec4 max{0.0};
+            for (size_t c = 0; c < components; ++c) {
+                min[c] = std::numeric_limits<double>::infinity();
+                max[c] = -std::numeric_limits<double>::infinity();
+            }
+            for (size_t i = begin; i < end; ++i) {
+                for (size_t c = 0; c < components; ++c) {
+                    const auto v = static_cast<double>(util::glmcomp(data[i], c));
+                    if (v < min[c]) min[c] = v;
+                    if (v > max[c]) max[c] = v;
+                }
+            }
+            ranges.first.push_back(min);
+            ranges.second.push_back(max);
+        }
+        return ranges;
+    });
+}
+
+}  // namespace
+
+void writeBinaryDataFrame(const DataFrame& dataFrame, const std::string& fileName,
+                          size_t blockSize) {
+    using Reader = BinaryDataFrameReader;
+
+    auto out = filesystem::ofstream(fileName, std::ios::out | std::ios::binary);
+    if (!out.is_open()) {
+        throw FileException("Could not open file \"" + fileName + "\" for writing", IVW_CONTEXT);
+    }
+
+    write(out, Reader::magic);
+    write(out, Reader::version);
+    write(out, Reader::byteOrderMark);
+    write(out, std::uint32_t{0});
+
+    std::vector<Reader::ColumnInfo> columns;
+    for (const auto& col : dataFrame) {
+        if (col == dataFrame.getIndexColumn()) continue;
+
+        const auto ram = col->getBuffer()->getRepresentation<BufferRAM>();
+
+        const auto pos = static_cast<size_t>(out.tellp());
+        const std::string padding((alignment - pos % alignment) % alignment, '\0');
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+        Reader::ColumnInfo info;
+        info.header = col->getHeader();
+        info.format = ram->getDataFormat();
+        if (auto cc = dynamic_cast<const CategoricalColumn*>(col.get())) {
+            info.categorical = true;
+            info.categories = cc->getCategories();
+        }
+        info.offset = pos + padding.size();
+        info.rows = ram->getSize();
+        std::tie(info.blockMin, info.blockMax) = blockRanges(*ram, blockSize);
+        columns.push_back(std::move(info));
+
+        out.write(static_cast<const char*>(ram->getData()),
+                  static_cast<std::streamsize>(ram->getSize() * ram->getSizeOfElement()));
+    }
+
+    const auto headerOffset = static_cast<std::uint64_t>(out.tellp());
+    write(out, static_cast<std::uint64_t>(blockSize));
+    write(out, static_cast<std::uint32_t>(columns.size()));
+    for (const auto& info : columns) {
+        writeString(out, info.header);
+        write(out, static_cast<std::uint32_t>(info.format->getId()));
+        write(out, static_cast<std::uint8_t>(info.categorical));
+        if (info.categorical) {
+            write(out, static_cast<std::uint32_t>(info.categories.size()));
+            for (const auto& category : info.categories) writeString(out, category);
+        }
+        write(out, static_cast<std::uint64_t>(info.offset));
+        write(out, static_cast<std::uint64_t>(info.rows));
+        for (size_t i = 0; i < info.blockMin.size(); ++i) {
+            write(out, info.blockMin[i]);
+            write(out, info.blockMax[i]);
+        }
+    }
+    write(out, headerOffset);
+    write(out, Reader::magic);
+
+    if (!out) {
+        throw FileException("Could not write to file \"" + fileName + "\"", IVW_CONTEXT);
+    }
+}
+
+}  // namespace dataframeutil
+
+}  // namespace inviwo
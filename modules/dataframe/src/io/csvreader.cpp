@@ -31,13 +31,525 @@
 
 #include <inviwo/dataframe/datastructures/column.h>
 #include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/io/memorymappedfile.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/stringconversion.h>
 
 #include <fstream>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
 
 namespace inviwo {
 
+namespace {
+
+constexpr size_t exampleRowCount = 50;
+// The smallest part of a file that is worth parsing in a task of its own
+constexpr size_t minChunkSize = size_t{1} << 18;
+
+bool isSpace(char ch) { return std::isspace(static_cast<unsigned char>(ch)) != 0; }
+bool isDigit(char ch) { return ch >= '0' && ch <= '9'; }
+
+std::string_view trimmed(std::string_view str) {
+    while (!str.empty() && isSpace(str.front())) str.remove_prefix(1);
+    while (!str.empty() && isSpace(str.back())) str.remove_suffix(1);
+    return str;
+}
+
+/**
+ * Parse a decimal floating point number with an optional exponent from the beginning of \p str,
+ * leading white space is skipped like for std::istream. The number is accumulated in an integer
+ * mantissa and scaled once, which is a lot faster than going through a stream.
+ * @return a pointer past the last parsed character, or nullptr if there is no number
+ */
+const char* parseFloat(std::string_view str, float& result) {
+    static constexpr std::array<double, 23> powers = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr int maxDigits = 19;  // fits in a 64 bit integer
+
+    const char* p = str.data();
+    const char* const end = p + str.size();
+    while (p != end && isSpace(*p)) ++p;
+
+    bool negative = false;
+    if (p != end && (*p == '+' || *p == '-')) {
+        negative = *p == '-';
+        ++p;
+    }
+
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool anyDigits = false;
+    for (; p != end && isDigit(*p); ++p) {
+        anyDigits = true;
+        if (digits < maxDigits) {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+            if (mantissa != 0) ++digits;
+        } else {
+            ++exponent;
+        }
+    }
+    if (p != end && *p == '.') {
+        ++p;
+        for (; p != end && isDigit(*p); ++p) {
+            anyDigits = true;
+            if (digits < maxDigits) {
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+                if (mantissa != 0) ++digits;
+                --exponent;
+            }
+        }
+    }
+    if (!anyDigits) return nullptr;
+
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        const char* e = p + 1;
+        bool negativeExponent = false;
+        if (e != end && (*e == '+' || *e == '-')) {
+            negativeExponent = *e == '-';
+            ++e;
+        }
+        // a stream fails on an exponent without digits
+        if (e == end || !isDigit(*e)) return nullptr;
+        int value = 0;
+        for (; e != end && isDigit(*e); ++e) {
+            if (value < 100000) value = value * 10 + (*e - '0');
+        }
+        exponent += negativeExponent ? -value : value;
+        p = e;
+    }
+
+    auto value = static_cast<double>(mantissa);
+    if (mantissa != 0 && exponent != 0) {
+        if (exponent > 0 && exponent < static_cast<int>(powers.size())) {
+            value *= powers[static_cast<size_t>(exponent)];
+        } else if (exponent < 0 && -exponent < static_cast<int>(powers.size())) {
+            value /= powers[static_cast<size_t>(-exponent)];
+        } else {
+            value *= std::pow(10.0, exponent);
+        }
+    }
+    result = static_cast<float>(negative ? -value : value);
+    return p;
+}
+
+float toFloat(std::string_view str) {
+    float value;
+    return parseFloat(str, value) ? value : std::numeric_limits<float>::quiet_NaN();
+}
+
+/**
+ * Unique strings in order of first appearance, the same mapping as CategoricalColumn::add
+ */
+class Categories {
+public:
+    std::uint32_t getId(std::string_view str) {
+        auto it = ids_.find(str);
+        if (it != ids_.end()) return it->second;
+        const auto id = static_cast<std::uint32_t>(names_.size());
+        // the deque never moves its elements, the keys stay valid
+        names_.emplace_back(str);
+        ids_.emplace(names_.back(), id);
+        return id;
+    }
+    const std::deque<std::string>& getNames() const { return names_; }
+
+private:
+    std::deque<std::string> names_;
+    std::unordered_map<std::string_view, std::uint32_t> ids_;
+};
+
+/**
+ * Splits CSV data into records and fields. The rules are the same as the ones of the stream based
+ * CSVReader::readData, fields keep their quotes, line breaks are normalized to '\n' within fields,
+ * all fields except for the first one are trimmed and an empty field after the last column is
+ * ignored.
+ */
+class CSVParser {
+public:
+    enum class Row { Fields, Empty, End, Error };
+
+    CSVParser(const std::array<char, 256>& classes, const char* begin, const char* end)
+        : classes_{classes}, pos_{begin}, end_{end} {}
+
+    Row nextRow(size_t maxColCount = std::numeric_limits<size_t>::max()) {
+        fields_.clear();
+        rowLine_ = lines_;
+
+        std::string_view value;
+        auto field = nextField(value);
+        if (field == Field::Error) return Row::Error;
+        if (eof_ && value.empty()) return Row::End;
+        if (value.empty() && field == Field::LineBreak) return Row::Empty;
+
+        fields_.push_back(value);
+        while (field == Field::Delimiter && !eof_) {
+            field = nextField(value);
+            if (field == Field::Error) return Row::Error;
+            fields_.push_back(trimmed(value));
+        }
+
+        if (fields_.back().empty() && fields_.size() - 1 == maxColCount) {
+            fields_.pop_back();
+        } else if (fields_.size() != maxColCount &&
+                   maxColCount != std::numeric_limits<size_t>::max()) {
+            error_ = "Column counts do not match (line " + std::to_string(rowLine_ + lineOffset_) +
+                     ": " + std::to_string(fields_.size()) + " fields; DataFrame has " +
+                     std::to_string(maxColCount) + " columns)";
+            return Row::Error;
+        }
+        return Row::Fields;
+    }
+
+    const std::vector<std::string_view>& fields() const { return fields_; }
+    const char* pos() const { return pos_; }
+    // Number of line breaks consumed so far
+    size_t lines() const { return lines_; }
+    // Line break count at the beginning of the last row
+    size_t rowLine() const { return rowLine_; }
+    // Line number of the first line, only used in error messages
+    void setLineOffset(size_t offset) { lineOffset_ = offset; }
+    const std::string& error() const { return error_; }
+
+    enum CharClass : char { Other = 0, Delimiter, Quote, CR, LF };
+    static std::array<char, 256> classify(const std::string& delimiters) {
+        std::array<char, 256> classes{};
+        for (auto ch : delimiters) classes[static_cast<unsigned char>(ch)] = Delimiter;
+        classes[static_cast<unsigned char>('"')] = Quote;
+        classes[static_cast<unsigned char>('\r')] = CR;
+        classes[static_cast<unsigned char>('\n')] = LF;
+        return classes;
+    }
+
+private:
+    enum class Field { Delimiter, LineBreak, End, Error };
+
+    char classOf(char ch) const { return classes_[static_cast<unsigned char>(ch)]; }
+
+    Field nextField(std::string_view& value) {
+        const char* const begin = pos_;
+        size_t quoteCount = 0;
+        size_t quoteBeginLine = 0;
+        char prev = 0;
+        bool normalize = false;  // the value contains CR line breaks which should become LF
+
+        while (pos_ != end_) {
+            if (classOf(*pos_) == Other) {
+                while (pos_ != end_ && classOf(*pos_) == Other) ++pos_;
+                prev = pos_[-1];
+                continue;
+            }
+            const char* const current = pos_++;
+            const auto type = classOf(*current);
+            const bool linebreak = type == CR || type == LF;
+            if (linebreak) {
+                if (type == CR) {
+                    // consume potential LF following CR, a stream would set eof on the peek
+                    if (pos_ != end_ && *pos_ == '\n') {
+                        ++pos_;
+                    } else if (pos_ == end_) {
+                        eof_ = true;
+                    }
+                }
+                ++lines_;
+                // a line break inside quotes is part of the value
+                if ((quoteCount & 1) != 0) {
+                    normalize |= type == CR;
+                    prev = '\n';
+                    continue;
+                }
+            }
+            if (type == Quote) {
+                if (quoteCount == 0) quoteBeginLine = lines_;
+                ++quoteCount;
+            } else if (type == Delimiter || linebreak) {
+                // a delimiter/line break ends the field if it is not enclosed by quotes
+                if ((quoteCount == 0) || ((prev == '"') && ((quoteCount & 1) == 0))) {
+                    value = makeValue(begin, current, normalize);
+                    return linebreak ? Field::LineBreak : Field::Delimiter;
+                }
+            }
+            normalize |= type == CR;
+            prev = linebreak ? '\n' : *current;
+        }
+
+        eof_ = true;
+        if ((quoteCount & 1) != 0) {
+            error_ = "Unmatched quotes (starting in line " +
+                     std::to_string(quoteBeginLine + lineOffset_) + ")";
+            return Field::Error;
+        }
+        value = makeValue(begin, end_, normalize);
+        return Field::End;
+    }
+
+    std::string_view makeValue(const char* begin, const char* end, bool normalize) {
+        if (!normalize) return std::string_view(begin, static_cast<size_t>(end - begin));
+
+        // Replace CR LF and CR by LF, the value is kept until the next row is parsed
+        while (scratch_.size() <= fields_.size()) scratch_.emplace_back();
+        auto& str = scratch_[fields_.size()];
+        str.clear();
+        for (auto it = begin; it != end; ++it) {
+            if (*it == '\r') {
+                str.push_back('\n');
+                if (it + 1 != end && it[1] == '\n') ++it;
+            } else {
+                str.push_back(*it);
+            }
+        }
+        return str;
+    }
+
+    const std::array<char, 256>& classes_;
+    const char* pos_;
+    const char* end_;
+    bool eof_ = false;
+    size_t lines_ = 0;
+    size_t rowLine_ = 0;
+    size_t lineOffset_ = 1;
+    std::string error_;
+    std::vector<std::string_view> fields_;
+    std::deque<std::string> scratch_;
+};
+
+/**
+ * The rows of one part of the data. A chunk starts at a guessed record boundary, if the previous
+ * chunk does not end exactly there the guess was wrong and the chunk has to be scanned again.
+ */
+struct Chunk {
+    const char* begin = nullptr;
+    const char* limit = nullptr;  // no record is started at or after the limit
+    const char* end = nullptr;    // where the parsing actually stopped
+    size_t line = 0;              // line number of the first line, only used in error messages
+    size_t lines = 0;
+    size_t rows = 0;
+    size_t offset = 0;  // index of the first row of the chunk in the data frame
+    std::vector<Categories> categories;  // the local categories of each column
+    std::optional<std::string> error;
+};
+
+/**
+ * Split the records of the chunk starting at \p begin and call \p onRow(fields, row) for each
+ * non-empty row, where row is the index of the row within the chunk.
+ */
+template <typename OnRow>
+void scanChunk(Chunk& chunk, const char* begin, size_t line, const char* dataEnd,
+               const std::array<char, 256>& classes, size_t columnCount, OnRow&& onRow) {
+    chunk.begin = begin;
+    chunk.line = line;
+    chunk.rows = 0;
+    chunk.error.reset();
+
+    CSVParser parser(classes, begin, dataEnd);
+    parser.setLineOffset(line);
+    while (parser.pos() < chunk.limit) {
+        const auto row = parser.nextRow(columnCount);
+        if (row == CSVParser::Row::End) {
+            break;
+        } else if (row == CSVParser::Row::Error) {
+            chunk.error = parser.error();
+            break;
+        } else if (row == CSVParser::Row::Empty) {
+            continue;
+        }
+        const auto& fields = parser.fields();
+        // Do not add empty rows, i.e. rows with only delimiters (,,,,)
+        if (std::all_of(fields.begin(), fields.end(), [](auto f) { return f.empty(); })) {
+            continue;
+        }
+        onRow(fields, chunk.rows);
+        ++chunk.rows;
+    }
+    chunk.end = parser.pos();
+    chunk.lines = parser.lines();
+}
+
+// The position after the first line break at or after pos
+const char* nextLine(const char* pos, const char* end) {
+    while (pos != end && *pos != '\n' && *pos != '\r') ++pos;
+    if (pos != end && *pos == '\r') ++pos;
+    if (pos != end && *pos == '\n') ++pos;
+    return pos;
+}
+
+std::shared_ptr<DataFrame> parseCSV(std::string_view data, const std::string& delimiters,
+                                    bool firstRowHeader) {
+    // Skip BOM if it exists. Added by for example Excel when saving csv files.
+    if (data.substr(0, 3) == "\xEF\xBB\xBF") data.remove_prefix(3);
+
+    const auto classes = CSVParser::classify(delimiters);
+    const char* const dataEnd = data.data() + data.size();
+
+    std::vector<std::string> headers;
+    size_t maxColCount = std::numeric_limits<size_t>::max();
+    CSVParser headerParser(classes, data.data(), dataEnd);
+    if (firstRowHeader) {
+        const auto row = headerParser.nextRow();
+        if (row == CSVParser::Row::Error) {
+            throw CSVDataReaderException(headerParser.error(), IVW_CONTEXT_CUSTOM("CSVReader"));
+        } else if (row != CSVParser::Row::Fields) {
+            throw CSVDataReaderException("Empty file, column headers not found",
+                                         IVW_CONTEXT_CUSTOM("CSVReader"));
+        }
+        for (auto field : headerParser.fields()) headers.emplace_back(field);
+        maxColCount = headers.size();
+    }
+    const char* const dataBegin = headerParser.pos();
+    const size_t dataLine = headerParser.lines() + 1;
+
+    // Use the first rows to figure out the column types
+    std::vector<std::vector<std::string>> exampleRows;
+    std::vector<size_t> exampleLineNumbers;
+    CSVParser exampleParser(classes, dataBegin, dataEnd);
+    exampleParser.setLineOffset(dataLine);
+    for (size_t i = 0; i < exampleRowCount; ++i) {
+        const auto row = exampleParser.nextRow(maxColCount);
+        if (row == CSVParser::Row::End) {
+            break;
+        } else if (row == CSVParser::Row::Error) {
+            throw CSVDataReaderException(exampleParser.error(), IVW_CONTEXT_CUSTOM("CSVReader"));
+        } else if (row == CSVParser::Row::Fields) {
+            exampleRows.emplace_back(exampleParser.fields().begin(),
+                                     exampleParser.fields().end());
+            exampleLineNumbers.push_back(exampleParser.rowLine() + dataLine);
+        }
+    }
+    if (exampleRows.empty()) {
+        throw CSVDataReaderException("Empty file, no data", IVW_CONTEXT_CUSTOM("CSVReader"));
+    }
+
+    if (!firstRowHeader) {
+        // assign default column headers
+        for (size_t i = 0; i < exampleRows.front().size(); ++i) {
+            headers.push_back(std::string("Column ") + std::to_string(i + 1));
+        }
+        maxColCount = headers.size();
+    }
+    for (size_t i = 0; i < exampleRows.size(); ++i) {
+        if (exampleRows[i].size() != maxColCount) {
+            throw CSVDataReaderException(
+                "Column counts do not match (line " + std::to_string(exampleLineNumbers[i]) + ": " +
+                    std::to_string(exampleRows[i].size()) + " fields; DataFrame has " +
+                    std::to_string(maxColCount) + " columns)",
+                IVW_CONTEXT_CUSTOM("CSVReader"));
+        }
+    }
+
+    std::vector<bool> categorical;
+    {
+        const auto types = createDataFrame(exampleRows, headers);
+        for (size_t i = 0; i < headers.size(); ++i) {
+            categorical.push_back(
+                dynamic_cast<const CategoricalColumn*>(types->getColumn(i + 1).get()) != nullptr);
+        }
+    }
+
+    // Split the data into chunks at (guessed) record boundaries and parse them in parallel
+    const size_t dataSize = static_cast<size_t>(dataEnd - dataBegin);
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    const size_t nChunks =
+        std::clamp(dataSize / minChunkSize, size_t{1}, 4 * std::max(poolSize, size_t{1}));
+
+    std::vector<Chunk> chunks(nChunks);
+    for (size_t i = 0; i < nChunks; ++i) {
+        chunks[i].begin =
+            i == 0 ? dataBegin : nextLine(dataBegin + (dataSize * i) / nChunks, dataEnd);
+    }
+    for (size_t i = 0; i < nChunks; ++i) {
+        chunks[i].limit = i + 1 < nChunks ? chunks[i + 1].begin : dataEnd;
+    }
+
+    // The rows are counted first, without converting any values, so that the columns can be
+    // allocated once and every chunk can write its values directly to its final position.
+    // The line numbers are not known in advance, they are only used for error messages.
+    const auto count = [&](Chunk& chunk, const char* begin, size_t line) {
+        scanChunk(chunk, begin, line, dataEnd, classes, headers.size(), [](auto&, size_t) {});
+    };
+    util::forEachTask(nChunks, [&](size_t i) { count(chunks[i], chunks[i].begin, dataLine); });
+
+    // Make sure every chunk starts where the previous one ended, a guessed boundary inside of a
+    // quoted field makes the chunk invalid. Chunks with errors are scanned again to get the right
+    // line numbers.
+    const char* expected = dataBegin;
+    size_t line = dataLine;
+    size_t rows = 0;
+    for (auto& chunk : chunks) {
+        if (chunk.begin != expected || chunk.error) count(chunk, expected, line);
+        if (chunk.error) {
+            throw CSVDataReaderException(*chunk.error, IVW_CONTEXT_CUSTOM("CSVReader"));
+        }
+        chunk.offset = rows;
+        expected = chunk.end;
+        line += chunk.lines;
+        rows += chunk.rows;
+    }
+
+    std::vector<std::vector<float>> values(headers.size());
+    std::vector<std::vector<std::uint32_t>> ids(headers.size());
+    for (size_t col = 0; col < headers.size(); ++col) {
+        if (categorical[col]) {
+            ids[col].resize(rows);
+        } else {
+            values[col].resize(rows);
+        }
+    }
+
+    // Convert the values, categorical columns get the ids of the local categories of the chunk
+    util::forEachTask(nChunks, [&](size_t i) {
+        auto& chunk = chunks[i];
+        chunk.categories.resize(headers.size());
+        scanChunk(chunk, chunk.begin, chunk.line, dataEnd, classes, headers.size(),
+                  [&](const std::vector<std::string_view>& fields, size_t row) {
+                      const size_t index = chunk.offset + row;
+                      for (size_t col = 0; col < fields.size(); ++col) {
+                          if (categorical[col]) {
+                              ids[col][index] = chunk.categories[col].getId(fields[col]);
+                          } else {
+                              values[col][index] = toFloat(fields[col]);
+                          }
+                      }
+                  });
+    });
+
+    auto dataFrame = std::make_shared<DataFrame>(0u);
+    for (size_t col = 0; col < headers.size(); ++col) {
+        if (categorical[col]) {
+            // Map the local ids of each chunk to the ids of the whole column
+            Categories categories;
+            for (auto& chunk : chunks) {
+                std::vector<std::uint32_t> toGlobal;
+                for (const auto& name : chunk.categories[col].getNames()) {
+                    toGlobal.push_back(categories.getId(name));
+                }
+                const auto begin = ids[col].begin() + chunk.offset;
+                std::transform(begin, begin + chunk.rows, begin,
+                               [&](std::uint32_t id) { return toGlobal[id]; });
+                chunk.categories[col] = Categories{};
+            }
+            const auto& names = categories.getNames();
+            dataFrame->addColumn(std::make_shared<CategoricalColumn>(
+                headers[col], std::move(ids[col]),
+                std::vector<std::string>(names.begin(), names.end())));
+        } else {
+            dataFrame->addColumn(headers[col], std::move(values[col]));
+        }
+    }
+    dataFrame->updateIndexBuffer();
+    return dataFrame;
+}
+
+}  // namespace
+
 CSVDataReaderException::CSVDataReaderException(const std::string& message, ExceptionContext context)
     : DataReaderException("CSVReader: " + message, context) {}
 
@@ -65,8 +577,11 @@ std::shared_ptr<DataFrame> CSVReader::readData(const std::string& fileName) {
     if (len == std::streampos(0)) {
         throw CSVDataReaderException("Empty file, no data", IVW_CONTEXT);
     }
+    file.close();
 
-    return readData(file);
+    MemoryMappedFile mapping(fileName, 0, static_cast<size_t>(len));
+    return parseCSV({static_cast<const char*>(mapping.data()), mapping.size()}, delimiters_,
+                    firstRowHeader_);
 }
 
 std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
@@ -29,6 +29,7 @@
 
 #include <inviwo/dataframe/processors/dataframeexporter.h>
 #include <inviwo/dataframe/datastructures/dataframeutil.h>
+#include <inviwo/dataframe/io/binarydataframewriter.h>
 
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/ostreamjoiner.h>
@@ -40,17 +41,18 @@ namespace inviwo {
 
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
 const ProcessorInfo DataFrameExporter::processorInfo_{
-    "org.inviwo.DataFrameExporter",      // Class identifier
-    "DataFrame Exporter",                // Display name
-    "Data Output",                       // Category
-    CodeState::Stable,                   // Code state
-    "CPU, DataFrame, Export, CSV, XML",  // Tags
+    "org.inviwo.DataFrameExporter",              // Class identifier
+    "DataFrame Exporter",                        // Display name
+    "Data Output",                               // Category
+    CodeState::Stable,                           // Code state
+    "CPU, DataFrame, Export, CSV, XML, Binary",  // Tags
 };
 
 const ProcessorInfo DataFrameExporter::getProcessorInfo() const { return processorInfo_; }
 
 FileExtension DataFrameExporter::csvExtension_ = FileExtension("csv", "CSV");
 FileExtension DataFrameExporter::xmlExtension_ = FileExtension("xml", "XML");
+FileExtension DataFrameExporter::ivdfExtension_ = FileExtension("ivdf", "Inviwo DataFrame");
 
 DataFrameExporter::DataFrameExporter()
     : Processor()
@@ -68,6 +70,7 @@ DataFrameExporter::DataFrameExporter()
     exportFile_.clearNameFilters();
     exportFile_.addNameFilter(csvExtension_);
     exportFile_.addNameFilter(xmlExtension_);
+    exportFile_.addNameFilter(ivdfExtension_);
 
     addPort(dataFrame_);
     addProperty(exportFile_);
@@ -80,8 +83,9 @@ DataFrameExporter::DataFrameExporter()
 
     exportFile_.setAcceptMode(AcceptMode::Save);
     exportFile_.onChange([this]() {
-        separateVectorTypesIntoColumns_.setReadOnly(exportFile_.getSelectedExtension().extension_ ==
-                                                    xmlExtension_.extension_);
+        const auto& ext = exportFile_.getSelectedExtension().extension_;
+        separateVectorTypesIntoColumns_.setReadOnly(ext == xmlExtension_.extension_ ||
+                                                    ext == ivdfExtension_.extension_);
     });
     exportButton_.onChange([&]() { export_ = true; });
 
@@ -100,6 +104,8 @@ void DataFrameExporter::exportNow() {
     }
     if (exportFile_.getSelectedExtension() == xmlExtension_) {
         exportAsXML();
+    } else if (exportFile_.getSelectedExtension() == ivdfExtension_) {
+        exportAsBinary();
     } else if (exportFile_.getSelectedExtension() == csvExtension_) {
         exportAsCSV(separateVectorTypesIntoColumns_);
     } else {
@@ -215,4 +221,9 @@ void DataFrameExporter::exportAsXML() {
     LogInfo("XML file exported to " << exportFile_);
 }
 
+void DataFrameExporter::exportAsBinary() {
+    dataframeutil::writeBinaryDataFrame(*dataFrame_.getData(), exportFile_);
+    LogInfo("DataFrame exported to " << exportFile_);
+}
+
 }  // namespace inviwo
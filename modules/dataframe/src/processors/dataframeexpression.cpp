@@ -0,0 +1,90 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/processors/dataframeexpression.h>
+#include <inviwo/dataframe/datastructures/columnexpression.h>
+#include <inviwo/dataframe/datastructures/dataframeutil.h>
+
+namespace inviwo {
+
+// The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
+const ProcessorInfo DataFrameExpression::processorInfo_{
+    "org.inviwo.DataFrameExpression",      // Class identifier
+    "DataFrame Expression",                // Display name
+    "Data Operation",                      // Category
+    CodeState::Experimental,               // Code state
+    "CPU, DataFrame, Expression, Filter",  // Tags
+};
+const ProcessorInfo DataFrameExpression::getProcessorInfo() const { return processorInfo_; }
+
+DataFrameExpression::DataFrameExpression()
+    : Processor()
+    , inport_("inport")
+    , outport_("outport")
+    , expression_("expression", "Expression", "")
+    , mode_{"mode",
+            "Mode",
+            {{"addColumn", "Add Column", Mode::AddColumn},
+             {"filterRows", "Filter Rows", Mode::FilterRows}},
+            0}
+    , columnName_("columnName", "Column Name", "Expression") {
+
+    addPort(inport_);
+    addPort(outport_);
+
+    addProperty(expression_);
+    addProperty(mode_);
+    addProperty(columnName_);
+
+    columnName_.visibilityDependsOn(mode_, [](const auto& p) { return p == Mode::AddColumn; });
+}
+
+void DataFrameExpression::process() {
+    auto dataFrame = inport_.getData();
+    if (expression_.get().empty()) {
+        outport_.setData(dataFrame);
+        return;
+    }
+
+    const ColumnExpression expression{expression_.get()};
+    if (mode_ == Mode::FilterRows) {
+        outport_.setData(dataframeutil::selectRows(*dataFrame, expression.filter(*dataFrame)));
+    } else {
+        // The existing columns are shared with the input, only the new column is allocated
+        auto result = std::make_shared<DataFrame>();
+        for (const auto& col : *dataFrame) {
+            if (col != dataFrame->getIndexColumn()) result->addColumn(col);
+        }
+        result->addColumn(expression.createColumn(*dataFrame, columnName_.get()));
+        result->updateIndexBuffer();
+        outport_.setData(result);
+    }
+}
+
+}  // namespace inviwo
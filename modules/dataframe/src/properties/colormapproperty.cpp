@@ -30,8 +30,6 @@
 #include <inviwo/dataframe/properties/colormapproperty.h>
 #include <inviwo/core/network/networklock.h>
 
-#include <modules/base/algorithm/dataminmax.h>
-
 namespace inviwo {
 
 const std::string ColormapProperty::classIdentifier = "org.inviwo.ColormapProperty";
@@ -134,11 +132,8 @@ colorbrewer::Category ColormapProperty::getCategory() const {
 colorbrewer::Family ColormapProperty::getFamily() const { return *colormap; }
 
 void ColormapProperty::setupForColumn(const Column& col) {
-    col.getBuffer()->getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Scalars>(
-        [&](auto ram) -> void {
-            auto minMax = util::bufferMinMax(ram, IgnoreSpecialValues::Yes);
-            setupForColumn(col, minMax.first.x, minMax.second.x);
-        });
+    const auto stats = col.getStatistics();
+    setupForColumn(col, stats->min, stats->max);
 }
 void ColormapProperty::setupForColumn(const Column& col, double minVal, double maxVal) {
     NetworkLock lock(this);
@@ -0,0 +1,112 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/dataframe/io/csvreader.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <random>
+#include <sstream>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+struct CSVFile {
+    util::TempFileHandle file{"bench", ".csv"};
+    size_t bytes = 0;
+};
+
+/**
+ * A CSV file with a header, four float columns and one categorical column with 32 categories
+ */
+std::unique_ptr<CSVFile> makeCSVFile(size_t rows) {
+    auto csv = std::make_unique<CSVFile>();
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+    std::ostringstream ss;
+    ss << "x,y,z,w,category\n";
+    for (size_t i = 0; i < rows; ++i) {
+        ss << dist(gen) << "," << dist(gen) << "," << dist(gen) << "," << dist(gen) << ",cat "
+           << gen() % 32 << "\n";
+    }
+    const auto str = ss.str();
+    std::fwrite(str.data(), 1, str.size(), csv->file);
+    std::fflush(csv->file);
+    csv->bytes = str.size();
+    return csv;
+}
+
+void setCounters(benchmark::State& state, const CSVFile& csv) {
+    const auto bytes = static_cast<double>(csv.bytes);
+    state.counters["Bytes"] = bytes;
+    state.counters["Rate"] = benchmark::Counter(bytes * static_cast<double>(state.iterations()),
+                                                benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+/**
+ * The stream based reader, the file is read into a string stream and parsed one field at a time
+ */
+static void CSVStream(benchmark::State& state) {
+    const auto csv = makeCSVFile(static_cast<size_t>(state.range(0)));
+    CSVReader reader;
+    for (auto _ : state) {
+        auto stream = filesystem::ifstream(csv->file.getFileName());
+        auto dataframe = reader.readData(stream);
+        benchmark::DoNotOptimize(dataframe);
+    }
+    setCounters(state, *csv);
+}
+
+/**
+ * The memory mapped reader, the file is parsed in parallel chunks directly into the columns
+ */
+static void CSVMapped(benchmark::State& state) {
+    const auto csv = makeCSVFile(static_cast<size_t>(state.range(0)));
+    CSVReader reader;
+    for (auto _ : state) {
+        auto dataframe = reader.readData(csv->file.getFileName());
+        benchmark::DoNotOptimize(dataframe);
+    }
+    setCounters(state, *csv);
+}
+
+BENCHMARK(CSVStream)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(CSVMapped)->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+
+#include <warn/pop>
@@ -0,0 +1,183 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/buffer/bufferdisk.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/dataframe/io/binarydataframereader.h>
+#include <inviwo/dataframe/io/binarydataframewriter.h>
+
+#include <cmath>
+#include <cstdio>
+
+namespace inviwo {
+
+namespace {
+
+DataFrame createDataFrame(size_t rows) {
+    DataFrame dataFrame;
+    std::vector<float> floats(rows);
+    std::vector<ivec2> points(rows);
+    auto categorical = dataFrame.addCategoricalColumn("category");
+    for (size_t i = 0; i < rows; ++i) {
+        floats[i] = i == 3 ? std::numeric_limits<float>::quiet_NaN() : 0.5f * static_cast<float>(i);
+        points[i] = ivec2(static_cast<int>(i), -static_cast<int>(i));
+        categorical->add(i % 3 == 0 ? "a" : "b");
+    }
+    dataFrame.addColumn("float", std::move(floats));
+    dataFrame.addColumn("points", std::move(points));
+    dataFrame.updateIndexBuffer();
+    return dataFrame;
+}
+
+}  // namespace
+
+TEST(BinaryDataFrame, roundTrip) {
+    const auto expected = createDataFrame(100);
+    util::TempFileHandle file("df", ".ivdf");
+    dataframeutil::writeBinaryDataFrame(expected, file.getFileName(), 32);
+
+    BinaryDataFrameReader reader;
+    auto dataFrame = reader.readData(file.getFileName());
+    ASSERT_EQ(expected.getNumberOfColumns(), dataFrame->getNumberOfColumns());
+    ASSERT_EQ(expected.getNumberOfRows(), dataFrame->getNumberOfRows());
+    EXPECT_EQ(expected.getHeaders(), dataFrame->getHeaders());
+
+    auto categorical = std::dynamic_pointer_cast<const CategoricalColumn>(dataFrame->getColumn(1));
+    ASSERT_TRUE(categorical);
+    EXPECT_EQ(std::vector<std::string>({"a", "b"}), categorical->getCategories());
+
+    for (size_t col = 0; col < expected.getNumberOfColumns(); ++col) {
+        ASSERT_EQ(expected.getColumn(col)->getBuffer()->getDataFormat(),
+                  dataFrame->getColumn(col)->getBuffer()->getDataFormat())
+            << "column " << col;
+    }
+    for (size_t row = 0; row < expected.getNumberOfRows(); ++row) {
+        for (size_t col = 0; col < expected.getNumberOfColumns(); ++col) {
+            // The values are stored as is, they have to match exactly. NaN is stored as well
+            const auto a = expected.getColumn(col)->getAsDVec4(row);
+            const auto b = dataFrame->getColumn(col)->getAsDVec4(row);
+            for (int c = 0; c < 4; ++c) {
+                if (std::isnan(a[c])) {
+                    EXPECT_TRUE(std::isnan(b[c])) << "row " << row << ", column " << col;
+                } else {
+                    EXPECT_EQ(a[c], b[c]) << "row " << row << ", column " << col;
+                }
+            }
+        }
+    }
+}
+
+TEST(BinaryDataFrame, blocks) {
+    util::TempFileHandle file("df", ".ivdf");
+    dataframeutil::writeBinaryDataFrame(createDataFrame(100), file.getFileName(), 32);
+
+    const auto info = BinaryDataFrameReader::readInfo(file.getFileName());
+    ASSERT_EQ(32, info.blockSize);
+    ASSERT_EQ(3, info.columns.size());
+    const auto& floats = info.columns[1];
+    EXPECT_EQ("float", floats.header);
+    ASSERT_EQ(4, floats.blockMin.size());
+
+    // The floats are 0.5 * row, with a NaN in row 3 that is ignored by the block ranges
+    EXPECT_EQ(0.0, floats.blockMin[0].x);
+    EXPECT_EQ(15.5, floats.blockMax[0].x);
+    EXPECT_EQ(std::vector<size_t>({1}), floats.blocksInRange(20.0, 30.0));
+    EXPECT_EQ(std::vector<size_t>({2, 3}), floats.blocksInRange(40.0, 100.0));
+    EXPECT_TRUE(floats.blocksInRange(60.0, 100.0).empty());
+    EXPECT_TRUE(floats.blocksInRange(0.0, 1.0, 1).empty());
+
+    // The points are (row, -row), check the second component
+    EXPECT_EQ(std::vector<size_t>({0, 1}), info.columns[2].blocksInRange(-40.0, -10.0, 1));
+
+    auto block = BinaryDataFrameReader::readBlock(file.getFileName(), info, 1, 3);
+    ASSERT_EQ(4, block->getSize());
+    EXPECT_EQ(DataFloat32::get(), block->getDataFormat());
+    for (size_t i = 0; i < block->getSize(); ++i) {
+        EXPECT_EQ(0.5 * static_cast<double>(96 + i), block->getAsDouble(i));
+    }
+    EXPECT_THROW(BinaryDataFrameReader::readBlock(file.getFileName(), info, 1, 4), RangeException);
+    EXPECT_THROW(BinaryDataFrameReader::readBlock(file.getFileName(), info, 3, 0), RangeException);
+}
+
+TEST(BinaryDataFrame, lazyColumns) {
+    util::TempFileHandle file("df", ".ivdf");
+    dataframeutil::writeBinaryDataFrame(createDataFrame(10), file.getFileName());
+
+    BinaryDataFrameReader reader;
+    auto dataFrame = reader.readData(file.getFileName());
+    for (size_t col = 1; col < dataFrame->getNumberOfColumns(); ++col) {
+        auto buffer = dataFrame->getColumn(col)->getBuffer();
+        EXPECT_EQ(10, buffer->getSize());
+        EXPECT_TRUE(buffer->hasRepresentation<BufferDisk>());
+        EXPECT_FALSE(buffer->hasRepresentation<BufferRAM>());
+    }
+
+    EXPECT_EQ(2.5, dataFrame->getColumn("float")->getAsDouble(5));
+    EXPECT_TRUE(dataFrame->getColumn("float")->getBuffer()->hasRepresentation<BufferRAM>());
+    EXPECT_FALSE(dataFrame->getColumn("points")->getBuffer()->hasRepresentation<BufferRAM>());
+}
+
+TEST(BinaryDataFrame, blockRanges) {
+    util::TempFileHandle file("df", ".ivdf");
+    dataframeutil::writeBinaryDataFrame(createDataFrame(10), file.getFileName(), 4);
+
+    const auto info = BinaryDataFrameReader::readInfo(file.getFileName());
+    ASSERT_EQ(3, info.columns.size());
+    EXPECT_EQ(4, info.blockSize);
+
+    const auto& floats = info.columns[1];
+    EXPECT_EQ("float", floats.header);
+    EXPECT_EQ(10, floats.rows);
+    ASSERT_EQ(3, floats.blockMin.size());
+    // the NaN at row 3 is ignored
+    EXPECT_EQ(0.0, floats.blockMin[0].x);
+    EXPECT_EQ(1.0, floats.blockMax[0].x);
+    EXPECT_EQ(4.5, floats.blockMax[2].x);
+
+    const auto& points = info.columns[2];
+    EXPECT_EQ(dvec4(4.0, -7.0, 0.0, 0.0), points.blockMin[1]);
+    EXPECT_EQ(dvec4(7.0, -4.0, 0.0, 0.0), points.blockMax[1]);
+}
+
+TEST(BinaryDataFrame, invalidFile) {
+    util::TempFileHandle file("df", ".ivdf");
+    std::fputs("index,value\n0,1\n", file.getHandle());
+    std::fflush(file.getHandle());
+
+    BinaryDataFrameReader reader;
+    EXPECT_THROW(reader.readData(file.getFileName()), DataReaderException);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,126 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/dataframe/datastructures/columnexpression.h>
+#include <inviwo/dataframe/datastructures/dataframeutil.h>
+
+#include <cmath>
+
+namespace inviwo {
+
+namespace {
+
+DataFrame createDataFrame() {
+    DataFrame dataFrame;
+    dataFrame.addColumn("x", std::vector<float>{1.0f, 2.0f, 3.0f, 4.0f, 5.0f});
+    dataFrame.addColumn("Column 2", std::vector<int>{-2, -1, 0, 1, 2});
+    auto species = dataFrame.addCategoricalColumn("species");
+    for (auto s : {"setosa", "virginica", "setosa", "versicolor", "virginica"}) species->add(s);
+    dataFrame.addColumn("missing", std::vector<double>{0.0, std::nan(""), 1.0, 2.0, 3.0});
+    dataFrame.updateIndexBuffer();
+    return dataFrame;
+}
+
+}  // namespace
+
+TEST(ColumnExpression, arithmetic) {
+    const auto dataFrame = createDataFrame();
+
+    EXPECT_EQ(std::vector<double>({7, 7, 7, 7, 7}),
+              ColumnExpression("1 + 2 * 3").evaluate(dataFrame));
+    EXPECT_EQ(std::vector<double>({-1, 1, 3, 5, 7}),
+              ColumnExpression("x + \"Column 2\"").evaluate(dataFrame));
+    EXPECT_EQ(std::vector<double>({1, 4, 9, 16, 25}), ColumnExpression("x^2").evaluate(dataFrame));
+    EXPECT_EQ(std::vector<double>({-1, -4, -9, -16, -25}),
+              ColumnExpression("-x^2").evaluate(dataFrame));
+    EXPECT_EQ(std::vector<double>({2, 1, 0, 1, 2}),
+              ColumnExpression("abs(\"Column 2\")").evaluate(dataFrame));
+    EXPECT_EQ(std::vector<double>({1, 2, 3, 3, 3}),
+              ColumnExpression("min(x, 3)").evaluate(dataFrame));
+
+    const auto missing = ColumnExpression("missing * 2").evaluate(dataFrame);
+    EXPECT_TRUE(std::isnan(missing[1]));
+    EXPECT_EQ(6.0, missing[4]);
+}
+
+TEST(ColumnExpression, filter) {
+    const auto dataFrame = createDataFrame();
+
+    EXPECT_EQ(std::vector<std::uint32_t>({1, 2}),
+              ColumnExpression("x > 1 && x <= 3").filter(dataFrame));
+    EXPECT_EQ(std::vector<std::uint32_t>({0, 4}),
+              ColumnExpression("x < 2 || !(\"Column 2\" < 2)").filter(dataFrame));
+    EXPECT_EQ(std::vector<std::uint32_t>({1, 4}),
+              ColumnExpression("species == 'virginica'").filter(dataFrame));
+    EXPECT_EQ(std::vector<std::uint32_t>({0, 1, 2, 3, 4}),
+              ColumnExpression("species != 'unknown'").filter(dataFrame));
+    // NaN is false
+    EXPECT_EQ(std::vector<std::uint32_t>({2, 3, 4}), ColumnExpression("missing").filter(dataFrame));
+}
+
+TEST(ColumnExpression, columns) {
+    const auto dataFrame = createDataFrame();
+
+    ColumnExpression expression("sqrt(x) + \"Column 2\" * x");
+    EXPECT_EQ(std::vector<std::string>({"x", "Column 2"}), expression.getColumns());
+
+    auto column = expression.createColumn(dataFrame, "derived");
+    EXPECT_EQ("derived", column->getHeader());
+    ASSERT_EQ(5, column->getSize());
+    EXPECT_FLOAT_EQ(std::sqrt(5.0f) + 10.0f, column->get(4));
+
+    auto selected =
+        dataframeutil::selectRows(dataFrame, ColumnExpression("x > 3").filter(dataFrame));
+    ASSERT_EQ(2, selected->getNumberOfRows());
+    ASSERT_EQ(dataFrame.getNumberOfColumns(), selected->getNumberOfColumns());
+    EXPECT_EQ(4.0, selected->getColumn("x")->getAsDouble(0));
+    EXPECT_EQ("virginica", selected->getColumn("species")->getAsString(1));
+    EXPECT_EQ(1, selected->getIndexColumn()->get(1));
+}
+
+TEST(ColumnExpression, errors) {
+    const auto dataFrame = createDataFrame();
+
+    EXPECT_THROW(ColumnExpression("1 +"), ExpressionException);
+    EXPECT_THROW(ColumnExpression("(x"), ExpressionException);
+    EXPECT_THROW(ColumnExpression("x = 1"), ExpressionException);
+    EXPECT_THROW(ColumnExpression("foo(x)"), ExpressionException);
+    EXPECT_THROW(ColumnExpression("max(x)"), ExpressionException);
+    EXPECT_THROW(ColumnExpression("'setosa' + 1"), ExpressionException);
+
+    EXPECT_THROW(ColumnExpression("y + 1").evaluate(dataFrame), ExpressionException);
+    EXPECT_THROW(ColumnExpression("x == 'setosa'").evaluate(dataFrame), ExpressionException);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,130 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/dataframe/datastructures/column.h>
+#include <inviwo/dataframe/datastructures/columnstatistics.h>
+
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace inviwo {
+
+TEST(ColumnStatistics, moments) {
+    TemplateColumn<double> col("x", std::vector<double>{2.0, 4.0, std::nan(""), 4.0, 4.0, 5.0,
+                                                        5.0, 7.0, 9.0});
+    const auto stats = col.getStatistics();
+    EXPECT_EQ(size_t{8}, stats->count);
+    EXPECT_EQ(size_t{1}, stats->missing);
+    EXPECT_DOUBLE_EQ(2.0, stats->min);
+    EXPECT_DOUBLE_EQ(9.0, stats->max);
+    EXPECT_DOUBLE_EQ(5.0, stats->mean);
+    EXPECT_DOUBLE_EQ(2.0, stats->stddev);
+    EXPECT_EQ(size_t{0}, stats->distinct);
+}
+
+TEST(ColumnStatistics, chunks) {
+    // More rows than a single chunk, with an offset to check the merging of chunk moments
+    std::vector<int> data(200000);
+    std::iota(data.begin(), data.end(), 1000000);
+    TemplateColumn<int> col("x", data);
+    const auto stats = col.getStatistics();
+    EXPECT_EQ(data.size(), stats->count);
+    EXPECT_DOUBLE_EQ(1000000.0, stats->min);
+    EXPECT_DOUBLE_EQ(1199999.0, stats->max);
+    EXPECT_DOUBLE_EQ(1099999.5, stats->mean);
+    EXPECT_NEAR(std::sqrt((200000.0 * 200000.0 - 1.0) / 12.0), stats->stddev, 1e-6);
+}
+
+TEST(ColumnStatistics, quantiles) {
+    std::vector<float> data(10001);
+    std::iota(data.begin(), data.end(), 0.0f);
+    TemplateColumn<float> col("x", data);
+    const auto stats = col.getStatistics();
+    const auto tolerance = (stats->max - stats->min) / ColumnStatistics::sketchBins;
+
+    EXPECT_DOUBLE_EQ(0.0, stats->quantile(0.0));
+    EXPECT_DOUBLE_EQ(10000.0, stats->quantile(1.0));
+    EXPECT_NEAR(2500.0, stats->quantile(0.25), tolerance);
+    EXPECT_NEAR(5000.0, stats->quantile(0.5), tolerance);
+    EXPECT_NEAR(7500.0, stats->quantile(0.75), tolerance);
+}
+
+TEST(ColumnStatistics, categorical) {
+    CategoricalColumn col("species");
+    for (auto s : {"setosa", "virginica", "setosa", "versicolor", "virginica"}) col.add(s);
+    EXPECT_EQ(size_t{3}, col.getStatistics()->distinct);
+    EXPECT_DOUBLE_EQ(0.0, col.getStatistics()->min);
+    EXPECT_DOUBLE_EQ(2.0, col.getStatistics()->max);
+}
+
+TEST(ColumnStatistics, invalidation) {
+    TemplateColumn<float> col("x", std::vector<float>{1.0f, 2.0f, 3.0f});
+    const auto stats = col.getStatistics();
+    EXPECT_EQ(stats, col.getStatistics());
+
+    col.add(10.0f);
+    const auto updated = col.getStatistics();
+    EXPECT_NE(stats, updated);
+    EXPECT_EQ(size_t{3}, stats->count);
+    EXPECT_EQ(size_t{4}, updated->count);
+    EXPECT_DOUBLE_EQ(10.0, updated->max);
+
+    col.set(0, -1.0f);
+    EXPECT_DOUBLE_EQ(-1.0, col.getStatistics()->min);
+}
+
+TEST(ColumnStatistics, empty) {
+    TemplateColumn<float> col("x", std::vector<float>{std::nanf(""), std::nanf("")});
+    const auto stats = col.getStatistics();
+    EXPECT_EQ(size_t{0}, stats->count);
+    EXPECT_EQ(size_t{2}, stats->missing);
+    EXPECT_TRUE(std::isnan(stats->min));
+    EXPECT_TRUE(std::isnan(stats->quantile(0.5)));
+}
+
+TEST(ColumnStatistics, infinite) {
+    const auto inf = std::numeric_limits<double>::infinity();
+    TemplateColumn<double> col("x", std::vector<double>{1.0, inf, -inf, 3.0, std::nan(""), 2.0});
+    const auto stats = col.getStatistics();
+    EXPECT_EQ(size_t{3}, stats->count);
+    EXPECT_EQ(size_t{3}, stats->missing);
+    EXPECT_DOUBLE_EQ(1.0, stats->min);
+    EXPECT_DOUBLE_EQ(3.0, stats->max);
+    EXPECT_DOUBLE_EQ(2.0, stats->mean);
+    EXPECT_EQ(size_t{3}, std::accumulate(stats->sketch.begin(), stats->sketch.end(), size_t{0}));
+    EXPECT_NEAR(2.0, stats->quantile(0.5), 1e-2);
+}
+
+}  // namespace inviwo
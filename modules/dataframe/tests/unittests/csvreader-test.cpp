@@ -35,10 +35,57 @@
 #include <inviwo/core/io/tempfilehandle.h>
 #include <inviwo/dataframe/io/csvreader.h>
 
+#include <cmath>
+#include <cstdio>
 #include <sstream>
 
 namespace inviwo {
 
+namespace {
+
+// Read the data both from a file and from a stream, the results should be identical
+void readFileAndStream(const std::string& data, CSVReader& reader) {
+    util::TempFileHandle tmpFile("", ".csv");
+    std::fwrite(data.data(), 1, data.size(), tmpFile);
+    std::fflush(tmpFile);
+
+    std::istringstream ss(data);
+    auto expected = reader.readData(ss);
+    auto dataframe = reader.readData(tmpFile.getFileName());
+
+    ASSERT_EQ(expected->getNumberOfColumns(), dataframe->getNumberOfColumns());
+    ASSERT_EQ(expected->getNumberOfRows(), dataframe->getNumberOfRows());
+    for (size_t col = 0; col < expected->getNumberOfColumns(); ++col) {
+        auto expectedCol = expected->getColumn(col);
+        auto column = dataframe->getColumn(col);
+        EXPECT_EQ(expectedCol->getHeader(), column->getHeader());
+        ASSERT_EQ(expectedCol->getBuffer()->getDataFormat(), column->getBuffer()->getDataFormat())
+            << "column " << col;
+
+        const auto categorical = std::dynamic_pointer_cast<const CategoricalColumn>(expectedCol);
+        ASSERT_EQ(categorical != nullptr,
+                  std::dynamic_pointer_cast<const CategoricalColumn>(column) != nullptr)
+            << "column " << col;
+        for (size_t row = 0; row < expected->getNumberOfRows(); ++row) {
+            if (categorical) {
+                EXPECT_EQ(expectedCol->getAsString(row), column->getAsString(row))
+                    << "column " << col << " row " << row;
+            } else {
+                // The values are parsed into floats, allow for the last bits to differ
+                const auto a = static_cast<float>(expectedCol->getAsDouble(row));
+                const auto b = static_cast<float>(column->getAsDouble(row));
+                if (std::isnan(a)) {
+                    EXPECT_TRUE(std::isnan(b)) << "column " << col << " row " << row;
+                } else {
+                    EXPECT_FLOAT_EQ(a, b) << "column " << col << " row " << row;
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
 TEST(CSVnoData, stream) {
     std::istringstream ss("");
 
@@ -465,4 +512,53 @@ TEST(CSVlinebreaks, mixed) {
     ASSERT_EQ(4, dataframe->getNumberOfRows()) << "row count does not match";
 }
 
+TEST(CSVfile, sameAsStream) {
+    CSVReader reader;
+    reader.setFirstRowHeader(false);
+    readFileAndStream("1,a\n2,b\n3,c", reader);
+    readFileAndStream("1\n2\n\n\n3\n4\n\n5\n6\n\n", reader);
+    readFileAndStream("1,a,\n2,b,", reader);
+    readFileAndStream("1,a,apple,fruit\n,,,\n,,,\n2,b,banana,fruit\n", reader);
+    readFileAndStream("1,2,3\r\n4,5,6\n\r7,8,9\r10,11,12", reader);
+    readFileAndStream("\"multi\r\nline\", 1.5e3 , -2\n\"x,y\",.5,1e", reader);
+    readFileAndStream("\xef\xbb\xbf1,2,3", reader);
+
+    reader.setFirstRowHeader(true);
+    readFileAndStream("Number,Name,Category\n1,Apple,Fruit\n2,Banana,\n,,Vegetable", reader);
+    readFileAndStream("\"first \"col\"\",second,\"third\"\n1,2,3", reader);
+    readFileAndStream("A,B\n1,a,\n2,b,\n", reader);
+
+    reader.setDelimiters("|@#");
+    readFileAndStream("A|B#C\na|b#3\n4@5|6\n", reader);
+}
+
+TEST(CSVfile, chunks) {
+    // large enough to be split into several chunks, with quoted line breaks that can end up on
+    // the chunk boundaries
+    std::ostringstream ss;
+    ss << "Index,Name,Value,Category\r\n";
+    for (int i = 0; i < 60000; ++i) {
+        ss << i << ",\"name\n" << i % 97 << "\"," << i * 0.25 << ",cat " << i % 13;
+        ss << (i % 3 == 0 ? "\r\n" : "\n");
+    }
+
+    CSVReader reader;
+    readFileAndStream(ss.str(), reader);
+}
+
+TEST(CSVfile, errors) {
+    CSVReader reader;
+    reader.setFirstRowHeader(false);
+
+    util::TempFileHandle mismatch("", ".csv");
+    std::fputs("1,2,3\n4,5\n7,8,9", mismatch);
+    std::fflush(mismatch);
+    EXPECT_THROW(reader.readData(mismatch.getFileName()), CSVDataReaderException);
+
+    util::TempFileHandle quotes("", ".csv");
+    std::fputs("1,2,3\n4,\"5,6\n7,8,9", quotes);
+    std::fflush(quotes);
+    EXPECT_THROW(reader.readData(quotes.getFileName()), CSVDataReaderException);
+}
+
 }  // namespace inviwo
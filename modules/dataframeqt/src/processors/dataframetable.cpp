@@ -86,11 +86,11 @@ void DataFrameTable::process() {
     if (auto w = getWidget()) {
         if (inport_.isChanged() || vectorCompAsColumn_.isModified()) {
             w->setDataFrame(inport_.getData(), vectorCompAsColumn_);
-            w->updateSelection(brushLinkPort_.getSelectedColumns(),
-                               brushLinkPort_.getSelectedIndices());
+            w->updateSelection(brushLinkPort_.getSelectedColumns().toUnorderedSet(),
+                               brushLinkPort_.getSelectedIndices().toUnorderedSet());
         } else if (brushLinkPort_.isChanged()) {
-            w->updateSelection(brushLinkPort_.getSelectedColumns(),
-                               brushLinkPort_.getSelectedIndices());
+            w->updateSelection(brushLinkPort_.getSelectedColumns().toUnorderedSet(),
+                               brushLinkPort_.getSelectedIndices().toUnorderedSet());
         }
     }
 }
@@ -106,7 +106,7 @@ void DataFrameTable::setProcessorWidget(std::unique_ptr<ProcessorWidget> process
     if (widget) {
         rowSelectionChanged_ =
             widget->setRowSelectionChangedCallback([this](const std::unordered_set<size_t>& rows) {
-                brushLinkPort_.sendSelectionEvent(rows);
+                brushLinkPort_.sendSelectionEvent(BitSet(rows));
             });
     }
 
@@ -0,0 +1,132 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/plotting/plottingmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+
+#include <optional>
+#include <vector>
+
+namespace inviwo {
+
+namespace plot {
+
+/**
+ * \brief Point density of a 2D scatter plot, binned into a regular grid
+ *
+ * The points given by two scalar buffers are counted per bin of a grid covering the requested
+ * ranges, optionally split into categories given by a third buffer. Binning is done in chunks on
+ * the thread pool and points with values that are not finite or outside of the ranges are
+ * skipped.
+ *
+ * To avoid rebinning all points every time the ranges change, an overview grid covering the full
+ * extent of the data is binned once. As long as the bins of the requested grid are at least as
+ * large as the overview bins, the grid is resampled from the overview instead, and only when
+ * zooming in further are the points binned again. Calling update() with unchanged dimensions and
+ * ranges returns the previous grid.
+ */
+class IVW_MODULE_PLOTTING_API DensityGrid {
+public:
+    struct IVW_MODULE_PLOTTING_API Grid {
+        size2_t dims{0};
+        size_t categories = 1;
+        dvec2 rangeX{0.0};
+        dvec2 rangeY{0.0};
+        /// Number of points per bin and category, bins in row-major order starting at the lower
+        /// left corner, with the categories of a bin next to each other
+        std::vector<float> counts;
+        /// Largest number of points in a bin, summed over all categories
+        float maxCount = 0.0f;
+
+        float count(size2_t bin) const;
+        float count(size2_t bin, size_t category) const;
+    };
+
+    /// How the grid was computed in the last call to update()
+    enum class Update { Cached, Resampled, Binned };
+
+    /// Maximum number of counters in the overview grid
+    static constexpr size_t overviewSize = 1 << 20;
+
+    DensityGrid() = default;
+
+    /**
+     * Set the x and y coordinates of the points, both buffers have to be scalar and of the same
+     * size. Invalidates the overview grid.
+     */
+    void setData(std::shared_ptr<const BufferBase> x, std::shared_ptr<const BufferBase> y);
+
+    /**
+     * Split the points into \p categories categories. The range of \p values is divided into
+     * equally large intervals, one per category, i.e. for integer values v in [a, b] use the
+     * range [a - 0.5, b + 0.5] and b - a + 1 categories. Values outside of the range are
+     * clamped. Pass a nullptr to remove the categories.
+     */
+    void setCategories(std::shared_ptr<const BufferBase> values, dvec2 range, size_t categories);
+
+    /**
+     * Only bin the points with the given indices. Nothing is invalidated if the indices are the
+     * same as before.
+     */
+    void setIndices(const std::vector<std::uint32_t>& indices);
+    /// Bin all points
+    void clearIndices();
+
+    /**
+     * Compute the point density in a grid of \p dims bins covering the given ranges. Empty or
+     * inverted ranges are extended to a width of one around their lower value.
+     */
+    const Grid& update(size2_t dims, dvec2 rangeX, dvec2 rangeY);
+
+    const Grid& getGrid() const;
+    Update getLastUpdate() const;
+
+private:
+    void invalidate();
+    void bin(Grid& grid) const;
+    void resample(Grid& grid) const;
+
+    std::shared_ptr<const BufferBase> x_;
+    std::shared_ptr<const BufferBase> y_;
+    std::shared_ptr<const BufferBase> categories_;
+    dvec2 categoryRange_{0.0, 1.0};
+    size_t nCategories_ = 1;
+    std::optional<std::vector<std::uint32_t>> indices_;
+
+    std::optional<Grid> overview_;
+    Grid grid_;
+    bool gridValid_ = false;
+    Update lastUpdate_ = Update::Binned;
+};
+
+}  // namespace plot
+
+}  // namespace inviwo
@@ -0,0 +1,365 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/plotting/datastructures/densitygrid.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/util/formatdispatching.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+
+namespace inviwo {
+
+namespace plot {
+
+namespace {
+
+constexpr size_t chunkSize = 1024;
+constexpr size_t minTaskSize = 64 * chunkSize;
+
+/// Copies \p count values, starting at \p begin or at rows[begin] if \p rows is given, to \p dst
+using Loader =
+    std::function<void(const std::uint32_t* rows, size_t begin, size_t count, double* dst)>;
+
+Loader makeLoader(const BufferBase& buffer) {
+    return buffer.getRepresentation<BufferRAM>()->dispatch<Loader, dispatching::filter::Scalars>(
+        [](auto ram) -> Loader {
+            const auto* data = ram->getDataContainer().data();
+            return [data](const std::uint32_t* rows, size_t begin, size_t count, double* dst) {
+                if (rows) {
+                    for (size_t i = 0; i < count; ++i) {
+                        dst[i] = static_cast<double>(data[rows[begin + i]]);
+                    }
+                } else {
+                    for (size_t i = 0; i < count; ++i) {
+                        dst[i] = static_cast<double>(data[begin + i]);
+                    }
+                }
+            };
+        });
+}
+
+struct Points {
+    Loader x;
+    Loader y;
+    Loader category;  // empty if the points have no categories
+    const std::uint32_t* rows;
+    size_t size;
+};
+
+Points makePoints(const BufferBase& x, const BufferBase& y, const BufferBase* categories,
+                  const std::vector<std::uint32_t>* rows) {
+    if (categories && categories->getSize() != x.getSize()) {
+        throw Exception("Categories and points are not of equal length",
+                        IVW_CONTEXT_CUSTOM("DensityGrid"));
+    }
+    return Points{makeLoader(x), makeLoader(y), categories ? makeLoader(*categories) : Loader{},
+                  rows ? rows->data() : nullptr, rows ? rows->size() : x.getSize()};
+}
+
+size_t taskCount(size_t points) {
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    return std::clamp<size_t>((points + minTaskSize - 1) / minTaskSize, 1,
+                              std::max<size_t>(poolSize, 1));
+}
+
+/**
+ * Splits the points into \p tasks contiguous ranges that run on the thread pool, and calls
+ * \p func(task, x, y, category, count) for each chunk of points. category is a nullptr if the
+ * points have no categories.
+ */
+template <typename Func>
+void forEachChunk(const Points& points, size_t tasks, Func&& func) {
+    const auto runTask = [&](size_t task) {
+        std::array<double, chunkSize> x;
+        std::array<double, chunkSize> y;
+        std::array<double, chunkSize> c;
+        const size_t end = points.size * (task + 1) / tasks;
+        for (size_t begin = points.size * task / tasks; begin < end; begin += chunkSize) {
+            const size_t count = std::min(chunkSize, end - begin);
+            points.x(points.rows, begin, count, x.data());
+            points.y(points.rows, begin, count, y.data());
+            if (points.category) points.category(points.rows, begin, count, c.data());
+            func(task, x.data(), y.data(), points.category ? c.data() : nullptr, count);
+        }
+    };
+
+    util::forEachTask(tasks, runTask);
+}
+
+dvec2 validRange(dvec2 range) {
+    if (!std::isfinite(range.x)) return dvec2{0.0, 1.0};
+    if (!std::isfinite(range.y) || !(range.y > range.x)) return dvec2{range.x - 0.5, range.x + 0.5};
+    return range;
+}
+
+/// The x and y range of all points where both coordinates are finite
+std::pair<dvec2, dvec2> extent(const Points& points) {
+    constexpr auto inf = std::numeric_limits<double>::infinity();
+    const auto tasks = taskCount(points.size);
+    std::vector<dvec4> extents(tasks, dvec4{inf, -inf, inf, -inf});
+    forEachChunk(points, tasks,
+                 [&](size_t task, const double* x, const double* y, const double*, size_t count) {
+                     auto& e = extents[task];
+                     for (size_t i = 0; i < count; ++i) {
+                         if (!std::isfinite(x[i]) || !std::isfinite(y[i])) continue;
+                         e.x = std::min(e.x, x[i]);
+                         e.y = std::max(e.y, x[i]);
+                         e.z = std::min(e.z, y[i]);
+                         e.w = std::max(e.w, y[i]);
+                     }
+                 });
+
+    dvec4 e{inf, -inf, inf, -inf};
+    for (const auto& te : extents) {
+        e = dvec4{std::min(e.x, te.x), std::max(e.y, te.y), std::min(e.z, te.z),
+                  std::max(e.w, te.w)};
+    }
+    return {validRange(dvec2{e.x, e.y}), validRange(dvec2{e.z, e.w})};
+}
+
+void updateMaxCount(DensityGrid::Grid& grid) {
+    grid.maxCount = 0.0f;
+    for (size_t i = 0; i < grid.counts.size(); i += grid.categories) {
+        const auto* counts = grid.counts.data() + i;
+        grid.maxCount =
+            std::max(grid.maxCount, std::accumulate(counts, counts + grid.categories, 0.0f));
+    }
+}
+
+/// The first of the (at most two) destination bins covered by a source bin and the fraction of
+/// the source bin that falls into it, the rest falls into the next destination bin
+struct Span {
+    std::ptrdiff_t bin;
+    double weight;
+};
+
+/// Maps each of the \p srcBins bins over \p srcRange onto the \p dstBins bins over \p dstRange.
+/// The source bins can not be larger than the destination bins.
+std::vector<Span> spans(size_t srcBins, dvec2 srcRange, size_t dstBins, dvec2 dstRange) {
+    const double srcWidth = (srcRange.y - srcRange.x) / static_cast<double>(srcBins);
+    const double scale = static_cast<double>(dstBins) / (dstRange.y - dstRange.x);
+    std::vector<Span> result(srcBins);
+    for (size_t i = 0; i < srcBins; ++i) {
+        const double begin = (srcRange.x + srcWidth * static_cast<double>(i) - dstRange.x) * scale;
+        const double end = begin + srcWidth * scale;
+        const double first = std::floor(begin);
+        result[i] = Span{static_cast<std::ptrdiff_t>(first),
+                         end > begin ? (std::min(end, first + 1.0) - begin) / (end - begin) : 1.0};
+    }
+    return result;
+}
+
+}  // namespace
+
+float DensityGrid::Grid::count(size2_t bin) const {
+    const auto* binCounts = counts.data() + (bin.y * dims.x + bin.x) * categories;
+    return std::accumulate(binCounts, binCounts + categories, 0.0f);
+}
+
+float DensityGrid::Grid::count(size2_t bin, size_t category) const {
+    return counts[(bin.y * dims.x + bin.x) * categories + category];
+}
+
+void DensityGrid::setData(std::shared_ptr<const BufferBase> x,
+                          std::shared_ptr<const BufferBase> y) {
+    if (x && y && x->getSize() != y->getSize()) {
+        throw Exception("Buffers are not of equal length", IVW_CONTEXT);
+    }
+    x_ = x;
+    y_ = y;
+    invalidate();
+}
+
+void DensityGrid::setCategories(std::shared_ptr<const BufferBase> values, dvec2 range,
+                                size_t categories) {
+    categories_ = values;
+    categoryRange_ = validRange(range);
+    nCategories_ = std::max<size_t>(categories, 1);
+    invalidate();
+}
+
+void DensityGrid::setIndices(const std::vector<std::uint32_t>& indices) {
+    if (indices_ && *indices_ == indices) return;
+    indices_ = indices;
+    // The extent of the overview covers all points and stays valid
+    if (overview_) overview_->counts.clear();
+    gridValid_ = false;
+}
+
+void DensityGrid::clearIndices() {
+    if (!indices_) return;
+    indices_.reset();
+    if (overview_) overview_->counts.clear();
+    gridValid_ = false;
+}
+
+auto DensityGrid::update(size2_t dims, dvec2 rangeX, dvec2 rangeY) -> const Grid& {
+    rangeX = validRange(rangeX);
+    rangeY = validRange(rangeY);
+    if (gridValid_ && grid_.dims == dims && grid_.rangeX == rangeX && grid_.rangeY == rangeY) {
+        lastUpdate_ = Update::Cached;
+        return grid_;
+    }
+
+    grid_.dims = dims;
+    grid_.categories = categories_ ? nCategories_ : 1;
+    grid_.rangeX = rangeX;
+    grid_.rangeY = rangeY;
+    gridValid_ = true;
+    lastUpdate_ = Update::Binned;
+
+    if (!x_ || !y_ || dims.x == 0 || dims.y == 0) {
+        grid_.counts.assign(dims.x * dims.y * grid_.categories, 0.0f);
+        grid_.maxCount = 0.0f;
+        return grid_;
+    }
+
+    if (!overview_) {
+        const auto [extentX, extentY] = extent(makePoints(*x_, *y_, nullptr, nullptr));
+        const auto side = static_cast<size_t>(
+            std::sqrt(static_cast<double>(overviewSize / grid_.categories)));
+        overview_ = Grid{};
+        overview_->dims = size2_t{std::max<size_t>(side, 1)};
+        overview_->categories = grid_.categories;
+        overview_->rangeX = extentX;
+        overview_->rangeY = extentY;
+    }
+
+    const auto binSize = [](dvec2 range, size_t bins) {
+        return (range.y - range.x) / static_cast<double>(bins);
+    };
+    if (binSize(rangeX, dims.x) >= binSize(overview_->rangeX, overview_->dims.x) &&
+        binSize(rangeY, dims.y) >= binSize(overview_->rangeY, overview_->dims.y)) {
+        if (overview_->counts.empty()) bin(*overview_);
+        resample(grid_);
+        lastUpdate_ = Update::Resampled;
+    } else {
+        bin(grid_);
+    }
+    return grid_;
+}
+
+auto DensityGrid::getGrid() const -> const Grid& { return grid_; }
+
+auto DensityGrid::getLastUpdate() const -> Update { return lastUpdate_; }
+
+void DensityGrid::invalidate() {
+    overview_.reset();
+    gridValid_ = false;
+}
+
+void DensityGrid::bin(Grid& grid) const {
+    const auto points =
+        makePoints(*x_, *y_, categories_.get(), indices_ ? &*indices_ : nullptr);
+    const size_t size = grid.dims.x * grid.dims.y * grid.categories;
+    // Every task counts into a grid of its own, which then has to be merged. Use fewer tasks for
+    // large grids so that allocating and merging the grids does not cost more than the binning.
+    const auto tasks = std::min(taskCount(points.size), std::max<size_t>(points.size / size, 1));
+    std::vector<std::vector<std::uint32_t>> taskCounts(tasks, std::vector<std::uint32_t>(size, 0));
+
+    const dvec2 dims{grid.dims};
+    const dvec2 scale = dims / dvec2{grid.rangeX.y - grid.rangeX.x, grid.rangeY.y - grid.rangeY.x};
+    const double categoryScale =
+        static_cast<double>(grid.categories) / (categoryRange_.y - categoryRange_.x);
+    const double maxCategory = static_cast<double>(grid.categories - 1);
+
+    forEachChunk(points, tasks, [&](size_t task, const double* x, const double* y,
+                                    const double* c, size_t count) {
+        auto& counts = taskCounts[task];
+        for (size_t i = 0; i < count; ++i) {
+            const double fx = (x[i] - grid.rangeX.x) * scale.x;
+            const double fy = (y[i] - grid.rangeY.x) * scale.y;
+            // Also skips NaN, points on the upper edge go into the last bin
+            if (!(fx >= 0.0 && fx <= dims.x && fy >= 0.0 && fy <= dims.y)) continue;
+            size_t category = 0;
+            if (c) {
+                const double fc = (c[i] - categoryRange_.x) * categoryScale;
+                if (std::isnan(fc)) continue;
+                category = static_cast<size_t>(std::clamp(fc, 0.0, maxCategory));
+            }
+            const auto bx = std::min(static_cast<size_t>(fx), grid.dims.x - 1);
+            const auto by = std::min(static_cast<size_t>(fy), grid.dims.y - 1);
+            ++counts[(by * grid.dims.x + bx) * grid.categories + category];
+        }
+    });
+
+    grid.counts.assign(size, 0.0f);
+    for (const auto& counts : taskCounts) {
+        std::transform(counts.begin(), counts.end(), grid.counts.begin(), grid.counts.begin(),
+                       [](std::uint32_t a, float b) { return static_cast<float>(a) + b; });
+    }
+    updateMaxCount(grid);
+}
+
+void DensityGrid::resample(Grid& grid) const {
+    const auto& src = *overview_;
+    const auto xs = spans(src.dims.x, src.rangeX, grid.dims.x, grid.rangeX);
+    const auto ys = spans(src.dims.y, src.rangeY, grid.dims.y, grid.rangeY);
+    const auto width = static_cast<std::ptrdiff_t>(grid.dims.x);
+    const auto height = static_cast<std::ptrdiff_t>(grid.dims.y);
+    const auto categories = grid.categories;
+
+    grid.counts.assign(grid.dims.x * grid.dims.y * categories, 0.0f);
+    const auto add = [&](std::ptrdiff_t x, std::ptrdiff_t y, double weight, const float* counts) {
+        if (x < 0 || x >= width || y < 0 || y >= height || weight <= 0.0) return;
+        auto* dst = &grid.counts[static_cast<size_t>(y * width + x) * categories];
+        for (size_t c = 0; c < categories; ++c) {
+            dst[c] += static_cast<float>(weight * counts[c]);
+        }
+    };
+
+    for (size_t sy = 0; sy < src.dims.y; ++sy) {
+        const auto [by, wy] = ys[sy];
+        if (by < -1 || by >= height) continue;
+        for (size_t sx = 0; sx < src.dims.x; ++sx) {
+            const auto [bx, wx] = xs[sx];
+            if (bx < -1 || bx >= width) continue;
+            const float* counts = &src.counts[(sy * src.dims.x + sx) * categories];
+            if (std::all_of(counts, counts + categories, [](float v) { return v == 0.0f; })) {
+                continue;
+            }
+            add(bx, by, wx * wy, counts);
+            add(bx + 1, by, (1.0 - wx) * wy, counts);
+            add(bx, by + 1, wx * (1.0 - wy), counts);
+            add(bx + 1, by + 1, (1.0 - wx) * (1.0 - wy), counts);
+        }
+    }
+    updateMaxCount(grid);
+}
+
+}  // namespace plot
+
+}  // namespace inviwo
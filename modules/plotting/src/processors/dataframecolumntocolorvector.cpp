@@ -62,6 +62,9 @@ DataFrameColumnToColorVector::DataFrameColumnToColorVector()
 
 void DataFrameColumnToColorVector::process() {
     auto dataFrame = dataFrame_.getData();
+    const auto stats = selectedColorAxis_.getColumn()->getStatistics();
+    const double minV = stats->min;
+    const double range = stats->max - stats->min;
 
     colors_.setData(
         selectedColorAxis_.getBuffer()
@@ -70,10 +73,6 @@ void DataFrameColumnToColorVector::process() {
                 [&](auto buf) {
                     auto colors = std::make_shared<std::vector<vec4>>();
                     auto &vec = buf->getDataContainer();
-                    auto minMax = std::minmax_element(vec.begin(), vec.end());
-                    double minV = static_cast<double>(*minMax.first);
-                    double maxV = static_cast<double>(*minMax.second);
-                    const double range = (maxV - minV);
 
                     for (const auto &v : vec) {
                         colors->push_back(tf_.get().sample((v - minV) / range));
@@ -0,0 +1,131 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/plotting/datastructures/densitygrid.h>
+
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+float total(const plot::DensityGrid::Grid& grid) {
+    return std::accumulate(grid.counts.begin(), grid.counts.end(), 0.0f);
+}
+
+}  // namespace
+
+TEST(DensityGrid, binning) {
+    plot::DensityGrid density;
+    density.setData(util::makeBuffer<float>({0.0f, 1.0f, 1.0f, 2.0f, NAN, 4.0f}),
+                    util::makeBuffer<float>({0.0f, 0.0f, 0.0f, 3.0f, 1.0f, 1.0f}));
+
+    // Bins smaller than the overview bins, all points are binned
+    const auto& grid = density.update(size2_t{4000, 4000}, dvec2{0.0, 4.0}, dvec2{0.0, 4.0});
+    EXPECT_EQ(plot::DensityGrid::Update::Binned, density.getLastUpdate());
+    EXPECT_EQ(1.0f, grid.count(size2_t{0, 0}));
+    EXPECT_EQ(2.0f, grid.count(size2_t{1000, 0}));
+    EXPECT_EQ(1.0f, grid.count(size2_t{2000, 3000}));
+    EXPECT_EQ(1.0f, grid.count(size2_t{3999, 1000})) << "points on the upper edge are included";
+    EXPECT_EQ(5.0f, total(grid)) << "NaN is skipped";
+    EXPECT_EQ(2.0f, grid.maxCount);
+
+    density.update(size2_t{4000, 4000}, dvec2{0.0, 4.0}, dvec2{0.0, 4.0});
+    EXPECT_EQ(plot::DensityGrid::Update::Cached, density.getLastUpdate());
+
+    density.setIndices({0, 1, 4});
+    EXPECT_EQ(2.0f, total(density.update(size2_t{4000, 4000}, dvec2{0.0, 4.0}, dvec2{0.0, 4.0})));
+    density.setIndices({0, 1, 4});
+    density.update(size2_t{4000, 4000}, dvec2{0.0, 4.0}, dvec2{0.0, 4.0});
+    EXPECT_EQ(plot::DensityGrid::Update::Cached, density.getLastUpdate());
+}
+
+TEST(DensityGrid, categories) {
+    plot::DensityGrid density;
+    density.setData(util::makeBuffer<float>({0.0f, 1.0f, 1.0f, 2.0f, 3.0f}),
+                    util::makeBuffer<float>({0.0f, 0.0f, 0.0f, 3.0f, 1.0f}));
+    density.setCategories(util::makeBuffer<int>({0, 1, 2, 2, 5}), dvec2{-0.5, 2.5}, 3);
+
+    const auto& grid = density.update(size2_t{4000, 4000}, dvec2{0.0, 4.0}, dvec2{0.0, 4.0});
+    ASSERT_EQ(3, grid.categories);
+    EXPECT_EQ(1.0f, grid.count(size2_t{0, 0}, 0));
+    EXPECT_EQ(1.0f, grid.count(size2_t{1000, 0}, 1));
+    EXPECT_EQ(1.0f, grid.count(size2_t{1000, 0}, 2));
+    EXPECT_EQ(1.0f, grid.count(size2_t{2000, 3000}, 2));
+    EXPECT_EQ(1.0f, grid.count(size2_t{3000, 1000}, 2)) << "categories are clamped";
+}
+
+TEST(DensityGrid, resampling) {
+    constexpr size_t size = 100000;
+    std::vector<float> x(size);
+    std::vector<float> y(size);
+    for (size_t i = 0; i < size; ++i) {
+        x[i] = static_cast<float>((i * 7919) % 1000) / 100.0f;
+        y[i] = static_cast<float>((i * 104729) % 997) / 99.7f;
+    }
+    plot::DensityGrid density;
+    density.setData(util::makeBuffer<float>(std::vector<float>(x)),
+                    util::makeBuffer<float>(std::vector<float>(y)));
+
+    const auto& grid = density.update(size2_t{50, 40}, dvec2{0.0, 10.0}, dvec2{0.0, 10.0});
+    EXPECT_EQ(plot::DensityGrid::Update::Resampled, density.getLastUpdate());
+    EXPECT_NEAR(static_cast<float>(size), total(grid), 1.0f);
+
+    std::vector<float> expected(50 * 40, 0.0f);
+    for (size_t i = 0; i < size; ++i) {
+        const auto bx = std::min(static_cast<size_t>(x[i] / 10.0f * 50.0f), size_t{49});
+        const auto by = std::min(static_cast<size_t>(y[i] / 10.0f * 40.0f), size_t{39});
+        expected[by * 50 + bx] += 1.0f;
+    }
+    float error = 0.0f;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        error += std::abs(expected[i] - grid.count(size2_t{i % 50, i / 50}));
+    }
+    EXPECT_LT(error / static_cast<float>(size), 0.05f);
+
+    // Pan, still resampled
+    density.update(size2_t{50, 40}, dvec2{-2.0, 8.0}, dvec2{0.0, 10.0});
+    EXPECT_EQ(plot::DensityGrid::Update::Resampled, density.getLastUpdate());
+
+    // Zoom in beyond the overview resolution
+    const auto& zoomed = density.update(size2_t{500, 500}, dvec2{1.0, 2.0}, dvec2{1.0, 2.0});
+    EXPECT_EQ(plot::DensityGrid::Update::Binned, density.getLastUpdate());
+    float inside = 0.0f;
+    for (size_t i = 0; i < size; ++i) {
+        if (x[i] >= 1.0f && x[i] <= 2.0f && y[i] >= 1.0f && y[i] <= 2.0f) inside += 1.0f;
+    }
+    EXPECT_EQ(inside, total(zoomed));
+}
+
+}  // namespace inviwo
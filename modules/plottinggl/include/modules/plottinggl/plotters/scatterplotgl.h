@@ -33,6 +33,7 @@
 #include <inviwo/core/datastructures/transferfunction.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/interaction/pickingmapper.h>
+#include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/properties/transferfunctionproperty.h>
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/util/dispatcher.h>
@@ -43,9 +44,11 @@
 
 #include <modules/opengl/texture/textureutils.h>
 #include <modules/opengl/shader/shader.h>
+#include <modules/opengl/rendering/texturequadrenderer.h>
 
 #include <inviwo/dataframe/datastructures/dataframe.h>
 
+#include <modules/plotting/datastructures/densitygrid.h>
 #include <modules/plotting/interaction/boxselectioninteractionhandler.h>
 #include <modules/plotting/properties/marginproperty.h>
 #include <modules/plotting/properties/axisproperty.h>
@@ -53,9 +56,9 @@
 
 #include <modules/plottinggl/rendering/boxselectionrenderer.h>
 #include <modules/plottinggl/utils/axisrenderer.h>
+#include <modules/brushingandlinking/datastructures/indexsnapshot.h>
 
 #include <optional>
-#include <unordered_set>
 
 namespace inviwo {
 
@@ -72,6 +75,13 @@ public:
     using SelectionFunc = void(const std::vector<bool>&);
     using SelectionCallbackHandle = std::shared_ptr<std::function<SelectionFunc>>;
 
+    /**
+     * Points draws every point, Density draws the number of points per bin of a grid in the
+     * plot area, and Auto switches to Density when there are more points than the density
+     * threshold.
+     */
+    enum class RenderMode { Auto, Points, Density };
+
     class Properties : public CompositeProperty {
     public:
         virtual std::string getClassIdentifier() const override;
@@ -101,6 +111,11 @@ public:
 
         BoolProperty hovering_;
 
+        TemplateOptionProperty<RenderMode> renderMode_;
+        IntSizeTProperty densityThreshold_;  ///! Number of points above which Auto uses Density
+        IntProperty binSize_;                ///! Size of the density bins in pixels
+        BoolProperty logDensity_;
+
         AxisStyleProperty axisStyle_;
         AxisProperty xAxis_;
         AxisProperty yAxis_;
@@ -109,18 +124,26 @@ public:
         auto props() {
             return std::tie(radiusRange_, useCircle_, minRadius_, tf_, color_, hoverColor_,
                             selectionColor_, boxSelectionSettings_, margins_, axisMargin_,
-                            borderWidth_, borderColor_, hovering_, axisStyle_, xAxis_, yAxis_);
+                            borderWidth_, borderColor_, hovering_, renderMode_, densityThreshold_,
+                            binSize_, logDensity_, axisStyle_, xAxis_, yAxis_);
         }
         auto props() const {
             return std::tie(radiusRange_, useCircle_, minRadius_, tf_, color_, hoverColor_,
                             selectionColor_, boxSelectionSettings_, margins_, axisMargin_,
-                            borderWidth_, borderColor_, hovering_, axisStyle_, xAxis_, yAxis_);
+                            borderWidth_, borderColor_, hovering_, renderMode_, densityThreshold_,
+                            binSize_, logDensity_, axisStyle_, xAxis_, yAxis_);
         }
+        void setupDensityVisibility();
     };
 
     explicit ScatterPlotGL(Processor* processor = nullptr);
     virtual ~ScatterPlotGL() = default;
 
+    /**
+     * Plot the points given by \p indices, or all points that are not filtered if \p indices is
+     * a nullptr. The density grid is only rebinned if the indices differ from the ones in the
+     * previous call.
+     */
     void plot(Image& dest, IndexBuffer* indices = nullptr, bool useAxisRanges = false);
     void plot(Image& dest, const Image& src, IndexBuffer* indices = nullptr,
               bool useAxisRanges = false);
@@ -144,7 +167,12 @@ public:
     void setRadiusData(std::shared_ptr<const BufferBase> buffer);
     void setIndexColumn(std::shared_ptr<const TemplateColumn<uint32_t>> indexcol);
 
-    void setSelectedIndices(const std::unordered_set<size_t>& indices);
+    /**
+     * Update the selection from a snapshot. Nothing is done if the snapshot has the same version
+     * as the previous one, otherwise only the indices added or removed since the previous
+     * snapshot are updated.
+     */
+    void setSelectedIndices(const IndexSnapshot& indices);
 
     ToolTipCallbackHandle addToolTipCallback(std::function<ToolTipFunc> callback);
     SelectionCallbackHandle addSelectionChangedCallback(std::function<SelectionFunc> callback);
@@ -160,6 +188,11 @@ public:
 protected:
     void plot(const size2_t& dims, IndexBuffer* indices, bool useAxisRanges);
     void renderAxis(const size2_t& dims);
+    /*
+     * Bins the given points and draws the density in the plot area, the cost only depends on the
+     * number of points when the points or the axis ranges change.
+     */
+    void renderDensity(const size2_t& dims, const IndexBuffer& indices, bool useAxisRanges);
 
     void objectPicked(PickingEvent* p);
     uint32_t getGlobalPickId(uint32_t localIndex) const;
@@ -186,6 +219,8 @@ protected:
     PickingMapper picking_;
     std::vector<bool> filtered_;
     std::vector<bool> selected_;
+    // The last snapshot applied to selected_, reset when selected_ is changed locally
+    std::optional<IndexSnapshot> appliedSelection_;
     size_t nSelectedButNotFiltered_ = 0;
     bool filteringDirty_ = true;
     bool selectedIndicesGLDirty_ = true;
@@ -199,6 +234,15 @@ protected:
     std::unique_ptr<IndexBuffer> indices_;
     std::unique_ptr<BufferObjectArray> boa_;
 
+    DensityGrid density_;
+    bool densityDataDirty_ = true;
+    // Set when the density image has to be recolored, i.e. the grid or its color mapping changed
+    bool densityImageDirty_ = true;
+    dvec2 densityCategoryRange_{0.0, 1.0};
+    size_t densityCategories_ = 1;
+    std::shared_ptr<Layer> densityLayer_;
+    TextureQuadRenderer densityRenderer_;
+
     Processor* processor_;
 
     Dispatcher<ToolTipFunc> tooltipCallback_;
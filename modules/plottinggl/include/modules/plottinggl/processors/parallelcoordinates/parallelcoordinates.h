@@ -56,6 +56,7 @@
 #include <modules/plotting/properties/marginproperty.h>
 
 #include <modules/plottinggl/utils/axisrenderer.h>
+#include <modules/plottinggl/processors/parallelcoordinates/pcplinestrips.h>
 
 namespace inviwo {
 class PickingEvent;
@@ -93,7 +94,11 @@ public:
 
     void adjustMargins();
 
-    void updateBrushing(PCPAxisSettings& axis);
+    /**
+     * Update the brushing after the range of \p axis changed, \p changedRows are the rows that
+     * were brushed or unbrushed by that axis.
+     */
+    void updateBrushing(PCPAxisSettings& axis, const std::vector<std::uint32_t>& changedRows);
 
     DataInport<DataFrame> dataFrame_;
     BrushingAndLinkingInport brushingAndLinking_;
@@ -166,6 +171,7 @@ private:
     void buildLineIndices();
     void buildAxisPositions();
     void partitionLines();
+    void updateLinePartitions();
     void drawAxis(size2_t size);
     void drawHandles(size2_t size);
     void drawLines(size2_t size);
@@ -195,28 +201,26 @@ private:
         TypedMesh<buffertraits::PositionsBuffer1D, buffertraits::PickingBuffer,
                   buffertraits::ScalarMetaBuffer>
             mesh;
-        IndexBuffer indices;
-        std::vector<GLsizei> sizes;
-        std::vector<size_t> starts;
-
-        // startFilter, startRegular, startSelected, end
-        std::array<size_t, 4> offsets;
+        PCPLineStrips strips;
 
         std::vector<float> axisPositions;
         // using int here for performance reasons since bool is not supported as GLSL uniform
         // A bool vector would internally be converted to an int array prior setting the uniform.
         // \see UniformSetter<std::array<bool, N>>
         std::vector<int> axisFlipped;
-
-        inline static size_t offsetToIndex(size_t offset, size_t cols) {
-            return offset / (cols * sizeof(uint32_t));
-        }
-        inline static size_t indexToOffset(size_t index, size_t cols) {
-            return index * cols * sizeof(uint32_t);
-        }
     };
     Lines lines_;
 
+    // The brushing the line partitions were built from, and the row of each id in the index
+    // column. Used to only move the lines of rows whose filter or selection state changed.
+    IndexSnapshot partitionedFilter_;
+    IndexSnapshot partitionedSelection_;
+    std::vector<std::uint32_t> rowOfId_;
+
+    // The number of axes brushing away each row, and the ids of the rows brushed by any axis
+    std::vector<std::uint32_t> brushCounts_;
+    BitSet brushedIds_;
+
     std::pair<vec2, vec2> marginsInternal_;  // Margins with/without considering labels
     int hoveredLine_ = -1;
     int hoveredAxis_ = -1;
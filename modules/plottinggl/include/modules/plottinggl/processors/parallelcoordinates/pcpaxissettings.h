@@ -198,7 +198,12 @@ public:
     const CategoricalColumn* catCol_;
 
 private:
-    void updateBrushing();
+    /**
+     * Update the brushed rows after the range changed. Only the rows with values between the old
+     * and new handle positions are visited, found using the rows sorted by value.
+     * @return the rows that were brushed or unbrushed
+     */
+    std::vector<std::uint32_t> updateBrushing();
 
     PCPCaptionSettings captionSettings_;
     std::vector<std::string> labels_;
@@ -218,6 +223,12 @@ private:
 
     size_t columnId_;
     std::vector<bool> brushed_;
+
+    std::vector<std::uint32_t> sortedRows_;  //! Rows of all non-NaN values, sorted by value
+    std::vector<double> sortedValues_;       //! The values of sortedRows_
+    size_t lowerEnd_ = 0;    //! sortedRows_[0, lowerEnd_) are brushed by the lower handle
+    size_t upperBegin_ = 0;  //! sortedRows_[upperBegin_, end) are brushed by the upper handle
+    bool brushingValid_ = false;
 };
 
 }  // namespace plot
@@ -0,0 +1,110 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/plottinggl/plottingglmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <modules/opengl/inviwoopengl.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace inviwo {
+
+namespace plot {
+
+/**
+ * \brief The line strips drawn by the ParallelCoordinates processor
+ *
+ * Every row of the data is one GL_LINE_STRIP running through the enabled axes in order. The
+ * strips are drawn with glMultiDrawElements using the byte offsets in `starts`, which are
+ * partitioned into filtered, regular, and selected lines. Changing the order of the axes or the
+ * state of a few rows only touches the indices and offsets that actually change, only adding or
+ * removing axes requires a rebuild.
+ */
+class IVW_MODULE_PLOTTINGGL_API PCPLineStrips {
+public:
+    enum class State : std::uint8_t { Filtered = 0, Regular = 1, Selected = 2 };
+
+    /**
+     * Build the strips for \p rows rows where the vertex of row r and axis a is found at
+     * r * axes + a. All lines start out as State::Regular.
+     */
+    void build(size_t rows, size_t axes, const std::vector<size_t>& enabledAxes);
+
+    /**
+     * Change the order of the enabled axes, only the indices of the axes that moved are
+     * rewritten. Returns false, without changing anything, if \p enabledAxes is not a permutation
+     * of the current enabled axes, the strips then have to be rebuilt.
+     */
+    bool reorder(const std::vector<size_t>& enabledAxes);
+
+    /**
+     * Assign a new state to every row and partition all strips accordingly.
+     */
+    void partition(const std::function<State(size_t)>& state);
+
+    /**
+     * Move a single row to the group of \p state by swapping it with the lines at the group
+     * boundaries. This is constant time, independent of the number of rows.
+     */
+    void setState(size_t row, State state);
+    State getState(size_t row) const;
+
+    size_t getNumberOfRows() const { return sizes.size(); }
+    const std::vector<size_t>& getEnabledAxes() const { return enabledAxes_; }
+
+    inline static size_t offsetToIndex(size_t offset, size_t cols) {
+        return offset / (cols * sizeof(uint32_t));
+    }
+    inline static size_t indexToOffset(size_t index, size_t cols) {
+        return index * cols * sizeof(uint32_t);
+    }
+
+    IndexBuffer indices;
+    std::vector<GLsizei> sizes;
+    std::vector<size_t> starts;
+
+    // startFilter, startRegular, startSelected, end
+    std::array<size_t, 4> offsets{0, 0, 0, 0};
+
+private:
+    void swapLines(size_t a, size_t b);
+
+    size_t axes_ = 0;
+    std::vector<size_t> enabledAxes_;
+    std::vector<size_t> positions_;  //! The position in starts of the line of each row
+};
+
+}  // namespace plot
+
+}  // namespace inviwo
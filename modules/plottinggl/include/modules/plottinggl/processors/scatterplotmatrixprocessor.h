@@ -88,6 +88,8 @@ private:
     size_t numParams_;
 
     ScatterPlotGL::Properties scatterPlotproperties_;
+    // points that are not filtered by brushing and linking, rebuilt when the brushing changes
+    std::unique_ptr<IndexBuffer> indices_;
     DataFrameColumnProperty color_;
 
     DataFrameColumnProperty selectedX_;
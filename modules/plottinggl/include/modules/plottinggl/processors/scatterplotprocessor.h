@@ -73,6 +73,8 @@ private:
     ImageOutport outport_;
 
     ScatterPlotGL scatterPlot_;
+    // points that are not filtered by brushing and linking, rebuilt when the brushing changes
+    std::unique_ptr<IndexBuffer> indices_;
 
     DataFrameColumnProperty xAxis_;
     DataFrameColumnProperty yAxis_;
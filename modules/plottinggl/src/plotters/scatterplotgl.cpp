@@ -42,6 +42,8 @@
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/datastructures/buffer/bufferram.h>
 #include <inviwo/core/datastructures/geometry/basicmesh.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
 #include <inviwo/core/properties/cameraproperty.h>
 #include <inviwo/core/util/colorconversion.h>
 #include <inviwo/core/util/zip.h>
@@ -51,6 +53,23 @@ namespace inviwo {
 
 namespace plot {
 
+namespace {
+
+/**
+ * The categories used to color the density: one per value for integer data with at most 256
+ * distinct values, otherwise 32 equally large intervals of the value range.
+ */
+std::pair<dvec2, size_t> densityCategories(const BufferBase& buffer, vec2 minmax) {
+    const double min = std::floor(minmax.x);
+    const double max = std::ceil(minmax.y);
+    if (buffer.getDataFormat()->getNumericType() != NumericType::Float && max - min < 256.0) {
+        return {dvec2{min - 0.5, max + 0.5}, static_cast<size_t>(max - min) + 1};
+    }
+    return {dvec2{minmax}, 32};
+}
+
+}  // namespace
+
 const std::string ScatterPlotGL::Properties::classIdentifier =
     "org.inviwo.ScatterPlotGL.Properties";
 std::string ScatterPlotGL::Properties::getClassIdentifier() const { return classIdentifier; }
@@ -76,6 +95,15 @@ ScatterPlotGL::Properties::Properties(std::string identifier, std::string displa
     , borderColor_("borderColor", "Border Color", vec4(0, 0, 0, 1))
     , hovering_("hovering", "Enable Hovering", true)
 
+    , renderMode_("renderMode", "Render Mode",
+                  {{"auto", "Auto", RenderMode::Auto},
+                   {"points", "Points", RenderMode::Points},
+                   {"density", "Density", RenderMode::Density}},
+                  0)
+    , densityThreshold_("densityThreshold", "Density Threshold", 1000000, 0, 100000000, 1000)
+    , binSize_("binSize", "Bin Size (pixels)", 2, 1, 32)
+    , logDensity_("logDensity", "Logarithmic Density", true)
+
     , axisStyle_("axisStyle", "Global Axis Style")
     , xAxis_("xAxis", "X Axis")
     , yAxis_("yAxis", "Y Axis", AxisProperty::Orientation::Vertical) {
@@ -92,6 +120,7 @@ ScatterPlotGL::Properties::Properties(std::string identifier, std::string displa
     color_.setVisible(true);
     tf_.setVisible(!color_.getVisible());
     minRadius_.setVisible(false);
+    setupDensityVisibility();
 
     tf_.setCurrentStateAsDefault();
 }
@@ -111,18 +140,31 @@ ScatterPlotGL::Properties::Properties(const ScatterPlotGL::Properties& rhs)
     , borderWidth_(rhs.borderWidth_)
     , borderColor_(rhs.borderColor_)
     , hovering_(rhs.hovering_)
+    , renderMode_(rhs.renderMode_)
+    , densityThreshold_(rhs.densityThreshold_)
+    , binSize_(rhs.binSize_)
+    , logDensity_(rhs.logDensity_)
     , axisStyle_(rhs.axisStyle_)
     , xAxis_(rhs.xAxis_)
     , yAxis_(rhs.yAxis_) {
     util::for_each_in_tuple([&](auto& e) { this->addProperty(e); }, props());
     axisStyle_.unregisterAll();
     axisStyle_.registerProperties(xAxis_, yAxis_);
+    setupDensityVisibility();
 }
 
 ScatterPlotGL::Properties* ScatterPlotGL::Properties::clone() const {
     return new Properties(*this);
 }
 
+void ScatterPlotGL::Properties::setupDensityVisibility() {
+    const auto density = [](const auto& mode) { return mode.get() != RenderMode::Points; };
+    densityThreshold_.visibilityDependsOn(
+        renderMode_, [](const auto& mode) { return mode.get() == RenderMode::Auto; });
+    binSize_.visibilityDependsOn(renderMode_, density);
+    logDensity_.visibilityDependsOn(renderMode_, density);
+}
+
 ScatterPlotGL::ScatterPlotGL(Processor* processor)
     : properties_("scatterplot", "Scatterplot")
     , shader_("scatterplot.vert", "scatterplot.geom", "scatterplot.frag")
@@ -168,6 +210,10 @@ ScatterPlotGL::ScatterPlotGL(Processor* processor)
             hoverIndex_ = std::nullopt;
         }
     });
+    for (Property* p : std::initializer_list<Property*>{
+             &properties_.tf_, &properties_.color_, &properties_.logDensity_}) {
+        p->onChange([this]() { densityImageDirty_ = true; });
+    }
 
     boxSelectionChangedCallBack_ = boxSelectionHandler_.addSelectionChangedCallback(
         [this](const std::vector<bool>& selected, bool append) {
@@ -180,6 +226,7 @@ ScatterPlotGL::ScatterPlotGL(Processor* processor)
                 }
             }
 
+            appliedSelection_.reset();
             selectedIndicesGLDirty_ = true;
             // selection changed, inform processor
             selectionChangedCallback_.invoke(selected_);
@@ -234,6 +281,13 @@ void ScatterPlotGL::plot(const ivec2& start, const ivec2& size, IndexBuffer* ind
 
 void ScatterPlotGL::plot(const size2_t& dims, IndexBuffer* indexBuffer, bool useAxisRanges) {
     ensureSelectAndFilterSizes();
+    const auto renderMode = properties_.renderMode_.get();
+    const bool density =
+        renderMode == RenderMode::Density ||
+        (renderMode == RenderMode::Auto &&
+         (indexBuffer ? indexBuffer->getSize() : xAxis_->getSize()) >
+             properties_.densityThreshold_.get());
+
     // adjust all margins by axis margin
     vec4 margins = properties_.margins_.getAsVec4() + properties_.axisMargin_.get();
 
@@ -353,7 +407,7 @@ void ScatterPlotGL::plot(const size2_t& dims, IndexBuffer* indexBuffer, bool use
         filteringDirty_ = false;
     };
     IndexBuffer* indices;
-    if (radius_) {
+    if (radius_ && !density) {
 
         if (indexBuffer) {
             // copy selected indices
@@ -383,12 +437,19 @@ void ScatterPlotGL::plot(const size2_t& dims, IndexBuffer* indexBuffer, bool use
         }
     }
 
-    boa_->bind();
-    auto indicesGL = indices->getRepresentation<BufferGL>();
-    indicesGL->bind();
-    glDrawElements(GL_POINTS, static_cast<uint32_t>(indices->getSize()), indicesGL->getFormatType(),
-                   nullptr);
-    indicesGL->getBufferObject()->unbind();
+    if (density) {
+        shader_.deactivate();
+        renderDensity(dims, *indices, useAxisRanges);
+        shader_.activate();
+        boa_->bind();
+    } else {
+        boa_->bind();
+        auto indicesGL = indices->getRepresentation<BufferGL>();
+        indicesGL->bind();
+        glDrawElements(GL_POINTS, static_cast<uint32_t>(indices->getSize()),
+                       indicesGL->getFormatType(), nullptr);
+        indicesGL->getBufferObject()->unbind();
+    }
     // draw selected and hovered points on top
 
     if (selectedIndicesGLDirty_ || nSelectedButNotFiltered_ > 0) {
@@ -453,6 +514,88 @@ void ScatterPlotGL::plot(const size2_t& dims, IndexBuffer* indexBuffer, bool use
     renderAxis(dims);
 }  // namespace plot
 
+void ScatterPlotGL::renderDensity(const size2_t& dims, const IndexBuffer& indices,
+                                  bool useAxisRanges) {
+    // plot area in pixels, margins are top, right, bottom, left
+    const ivec4 margins{properties_.margins_.getAsVec4() + properties_.axisMargin_.get()};
+    const ivec2 pos{margins.w, margins.z};
+    const ivec2 extent = ivec2{dims} - ivec2{margins.w + margins.y, margins.x + margins.z};
+    if (extent.x <= 0 || extent.y <= 0) return;
+
+    if (densityDataDirty_) {
+        density_.setData(xAxis_, yAxis_);
+        if (color_) {
+            std::tie(densityCategoryRange_, densityCategories_) =
+                densityCategories(*color_, minmaxC_);
+            density_.setCategories(color_, densityCategoryRange_, densityCategories_);
+        } else {
+            density_.setCategories(nullptr, dvec2{0.0, 1.0}, 1);
+        }
+        densityDataDirty_ = false;
+        densityImageDirty_ = true;
+    }
+    // The indices are compared to the previous ones, the points are only binned again if they
+    // changed. The buffer can not be used to detect changes, a new buffer might get the address
+    // of a deleted one and a buffer can be edited in place.
+    density_.setIndices(indices.getRAMRepresentation()->getDataContainer());
+
+    const size2_t gridDims{glm::max(extent / properties_.binSize_.get(), ivec2{1})};
+    const auto& grid =
+        useAxisRanges
+            ? density_.update(gridDims, properties_.xAxis_.range_.get(),
+                              properties_.yAxis_.range_.get())
+            : density_.update(gridDims, dvec2{minmaxX_}, dvec2{minmaxY_});
+
+    if (density_.getLastUpdate() != DensityGrid::Update::Cached) densityImageDirty_ = true;
+    if (!densityLayer_ || densityImageDirty_) {
+        // The color of each category, and the mean color of the points in each bin
+        std::vector<vec4> colors(grid.categories, properties_.color_.get());
+        if (color_) {
+            const auto& tf = properties_.tf_.get();
+            // a constant color column maps to the center of the transfer function
+            const double range = minmaxC_.y - minmaxC_.x;
+            const double width = (densityCategoryRange_.y - densityCategoryRange_.x) /
+                                  static_cast<double>(grid.categories);
+            for (size_t c = 0; c < grid.categories; ++c) {
+                const double value =
+                    densityCategoryRange_.x + width * (static_cast<double>(c) + 0.5);
+                colors[c] = tf.sample(range > 0.0 ? (value - minmaxC_.x) / range : 0.5);
+            }
+        }
+        const bool logDensity = properties_.logDensity_.get();
+        const float maxDensity = logDensity ? std::log1p(grid.maxCount) : grid.maxCount;
+
+        if (!densityLayer_ || densityLayer_->getDimensions() != gridDims) {
+            densityLayer_ =
+                std::make_shared<Layer>(std::make_shared<LayerRAMPrecision<vec4>>(gridDims));
+        }
+        auto data = static_cast<LayerRAMPrecision<vec4>*>(
+                        densityLayer_->getEditableRepresentation<LayerRAM>())
+                        ->getDataTyped();
+        for (size_t bin = 0; bin < gridDims.x * gridDims.y; ++bin) {
+            const float* counts = &grid.counts[bin * grid.categories];
+            vec4 color{0.0f};
+            float count = 0.0f;
+            for (size_t c = 0; c < grid.categories; ++c) {
+                color += counts[c] * colors[c];
+                count += counts[c];
+            }
+            if (count == 0.0f) {
+                data[bin] = vec4{0.0f};
+                continue;
+            }
+            color /= count;
+            const float alpha = color.a * (logDensity ? std::log1p(count) : count) / maxDensity;
+            // premultiplied alpha
+            data[bin] = vec4{vec3{color} * alpha, alpha};
+        }
+        densityImageDirty_ = false;
+    }
+
+    utilgl::GlBoolState depthTest(GL_DEPTH_TEST, false);
+    densityRenderer_.renderToRect(*densityLayer_, pos, extent, dims);
+}
+
 void ScatterPlotGL::setXAxisLabel(const std::string& label) {
     properties_.xAxis_.setCaption(label);
 }
@@ -472,6 +615,7 @@ void ScatterPlotGL::setYAxis(std::shared_ptr<const Column> col) {
 }
 
 void ScatterPlotGL::setXAxisData(std::shared_ptr<const BufferBase> buffer) {
+    densityDataDirty_ = true;
     xAxis_ = buffer;
     if (buffer) {
         auto minmax = util::bufferMinMax(buffer.get(), IgnoreSpecialValues::Yes);
@@ -484,6 +628,7 @@ void ScatterPlotGL::setXAxisData(std::shared_ptr<const BufferBase> buffer) {
 }
 
 void ScatterPlotGL::setYAxisData(std::shared_ptr<const BufferBase> buffer) {
+    densityDataDirty_ = true;
     yAxis_ = buffer;
     if (buffer) {
         auto minmax = util::bufferMinMax(buffer.get(), IgnoreSpecialValues::Yes);
@@ -496,6 +641,7 @@ void ScatterPlotGL::setYAxisData(std::shared_ptr<const BufferBase> buffer) {
 }
 
 void ScatterPlotGL::setColorData(std::shared_ptr<const BufferBase> buffer) {
+    densityDataDirty_ = true;
     color_ = buffer;
     if (buffer) {
         auto minmax = util::bufferMinMax(buffer.get(), IgnoreSpecialValues::Yes);
@@ -532,13 +678,29 @@ void ScatterPlotGL::setIndexColumn(std::shared_ptr<const TemplateColumn<uint32_t
     }
 }
 
-void ScatterPlotGL::setSelectedIndices(const std::unordered_set<size_t>& indices) {
+void ScatterPlotGL::setSelectedIndices(const IndexSnapshot& indices) {
     ensureSelectAndFilterSizes();
-    selected_.resize(xAxis_->getSize(), false);
-    for (auto i : indices) {
-        selected_[i] = true;
+    if (appliedSelection_ && appliedSelection_->getVersion() == indices.getVersion()) return;
+
+    const size_t size = selected_.size();
+    const auto fill = [&](const BitSet& bitSet, bool value) {
+        bitSet.forEachRange([&](size_t begin, size_t end) {
+            std::fill(selected_.begin() + std::min(begin, size),
+                      selected_.begin() + std::min(end, size), value);
+        });
+    };
+
+    if (appliedSelection_) {
+        const auto delta = util::delta(**appliedSelection_, *indices);
+        fill(delta.removed, false);
+        fill(delta.added, true);
+        if (!delta.empty()) selectedIndicesGLDirty_ = true;
+    } else {
+        selected_.assign(size, false);
+        fill(*indices, true);
+        selectedIndicesGLDirty_ = true;
     }
-    selectedIndicesGLDirty_ = true;
+    appliedSelection_ = indices;
 }
 
 auto ScatterPlotGL::addToolTipCallback(std::function<ToolTipFunc> callback)
@@ -629,6 +791,7 @@ void ScatterPlotGL::objectPicked(PickingEvent* p) {
         (p->getCurrentGlobalPickingId() == p->getPressedGlobalPickingId())) {
         ensureSelectAndFilterSizes();
         selected_[id] = !selected_[id];
+        appliedSelection_.reset();
         selectedIndicesGLDirty_ = true;
 
         // selection changed, inform processor
@@ -645,6 +808,7 @@ void ScatterPlotGL::ensureSelectAndFilterSizes() {
     if (xAxis_->getSize() != selected_.size() || xAxis_->getSize() != filtered_.size()) {
         selected_.resize(xAxis_->getSize(), false);
         filtered_.resize(xAxis_->getSize(), false);
+        appliedSelection_.reset();
         selectedIndicesGLDirty_ = true;
         filteringDirty_ = true;
     }
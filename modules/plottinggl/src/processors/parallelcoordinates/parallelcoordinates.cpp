@@ -301,9 +301,15 @@ void ParallelCoordinates::process() {
     if (colormap_.isModified() || dataFrame_.isChanged()) {
         buildLineMesh();
     } else if (enabledAxesModified_) {
-        buildLineIndices();
+        // Reordering axes only rewrites the indices of the axes that moved, adding or removing
+        // axes changes the length of every line and requires a rebuild.
+        if (lines_.strips.reorder(enabledAxes_)) {
+            buildAxisPositions();
+        } else {
+            buildLineIndices();
+        }
     } else if (brushingAndLinking_.isChanged() || axisProperties_.isModified()) {
-        partitionLines();
+        updateLinePartitions();
     }
     if ((!isDragging_ || enabledAxesModified_) &&
         (margins_.isModified() || includeLabelsInMargin_.isModified() || enabledAxesModified_ ||
@@ -421,37 +427,24 @@ void ParallelCoordinates::buildLineMesh() {
     lineShader_.getVertexShaderObject()->addShaderDefine("NUMBER_OF_AXIS", toString(numberOfAxis));
     lineShader_.build();
 
+    // Map ids back to rows for updating the partitions of the lines. The index column usually
+    // holds the row numbers, for sparse ids we fall back to partitioning all lines.
+    const auto iCol = dataFrame_.getData()->getIndexColumn();
+    const auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+    rowOfId_.clear();
+    const auto maxId = indexCol.empty() ? 0 : *std::max_element(indexCol.begin(), indexCol.end());
+    if (!indexCol.empty() && maxId < 2 * indexCol.size()) {
+        rowOfId_.resize(maxId + 1, std::numeric_limits<std::uint32_t>::max());
+        for (size_t row = 0; row < indexCol.size(); ++row) {
+            rowOfId_[indexCol[row]] = static_cast<std::uint32_t>(row);
+        }
+    }
+
     buildLineIndices();
 }
 
 void ParallelCoordinates::buildLineIndices() {
-    const auto numberOfAxis = axes_.size();
-    const auto numberOfEnabledAxis = enabledAxes_.size();
-    const auto numberOfLines = dataFrame_.getData()->getNumberOfRows();
-
-    lines_.sizes.resize(numberOfLines, static_cast<int>(numberOfEnabledAxis));
-    if (!lines_.sizes.empty() && lines_.sizes.front() != static_cast<int>(numberOfEnabledAxis)) {
-        std::fill(lines_.sizes.begin(), lines_.sizes.end(),
-                  static_cast<GLsizei>(numberOfEnabledAxis));
-    }
-
-    auto& indices = lines_.indices.getEditableRAMRepresentation()->getDataContainer();
-
-    indices.clear();
-    indices.reserve(numberOfEnabledAxis * numberOfLines);
-    for (size_t i = 0; i < numberOfLines; i++) {
-        for (auto id : enabledAxes_) {
-            indices.push_back(static_cast<uint32_t>(i * numberOfAxis + id));
-        }
-    }
-
-    lines_.starts.clear();
-    if (!indices.empty()) {
-        lines_.starts.reserve(numberOfLines);
-        for (size_t i = 0; i < numberOfLines; i++) {
-            lines_.starts.push_back(Lines::indexToOffset(i, numberOfEnabledAxis));
-        }
-    }
+    lines_.strips.build(dataFrame_.getData()->getNumberOfRows(), axes_.size(), enabledAxes_);
 
     buildAxisPositions();
     partitionLines();
@@ -470,25 +463,60 @@ void ParallelCoordinates::buildAxisPositions() {
 }
 
 void ParallelCoordinates::partitionLines() {
-    const auto numberOfEnabledAxis = enabledAxes_.size();
-
     const auto iCol = dataFrame_.getData()->getIndexColumn();
     const auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
 
-    const auto lastFilteredIt =
-        std::partition(lines_.starts.begin(), lines_.starts.end(), [&](auto ind) {
-            return brushingAndLinking_.isFiltered(
-                indexCol[Lines::offsetToIndex(ind, numberOfEnabledAxis)]);
-        });
-    const auto lastRegularIt = std::partition(lastFilteredIt, lines_.starts.end(), [&](auto ind) {
-        return !brushingAndLinking_.isSelected(
-            indexCol[Lines::offsetToIndex(ind, numberOfEnabledAxis)]);
+    partitionedFilter_ = brushingAndLinking_.getFilterSnapshot();
+    partitionedSelection_ = brushingAndLinking_.getSelectionSnapshot();
+
+    lines_.strips.partition([&](size_t row) {
+        const auto id = indexCol[row];
+        if (partitionedFilter_->contains(id)) return PCPLineStrips::State::Filtered;
+        if (partitionedSelection_->contains(id)) return PCPLineStrips::State::Selected;
+        return PCPLineStrips::State::Regular;
     });
+}
+
+void ParallelCoordinates::updateLinePartitions() {
+    const auto& filter = brushingAndLinking_.getFilterSnapshot();
+    const auto& selection = brushingAndLinking_.getSelectionSnapshot();
+    if (filter.getVersion() == partitionedFilter_.getVersion() &&
+        selection.getVersion() == partitionedSelection_.getVersion()) {
+        return;
+    }
 
-    lines_.offsets[0] = 0;
-    lines_.offsets[1] = std::distance(lines_.starts.begin(), lastFilteredIt);
-    lines_.offsets[2] = std::distance(lines_.starts.begin(), lastRegularIt);
-    lines_.offsets[3] = lines_.starts.size();
+    const auto filterDelta = util::delta(*partitionedFilter_, *filter);
+    const auto selectionDelta = util::delta(*partitionedSelection_, *selection);
+    const auto numberOfChanges = filterDelta.added.size() + filterDelta.removed.size() +
+                                 selectionDelta.added.size() + selectionDelta.removed.size();
+
+    // Moving lines one at a time only pays off as long as a minority of the rows changed
+    if (rowOfId_.empty() || numberOfChanges > lines_.strips.getNumberOfRows() / 4) {
+        partitionLines();
+        return;
+    }
+
+    partitionedFilter_ = filter;
+    partitionedSelection_ = selection;
+
+    const auto update = [&](const BitSet& ids) {
+        for (auto id : ids) {
+            if (id >= rowOfId_.size()) continue;
+            const auto row = rowOfId_[id];
+            if (row == std::numeric_limits<std::uint32_t>::max()) continue;
+            if (partitionedFilter_->contains(id)) {
+                lines_.strips.setState(row, PCPLineStrips::State::Filtered);
+            } else if (partitionedSelection_->contains(id)) {
+                lines_.strips.setState(row, PCPLineStrips::State::Selected);
+            } else {
+                lines_.strips.setState(row, PCPLineStrips::State::Regular);
+            }
+        }
+    };
+    update(filterDelta.added);
+    update(filterDelta.removed);
+    update(selectionDelta.added);
+    update(selectionDelta.removed);
 }
 
 void ParallelCoordinates::drawAxis(size2_t size) {
@@ -588,9 +616,10 @@ void ParallelCoordinates::drawLines(size2_t size) {
     lineShader_.setUniform("filterIntensity", filterIntensity_.get());
 
     {
+        const auto& strips = lines_.strips;
         auto meshGL = lines_.mesh.getRepresentation<MeshGL>();
         utilgl::Enable<MeshGL> enable{meshGL};
-        lines_.indices.getRepresentation<BufferGL>()->bind();
+        strips.indices.getRepresentation<BufferGL>()->bind();
 
         std::array<float, 3> width = {lineWidth_, lineWidth_, selectedLineWidth_};
         std::array<float, 3> mixColor = {filterIntensity_, 0.0f, 0.0f};
@@ -598,9 +627,9 @@ void ParallelCoordinates::drawLines(size2_t size) {
                                              selectedLineColorOverride_.isChecked() ? 1.0f : 0.0f};
         std::array<float, 3> mixAlpha = {1.0, 0.0f, 0.0f};
 
-        for (size_t i = showFiltered_ ? 0 : 1; i < lines_.offsets.size() - 1; ++i) {
-            auto begin = lines_.offsets[i];
-            auto end = lines_.offsets[i + 1];
+        for (size_t i = showFiltered_ ? 0 : 1; i < strips.offsets.size() - 1; ++i) {
+            auto begin = strips.offsets[i];
+            auto end = strips.offsets[i + 1];
             if (end == begin) continue;
 
             lineShader_.setUniform("lineWidth", width[i]);
@@ -609,18 +638,18 @@ void ParallelCoordinates::drawLines(size2_t size) {
             lineShader_.setUniform("mixSelection", mixSelection[i]);
 
             glMultiDrawElements(
-                GL_LINE_STRIP, lines_.sizes.data() + begin, GL_UNSIGNED_INT,
-                reinterpret_cast<const GLvoid* const*>(lines_.starts.data() + begin),
+                GL_LINE_STRIP, strips.sizes.data() + begin, GL_UNSIGNED_INT,
+                reinterpret_cast<const GLvoid* const*>(strips.starts.data() + begin),
                 static_cast<GLsizei>(end - begin));
         }
 
-        if (hoveredLine_ >= 0 && hoveredLine_ < static_cast<int>(lines_.sizes.size()) &&
+        if (hoveredLine_ >= 0 && hoveredLine_ < static_cast<int>(strips.sizes.size()) &&
             !brushingAndLinking_.isFiltered(hoveredLine_)) {
             lineShader_.setUniform("fallofPower", 0.5f * falllofPower_.get());
 
-            glDrawElements(GL_LINE_STRIP, lines_.sizes[hoveredLine_], GL_UNSIGNED_INT,
-                           reinterpret_cast<GLvoid*>(
-                               Lines::indexToOffset(hoveredLine_, lines_.sizes[hoveredLine_])));
+            glDrawElements(GL_LINE_STRIP, strips.sizes[hoveredLine_], GL_UNSIGNED_INT,
+                           reinterpret_cast<GLvoid*>(PCPLineStrips::indexToOffset(
+                               hoveredLine_, strips.sizes[hoveredLine_])));
         }
     }
     lineShader_.deactivate();
@@ -656,7 +685,7 @@ void ParallelCoordinates::linePicked(PickingEvent* p) {
         } else {
             selection.insert(indexCol[id]);
         }
-        brushingAndLinking_.sendSelectionEvent(selection);
+        brushingAndLinking_.sendSelectionEvent(std::move(selection));
 
         p->markAsUsed();
         invalidate(InvalidationLevel::InvalidOutput);
@@ -703,7 +732,7 @@ void ParallelCoordinates::axisPicked(PickingEvent* p, size_t pickedID, PickType
             selection.clear();
             selection.insert(pickedID);
         }
-        brushingAndLinking_.sendColumnSelectionEvent(selection);
+        brushingAndLinking_.sendColumnSelectionEvent(std::move(selection));
 
         p->markAsUsed();
         invalidate(InvalidationLevel::InvalidOutput);
@@ -719,7 +748,7 @@ void ParallelCoordinates::axisPicked(PickingEvent* p, size_t pickedID, PickType
         } else {
             selection.insert(pickedID);
         }
-        brushingAndLinking_.sendColumnSelectionEvent(selection);
+        brushingAndLinking_.sendColumnSelectionEvent(std::move(selection));
 
         p->markAsUsed();
         invalidate(InvalidationLevel::InvalidOutput);
@@ -775,7 +804,31 @@ void ParallelCoordinates::axisPicked(PickingEvent* p, size_t pickedID, PickType
     }
 }
 
-void ParallelCoordinates::updateBrushing(PCPAxisSettings&) { updateBrushing(); }
+void ParallelCoordinates::updateBrushing(PCPAxisSettings& axis,
+                                         const std::vector<std::uint32_t>& changedRows) {
+    if (updating_) return;
+
+    auto iCol = dataFrame_.getData()->getIndexColumn();
+    auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+
+    // Axes that are not part of the current data are not counted
+    if (axis.columnId() >= axes_.size() || axes_[axis.columnId()].pcp != &axis) return;
+    const auto& brushedAxis = axis.getBrushed();
+    if (brushingDirty_ || brushCounts_.size() != indexCol.size() ||
+        brushedAxis.size() != indexCol.size()) {
+        updateBrushing();
+        return;
+    }
+
+    for (auto row : changedRows) {
+        if (brushedAxis[row]) {
+            if (brushCounts_[row]++ == 0) brushedIds_.insert(indexCol[row]);
+        } else {
+            if (--brushCounts_[row] == 0) brushedIds_.erase(indexCol[row]);
+        }
+    }
+    if (!changedRows.empty()) brushingAndLinking_.sendFilterEvent(brushedIds_);
+}
 
 void ParallelCoordinates::updateBrushing() {
     if (updating_) return;
@@ -787,20 +840,19 @@ void ParallelCoordinates::updateBrushing() {
 
     const auto nRows = indexCol.size();
 
-    std::vector<bool> brushed(nRows, false);
-
+    brushCounts_.assign(nRows, 0);
     for (auto& axis : axes_) {
         auto& brushedAxis = axis.pcp->getBrushed();
-        for (size_t i = 0; i < nRows; ++i) {
-            brushed[i] = brushed[i] || brushedAxis[i];
+        for (size_t i = 0; i < std::min(nRows, brushedAxis.size()); ++i) {
+            if (brushedAxis[i]) ++brushCounts_[i];
         }
     }
 
-    std::unordered_set<size_t> brushedID;
+    brushedIds_.clear();
     for (size_t i = 0; i < nRows; ++i) {
-        if (brushed[i]) brushedID.insert(indexCol[i]);
+        if (brushCounts_[i] != 0) brushedIds_.insert(indexCol[i]);
     }
-    brushingAndLinking_.sendFilterEvent(brushedID);
+    brushingAndLinking_.sendFilterEvent(brushedIds_);
 }
 
 std::pair<size2_t, size2_t> ParallelCoordinates::axisPos(size_t columnId) const {
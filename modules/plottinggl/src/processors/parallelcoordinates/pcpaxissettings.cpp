@@ -30,39 +30,18 @@
 #include <modules/plottinggl/processors/parallelcoordinates/pcpaxissettings.h>
 
 #include <inviwo/dataframe/datastructures/column.h>
-#include <modules/base/algorithm/dataminmax.h>
-#include <modules/plotting/utils/statsutils.h>
 #include <modules/plottinggl/processors/parallelcoordinates/parallelcoordinates.h>
 #include <modules/plotting/utils/axisutils.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include <fmt/format.h>
 #include <fmt/printf.h>
 
 namespace inviwo {
 namespace plot {
 
-namespace detail {
-enum class FilterResult { Upper, Lower, None };
-/**
- * Helper for brushing data
- * @param value to filter
- * @param range to use for filtering
- * @return true if value is outside range and not missing data.
- */
-FilterResult filterValue(const double& value, const dvec2& range) {
-    // Do not filter missing data (NaN)
-    if (util::isnan(value)) return FilterResult::None;
-    if (value < range.x) {
-        return FilterResult::Lower;
-    }
-    if (value > range.y) {
-        return FilterResult::Upper;
-    }
-    return FilterResult::None;
-}
-
-}  // namespace detail
-
 const std::string PCPAxisSettings::classIdentifier =
     "org.inviwo.parallelcoordinates.axissettingsproperty";
 std::string PCPAxisSettings::getClassIdentifier() const { return classIdentifier; }
@@ -85,8 +64,8 @@ PCPAxisSettings::PCPAxisSettings(std::string identifier, std::string displayName
     usePercentiles.setSerializationMode(PropertySerializationMode::All);
 
     range.onChange([this]() {
-        updateBrushing();
-        if (pcp_) pcp_->updateBrushing(*this);
+        const auto changed = updateBrushing();
+        if (pcp_) pcp_->updateBrushing(*this, changed);
     });
 }
 
@@ -102,8 +81,8 @@ PCPAxisSettings::PCPAxisSettings(const PCPAxisSettings& rhs)
     addProperty(usePercentiles);
 
     range.onChange([this]() {
-        updateBrushing();
-        if (pcp_) pcp_->updateBrushing(*this);
+        const auto changed = updateBrushing();
+        if (pcp_) pcp_->updateBrushing(*this, changed);
     });
 }
 
@@ -112,15 +91,15 @@ PCPAxisSettings* PCPAxisSettings::clone() const { return new PCPAxisSettings(*th
 void PCPAxisSettings::updateFromColumn(std::shared_ptr<const Column> col) {
     col_ = col;
     catCol_ = dynamic_cast<const CategoricalColumn*>(col.get());
+    const auto stats = col->getStatistics();
 
     col->getBuffer()->getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Scalars>(
         [&](auto ram) -> void {
             using T = typename util::PrecisionValueType<decltype(ram)>;
             auto& dataVector = ram->getDataContainer();
 
-            auto minMax = util::bufferMinMax(ram, IgnoreSpecialValues::Yes);
-            double minV = minMax.first.x;
-            double maxV = minMax.second.x;
+            double minV = stats->min;
+            double maxV = stats->max;
 
             if (std::abs(maxV - minV) == 0.0) {
                 minV -= 1.0;
@@ -140,14 +119,29 @@ void PCPAxisSettings::updateFromColumn(std::shared_ptr<const Column> col) {
                 range.set(
                     {minV + prevMinRatio * (maxV - minV), minV + prevMaxRatio * (maxV - minV)});
             }
-            auto pecentiles = statsutil::percentiles(dataVector, {0., 0.25, 0.75, 1.});
-            p0_ = static_cast<double>(pecentiles[0]);
-            p25_ = static_cast<double>(pecentiles[1]);
-            p75_ = static_cast<double>(pecentiles[2]);
-            p100_ = static_cast<double>(pecentiles[3]);
+            p0_ = stats->min;
+            p25_ = stats->quantile(0.25);
+            p75_ = stats->quantile(0.75);
+            p100_ = stats->max;
             at = [vec = &dataVector](size_t idx) { return static_cast<double>(vec->at(idx)); };
+
+            // Missing data (NaN) is never brushed and left out
+            sortedRows_.clear();
+            sortedRows_.reserve(dataVector.size());
+            for (size_t i = 0; i < dataVector.size(); ++i) {
+                if (!std::isnan(static_cast<double>(dataVector[i]))) {
+                    sortedRows_.push_back(static_cast<std::uint32_t>(i));
+                }
+            }
+            std::sort(sortedRows_.begin(), sortedRows_.end(),
+                      [&](auto a, auto b) { return dataVector[a] < dataVector[b]; });
+            sortedValues_.resize(sortedRows_.size());
+            std::transform(sortedRows_.begin(), sortedRows_.end(), sortedValues_.begin(),
+                           [&](auto row) { return static_cast<double>(dataVector[row]); });
         });
 
+    brushingValid_ = false;
+
     range.propertyModified();
 }
 
@@ -257,29 +251,59 @@ void PCPAxisSettings::setParallelCoordinates(ParallelCoordinates* pcp) {
     updateLabels();
 }
 
-void PCPAxisSettings::updateBrushing() {
-    if (!col_) return;
+std::vector<std::uint32_t> PCPAxisSettings::updateBrushing() {
+    if (!col_) return {};
 
     // Increase range to avoid conversion issues
     const dvec2 off{-std::numeric_limits<float>::epsilon(), std::numeric_limits<float>::epsilon()};
     const auto rangeTmp = range.get() + off;
     const auto nRows = col_->getSize();
 
-    upperBrushed_ = false;
-    lowerBrushed_ = false;
-
-    brushed_.resize(nRows, false);
-
-    for (size_t i = 0; i < nRows; i++) {
-        const auto filtered = detail::filterValue(at(i), rangeTmp);
-        if (filtered == detail::FilterResult::None) {
-            brushed_[i] = false;
-            continue;
+    // Values below rangeTmp.x are in [0, lower), values above rangeTmp.y in [upper, end)
+    const auto lower = static_cast<size_t>(
+        std::lower_bound(sortedValues_.begin(), sortedValues_.end(), rangeTmp.x) -
+        sortedValues_.begin());
+    const auto upper = std::max(
+        lower, static_cast<size_t>(
+                   std::upper_bound(sortedValues_.begin(), sortedValues_.end(), rangeTmp.y) -
+                   sortedValues_.begin()));
+
+    std::vector<std::uint32_t> changed;
+    if (!brushingValid_ || brushed_.size() != nRows) {
+        std::vector<bool> brushed(nRows, false);
+        for (size_t k = 0; k < lower; ++k) brushed[sortedRows_[k]] = true;
+        for (size_t k = upper; k < sortedRows_.size(); ++k) brushed[sortedRows_[k]] = true;
+        for (size_t i = 0; i < nRows; ++i) {
+            if (brushed[i] != (i < brushed_.size() && brushed_[i])) {
+                changed.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+        brushed_.swap(brushed);
+        brushingValid_ = true;
+    } else {
+        // Only the rows between the old and new position of each handle toggle. A row passed by
+        // both handles, i.e. moving from the lower to the upper brushed part, stays brushed.
+        const auto [l0, l1] = std::minmax(lower, lowerEnd_);
+        const auto [u0, u1] = std::minmax(upper, upperBegin_);
+        const auto toggle = [&](size_t k) {
+            const auto row = sortedRows_[k];
+            brushed_[row] = !brushed_[row];
+            changed.push_back(row);
+        };
+        for (size_t k = l0; k < l1; ++k) {
+            if (k < u0 || k >= u1) toggle(k);
+        }
+        for (size_t k = u0; k < u1; ++k) {
+            if (k < l0 || k >= l1) toggle(k);
         }
-        brushed_[i] = true;
-        if (filtered == detail::FilterResult::Upper) upperBrushed_ = true;
-        if (filtered == detail::FilterResult::Lower) lowerBrushed_ = true;
     }
+
+    lowerEnd_ = lower;
+    upperBegin_ = upper;
+    lowerBrushed_ = lower > 0;
+    upperBrushed_ = upper < sortedRows_.size();
+
+    return changed;
 }
 
 dvec2 PCPAxisSettings::getRange() const {
@@ -0,0 +1,153 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/plottinggl/processors/parallelcoordinates/pcplinestrips.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace plot {
+
+void PCPLineStrips::build(size_t rows, size_t axes, const std::vector<size_t>& enabledAxes) {
+    axes_ = axes;
+    enabledAxes_ = enabledAxes;
+    const auto cols = enabledAxes_.size();
+
+    auto& ind = indices.getEditableRAMRepresentation()->getDataContainer();
+    ind.resize(rows * cols);
+    for (size_t row = 0; row < rows; ++row) {
+        auto* dst = ind.data() + row * cols;
+        for (size_t k = 0; k < cols; ++k) {
+            dst[k] = static_cast<std::uint32_t>(row * axes_ + enabledAxes_[k]);
+        }
+    }
+
+    sizes.assign(rows, static_cast<GLsizei>(cols));
+
+    const auto lines = cols == 0 ? size_t{0} : rows;
+    starts.resize(lines);
+    positions_.resize(lines);
+    for (size_t row = 0; row < lines; ++row) {
+        starts[row] = indexToOffset(row, cols);
+        positions_[row] = row;
+    }
+    offsets = {0, 0, lines, lines};
+}
+
+bool PCPLineStrips::reorder(const std::vector<size_t>& enabledAxes) {
+    if (enabledAxes.size() != enabledAxes_.size() ||
+        !std::is_permutation(enabledAxes.begin(), enabledAxes.end(), enabledAxes_.begin())) {
+        return false;
+    }
+
+    std::vector<size_t> moved;
+    for (size_t k = 0; k < enabledAxes.size(); ++k) {
+        if (enabledAxes[k] != enabledAxes_[k]) moved.push_back(k);
+    }
+    if (moved.empty()) return true;
+
+    const auto cols = enabledAxes.size();
+    const auto rows = sizes.size();
+    auto& ind = indices.getEditableRAMRepresentation()->getDataContainer();
+    for (size_t row = 0; row < rows; ++row) {
+        auto* dst = ind.data() + row * cols;
+        for (auto k : moved) {
+            dst[k] = static_cast<std::uint32_t>(row * axes_ + enabledAxes[k]);
+        }
+    }
+    enabledAxes_ = enabledAxes;
+    return true;
+}
+
+void PCPLineStrips::partition(const std::function<State(size_t)>& state) {
+    const auto cols = enabledAxes_.size();
+    if (starts.empty()) return;
+
+    const auto lastFilteredIt = std::partition(starts.begin(), starts.end(), [&](auto offset) {
+        return state(offsetToIndex(offset, cols)) == State::Filtered;
+    });
+    const auto lastRegularIt = std::partition(lastFilteredIt, starts.end(), [&](auto offset) {
+        return state(offsetToIndex(offset, cols)) == State::Regular;
+    });
+
+    offsets[0] = 0;
+    offsets[1] = static_cast<size_t>(std::distance(starts.begin(), lastFilteredIt));
+    offsets[2] = static_cast<size_t>(std::distance(starts.begin(), lastRegularIt));
+    offsets[3] = starts.size();
+
+    for (size_t pos = 0; pos < starts.size(); ++pos) {
+        positions_[offsetToIndex(starts[pos], cols)] = pos;
+    }
+}
+
+void PCPLineStrips::setState(size_t row, State state) {
+    if (row >= positions_.size()) return;
+
+    auto pos = positions_[row];
+    auto group = static_cast<size_t>(getState(row));
+    const auto target = static_cast<size_t>(state);
+
+    // Move the line one group at a time, swapping it with the line at the boundary it crosses
+    // and moving that boundary past it.
+    while (group < target) {
+        const auto last = offsets[group + 1] - 1;
+        swapLines(pos, last);
+        pos = last;
+        --offsets[group + 1];
+        ++group;
+    }
+    while (group > target) {
+        const auto first = offsets[group];
+        swapLines(pos, first);
+        pos = first;
+        ++offsets[group];
+        --group;
+    }
+}
+
+PCPLineStrips::State PCPLineStrips::getState(size_t row) const {
+    const auto pos = positions_[row];
+    if (pos < offsets[1]) return State::Filtered;
+    if (pos < offsets[2]) return State::Regular;
+    return State::Selected;
+}
+
+void PCPLineStrips::swapLines(size_t a, size_t b) {
+    if (a == b) return;
+    const auto cols = enabledAxes_.size();
+    std::swap(starts[a], starts[b]);
+    positions_[offsetToIndex(starts[a], cols)] = a;
+    positions_[offsetToIndex(starts[b], cols)] = b;
+}
+
+}  // namespace plot
+
+}  // namespace inviwo
@@ -76,9 +76,7 @@ PersistenceDiagramPlotProcessor::PersistenceDiagramPlotProcessor()
             }
         });
     selectionChangedCallBack_ = persistenceDiagramPlot_.addSelectionChangedCallback(
-        [this](const std::unordered_set<size_t> &indices) {
-            brushingPort_.sendSelectionEvent(indices);
-        });
+        [this](const IndexSnapshot &indices) { brushingPort_.sendSelectionEvent(indices); });
 
     addProperty(persistenceDiagramPlot_.properties_);
     addProperty(xAxis_);
@@ -103,7 +101,7 @@ PersistenceDiagramPlotProcessor::PersistenceDiagramPlotProcessor()
 void PersistenceDiagramPlotProcessor::process() {
     if (brushingPort_.isConnected()) {
         if (brushingPort_.isChanged()) {
-            persistenceDiagramPlot_.setSelectedIndices(brushingPort_.getSelectedIndices());
+            persistenceDiagramPlot_.setSelectedIndices(brushingPort_.getSelectionSnapshot());
         }
 
         auto dataframe = dataFrame_.getData();
@@ -112,7 +110,7 @@ void PersistenceDiagramPlotProcessor::process() {
         auto iCol = dataframe->getIndexColumn();
         auto &indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
 
-        auto filteredIndicies = brushingPort_.getFilteredIndices();
+        const auto &filteredIndicies = brushingPort_.getFilteredIndices();
         IndexBuffer indicies;
         auto &vec = indicies.getEditableRAMRepresentation()->getDataContainer();
         vec.reserve(dfSize - filteredIndicies.size());
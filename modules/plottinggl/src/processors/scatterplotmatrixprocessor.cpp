@@ -213,22 +213,25 @@ void ScatterPlotMatrixProcessor::process() {
         createStatsLabels();
     }
 
-    std::unique_ptr<IndexBuffer> indicies = nullptr;
-    if (brushing_.isConnected()) {
+    // the scatter plots only rebin their density grids when given a new index buffer
+    if (!brushing_.isConnected()) {
+        indices_.reset();
+    } else if (!indices_ || brushing_.isChanged() || dataFrame_.isChanged()) {
         auto dataframe = dataFrame_.getData();
         auto dfSize = dataframe->getNumberOfRows();
 
         auto iCol = dataframe->getIndexColumn();
         auto &indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
 
-        auto brushedIndicies = brushing_.getFilteredIndices();
-        indicies = std::make_unique<IndexBuffer>();
+        const auto &brushedIndicies = brushing_.getFilteredIndices();
+        auto indicies = std::make_unique<IndexBuffer>();
         auto &vec = indicies->getEditableRAMRepresentation()->getDataContainer();
         vec.reserve(dfSize - brushedIndicies.size());
 
         auto seq = util::sequence<uint32_t>(0, static_cast<uint32_t>(dfSize), 1);
         std::copy_if(seq.begin(), seq.end(), std::back_inserter(vec),
                      [&](const auto &id) { return !brushing_.isFiltered(indexCol[id]); });
+        indices_ = std::move(indicies);
     }
 
     utilgl::activateAndClearTarget(outport_);
@@ -243,7 +246,7 @@ void ScatterPlotMatrixProcessor::process() {
         pos.x = size.x * i;
         for (size_t j = i + 1; j < numParams_; j++) {
             pos.y = size.y * j;
-            plots_[idx]->plot(pos, size, indicies.get());
+            plots_[idx]->plot(pos, size, indices_.get());
 
             vec2 statstextPos = vec2(size) * vec2((j + 0.5f), i + 0.5f);
             statstextPos -= vec2(statsTextures_[i]->getDimensions()) / 2.f;
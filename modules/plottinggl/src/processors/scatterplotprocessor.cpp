@@ -78,13 +78,13 @@ ScatterPlotProcessor::ScatterPlotProcessor()
     selectionChangedCallBack_ =
         scatterPlot_.addSelectionChangedCallback([this](const std::vector<bool>& selected) {
             if (brushingPort_.isConnected()) {
-                std::unordered_set<size_t> selectedIndices;
+                BitSet selectedIndices;
                 auto iCol = dataFramePort_.getData()->getIndexColumn();
                 auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
                 for (size_t i = 0; i < selected.size(); ++i) {
                     if (selected[i]) selectedIndices.insert(indexCol[i]);
                 }
-                brushingPort_.sendSelectionEvent(selectedIndices);
+                brushingPort_.sendSelectionEvent(std::move(selectedIndices));
             } else {
                 invalidate(InvalidationLevel::InvalidOutput);
             }
@@ -92,13 +92,13 @@ ScatterPlotProcessor::ScatterPlotProcessor()
     filteringChangedCallBack_ =
         scatterPlot_.addFilteringChangedCallback([this](const std::vector<bool>& filtered) {
             if (brushingPort_.isConnected()) {
-                std::unordered_set<size_t> filteredIndices;
+                BitSet filteredIndices;
                 auto iCol = dataFramePort_.getData()->getIndexColumn();
                 auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
                 for (size_t i = 0; i < filtered.size(); ++i) {
                     if (filtered[i]) filteredIndices.insert(indexCol[i]);
                 }
-                brushingPort_.sendFilterEvent(filteredIndices);
+                brushingPort_.sendFilterEvent(std::move(filteredIndices));
             } else {
                 invalidate(InvalidationLevel::InvalidOutput);
             }
@@ -139,31 +139,36 @@ void ScatterPlotProcessor::process() {
 
     if (brushingPort_.isConnected()) {
         if (brushingPort_.isChanged()) {
-            scatterPlot_.setSelectedIndices(brushingPort_.getSelectedIndices());
+            scatterPlot_.setSelectedIndices(brushingPort_.getSelectionSnapshot());
         }
 
-        auto dfSize = dataframe->getNumberOfRows();
+        // the scatter plot only rebins its density grid when given a new index buffer
+        if (!indices_ || brushingPort_.isChanged() || dataFramePort_.isChanged()) {
+            auto dfSize = dataframe->getNumberOfRows();
 
-        auto iCol = dataframe->getIndexColumn();
-        auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+            auto iCol = dataframe->getIndexColumn();
+            auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
 
-        auto brushedIndicies = brushingPort_.getFilteredIndices();
-        IndexBuffer indicies;
-        auto& vec = indicies.getEditableRAMRepresentation()->getDataContainer();
-        vec.reserve(dfSize - brushedIndicies.size());
+            const auto& brushedIndicies = brushingPort_.getFilteredIndices();
+            auto indicies = std::make_unique<IndexBuffer>();
+            auto& vec = indicies->getEditableRAMRepresentation()->getDataContainer();
+            vec.reserve(dfSize - brushedIndicies.size());
 
-        auto seq = util::sequence<uint32_t>(0, static_cast<uint32_t>(dfSize), 1);
-        std::copy_if(seq.begin(), seq.end(), std::back_inserter(vec),
-                     [&](const auto& id) { return !brushingPort_.isFiltered(indexCol[id]); });
+            auto seq = util::sequence<uint32_t>(0, static_cast<uint32_t>(dfSize), 1);
+            std::copy_if(seq.begin(), seq.end(), std::back_inserter(vec),
+                         [&](const auto& id) { return !brushingPort_.isFiltered(indexCol[id]); });
+            indices_ = std::move(indicies);
+        }
 
         if (backgroundPort_.hasData()) {
-            scatterPlot_.plot(*outport_.getEditableData(), *backgroundPort_.getData(), &indicies,
-                              true);
+            scatterPlot_.plot(*outport_.getEditableData(), *backgroundPort_.getData(),
+                              indices_.get(), true);
         } else {
-            scatterPlot_.plot(*outport_.getEditableData(), &indicies, true);
+            scatterPlot_.plot(*outport_.getEditableData(), indices_.get(), true);
         }
 
     } else {
+        indices_.reset();
         if (backgroundPort_.hasData()) {
             scatterPlot_.plot(*outport_.getEditableData(), *backgroundPort_.getData(), nullptr,
                               true);
@@ -0,0 +1,195 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/dataframe/datastructures/column.h>
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/processors/syntheticdataframe.h>
+#include <modules/plottinggl/processors/parallelcoordinates/pcpaxissettings.h>
+#include <modules/plottinggl/processors/parallelcoordinates/pcplinestrips.h>
+
+#include <benchmark/benchmark.h>
+
+#include <numeric>
+#include <random>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+using namespace inviwo::plot;
+
+namespace {
+
+/**
+ * A DataFrame with 11 random float columns from the SyntheticDataFrame processor
+ */
+std::shared_ptr<const DataFrame> makeDataFrame(size_t rows) {
+    SyntheticDataFrame synthetic;
+    auto numRow = dynamic_cast<IntSizeTProperty*>(synthetic.getPropertyByIdentifier("numRow"));
+    numRow->setMaxValue(rows);
+    numRow->set(rows);
+    synthetic.process();
+    auto outport = dynamic_cast<DataOutport<DataFrame>*>(synthetic.getOutports().front());
+    return outport->getData();
+}
+
+std::vector<size_t> allAxes(const DataFrame& df) {
+    std::vector<size_t> axes(df.getNumberOfColumns());
+    std::iota(axes.begin(), axes.end(), size_t{0});
+    return axes;
+}
+
+/**
+ * Filter rows by the first data column and select them by the second
+ */
+std::vector<PCPLineStrips::State> makeStates(const DataFrame& df, float filter, float select) {
+    const auto data = [&](size_t col) -> const std::vector<float>& {
+        auto column = std::dynamic_pointer_cast<const TemplateColumn<float>>(df.getColumn(col));
+        return column->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
+    };
+    const auto& x = data(1);
+    const auto& y = data(2);
+    std::vector<PCPLineStrips::State> states(x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        states[i] = x[i] < filter    ? PCPLineStrips::State::Filtered
+                    : y[i] < select ? PCPLineStrips::State::Selected
+                                    : PCPLineStrips::State::Regular;
+    }
+    return states;
+}
+
+void setCounters(benchmark::State& state, size_t rows) {
+    state.counters["Rows"] = static_cast<double>(rows);
+    state.counters["Rate"] = benchmark::Counter(
+        static_cast<double>(rows) * static_cast<double>(state.iterations()),
+        benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+/**
+ * Build the indices and offsets of all lines from scratch, as when axes are added or removed
+ */
+static void PCPBuild(benchmark::State& state) {
+    const auto df = makeDataFrame(static_cast<size_t>(state.range(0)));
+    const auto axes = allAxes(*df);
+    PCPLineStrips strips;
+    for (auto _ : state) {
+        strips.build(df->getNumberOfRows(), df->getNumberOfColumns(), axes);
+        benchmark::DoNotOptimize(strips.starts.data());
+    }
+    setCounters(state, df->getNumberOfRows());
+}
+
+/**
+ * Swap two neighbouring axes, as when dragging an axis past another one
+ */
+static void PCPReorder(benchmark::State& state) {
+    const auto df = makeDataFrame(static_cast<size_t>(state.range(0)));
+    auto axes = allAxes(*df);
+    PCPLineStrips strips;
+    strips.build(df->getNumberOfRows(), df->getNumberOfColumns(), axes);
+    for (auto _ : state) {
+        std::swap(axes[3], axes[4]);
+        strips.reorder(axes);
+        benchmark::DoNotOptimize(strips.indices.getRAMRepresentation()->getDataContainer().data());
+    }
+    setCounters(state, df->getNumberOfRows());
+}
+
+/**
+ * Partition all lines into filtered, regular, and selected lines
+ */
+static void PCPPartition(benchmark::State& state) {
+    const auto df = makeDataFrame(static_cast<size_t>(state.range(0)));
+    const auto states = makeStates(*df, -0.05f, 0.1f);
+    PCPLineStrips strips;
+    strips.build(df->getNumberOfRows(), df->getNumberOfColumns(), allAxes(*df));
+    for (auto _ : state) {
+        strips.partition([&](size_t row) { return states[row]; });
+        benchmark::DoNotOptimize(strips.offsets.data());
+    }
+    setCounters(state, df->getNumberOfRows());
+}
+
+/**
+ * Move 1% of the rows between the filtered and regular lines, as when a brush changes slightly
+ */
+static void PCPUpdate(benchmark::State& state) {
+    const auto df = makeDataFrame(static_cast<size_t>(state.range(0)));
+    const auto rows = df->getNumberOfRows();
+    const auto states = makeStates(*df, -0.05f, 0.1f);
+    PCPLineStrips strips;
+    strips.build(rows, df->getNumberOfColumns(), allAxes(*df));
+    strips.partition([&](size_t row) { return states[row]; });
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<size_t> dist(0, rows - 1);
+    std::vector<size_t> changed(rows / 100);
+    std::generate(changed.begin(), changed.end(), [&]() { return dist(gen); });
+
+    bool filter = true;
+    for (auto _ : state) {
+        for (auto row : changed) {
+            strips.setState(row, filter ? PCPLineStrips::State::Filtered : states[row]);
+        }
+        filter = !filter;
+        benchmark::DoNotOptimize(strips.offsets.data());
+    }
+    setCounters(state, changed.size());
+}
+
+/**
+ * Drag the lower handle of an axis by 1% of its range
+ */
+static void PCPBrushAxis(benchmark::State& state) {
+    const auto df = makeDataFrame(static_cast<size_t>(state.range(0)));
+    PCPAxisSettings axis("axis", "Axis");
+    axis.updateFromColumn(df->getColumn(1));
+    const auto range = axis.range.get();
+    const auto step = 0.01 * (range.y - range.x);
+
+    bool down = true;
+    for (auto _ : state) {
+        axis.range.set({range.x + (down ? step : 0.0), range.y});
+        down = !down;
+        benchmark::DoNotOptimize(axis.getBrushed().size());
+    }
+    setCounters(state, df->getNumberOfRows());
+}
+
+BENCHMARK(PCPBuild)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(PCPReorder)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(PCPPartition)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(PCPUpdate)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(PCPBrushAxis)->RangeMultiplier(10)->Range(10000, 1000000)->Unit(benchmark::kMillisecond);
+
+#include <warn/pop>
@@ -0,0 +1,118 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/plottinggl/processors/parallelcoordinates/pcpaxissettings.h>
+#include <inviwo/dataframe/datastructures/column.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+// Brushing of all rows from scratch, rows outside of the range are brushed unless missing (NaN)
+std::vector<bool> brushed(const std::vector<float>& values, dvec2 range) {
+    const double eps = std::numeric_limits<float>::epsilon();
+    std::vector<bool> result(values.size(), false);
+    for (size_t i = 0; i < values.size(); ++i) {
+        const auto v = static_cast<double>(values[i]);
+        result[i] = !std::isnan(v) && (v < range.x - eps || v > range.y + eps);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(PCPAxisSettings, IncrementalBrushingMatchesRebuild) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+    std::vector<float> values(500);
+    for (auto& v : values) v = dist(gen);
+    values[5] = std::numeric_limits<float>::quiet_NaN();
+    values[11] = values[10];
+    values[12] = values[10];
+    auto column = std::make_shared<TemplateColumn<float>>("x", values);
+
+    plot::PCPAxisSettings axis("axis", "Axis");
+    axis.updateFromColumn(column);
+    EXPECT_EQ(brushed(values, axis.range.get()), axis.getBrushed());
+
+    for (int step = 0; step < 200; ++step) {
+        // Move one or both handles, to random positions, onto data values, or to the ends
+        auto range = axis.range.get();
+        const auto position = [&]() -> double {
+            switch (gen() % 4) {
+                case 0:
+                    return values[gen() % values.size()];
+                case 1:
+                    return gen() % 2 == 0 ? axis.range.getRangeMin() : axis.range.getRangeMax();
+                default:
+                    return dist(gen);
+            }
+        };
+        switch (gen() % 3) {
+            case 0:
+                range.x = position();
+                break;
+            case 1:
+                range.y = position();
+                break;
+            default:
+                range = dvec2{position(), position()};
+                break;
+        }
+        if (std::isnan(range.x)) range.x = axis.range.getRangeMin();
+        if (std::isnan(range.y)) range.y = axis.range.getRangeMax();
+        if (range.x > range.y) std::swap(range.x, range.y);
+        axis.range.set(range);
+
+        const auto expected = brushed(values, axis.range.get());
+        EXPECT_EQ(expected, axis.getBrushed()) << "step " << step;
+        EXPECT_EQ(std::find(expected.begin(), expected.end(), true) != expected.end(),
+                  axis.isFiltering())
+            << "step " << step;
+    }
+
+    // A new column brushes all rows again
+    std::shuffle(values.begin(), values.end(), gen);
+    values.resize(300);
+    column = std::make_shared<TemplateColumn<float>>("x", values);
+    axis.updateFromColumn(column);
+    EXPECT_EQ(brushed(values, axis.range.get()), axis.getBrushed());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,150 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/plottinggl/processors/parallelcoordinates/pcplinestrips.h>
+
+#include <algorithm>
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+using State = plot::PCPLineStrips::State;
+
+// The rows of the lines in [begin, end) of starts, sorted
+std::vector<size_t> rowsInGroup(const plot::PCPLineStrips& strips, size_t begin, size_t end) {
+    const auto cols = strips.getEnabledAxes().size();
+    std::vector<size_t> rows;
+    for (size_t i = begin; i < end; ++i) {
+        rows.push_back(plot::PCPLineStrips::offsetToIndex(strips.starts[i], cols));
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+// Compare incrementally updated strips against strips built from scratch with the same state
+void expectSameAsRebuild(const plot::PCPLineStrips& strips, size_t axes,
+                         const std::vector<State>& states) {
+    plot::PCPLineStrips rebuilt;
+    rebuilt.build(states.size(), axes, strips.getEnabledAxes());
+    rebuilt.partition([&](size_t row) { return states[row]; });
+
+    EXPECT_EQ(rebuilt.indices.getRAMRepresentation()->getDataContainer(),
+              strips.indices.getRAMRepresentation()->getDataContainer());
+    EXPECT_EQ(rebuilt.sizes, strips.sizes);
+    EXPECT_EQ(rebuilt.offsets, strips.offsets);
+    for (size_t group = 0; group < 3; ++group) {
+        EXPECT_EQ(rowsInGroup(rebuilt, rebuilt.offsets[group], rebuilt.offsets[group + 1]),
+                  rowsInGroup(strips, strips.offsets[group], strips.offsets[group + 1]))
+            << "group " << group;
+    }
+    for (size_t row = 0; row < states.size(); ++row) {
+        EXPECT_EQ(states[row], strips.getState(row)) << "row " << row;
+    }
+}
+
+}  // namespace
+
+TEST(PCPLineStrips, IncrementalUpdatesMatchRebuild) {
+    constexpr size_t rows = 97;
+    constexpr size_t axes = 7;
+    std::vector<size_t> enabled{0, 2, 3, 5, 6};
+    std::vector<State> states(rows, State::Regular);
+
+    plot::PCPLineStrips strips;
+    strips.build(rows, axes, enabled);
+    expectSameAsRebuild(strips, axes, states);
+
+    std::mt19937 gen(17);
+    const auto randomState = [&]() { return static_cast<State>(gen() % 3); };
+    for (int step = 0; step < 300; ++step) {
+        switch (gen() % 5) {
+            case 0: {  // move an axis
+                std::shuffle(enabled.begin(), enabled.end(), gen);
+                ASSERT_TRUE(strips.reorder(enabled));
+                break;
+            }
+            case 1: {  // toggle an axis, rebuilt like in ParallelCoordinates::process
+                const size_t axis = gen() % axes;
+                auto it = std::find(enabled.begin(), enabled.end(), axis);
+                if (it != enabled.end() && enabled.size() > 2) {
+                    enabled.erase(it);
+                } else if (it == enabled.end()) {
+                    enabled.insert(enabled.begin() + gen() % (enabled.size() + 1), axis);
+                }
+                if (!strips.reorder(enabled)) {
+                    strips.build(rows, axes, enabled);
+                    strips.partition([&](size_t row) { return states[row]; });
+                }
+                break;
+            }
+            case 2: {  // brush everything, e.g. a new selection
+                for (auto& state : states) state = randomState();
+                strips.partition([&](size_t row) { return states[row]; });
+                break;
+            }
+            default: {  // brush a few rows
+                for (int i = 0; i < 5; ++i) {
+                    const auto row = gen() % rows;
+                    states[row] = randomState();
+                    strips.setState(row, states[row]);
+                }
+                break;
+            }
+        }
+        expectSameAsRebuild(strips, axes, states);
+        if (HasFailure()) {
+            FAIL() << "step " << step;
+        }
+    }
+}
+
+TEST(PCPLineStrips, ToggledAxesRequireRebuild) {
+    plot::PCPLineStrips strips;
+    strips.build(10, 4, {0, 1, 2, 3});
+    strips.setState(3, State::Selected);
+
+    EXPECT_FALSE(strips.reorder({0, 1, 3}));
+    EXPECT_FALSE(strips.reorder({0, 1, 2, 2}));
+    EXPECT_EQ(std::vector<size_t>({0, 1, 2, 3}), strips.getEnabledAxes());
+    EXPECT_EQ(State::Selected, strips.getState(3));
+
+    // Toggling an axis changes the length of every line and is done with a rebuild
+    strips.build(10, 4, {0, 1, 3});
+    std::vector<State> states(10, State::Regular);
+    expectSameAsRebuild(strips, 4, states);
+}
+
+}  // namespace inviwo
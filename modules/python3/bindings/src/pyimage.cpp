@@ -59,6 +59,53 @@ namespace py = pybind11;
 
 namespace inviwo {
 
+namespace {
+
+/**
+ * A view of the RAM data of the layer that keeps the layer alive. The read only view uses the
+ * const representation and leaves the other representations valid, the editable one invalidates
+ * them. Neither copies the data, and both are only valid until the data of the layer is
+ * replaced, Layer.shareData returns a copy-on-write array that stays valid.
+ */
+py::array layerData(py::object self, bool editable) {
+    auto layer = self.cast<Layer*>();
+    auto df = layer->getDataFormat();
+    auto dims = layer->getDimensions();
+
+    std::vector<size_t> shape = {dims.x, dims.y};
+    std::vector<size_t> strides = {df->getSize(), df->getSize() * dims.x};
+
+    if (df->getComponents() > 1) {
+        shape.push_back(df->getComponents());
+        strides.push_back(df->getSize() / df->getComponents());
+    }
+
+    if (editable) {
+        auto data = layer->getEditableRepresentation<LayerRAM>()->getData();
+        return py::array(pyutil::toNumPyFormat(df), shape, strides, data, self);
+    }
+    auto data = layer->getRepresentation<LayerRAM>()->getData();
+    py::array arr(pyutil::toNumPyFormat(df), shape, strides, data, self);
+    arr.attr("flags").attr("writeable") = false;
+    return arr;
+}
+
+/**
+ * Layer.data returns an editable view, as it always has, until scripts have moved over to
+ * Layer.editableData and Layer.readOnlyData. It will then return the read only view.
+ */
+py::array deprecatedLayerData(py::object self) {
+    if (PyErr_WarnEx(PyExc_DeprecationWarning,
+                     "Layer.data will become read only, use Layer.editableData to modify the "
+                     "data in place or Layer.readOnlyData to read it",
+                     1) != 0) {
+        throw py::error_already_set();
+    }
+    return layerData(self, true);
+}
+
+}  // namespace
+
 auto getLayers = [](Image* img) {
     pybind11::list list;
     for (size_t idx = 0; idx < img->getNumberOfColorLayers(); idx++) {
@@ -130,7 +177,16 @@ void exposeImage(py::module& m) {
         .def(py::init<size2_t, const DataFormatBase*, LayerType, const SwizzleMask&,
                       InterpolationType, const Wrapping2D&>())
         .def("clone", [](Layer& self) { return self.clone(); })
-        .def(py::init([](py::array data) { return pyutil::createLayer(data).release(); }))
+        .def(py::init([](py::array data, bool copy) {
+                 return pyutil::createLayer(data, copy).release();
+             }),
+             py::arg("data"), py::arg("copy") = true,
+             "Create a layer from a NumPy array. A read only array, i.e. one with\n"
+             "arr.flags.writeable = False, that is contiguous and aligned is used without\n"
+             "copying it. A writable array is copied, unless copy is False. Then the layer\n"
+             "uses the memory of the array directly, and changes made through the array later\n"
+             "are seen by the layer data but not by representations already created from it,\n"
+             "like textures. The layer never writes to the memory of the array.")
         .def_property_readonly("dimensions", &Layer::getDimensions)
         .def_property("swizzlemask", &Layer::getSwizzleMask, &Layer::setSwizzleMask)
         .def_property("interpolation", &Layer::getInterpolation, &Layer::setInterpolation)
@@ -149,28 +205,23 @@ void exposeImage(py::module& m) {
                  writer->writeData(&self, filepath);
              })
         .def_property(
-            "data",
-            [&](Layer* layer) -> py::array {
-                auto df = layer->getDataFormat();
-                auto dims = layer->getDimensions();
-
-                std::vector<size_t> shape = {dims.x, dims.y};
-                std::vector<size_t> strides = {df->getSize(), df->getSize() * dims.x};
-
-                if (df->getComponents() > 1) {
-                    shape.push_back(df->getComponents());
-                    strides.push_back(df->getSize() / df->getComponents());
-                }
-
-                auto data = layer->getEditableRepresentation<LayerRAM>()->getData();
-                return py::array(pyutil::toNumPyFormat(df), shape, strides, data, py::cast<>(1));
-            },
-            [](Layer* layer, py::array data) {
-                auto rep = layer->getEditableRepresentation<LayerRAM>();
-                pyutil::checkDataFormat<2>(rep->getDataFormat(), rep->getDimensions(), data);
-
-                memcpy(rep->getData(), data.data(0), data.nbytes());
-            })
+            "data", [](py::object self) { return deprecatedLayerData(self); },
+            [](Layer& layer, py::array data) { pyutil::adoptData(layer, data); },
+            "Deprecated, an editable view of the data. Use editableData or readOnlyData.\n"
+            "Assigning an array uses it as in adoptData.")
+        .def_property_readonly(
+            "readOnlyData", [](py::object self) { return layerData(self, false); },
+            "A read only view of the data, other representations stay valid")
+        .def_property_readonly(
+            "editableData", [](py::object self) { return layerData(self, true); },
+            "An editable view of the data, other representations are invalidated")
+        .def("adoptData",
+             [](Layer& layer, py::array data, bool copy) { pyutil::adoptData(layer, data, copy); },
+             py::arg("data"), py::arg("copy") = true,
+             "Replace the data with the array, the array is used as in Layer(data, copy).\n"
+             "Set arr.flags.writeable = False to share the memory without copying it, or\n"
+             "pass copy=False to alias a writable array.")
+        .def("shareData", [](Layer& self) { return pyutil::shareData(self); })
         .def("__repr__", [](const Layer& self) {
             return fmt::format(
                 "<Layer:\n  type = {}\n  format = {}\n  dimensions = {}\n  swizzlemask = {}>",
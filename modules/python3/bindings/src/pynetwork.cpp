@@ -35,17 +35,74 @@
 #include <inviwo/core/network/portconnection.h>
 #include <inviwo/core/links/propertylink.h>
 #include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/network/processorstatistics.h>
 #include <inviwo/core/ports/port.h>
 #include <inviwo/core/ports/inport.h>
 #include <inviwo/core/common/inviwoapplication.h>
 
 #include <inviwopy/vectoridentifierwrapper.h>
 
+#include <sstream>
+
 namespace py = pybind11;
 
 namespace inviwo {
 
 void exposeNetwork(py::module &m) {
+    using Stats = ProcessorStatistics;
+    const auto ms = [](Stats::duration time) {
+        return std::chrono::duration<double, std::milli>(time).count();
+    };
+
+    // All times are in milliseconds
+    py::class_<Stats::Entry>(m, "ProcessorStatisticsEntry")
+        .def_readonly("identifier", &Stats::Entry::identifier)
+        .def_readonly("classIdentifier", &Stats::Entry::classIdentifier)
+        .def_readonly("processCount", &Stats::Entry::processCount)
+        .def_property_readonly("processTime",
+                               [ms](const Stats::Entry &e) { return ms(e.processTime); })
+        .def_property_readonly("meanProcessTime",
+                               [ms](const Stats::Entry &e) { return ms(e.meanProcessTime()); })
+        .def_property_readonly("minProcessTime",
+                               [ms](const Stats::Entry &e) {
+                                   return e.processCount > 0 ? ms(e.minProcessTime) : 0.0;
+                               })
+        .def_property_readonly("maxProcessTime",
+                               [ms](const Stats::Entry &e) { return ms(e.maxProcessTime); })
+        .def("processTimeQuantile",
+             [ms](const Stats::Entry &e, double q) { return ms(e.processTimeQuantile(q)); },
+             py::arg("q"))
+        .def_readonly("histogram", &Stats::Entry::histogram)
+        .def_readonly("invalidationCount", &Stats::Entry::invalidationCount)
+        .def_readonly("conversionCount", &Stats::Entry::conversionCount)
+        .def_property_readonly("conversionTime",
+                               [ms](const Stats::Entry &e) { return ms(e.conversionTime); })
+        .def_readonly("bytesAllocated", &Stats::Entry::bytesAllocated)
+        .def("__repr__", [ms](const Stats::Entry &e) {
+            std::ostringstream oss;
+            oss << "<ProcessorStatisticsEntry: '" << e.identifier << "' " << e.processCount
+                << " process calls, " << ms(e.processTime) << " ms>";
+            return oss.str();
+        });
+
+    py::class_<Stats>(m, "ProcessorStatistics")
+        .def_property("enabled", &Stats::isEnabled, &Stats::setEnabled)
+        .def("reset", &Stats::reset)
+        .def_property_readonly("entries", &Stats::getEntries)
+        .def("getEntry", &Stats::getEntry, py::arg("identifier"))
+        .def("toJson",
+             [](const Stats &stats) {
+                 std::ostringstream oss;
+                 stats.writeJson(oss);
+                 return oss.str();
+             })
+        .def("toCsv", [](const Stats &stats) {
+            std::ostringstream oss;
+            stats.writeCsv(oss);
+            return oss.str();
+        });
+
     py::class_<PortConnection>(m, "PortConnection")
         .def(py::init<Outport *, Inport *>())
         .def_property_readonly("inport", &PortConnection::getInport,
@@ -132,6 +189,12 @@ void exposeNetwork(py::module &m) {
         .def("unlock", &ProcessorNetwork::unlock)
         .def_property_readonly("locked", &ProcessorNetwork::islocked)
         .def_property_readonly("deserializing", &ProcessorNetwork::isDeserializing)
+        .def_property_readonly(
+            "statistics",
+            [](ProcessorNetwork *pn) -> ProcessorStatistics & {
+                return pn->getApplication()->getProcessorNetworkEvaluator()->getStatistics();
+            },
+            py::return_value_policy::reference)
 
         .def("clear",
              [&](ProcessorNetwork *pn) { pn->getApplication()->getWorkspaceManager()->clear(); })
@@ -53,13 +53,70 @@ PYBIND11_MAKE_OPAQUE(VolumeSequence)
 
 namespace inviwo {
 
+namespace {
+
+/**
+ * A view of the RAM data of the volume that keeps the volume alive. The read only view uses the
+ * const representation and leaves the other representations valid, the editable one invalidates
+ * them. Neither copies the data, and both are only valid until the data of the volume is
+ * replaced, Volume.shareData returns a copy-on-write array that stays valid.
+ */
+pybind11::array volumeData(pybind11::object self, bool editable) {
+    auto volume = self.cast<Volume *>();
+    auto df = volume->getDataFormat();
+    auto dims = volume->getDimensions();
+
+    std::vector<size_t> shape = {dims.x, dims.y, dims.z};
+    std::vector<size_t> strides = {df->getSize(), df->getSize() * dims.x,
+                                   df->getSize() * dims.x * dims.y};
+
+    if (df->getComponents() > 1) {
+        shape.push_back(df->getComponents());
+        strides.push_back(df->getSize() / df->getComponents());
+    }
+
+    if (editable) {
+        auto data = volume->getEditableRepresentation<VolumeRAM>()->getData();
+        return pybind11::array(pyutil::toNumPyFormat(df), shape, strides, data, self);
+    }
+    auto data = volume->getRepresentation<VolumeRAM>()->getData();
+    pybind11::array arr(pyutil::toNumPyFormat(df), shape, strides, data, self);
+    arr.attr("flags").attr("writeable") = false;
+    return arr;
+}
+
+/**
+ * Volume.data returns an editable view, as it always has, until scripts have moved over to
+ * Volume.editableData and Volume.readOnlyData. It will then return the read only view.
+ */
+pybind11::array deprecatedVolumeData(pybind11::object self) {
+    if (PyErr_WarnEx(PyExc_DeprecationWarning,
+                     "Volume.data will become read only, use Volume.editableData to modify the "
+                     "data in place or Volume.readOnlyData to read it",
+                     1) != 0) {
+        throw pybind11::error_already_set();
+    }
+    return volumeData(self, true);
+}
+
+}  // namespace
+
 void exposeVolume(pybind11::module &m) {
     namespace py = pybind11;
     py::class_<Volume, std::shared_ptr<Volume>>(m, "Volume")
         .def(py::init<size3_t, const DataFormatBase *>())
         .def(py::init<size3_t, const DataFormatBase *, const SwizzleMask &, InterpolationType,
                       const Wrapping3D &>())
-        .def(py::init([](py::array data) { return pyutil::createVolume(data).release(); }))
+        .def(py::init([](py::array data, bool copy) {
+                 return pyutil::createVolume(data, copy).release();
+             }),
+             py::arg("data"), py::arg("copy") = true,
+             "Create a volume from a NumPy array. A read only array, i.e. one with\n"
+             "arr.flags.writeable = False, that is contiguous and aligned is used without\n"
+             "copying it. A writable array is copied, unless copy is False. Then the volume\n"
+             "uses the memory of the array directly, and changes made through the array later\n"
+             "are seen by the volume data but not by representations already created from it,\n"
+             "like textures. The volume never writes to the memory of the array.")
         .def("clone", [](Volume &self) { return self.clone(); })
         .def_property("modelMatrix", &Volume::getModelMatrix, &Volume::setModelMatrix)
         .def_property("worldMatrix", &Volume::getWorldMatrix, &Volume::setWorldMatrix)
@@ -73,29 +130,25 @@ void exposeVolume(pybind11::module &m) {
         .def_property("wrapping", &Volume::getWrapping, &Volume::setWrapping)
         .def_readwrite("dataMap", &Volume::dataMap_)
         .def_property(
-            "data",
-            [&](Volume *volume) -> py::array {
-                auto df = volume->getDataFormat();
-                auto dims = volume->getDimensions();
-
-                std::vector<size_t> shape = {dims.x, dims.y, dims.z};
-                std::vector<size_t> strides = {df->getSize(), df->getSize() * dims.x,
-                                               df->getSize() * dims.x * dims.y};
-
-                if (df->getComponents() > 1) {
-                    shape.push_back(df->getComponents());
-                    strides.push_back(df->getSize() / df->getComponents());
-                }
-
-                auto data = volume->getEditableRepresentation<VolumeRAM>()->getData();
-                return py::array(pyutil::toNumPyFormat(df), shape, strides, data, py::cast<>(1));
-            },
-            [](Volume *volume, py::array data) {
-                auto rep = volume->getEditableRepresentation<VolumeRAM>();
-                pyutil::checkDataFormat<3>(rep->getDataFormat(), rep->getDimensions(), data);
-
-                memcpy(rep->getData(), data.data(0), data.nbytes());
-            })
+            "data", [](py::object self) { return deprecatedVolumeData(self); },
+            [](Volume &volume, py::array data) { pyutil::adoptData(volume, data); },
+            "Deprecated, an editable view of the data. Use editableData or readOnlyData.\n"
+            "Assigning an array uses it as in adoptData.")
+        .def_property_readonly(
+            "readOnlyData", [](py::object self) { return volumeData(self, false); },
+            "A read only view of the data, other representations stay valid")
+        .def_property_readonly(
+            "editableData", [](py::object self) { return volumeData(self, true); },
+            "An editable view of the data, other representations are invalidated")
+        .def("adoptData",
+             [](Volume &volume, py::array data, bool copy) {
+                 pyutil::adoptData(volume, data, copy);
+             },
+             py::arg("data"), py::arg("copy") = true,
+             "Replace the data with the array, the array is used as in Volume(data, copy).\n"
+             "Set arr.flags.writeable = False to share the memory without copying it, or\n"
+             "pass copy=False to alias a writable array.")
+        .def("shareData", [](Volume &self) { return pyutil::shareData(self); })
         .def("__repr__", [](const Volume &volume) {
             std::ostringstream oss;
             oss << "<Volume:\n  dimensions = " << volume.getDimensions()
@@ -1,7 +1,7 @@
 import numpy as np
 import math
 
-data = vol.data
+data = vol.editableData
 size = data.shape 
 
 #x and y are in pixel coordinates
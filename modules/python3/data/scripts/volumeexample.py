@@ -25,7 +25,11 @@ def process(self):
 	# create a small float volume filled with random noise
 	numpy.random.seed(546465)
 	dim = self.properties.dim.value;
-	volume = Volume(numpy.random.rand(dim[0], dim[1], dim[2]).astype(numpy.float32))
+	data = numpy.random.rand(dim[0], dim[1], dim[2]).astype(numpy.float32)
+	# A read only array is used by the volume without copying it, a writable one is copied
+	# unless Volume(data, copy=False) is used to share it
+	data.flags.writeable = False
+	volume = Volume(data)
 	volume.dataMap.dataRange = dvec2(0.0, 1.0)
 	volume.dataMap.valueRange = dvec2(0.0, 1.0)
 	self.outports.outport.setData(volume)
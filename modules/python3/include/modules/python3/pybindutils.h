@@ -57,8 +57,42 @@ namespace pyutil {
 IVW_MODULE_PYTHON3_API pybind11::dtype toNumPyFormat(const DataFormatBase *df);
 IVW_MODULE_PYTHON3_API const DataFormatBase *getDataFormat(size_t components, pybind11::array &arr);
 IVW_MODULE_PYTHON3_API std::unique_ptr<BufferBase> createBuffer(pybind11::array &arr);
-IVW_MODULE_PYTHON3_API std::unique_ptr<Layer> createLayer(pybind11::array &arr);
-IVW_MODULE_PYTHON3_API std::unique_ptr<Volume> createVolume(pybind11::array &arr);
+
+/**
+ * Create a layer or volume from the array. A read only array that is contiguous and aligned is
+ * used without copying it. The data is then shared copy-on-write, the representation copies it
+ * before any modification, and the array is kept alive for as long as the representation uses
+ * it. Writable arrays are copied once, unless copy is false. Then a writable array is aliased:
+ * the representation uses its memory directly and changes made through the array afterwards are
+ * seen by the RAM representation, but not by other representations that were already created.
+ * Contiguous arrays are used in memory order, other arrays are copied into the layout of the
+ * data property, i.e. Fortran order with the components of a vector format next to each other.
+ * The flags of the array are never changed.
+ * @throws pybind11::value_error if copy is false and the array is not contiguous and aligned
+ */
+IVW_MODULE_PYTHON3_API std::unique_ptr<Layer> createLayer(pybind11::array &arr, bool copy = true);
+IVW_MODULE_PYTHON3_API std::unique_ptr<Volume> createVolume(pybind11::array &arr,
+                                                            bool copy = true);
+
+/**
+ * Replace the data of the RAM representation with the memory of the array, shared as in
+ * createLayer and createVolume. The format and dimensions of the array have to match.
+ * @throws pybind11::value_error if the format or dimensions do not match, or if copy is false
+ * and the array is not contiguous and aligned
+ */
+IVW_MODULE_PYTHON3_API void adoptData(Layer &layer, pybind11::array &arr, bool copy = true);
+IVW_MODULE_PYTHON3_API void adoptData(Volume &volume, pybind11::array &arr, bool copy = true);
+
+/**
+ * Returns a read only array that shares the memory of the RAM representation without copying
+ * it. The data is copy-on-write, later modifications of the layer or volume will not be visible
+ * in the array, and the array stays valid even if the layer or volume is destroyed. Handing the
+ * data over to a shared owner modifies the RAM representation, hence the editable representation
+ * is used and other representations are invalidated.
+ * @see VolumeRAMPrecision::shareData
+ */
+IVW_MODULE_PYTHON3_API pybind11::array shareData(Layer &layer);
+IVW_MODULE_PYTHON3_API pybind11::array shareData(Volume &volume);
 
 template <int Dim>
 void checkDataFormat(const DataFormatBase *format, const Vector<Dim, size_t> &dim,
@@ -102,15 +102,108 @@ struct BufferFromArrayDispatcher {
     }
 };
 
+namespace {
+
+/**
+ * Returns a read only array with the data of arr that can be used by an Inviwo representation,
+ * without ever changing the flags of arr. Contiguous arrays are used in memory order. A read only
+ * one that is aligned is shared through a private view. A writable one is copied once since the
+ * caller could still modify it through arr, unless copy is false, then it is shared as well and
+ * the caller is responsible for the aliasing. Other arrays are copied into the layout of the data
+ * property, i.e. Fortran order with the components of a vector format next to each other.
+ * @throws pybind11::value_error if copy is false and arr is not contiguous and aligned
+ */
+pybind11::array shareable(const pybind11::array &arr, size_t components, bool copy) {
+    namespace py = pybind11;
+    auto np = py::module::import("numpy");
+    auto flags = arr.attr("flags");
+    const bool contiguous =
+        flags.attr("c_contiguous").cast<bool>() || flags.attr("f_contiguous").cast<bool>();
+
+    py::array shared;
+    if (!contiguous || !flags.attr("aligned").cast<bool>()) {
+        if (!copy) {
+            throw py::value_error(
+                "The array has to be contiguous and aligned to be used without copying it");
+        }
+        if (components > 1) {
+            // Put the components first to store them next to each other in Fortran order
+            auto copied =
+                np.attr("array")(np.attr("moveaxis")(arr, -1, 0), py::arg("order") = "F");
+            shared = np.attr("moveaxis")(copied, 0, -1);
+        } else {
+            shared = np.attr("array")(arr, py::arg("order") = "F");
+        }
+    } else if (copy && flags.attr("writeable").cast<bool>()) {
+        shared = np.attr("array")(arr, py::arg("order") = "K");
+    } else {
+        shared = arr.attr("view")();
+    }
+    shared.attr("flags").attr("writeable") = false;
+    return shared;
+}
+
+/**
+ * Keep a Python object alive for as long as the returned owner is used. The owner might be
+ * released from any thread, the GIL is acquired to release the object.
+ */
+std::shared_ptr<const void> keepAlive(pybind11::object obj) {
+    return std::shared_ptr<const void>(new pybind11::object(std::move(obj)),
+                                       [](pybind11::object *o) {
+                                           if (Py_IsInitialized()) {
+                                               pybind11::gil_scoped_acquire gil;
+                                               delete o;
+                                           }
+                                       });
+}
+
+template <typename T>
+T *sharedData(const pybind11::array &arr) {
+    // The data is only read, any modification is done on a copy
+    return const_cast<T *>(static_cast<const T *>(arr.data()));
+}
+
+/**
+ * Create a read only array that shares the data of ram, see VolumeRAMPrecision::shareData
+ */
+template <typename Ram>
+pybind11::array shareRAM(Ram &ram, std::vector<size_t> shape) {
+    const auto df = ram.getDataFormat();
+    std::vector<size_t> strides;
+    for (size_t i = 0, stride = df->getSize(); i < shape.size(); stride *= shape[i++]) {
+        strides.push_back(stride);
+    }
+    if (df->getComponents() > 1) {
+        shape.push_back(df->getComponents());
+        strides.push_back(df->getSize() / df->getComponents());
+    }
+
+    return ram.template dispatch<pybind11::array>([&](auto typed) {
+        using Owner = decltype(typed->shareData());
+        auto owner = std::make_unique<Owner>(typed->shareData());
+        auto data = owner->get();
+        pybind11::capsule base(owner.release(),
+                               [](void *o) { delete static_cast<Owner *>(o); });
+        pybind11::array arr(toNumPyFormat(df), shape, strides, data, base);
+        arr.attr("flags").attr("writeable") = false;
+        return arr;
+    });
+}
+
+}  // namespace
+
 struct LayerFromArrayDispatcher {
     using type = std::unique_ptr<Layer>;
 
     template <typename Result, typename T>
-    std::unique_ptr<Layer> operator()(pybind11::array &arr) {
+    std::unique_ptr<Layer> operator()(pybind11::array &arr, bool copy) {
         using Type = typename T::type;
         size2_t dims(arr.shape(0), arr.shape(1));
-        auto layerRAM = std::make_shared<LayerRAMPrecision<Type>>(dims);
-        memcpy(layerRAM->getData(), arr.data(0), arr.nbytes());
+        auto shared = shareable(arr, DataFormat<Type>::components(), copy);
+        auto layerRAM = std::make_shared<LayerRAMPrecision<Type>>(sharedData<Type>(shared),
+                                                                  keepAlive(shared), dims);
+        // The array still refers to the data, make it copy-on-write
+        layerRAM->shareData();
         return std::make_unique<Layer>(layerRAM);
     }
 };
@@ -119,11 +212,14 @@ struct VolumeFromArrayDispatcher {
     using type = std::unique_ptr<Volume>;
 
     template <typename Result, typename T>
-    std::unique_ptr<Volume> operator()(pybind11::array &arr) {
+    std::unique_ptr<Volume> operator()(pybind11::array &arr, bool copy) {
         using Type = typename T::type;
         size3_t dims(arr.shape(0), arr.shape(1), arr.shape(2));
-        auto volumeRAM = std::make_shared<VolumeRAMPrecision<Type>>(dims);
-        memcpy(volumeRAM->getData(), arr.data(0), arr.nbytes());
+        auto shared = shareable(arr, DataFormat<Type>::components(), copy);
+        auto volumeRAM = std::make_shared<VolumeRAMPrecision<Type>>(sharedData<Type>(shared),
+                                                                    keepAlive(shared), dims);
+        // The array still refers to the data, make it copy-on-write
+        volumeRAM->shareData();
         return std::make_unique<Volume>(volumeRAM);
     }
 };
@@ -137,22 +233,58 @@ std::unique_ptr<BufferBase> createBuffer(pybind11::array &arr) {
         df->getId(), dispatcher, arr);
 }
 
-std::unique_ptr<Layer> createLayer(pybind11::array &arr) {
+std::unique_ptr<Layer> createLayer(pybind11::array &arr, bool copy) {
     auto ndim = arr.ndim();
     ivwAssert(ndim == 2 || ndim == 3, "Ndims must be either 2 or 3");
     auto df = pyutil::getDataFormat(ndim == 2 ? 1 : arr.shape(2), arr);
     LayerFromArrayDispatcher dispatcher;
-    return dispatching::dispatch<std::unique_ptr<Layer>, dispatching::filter::All>(df->getId(),
-                                                                                   dispatcher, arr);
+    return dispatching::dispatch<std::unique_ptr<Layer>, dispatching::filter::All>(
+        df->getId(), dispatcher, arr, copy);
 }
 
-std::unique_ptr<Volume> createVolume(pybind11::array &arr) {
+std::unique_ptr<Volume> createVolume(pybind11::array &arr, bool copy) {
     auto ndim = arr.ndim();
     ivwAssert(ndim == 3 || ndim == 4, "Ndims must be either 3 or 4");
     auto df = pyutil::getDataFormat(ndim == 3 ? 1 : arr.shape(3), arr);
     VolumeFromArrayDispatcher dispatcher;
     return dispatching::dispatch<std::unique_ptr<Volume>, dispatching::filter::All>(
-        df->getId(), dispatcher, arr);
+        df->getId(), dispatcher, arr, copy);
+}
+
+void adoptData(Layer &layer, pybind11::array &arr, bool copy) {
+    auto rep = layer.getEditableRepresentation<LayerRAM>();
+    checkDataFormat<2>(rep->getDataFormat(), rep->getDimensions(), arr);
+    auto shared = shareable(arr, rep->getDataFormat()->getComponents(), copy);
+    rep->dispatch<void>([&](auto typed) {
+        using Type = typename std::remove_pointer_t<decltype(typed)>::type;
+        typed->setData(sharedData<Type>(shared), keepAlive(shared), typed->getDimensions());
+        typed->shareData();
+    });
+}
+
+void adoptData(Volume &volume, pybind11::array &arr, bool copy) {
+    auto rep = volume.getEditableRepresentation<VolumeRAM>();
+    checkDataFormat<3>(rep->getDataFormat(), rep->getDimensions(), arr);
+    auto shared = shareable(arr, rep->getDataFormat()->getComponents(), copy);
+    rep->dispatch<void>([&](auto typed) {
+        using Type = typename std::remove_pointer_t<decltype(typed)>::type;
+        typed->setData(sharedData<Type>(shared), keepAlive(shared), typed->getDimensions());
+        typed->shareData();
+    });
+}
+
+pybind11::array shareData(Layer &layer) {
+    // Handing the data over to a shared owner modifies the representation
+    auto rep = layer.getEditableRepresentation<LayerRAM>();
+    const auto dims = rep->getDimensions();
+    return shareRAM(*rep, {dims.x, dims.y});
+}
+
+pybind11::array shareData(Volume &volume) {
+    // Handing the data over to a shared owner modifies the representation
+    auto rep = volume.getEditableRepresentation<VolumeRAM>();
+    const auto dims = rep->getDimensions();
+    return shareRAM(*rep, {dims.x, dims.y, dims.z});
 }
 
 }  // namespace pyutil
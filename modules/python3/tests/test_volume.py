@@ -30,6 +30,6 @@ volume = volPort.data
 
 
 print(volume.dimensions)
-data = volume.data
+data = volume.readOnlyData
 
 print(data[3,4,5])
\ No newline at end of file
@@ -57,6 +57,8 @@
 
 #include <glm/gtc/epsilon.hpp>
 
+#include <utility>
+
 namespace inviwo {
 
 namespace {
@@ -247,4 +249,154 @@ const static std::vector<std::string> dtypes = {{"float16"}, {"float32"}, {"floa
 
 INSTANTIATE_TEST_SUITE_P(DefaultTypes, DTypeTest, ::testing::ValuesIn(dtypes));
 
+TEST(NumPySharing, VolumeFromArray) {
+    PythonScript s;
+    s.setSource(
+        "import numpy as np\na = np.arange(8, dtype=np.float32).reshape((2, 2, 2))\n"
+        "a.flags.writeable = False\n");
+    bool status = false;
+    s.run([&](pybind11::dict dict) {
+        auto arr = pybind11::cast<pybind11::array>(dict["a"]);
+        auto volume = pyutil::createVolume(arr);
+
+        auto ram = static_cast<const VolumeRAMPrecision<float> *>(
+            volume->getRepresentation<VolumeRAM>());
+        EXPECT_EQ(arr.data(), ram->getData()) << "The array should be used without copying";
+        EXPECT_TRUE(ram->isCopyOnWrite());
+
+        auto editable = static_cast<VolumeRAMPrecision<float> *>(
+            volume->getEditableRepresentation<VolumeRAM>());
+        editable->getDataTyped()[0] = 42.0f;
+        EXPECT_NE(arr.data(), editable->getData()) << "Modifications should copy the data";
+        EXPECT_EQ(0.0f, *static_cast<const float *>(arr.data()));
+        EXPECT_EQ(1.0f, editable->getDataTyped()[1]);
+        status = true;
+    });
+    EXPECT_TRUE(status);
+}
+
+TEST(NumPySharing, WritableArrayIsCopied) {
+    PythonScript s;
+    s.setSource("import numpy as np\na = np.arange(8, dtype=np.float32).reshape((2, 2, 2))\n");
+    bool status = false;
+    s.run([&](pybind11::dict dict) {
+        auto arr = pybind11::cast<pybind11::array>(dict["a"]);
+        auto volume = pyutil::createVolume(arr);
+
+        const auto ram = volume->getRepresentation<VolumeRAM>();
+        EXPECT_NE(arr.data(), ram->getData()) << "A writable array should be copied";
+        EXPECT_TRUE(arr.attr("flags").attr("writeable").cast<bool>())
+            << "The flags of the array should not change";
+        for (size_t i = 0; i < 8; ++i) {
+            EXPECT_EQ(static_cast<double>(i), ram->getAsDouble(i));
+        }
+        status = true;
+    });
+    EXPECT_TRUE(status);
+}
+
+TEST(NumPySharing, NonContiguousArray) {
+    PythonScript s;
+    s.setSource(
+        "import numpy as np\na = np.arange(16, dtype=np.float32).reshape((2, 2, 4))[:, :, ::2]\n");
+    bool status = false;
+    s.run([&](pybind11::dict dict) {
+        auto arr = pybind11::cast<pybind11::array_t<float>>(dict["a"]);
+        auto volume = pyutil::createVolume(arr);
+
+        // The copy uses the layout of the data property, the first index varies fastest
+        const auto ram = volume->getRepresentation<VolumeRAM>();
+        const auto values = arr.unchecked<3>();
+        for (size_t z = 0; z < 2; ++z) {
+            for (size_t y = 0; y < 2; ++y) {
+                for (size_t x = 0; x < 2; ++x) {
+                    EXPECT_EQ(values(x, y, z), ram->getAsDouble(size3_t(x, y, z)));
+                }
+            }
+        }
+        status = true;
+    });
+    EXPECT_TRUE(status);
+}
+
+TEST(NumPySharing, WritableArrayWithoutCopy) {
+    PythonScript s;
+    s.setSource("import numpy as np\na = np.arange(8, dtype=np.float32).reshape((2, 2, 2))\n");
+    bool status = false;
+    s.run([&](pybind11::dict dict) {
+        auto arr = pybind11::cast<pybind11::array_t<float>>(dict["a"]);
+        auto volume = pyutil::createVolume(arr, false);
+
+        const auto ram = volume->getRepresentation<VolumeRAM>();
+        EXPECT_EQ(arr.data(), ram->getData()) << "The array should be aliased";
+        EXPECT_TRUE(arr.attr("flags").attr("writeable").cast<bool>())
+            << "The flags of the array should not change";
+
+        arr.mutable_at(1, 0, 0) = 42.0f;
+        EXPECT_EQ(42.0, ram->getAsDouble(size3_t(1, 0, 0)))
+            << "Changes through the array should be seen by the volume";
+
+        auto editable = volume->getEditableRepresentation<VolumeRAM>();
+        editable->setFromDouble(size3_t(0, 0, 0), 7.0);
+        EXPECT_NE(arr.data(), editable->getData()) << "The volume should never write to the array";
+        EXPECT_EQ(0.0f, arr.at(0, 0, 0));
+        status = true;
+    });
+    EXPECT_TRUE(status);
+}
+
+TEST(NumPySharing, NonContiguousArrayWithoutCopy) {
+    PythonScript s;
+    s.setSource(
+        "import numpy as np\na = np.arange(16, dtype=np.float32).reshape((2, 2, 4))[:, :, ::2]\n");
+    bool status = false;
+    s.run([&](pybind11::dict dict) {
+        auto arr = pybind11::cast<pybind11::array>(dict["a"]);
+        EXPECT_THROW(pyutil::createVolume(arr, false), pybind11::value_error);
+        status = true;
+    });
+    EXPECT_TRUE(status);
+}
+
+TEST(NumPySharing, ShareUnownedLayerData) {
+    std::vector<float> external{1.0f, 2.0f, 3.0f, 4.0f};
+    LayerRAMPrecision<float> ram(external.data(), nullptr, size2_t(2, 2));
+
+    // Nothing keeps the external data alive, hence a copy is shared
+    auto shared = ram.shareData();
+    EXPECT_NE(external.data(), shared.get());
+    EXPECT_EQ(shared.get(), std::as_const(ram).getDataTyped());
+    external[0] = 5.0f;
+    EXPECT_EQ(1.0f, shared.get()[0]);
+
+    ram.getDataTyped()[1] = 6.0f;
+    EXPECT_EQ(2.0f, shared.get()[1]) << "Modifications should copy the data";
+}
+
+TEST(NumPySharing, ShareVolumeData) {
+    Volume volume(size3_t(4, 4, 4), DataFormat<float>::get());
+    auto editable = static_cast<VolumeRAMPrecision<float> *>(
+        volume.getEditableRepresentation<VolumeRAM>());
+    editable->getDataTyped()[0] = 1.0f;
+
+    PythonScript s;
+    s.setSource(
+        "a = volume.shareData()\nwriteable = a.flags.writeable\nfirst = float(a[0, 0, 0])\n");
+    bool status = false;
+    s.run({{"volume", pybind11::cast(&volume, pybind11::return_value_policy::reference)}},
+          [&](pybind11::dict dict) {
+              auto arr = pybind11::cast<pybind11::array>(dict["a"]);
+              const auto ram = volume.getRepresentation<VolumeRAM>();
+              EXPECT_EQ(ram->getData(), arr.data()) << "The data should be shared without copying";
+              EXPECT_FALSE(pybind11::cast<bool>(dict["writeable"]));
+              EXPECT_EQ(1.0f, pybind11::cast<float>(dict["first"]));
+
+              editable->getDataTyped()[0] = 2.0f;
+              EXPECT_NE(editable->getData(), arr.data()) << "Modifications should copy the data";
+              EXPECT_EQ(1.0f, *static_cast<const float *>(arr.data()));
+              status = true;
+          });
+    EXPECT_TRUE(status);
+}
+
 }  // namespace inviwo
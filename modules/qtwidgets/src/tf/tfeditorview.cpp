@@ -258,6 +258,12 @@ void TFEditorView::updateHistogram() {
             } else if (!histCalculation_) {
                 histograms_.clear();
                 histCalculation_ = volume->calculateHistograms(2048);
+                // show the sampled histograms of large volumes while waiting for the full ones
+                histCalculation_->whenUpdated([this](const HistogramContainer& histograms) {
+                    updateHistogram(histograms);
+                    resetCachedContent();
+                    update();
+                });
                 histCalculation_->whenDone([this](const HistogramContainer& histograms) {
                     updateHistogram(histograms);
                     resetCachedContent();
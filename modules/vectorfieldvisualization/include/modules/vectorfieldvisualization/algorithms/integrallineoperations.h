@@ -34,6 +34,7 @@
 #include <inviwo/core/common/inviwo.h>
 #include <modules/vectorfieldvisualization/datastructures/integralline.h>
 #include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
 
 namespace inviwo {
 
@@ -51,6 +52,17 @@ IVW_MODULE_VECTORFIELDVISUALIZATION_API IntegralLineSet tortuosity(const Integra
 
 IVW_MODULE_VECTORFIELDVISUALIZATION_API void tortuosity(IntegralLine &line, dmat4 toWorld);
 IVW_MODULE_VECTORFIELDVISUALIZATION_API void tortuosity(IntegralLineSet &lines);
+
+/**
+ * Create a mesh of lines with adjacency information from the set. The position buffer and the
+ * meta data buffers share the arrays of the set without copying them, see
+ * IntegralLineSet::getPositionBuffer(), only the index buffer is created. The mesh is const since
+ * its buffers must not be modified. Meta data buffers are added as ScalarMetaAttrib, in the order
+ * of IntegralLineSet::getMetaDataKeys(), with consecutive locations starting at
+ * BufferType::NumberOfBufferTypes.
+ */
+IVW_MODULE_VECTORFIELDVISUALIZATION_API std::shared_ptr<const Mesh> toMesh(
+    const IntegralLineSet &lines);
 }  // namespace util
 
 }  // namespace inviwo
@@ -42,6 +42,83 @@
 
 namespace inviwo {
 
+namespace detail {
+
+/**
+ * Length of the polyline through the points in the range [begin, end)
+ */
+template <typename It>
+double lineLength(It begin, It end) {
+    double length = 0.0;
+    if (begin == end) return length;
+    for (auto prev = begin++; begin != end; prev = begin++) {
+        length += glm::distance(*prev, *begin);
+    }
+    return length;
+}
+
+/**
+ * The point at distance d along the polyline through positions, length should be the total
+ * length of the polyline. Returns dvec3(0) if d is outside of [0, length].
+ */
+template <typename Positions>
+dvec3 pointAtDistance(const Positions &positions, double length, double d) {
+    if (d < 0 || d > length) {
+        return dvec3(0);
+    }
+    if (d == 0) {
+        return *positions.begin();
+    }
+
+    double distPrev = 0, distNext = 0;
+    auto next = positions.begin();
+    auto prev = next;
+    while (distNext < d) {
+        prev = next++;
+        distPrev = distNext;
+        distNext += glm::distance(*prev, *next);
+    }
+
+    double x = (d - distPrev) / (distNext - distPrev);
+    return Interpolation<dvec3, double>::linear(*prev, *next, x);
+}
+
+/**
+ * The meta data interpolated at distance d along the polyline through positions, length should
+ * be the total length of the polyline. Returns T(0) if d is outside of [0, length].
+ */
+template <typename T, typename Positions, typename MetaData>
+T metaDataAtDistance(const Positions &positions, const MetaData &metaData, double length,
+                     double d) {
+    if (d < 0 || d > length) {
+        return T(0);
+    }
+    if (d == 0) {
+        return *metaData.begin();
+    }
+
+    double distPrev = 0, distNext = 0;
+    auto next = positions.begin();
+    auto prev = next;
+    auto nextMD = metaData.begin();
+    auto prevMD = nextMD;
+
+    while (distNext < d) {
+        prev = next++;
+        prevMD = nextMD++;
+        distPrev = distNext;
+        distNext += glm::distance(*prev, *next);
+    }
+
+    double x = (d - distPrev) / (distNext - distPrev);
+    using TV = typename util::same_extent<T, double>::type;
+
+    return static_cast<T>(
+        Interpolation<TV, double>::linear(static_cast<TV>(*prevMD), static_cast<TV>(*nextMD), x));
+}
+
+}  // namespace detail
+
 class IVW_MODULE_VECTORFIELDVISUALIZATION_API IntegralLine {
 public:
     enum class TerminationReason { StartPoint, Steps, OutOfBounds, ZeroVelocity, Unknown };
@@ -99,9 +176,6 @@ public:
     TerminationReason getForwardTerminationReason() const;
 
 private:
-    double calcLength(std::vector<dvec3>::const_iterator start,
-                      std::vector<dvec3>::const_iterator end) const;
-
     std::vector<dvec3> positions_;
     std::map<std::string, std::shared_ptr<BufferBase>> metaData_;
 
@@ -166,38 +240,10 @@ std::vector<T> &IntegralLine::getMetaData(const std::string &name, bool create)
 
 template <typename T>
 T IntegralLine::getMetaDataAtDistance(std::string md, double d) const {
-    if (d < 0 || d > getLength()) {
-        return T(0);
-    }
-
     if (!hasMetaData(md)) {
         return T(0);
     }
-
-    auto &metaData = getMetaData<T>(md);
-
-    if (d == 0) {
-        return metaData.front();
-    }
-
-    double distPrev = 0, distNext = 0;
-    auto next = positions_.begin();
-    auto prev = next;
-    auto nextMD = metaData.begin();
-    auto prevMD = nextMD;
-
-    while (distNext < d) {
-        prev = next++;
-        prevMD = nextMD++;
-        distPrev = distNext;
-        distNext += glm::distance(*prev, *next);
-    }
-
-    double x = (d - distPrev) / (distNext - distPrev);
-    using TV = typename util::same_extent<T, double>::type;
-
-    return static_cast<T>(
-        Interpolation<TV, double>::linear(static_cast<TV>(*prevMD), static_cast<TV>(*nextMD), x));
+    return detail::metaDataAtDistance<T>(positions_, getMetaData<T>(md), getLength(), d);
 }
 
 template <class Elem, class Traits>
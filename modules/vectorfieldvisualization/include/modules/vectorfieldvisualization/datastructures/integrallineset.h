@@ -37,60 +37,258 @@
 #include <inviwo/core/ports/dataoutport.h>
 #include <inviwo/core/ports/port.h>
 #include <inviwo/core/datastructures/datatraits.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/transformiterator.h>
+#include <inviwo/core/util/zip.h>
+
+#include <tcb/span.hpp>
+
+#include <map>
 
 namespace inviwo {
 
+class IntegralLineSet;
+
+/**
+ * \class IntegralLineView
+ * \brief A light weight view of a single line in an IntegralLineSet
+ *
+ * Provides the same const accessors as IntegralLine, but positions and meta data are returned as
+ * spans into the arrays of the set. The view is only valid as long as the set it refers to is
+ * alive and unmodified. Use toIntegralLine() to get a standalone copy.
+ */
+class IVW_MODULE_VECTORFIELDVISUALIZATION_API IntegralLineView {
+public:
+    using TerminationReason = IntegralLine::TerminationReason;
+
+    IntegralLineView(const IntegralLineSet& set, size_t line);
+
+    /**
+     * The number of points in the line
+     */
+    size_t size() const;
+
+    util::span<const dvec3> getPositions() const;
+
+    template <typename T>
+    util::span<const T> getMetaData(const std::string& name) const;
+
+    bool hasMetaData(const std::string& name) const;
+
+    std::vector<std::string> getMetaDataKeys() const;
+
+    double getLength() const;
+
+    double distBetweenPoints(size_t a, size_t b) const;
+
+    dvec3 getPointAtDistance(double d) const;
+
+    template <typename T>
+    T getMetaDataAtDistance(std::string md, double d) const;
+
+    size_t getIndex() const;
+
+    TerminationReason getBackwardTerminationReason() const;
+    TerminationReason getForwardTerminationReason() const;
+
+    /**
+     * The offset of the first point of the line into the point arrays of the set
+     */
+    size_t getOffset() const;
+
+    /**
+     * Copy the line out of the set into a standalone IntegralLine
+     */
+    IntegralLine toIntegralLine() const;
+
+private:
+    friend IntegralLineSet;
+    const IntegralLineSet* set_;
+    size_t line_;
+};
+
 /**
  * \class IntegralLineSet
- * \brief VERY_BRIEFLY_DESCRIBE_THE_CLASS
- * DESCRIBE_THE_CLASS
+ * \brief A set of integral lines stored as a structure of arrays
+ *
+ * The positions of all lines are stored in a single array, and each meta data channel in one
+ * array of the same length. Line i consists of the points in the range
+ * [getOffsets()[i], getOffsets()[i + 1]). Iterating the set, or indexing it, gives
+ * IntegralLineViews into the arrays.
+ *
+ * All meta data channels always have one value per point. Adding a line that lacks one of the
+ * channels of the set fills that channel with zeros, and adding a line with a new channel fills
+ * the new channel with zeros for all previous points.
+ *
+ * The arrays are shared on copy and only copied when modified, which makes copying a set cheap.
+ * getPositionBuffer() and getMetaDataBuffer() return const buffers that share the arrays in the
+ * same way, the set copies an array before modifying it while a buffer still refers to it.
  */
 class IVW_MODULE_VECTORFIELDVISUALIZATION_API IntegralLineSet {
 public:
     enum class SetIndex { Yes, No };
+    using TerminationReason = IntegralLine::TerminationReason;
+
+private:
+    struct MakeView {
+        IntegralLineView operator()(size_t line) const { return IntegralLineView(*set, line); }
+        const IntegralLineSet* set = nullptr;
+    };
+
+public:
+    using value_type = IntegralLineView;
+    using const_iterator = util::TransformIterator<MakeView, util::sequence<size_t>::iterator>;
+    using iterator = const_iterator;
 
-    using value_type = IntegralLine;
     IntegralLineSet(mat4 modelMatrix, mat4 worldMatrix = mat4(1));
+    IntegralLineSet(const IntegralLineSet& rhs) = default;
+    IntegralLineSet(IntegralLineSet&& rhs) = default;
+    IntegralLineSet& operator=(const IntegralLineSet& that) = default;
+    IntegralLineSet& operator=(IntegralLineSet&& that) = default;
     virtual ~IntegralLineSet();
 
     mat4 getModelMatrix() const;
     mat4 getWorldMatrix() const;
 
-    std::vector<IntegralLine>::const_iterator begin() const;
-    std::vector<IntegralLine>::const_iterator end() const;
+    const_iterator begin() const;
+    const_iterator end() const;
 
-    std::vector<IntegralLine>::iterator begin();
-    std::vector<IntegralLine>::iterator end();
-
-    const IntegralLine& back() const { return lines_.back(); }
-    IntegralLine& back() { return lines_.back(); }
-
-    const IntegralLine& front() const { return lines_.front(); }
-    IntegralLine& front() { return lines_.front(); }
+    IntegralLineView front() const;
+    IntegralLineView back() const;
 
     size_t size() const;
 
-    IntegralLine& operator[](size_t idx);
-    const IntegralLine& operator[](size_t idx) const;
-
-    IntegralLine& at(size_t idx);
-    const IntegralLine& at(size_t idx) const;
+    IntegralLineView operator[](size_t idx) const;
+    IntegralLineView at(size_t idx) const;
 
+    /**
+     * Append a copy of line to the set. The line is validated before the set is modified, if
+     * an exception is thrown the set is left unchanged.
+     * @throws Exception if a meta data channel of the line has a different format than the
+     * channel of the set, or more values than the line has points.
+     */
     void push_back(const IntegralLine& line, SetIndex updateIndex);
     void push_back(const IntegralLine& line, size_t idx);
 
-    void push_back(IntegralLine&& line, SetIndex updateIndex);
-    void push_back(IntegralLine&& line, size_t idx);
+    void push_back(const IntegralLineView& line, SetIndex updateIndex);
+    void push_back(const IntegralLineView& line, size_t idx);
+
+    /**
+     * The total number of points of all lines
+     */
+    size_t getNumberOfPoints() const;
+
+    /**
+     * The offsets of the lines into the point arrays, has size() + 1 elements.
+     */
+    const std::vector<size_t>& getOffsets() const;
+
+    const std::vector<dvec3>& getPositions() const;
+
+    bool hasMetaData(const std::string& name) const;
+
+    std::vector<std::string> getMetaDataKeys() const;
+
+    /**
+     * The values of meta data channel name for all points
+     */
+    template <typename T>
+    const std::vector<T>& getMetaData(const std::string& name) const;
+
+    const BufferRAM& getMetaDataRAM(const std::string& name) const;
+
+    /**
+     * A Buffer that shares the positions of the set without copying them. Later modifications of
+     * the set are not seen by the buffer.
+     */
+    std::shared_ptr<const Buffer<dvec3>> getPositionBuffer() const;
 
-    std::vector<IntegralLine>& getVector() { return lines_; }
-    const std::vector<IntegralLine>& getVector() const { return lines_; }
+    /**
+     * A Buffer that shares meta data channel name of the set without copying it. Later
+     * modifications of the set are not seen by the buffer.
+     */
+    std::shared_ptr<const BufferBase> getMetaDataBuffer(const std::string& name) const;
+
+    /**
+     * Editable access to the positions of all lines, used together with getEditableMetaData()
+     * and addLine() to build a set without going through IntegralLine. Points appended here
+     * belong to the next line until addLine() is called.
+     */
+    std::vector<dvec3>& getEditablePositions();
+
+    /**
+     * Editable access to meta data channel name for all points. If create is true, a missing
+     * channel is created and filled with zeros for all existing points.
+     */
+    template <typename T>
+    std::vector<T>& getEditableMetaData(const std::string& name, bool create = false);
+
+    /**
+     * Close the current line, i.e. all points appended after the previous line. Meta data
+     * channels shorter than the positions are padded with zeros.
+     * @throws Exception if a meta data channel has more values than there are points.
+     */
+    void addLine(size_t idx, TerminationReason backward = TerminationReason::Unknown,
+                 TerminationReason forward = TerminationReason::Unknown);
 
 private:
-    std::vector<IntegralLine> lines_;
+    friend IntegralLineView;
+    BufferRAM& getEditableChannel(const std::string& name, const DataFormatBase* format);
+    void checkFormat(const std::string& name, const BufferRAM& ram,
+                     const DataFormatBase* format) const;
+    void checkLine(size_t points) const;
+    void checkChannel(const std::string& name, const DataFormatBase* format, size_t values,
+                      size_t points) const;
+
     mat4 modelMatrix_;
     mat4 worldMatrix_;
+
+    std::vector<size_t> offsets_;
+    std::vector<size_t> indices_;
+    std::vector<TerminationReason> backwardTerminationReasons_;
+    std::vector<TerminationReason> forwardTerminationReasons_;
+
+    std::shared_ptr<BufferRAMPrecision<dvec3>> positions_;
+    std::map<std::string, std::shared_ptr<BufferRAM>> metaData_;
 };
 
+template <typename T>
+util::span<const T> IntegralLineView::getMetaData(const std::string& name) const {
+    return util::span<const T>(set_->getMetaData<T>(name)).subspan(getOffset(), size());
+}
+
+template <typename T>
+T IntegralLineView::getMetaDataAtDistance(std::string md, double d) const {
+    if (!hasMetaData(md)) {
+        return T(0);
+    }
+    return detail::metaDataAtDistance<T>(getPositions(), getMetaData<T>(md), getLength(), d);
+}
+
+template <typename T>
+const std::vector<T>& IntegralLineSet::getMetaData(const std::string& name) const {
+    const auto& ram = getMetaDataRAM(name);
+    auto askedDF = DataFormat<T>::get();
+    auto isDF = ram.getDataFormat();
+    if (isDF != askedDF) {
+        std::ostringstream oss;
+        oss << "Incorrect dataformat for meta data " << name << " asking for "
+            << askedDF->getString() << " but is " << isDF->getString();
+        throw Exception(oss.str(), IVW_CONTEXT);
+    }
+    return static_cast<const BufferRAMPrecision<T>&>(ram).getDataContainer();
+}
+
+template <typename T>
+std::vector<T>& IntegralLineSet::getEditableMetaData(const std::string& name, bool create) {
+    if (!create && !hasMetaData(name)) {
+        throw Exception("No meta data with name: " + name, IVW_CONTEXT);
+    }
+    return static_cast<BufferRAMPrecision<T>&>(getEditableChannel(name, DataFormat<T>::get()))
+        .getDataContainer();
+}
+
 using IntegralLineSetInport = DataInport<IntegralLineSet>;
 using IntegralLineSetOutport = DataOutport<IntegralLineSet>;
 
@@ -101,7 +299,8 @@ struct DataTraits<IntegralLineSet> {
     static uvec3 colorCode() { return uvec3(255, 150, 0); }
     static Document info(const IntegralLineSet& data) {
         std::ostringstream oss;
-        oss << "Integral Line Set with " << data.size() << " lines";
+        oss << "Integral Line Set with " << data.size() << " lines and "
+            << data.getNumberOfPoints() << " points";
         Document doc;
         doc.append("p", oss.str());
         return doc;
@@ -0,0 +1,749 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+#pragma once
+
+#include <modules/vectorfieldvisualization/vectorfieldvisualizationmoduledefine.h>
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/detected.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/spatialsampler.h>
+#include <inviwo/core/util/spatial4dsampler.h>
+#include <modules/vectorfieldvisualization/properties/integrallineproperties.h>
+#include <modules/vectorfieldvisualization/datastructures/integralline.h>
+#include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+
+#include <tcb/span.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace inviwo {
+
+namespace detail {
+
+template <typename Sampler, typename P, typename R>
+using batchSampleType = decltype(std::declval<const Sampler &>().sample(
+    std::declval<util::span<const P>>(), std::declval<util::span<R>>()));
+
+/**
+ * Samples all \p positions with one call if the sampler supports batched sampling, otherwise one
+ * position at a time.
+ */
+template <typename Sampler, typename P, typename R>
+void sampleBatch(const Sampler &sampler, util::span<const P> positions, util::span<R> result) {
+    if constexpr (util::is_detected_v<batchSampleType, Sampler, P, R>) {
+        sampler.sample(positions, result);
+    } else {
+        for (size_t i = 0; i < positions.size(); ++i) result[i] = sampler.sample(positions[i]);
+    }
+}
+
+}  // namespace detail
+
+/**
+ * \class IntegralLinePacketTracer
+ * \brief Traces integral lines from many seeds at once
+ *
+ * The seeds are split into packets of packetSize seeds that are advanced in lockstep, each
+ * integration stage samples the positions of all active seeds of a packet with one batched call.
+ * Packets are traced in parallel on the thread pool. Each job writes into arrays allocated once
+ * for the longest possible lines of a packet, and the lines are then compacted into a structure
+ * of arrays, see Lines. Finally the lines of every job are copied in parallel to their offsets in
+ * the result, which is allocated once.
+ *
+ * Euler and RK4 give the same lines as IntegralLineTracer. RK45 is the embedded Dormand-Prince
+ * scheme, the step size property is used as the initial step and the step is adapted to keep the
+ * local error, in data space, below the tolerance of the properties.
+ */
+template <typename SpatialSampler,
+          bool TimeDependent = SpatialSampler::SpatialDimensions != SpatialSampler::DataDimensions>
+class IntegralLinePacketTracer {
+public:
+    using Sampler = SpatialSampler;
+    using TerminationReason = IntegralLine::TerminationReason;
+
+    const static bool IsTimeDependent = TimeDependent;
+
+    using SpatialVector = Vector<SpatialSampler::SpatialDimensions, double>;
+    using DataVector = Vector<SpatialSampler::DataDimensions, double>;
+    using DataHomogenousVector = Vector<SpatialSampler::DataDimensions + 1, double>;
+    using DataMatrix = Matrix<SpatialSampler::DataDimensions, double>;
+    using DataHomogenousMatrix = Matrix<SpatialSampler::DataDimensions + 1, double>;
+    using MetaDataType = typename Sampler::ReturnType;
+
+    /// Number of seeds advanced in lockstep
+    static constexpr size_t packetSize = 64;
+    /// Adaptive steps are kept within [stepSize / adaptiveStepRange, stepSize * adaptiveStepRange]
+    static constexpr double adaptiveStepRange = 100.0;
+
+    /**
+     * Lines stored as a structure of arrays, there is one line for each seed. Line i consists of
+     * the points [offsets[i], offsets[i + 1]) of positions, velocities, timestamps and each meta
+     * data channel. Lines with zero velocity at the seed point are empty.
+     */
+    struct Lines {
+        size_t size() const { return offsets.size() - 1; }
+        size_t size(size_t line) const { return offsets[line + 1] - offsets[line]; }
+
+        std::vector<size_t> offsets{0};
+        std::vector<dvec3> positions;
+        std::vector<dvec3> velocities;
+        std::vector<double> timestamps;  ///< Only filled for time dependent tracers
+        std::vector<std::vector<MetaDataType>> metaData;  ///< In order of getMetaDataNames()
+        std::vector<size_t> seedIndices;                  ///< Index of the seed point in the line
+        std::vector<TerminationReason> backwardTerminationReasons;
+        std::vector<TerminationReason> forwardTerminationReasons;
+    };
+
+    IntegralLinePacketTracer(std::shared_ptr<const Sampler> sampler,
+                             const IntegralLineProperties &properties);
+
+    void addMetaDataSampler(const std::string &name, std::shared_ptr<const Sampler> sampler);
+    const std::vector<std::string> &getMetaDataNames() const;
+
+    /**
+     * Trace lines from all \p seeds in parallel. \p seeds can be any random access container of
+     * positions convertible to SpatialVector, given in the seed point space of the properties.
+     * @param seeds the seed points
+     * @param jobs number of jobs to split the packets into, if jobs == 0 (default) it will create
+     * pool size * 4 jobs. With one job, or a pool size of zero, the lines are traced in the
+     * calling thread.
+     * @see util::forEachTask
+     */
+    template <typename Seeds>
+    Lines traceFrom(const Seeds &seeds, size_t jobs = 0) const;
+
+    /**
+     * Add all lines with at least \p minPoints points to \p set, line i gets the index
+     * startIndex + i.
+     */
+    void addTo(const Lines &lines, IntegralLineSet &set, size_t startIndex,
+               size_t minPoints = 2) const;
+
+    const DataHomogenousMatrix &getSeedTransformationMatrix() const;
+
+private:
+    /**
+     * Integration state of one packet. The points of lane l are stored in the slots
+     * [first[l], last[l]) of [l * stride, (l + 1) * stride), with the seed point in slot
+     * stepsBWD_, such that backward integration prepends and forward integration appends.
+     */
+    struct Packet {
+        Packet(size_t stride, size_t metaDataChannels);
+
+        size_t stride;
+        size_t size = 0;
+        std::vector<SpatialVector> positions;
+        std::vector<DataVector> velocities;
+        std::vector<std::vector<MetaDataType>> metaData;
+        std::array<size_t, packetSize> first;
+        std::array<size_t, packetSize> last;
+        std::array<TerminationReason, packetSize> backward;
+        std::array<TerminationReason, packetSize> forward;
+
+        std::array<SpatialVector, packetSize> seeds;
+        std::array<DataVector, packetSize> seedVelocities;
+
+        std::array<size_t, packetSize> active;  ///< lanes that are still integrated
+        std::array<SpatialVector, packetSize> pos;
+        std::array<DataVector, packetSize> vel;  ///< sample at pos
+        std::array<double, packetSize> stepSize;
+        std::array<size_t, packetSize> steps;
+
+        std::array<bool, packetSize> accepted;
+        std::array<SpatialVector, packetSize> next;
+        std::array<DataVector, packetSize> nextVel;  ///< sample at next, only set by RK45
+        std::array<size_t, packetSize> lanes;
+        std::array<size_t, packetSize> slots;
+        std::array<SpatialVector, packetSize> stagePos;
+        std::array<DataVector, packetSize> stageVel;
+        std::array<MetaDataType, packetSize> stageMetaData;
+        std::array<std::array<DataVector, packetSize>, 7> k;
+    };
+
+    SpatialVector seedTransform(const SpatialVector &seed) const;
+    SpatialVector move(const SpatialVector &pos, DataVector v, double stepSize) const;
+    static DataVector normalize(const DataVector &v);
+
+    template <typename Seeds>
+    void tracePackets(const Seeds &seeds, size_t begin, size_t end, Lines &lines) const;
+    void writePoints(Packet &packet, size_t count) const;
+    void integrate(Packet &packet, size_t steps, bool fwd) const;
+    void step(Packet &packet, size_t count) const;
+    void stepRK45(Packet &packet, size_t count) const;
+
+    util::span<const SpatialVector> stagePositions(const Packet &packet, size_t count) const {
+        return util::span<const SpatialVector>(packet.stagePos.data(), count);
+    }
+
+    IntegralLineProperties::IntegrationScheme integrationScheme_;
+
+    size_t steps_;
+    double stepSize_;
+    double tolerance_;
+    size_t stepsBWD_;
+    size_t stepsFWD_;
+    IntegralLineProperties::Direction dir_;
+    bool normalizeSamples_;
+
+    std::shared_ptr<const Sampler> sampler_;
+    std::vector<std::string> metaNames_;
+    std::vector<std::shared_ptr<const Sampler>> metaSamplers_;
+
+    DataMatrix invBasis_;
+    DataHomogenousMatrix seedTransformation_;
+};
+
+template <typename SpatialSampler, bool TimeDependent>
+IntegralLinePacketTracer<SpatialSampler, TimeDependent>::Packet::Packet(size_t stride,
+                                                                       size_t metaDataChannels)
+    : stride(stride)
+    , positions(packetSize * stride)
+    , velocities(packetSize * stride)
+    , metaData(metaDataChannels, std::vector<MetaDataType>(packetSize * stride)) {}
+
+template <typename SpatialSampler, bool TimeDependent>
+IntegralLinePacketTracer<SpatialSampler, TimeDependent>::IntegralLinePacketTracer(
+    std::shared_ptr<const Sampler> sampler, const IntegralLineProperties &properties)
+    : integrationScheme_(properties.getIntegrationScheme())
+    , steps_(static_cast<size_t>(std::max(0, properties.getNumberOfSteps())))
+    , stepSize_(properties.getStepSize())
+    , tolerance_(properties.getTolerance())
+    , stepsBWD_(0)
+    , stepsFWD_(0)
+    , dir_(properties.getStepDirection())
+    , normalizeSamples_(properties.getNormalizeSamples())
+    , sampler_(sampler)
+    , invBasis_(glm::inverse(DataMatrix(sampler->getModelMatrix())))
+    , seedTransformation_(
+          properties.getSeedPointTransformationMatrix(sampler->getCoordinateTransformer())) {
+
+    // Same number of steps in each direction as IntegralLineTracer
+    switch (dir_) {
+        case IntegralLineProperties::Direction::FWD:
+            stepsBWD_ = 1;
+            stepsFWD_ = steps_ + 1;
+            break;
+        case IntegralLineProperties::Direction::BWD:
+            stepsBWD_ = steps_ + 1;
+            stepsFWD_ = 1;
+            break;
+        default:
+        case IntegralLineProperties::Direction::BOTH:
+            stepsBWD_ = steps_ / 2 + 1;
+            stepsFWD_ = steps_ - (steps_ / 2) + 1;
+            break;
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+void IntegralLinePacketTracer<SpatialSampler, TimeDependent>::addMetaDataSampler(
+    const std::string &name, std::shared_ptr<const Sampler> sampler) {
+    auto it = std::find(metaNames_.begin(), metaNames_.end(), name);
+    if (it != metaNames_.end()) {
+        metaSamplers_[std::distance(metaNames_.begin(), it)] = sampler;
+    } else {
+        metaNames_.push_back(name);
+        metaSamplers_.push_back(sampler);
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+const std::vector<std::string>
+    &IntegralLinePacketTracer<SpatialSampler, TimeDependent>::getMetaDataNames() const {
+    return metaNames_;
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+const typename IntegralLinePacketTracer<SpatialSampler, TimeDependent>::DataHomogenousMatrix &
+IntegralLinePacketTracer<SpatialSampler, TimeDependent>::getSeedTransformationMatrix() const {
+    return seedTransformation_;
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+template <typename Seeds>
+typename IntegralLinePacketTracer<SpatialSampler, TimeDependent>::Lines
+IntegralLinePacketTracer<SpatialSampler, TimeDependent>::traceFrom(const Seeds &seeds,
+                                                                   size_t jobs) const {
+    const size_t nSeeds = std::size(seeds);
+    const size_t packets = (nSeeds + packetSize - 1) / packetSize;
+
+    if (jobs == 0) {
+        const size_t poolSize =
+            InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+        jobs = 4 * poolSize;
+    }
+    jobs = std::max(size_t{1}, std::min(jobs, packets));
+
+    std::vector<Lines> results(jobs);
+    util::forEachTask(jobs, [&](size_t job) {
+        const auto begin = std::min(nSeeds, (packets * job) / jobs * packetSize);
+        const auto end = std::min(nSeeds, (packets * (job + 1)) / jobs * packetSize);
+        tracePackets(seeds, begin, end, results[job]);
+    });
+
+    if (jobs == 1) return std::move(results.front());
+
+    std::vector<size_t> lineOffsets(jobs + 1, 0);
+    std::vector<size_t> pointOffsets(jobs + 1, 0);
+    for (size_t job = 0; job < jobs; ++job) {
+        lineOffsets[job + 1] = lineOffsets[job] + results[job].size();
+        pointOffsets[job + 1] = pointOffsets[job] + results[job].positions.size();
+    }
+    const auto nLines = lineOffsets.back();
+    const auto nPoints = pointOffsets.back();
+
+    Lines lines;
+    lines.offsets.resize(nLines + 1, 0);
+    lines.positions.resize(nPoints);
+    lines.velocities.resize(nPoints);
+    if constexpr (TimeDependent) {
+        lines.timestamps.resize(nPoints);
+    }
+    lines.metaData.assign(metaSamplers_.size(), std::vector<MetaDataType>(nPoints));
+    lines.seedIndices.resize(nLines);
+    lines.backwardTerminationReasons.resize(nLines);
+    lines.forwardTerminationReasons.resize(nLines);
+
+    util::forEachTask(jobs, [&](size_t job) {
+        const auto line = lineOffsets[job];
+        const auto point = pointOffsets[job];
+        {
+            const auto &part = results[job];
+            std::transform(part.offsets.begin() + 1, part.offsets.end(),
+                           lines.offsets.begin() + line + 1,
+                           [point](size_t offset) { return point + offset; });
+            std::copy(part.positions.begin(), part.positions.end(),
+                      lines.positions.begin() + point);
+            std::copy(part.velocities.begin(), part.velocities.end(),
+                      lines.velocities.begin() + point);
+            if constexpr (TimeDependent) {
+                std::copy(part.timestamps.begin(), part.timestamps.end(),
+                          lines.timestamps.begin() + point);
+            }
+            for (size_t m = 0; m < part.metaData.size(); ++m) {
+                std::copy(part.metaData[m].begin(), part.metaData[m].end(),
+                          lines.metaData[m].begin() + point);
+            }
+            std::copy(part.seedIndices.begin(), part.seedIndices.end(),
+                      lines.seedIndices.begin() + line);
+            std::copy(part.backwardTerminationReasons.begin(),
+                      part.backwardTerminationReasons.end(),
+                      lines.backwardTerminationReasons.begin() + line);
+            std::copy(part.forwardTerminationReasons.begin(), part.forwardTerminationReasons.end(),
+                      lines.forwardTerminationReasons.begin() + line);
+        }
+        // Release the arrays of the job as soon as they are copied
+        results[job] = Lines{};
+    });
+    return lines;
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+void IntegralLinePacketTracer<SpatialSampler, TimeDependent>::addTo(const Lines &lines,
+                                                                    IntegralLineSet &set,
+                                                                    size_t startIndex,
+                                                                    size_t minPoints) const {
+    // Copy the ranges straight into the arrays of the set
+    auto &positions = set.getEditablePositions();
+    auto &velocities = set.getEditableMetaData<dvec3>("velocity", true);
+    std::vector<double> *timestamps = nullptr;
+    if constexpr (TimeDependent) {
+        timestamps = &set.getEditableMetaData<double>("timestamp", true);
+    }
+    std::vector<std::vector<MetaDataType> *> metaData;
+    for (const auto &name : metaNames_) {
+        metaData.push_back(&set.getEditableMetaData<MetaDataType>(name, true));
+    }
+
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (lines.size(i) < minPoints) continue;
+        const auto begin = lines.offsets[i];
+        const auto end = lines.offsets[i + 1];
+
+        positions.insert(positions.end(), lines.positions.begin() + begin,
+                         lines.positions.begin() + end);
+        velocities.insert(velocities.end(), lines.velocities.begin() + begin,
+                          lines.velocities.begin() + end);
+        if constexpr (TimeDependent) {
+            timestamps->insert(timestamps->end(), lines.timestamps.begin() + begin,
+                               lines.timestamps.begin() + end);
+        }
+        for (size_t m = 0; m < metaNames_.size(); ++m) {
+            metaData[m]->insert(metaData[m]->end(), lines.metaData[m].begin() + begin,
+                                lines.metaData[m].begin() + end);
+        }
+        set.addLine(startIndex + i, lines.backwardTerminationReasons[i],
+                    lines.forwardTerminationReasons[i]);
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+typename IntegralLinePacketTracer<SpatialSampler, TimeDependent>::SpatialVector
+IntegralLinePacketTracer<SpatialSampler, TimeDependent>::seedTransform(
+    const SpatialVector &seed) const {
+    if constexpr (IsTimeDependent) {
+        using V = DataVector;
+        auto p = seedTransformation_ * SpatialVector(V(seed), 1.0f);
+        return SpatialVector(V(p) / p[SpatialSampler::DataDimensions],
+                             seed[SpatialSampler::DataDimensions]);
+    } else {
+        using H = DataHomogenousVector;
+        auto p = seedTransformation_ * H(seed, 1.0f);
+        return SpatialVector(p) / p[SpatialSampler::DataDimensions];
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+typename IntegralLinePacketTracer<SpatialSampler, TimeDependent>::SpatialVector
+IntegralLinePacketTracer<SpatialSampler, TimeDependent>::move(const SpatialVector &pos,
+                                                              DataVector v,
+                                                              double stepSize) const {
+    if (normalizeSamples_) {
+        v = normalize(v);
+    }
+    const auto offset = (invBasis_ * (v * stepSize));
+    if constexpr (TimeDependent) {
+        return pos + SpatialVector(offset, stepSize);
+    } else {
+        return pos + offset;
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+typename IntegralLinePacketTracer<SpatialSampler, TimeDependent>::DataVector
+IntegralLinePacketTracer<SpatialSampler, TimeDependent>::normalize(const DataVector &v) {
+    const auto l = glm::length(v);
+    if (l == 0) return v;
+    return v / l;
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+template <typename Seeds>
+void IntegralLinePacketTracer<SpatialSampler, TimeDependent>::tracePackets(const Seeds &seeds,
+                                                                           size_t begin,
+                                                                           size_t end,
+                                                                           Lines &lines) const {
+    lines.metaData.resize(metaSamplers_.size());
+    if (begin >= end) return;
+
+    Packet packet(stepsBWD_ + stepsFWD_ + 1, metaSamplers_.size());
+    const auto stride = packet.stride;
+
+    for (size_t packetBegin = begin; packetBegin < end; packetBegin += packetSize) {
+        const auto size = std::min(packetSize, end - packetBegin);
+        packet.size = size;
+
+        for (size_t l = 0; l < size; ++l) {
+            packet.seeds[l] = seedTransform(SpatialVector(seeds[packetBegin + l]));
+        }
+        detail::sampleBatch(*sampler_, util::span<const SpatialVector>(packet.seeds.data(), size),
+                            util::span<DataVector>(packet.seedVelocities.data(), size));
+
+        size_t count = 0;
+        for (size_t l = 0; l < size; ++l) {
+            packet.first[l] = stepsBWD_;
+            packet.last[l] = stepsBWD_;
+            packet.backward[l] = dir_ == IntegralLineProperties::Direction::FWD
+                                     ? TerminationReason::StartPoint
+                                     : TerminationReason::Unknown;
+            packet.forward[l] = dir_ == IntegralLineProperties::Direction::BWD
+                                    ? TerminationReason::StartPoint
+                                    : TerminationReason::Unknown;
+
+            // Zero velocity at seed point gives an empty line
+            if (glm::length(packet.seedVelocities[l]) < std::numeric_limits<double>::epsilon()) {
+                continue;
+            }
+            packet.pos[l] = packet.seeds[l];
+            packet.next[l] = packet.seeds[l];
+            packet.vel[l] = packet.seedVelocities[l];
+            packet.lanes[count] = l;
+            packet.slots[count] = l * stride + stepsBWD_;
+            packet.last[l] = stepsBWD_ + 1;
+            ++count;
+        }
+        writePoints(packet, count);
+
+        integrate(packet, stepsBWD_, false);
+        integrate(packet, stepsFWD_, true);
+
+        for (size_t l = 0; l < size; ++l) {
+            const auto first = l * stride + packet.first[l];
+            const auto last = l * stride + packet.last[l];
+            lines.offsets.push_back(lines.offsets.back() + (last - first));
+            std::transform(packet.positions.begin() + first, packet.positions.begin() + last,
+                           std::back_inserter(lines.positions),
+                           [](const SpatialVector &p) { return util::glm_convert<dvec3>(p); });
+            std::transform(packet.velocities.begin() + first, packet.velocities.begin() + last,
+                           std::back_inserter(lines.velocities),
+                           [](const DataVector &v) { return util::glm_convert<dvec3>(v); });
+            if constexpr (TimeDependent) {
+                std::transform(packet.positions.begin() + first, packet.positions.begin() + last,
+                               std::back_inserter(lines.timestamps), [](const SpatialVector &p) {
+                                   return p[SpatialSampler::SpatialDimensions - 1];
+                               });
+            }
+            for (size_t m = 0; m < metaSamplers_.size(); ++m) {
+                lines.metaData[m].insert(lines.metaData[m].end(),
+                                         packet.metaData[m].begin() + first,
+                                         packet.metaData[m].begin() + last);
+            }
+            lines.seedIndices.push_back(stepsBWD_ - packet.first[l]);
+            lines.backwardTerminationReasons.push_back(packet.backward[l]);
+            lines.forwardTerminationReasons.push_back(packet.forward[l]);
+        }
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+void IntegralLinePacketTracer<SpatialSampler, TimeDependent>::writePoints(Packet &packet,
+                                                                          size_t count) const {
+    // Writes packet.next of packet.lanes[0, count) with the velocity packet.vel, i.e. the sample
+    // at the start of the step, into packet.slots, and samples the meta data at the new points.
+    for (size_t i = 0; i < count; ++i) {
+        const auto l = packet.lanes[i];
+        packet.positions[packet.slots[i]] = packet.next[l];
+        packet.velocities[packet.slots[i]] = packet.vel[l];
+        packet.stagePos[i] = packet.next[l];
+    }
+    for (size_t m = 0; m < metaSamplers_.size(); ++m) {
+        detail::sampleBatch(*metaSamplers_[m], stagePositions(packet, count),
+                            util::span<MetaDataType>(packet.stageMetaData.data(), count));
+        for (size_t i = 0; i < count; ++i) {
+            packet.metaData[m][packet.slots[i]] = packet.stageMetaData[i];
+        }
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+void IntegralLinePacketTracer<SpatialSampler, TimeDependent>::integrate(Packet &packet,
+                                                                        size_t steps,
+                                                                        bool fwd) const {
+    auto &reasons = fwd ? packet.forward : packet.backward;
+    const auto stride = packet.stride;
+
+    size_t n = 0;
+    for (size_t l = 0; l < packet.size; ++l) {
+        if (packet.first[l] == packet.last[l]) continue;
+        packet.active[n++] = l;
+        packet.pos[l] = packet.seeds[l];
+        packet.vel[l] = packet.seedVelocities[l];
+        packet.stepSize[l] = stepSize_ * (fwd ? 1.0 : -1.0);
+        packet.steps[l] = 0;
+    }
+
+    if (steps == 0) {
+        for (size_t i = 0; i < n; ++i) reasons[packet.active[i]] = TerminationReason::StartPoint;
+        return;
+    }
+
+    while (n > 0) {
+        size_t remaining = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const auto l = packet.active[i];
+            if (!sampler_->withinBounds(packet.pos[l])) {
+                reasons[l] = TerminationReason::OutOfBounds;
+            } else if (glm::length(packet.vel[l]) < std::numeric_limits<double>::epsilon()) {
+                reasons[l] = TerminationReason::ZeroVelocity;
+            } else {
+                packet.active[remaining++] = l;
+            }
+        }
+        n = remaining;
+        if (n == 0) break;
+
+        if (integrationScheme_ == IntegralLineProperties::IntegrationScheme::RK45) {
+            stepRK45(packet, n);
+        } else {
+            step(packet, n);
+        }
+
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (!packet.accepted[i]) continue;
+            const auto l = packet.active[i];
+            const auto slot = fwd ? packet.last[l]++ : --packet.first[l];
+            packet.lanes[count] = l;
+            packet.slots[count] = l * stride + slot;
+            ++packet.steps[l];
+            ++count;
+        }
+        writePoints(packet, count);
+
+        // The velocity at the new positions is needed by the next step
+        if (integrationScheme_ == IntegralLineProperties::IntegrationScheme::RK45) {
+            for (size_t i = 0; i < count; ++i) {
+                const auto l = packet.lanes[i];
+                packet.vel[l] = packet.nextVel[l];
+            }
+        } else {
+            detail::sampleBatch(*sampler_, stagePositions(packet, count),
+                                util::span<DataVector>(packet.stageVel.data(), count));
+            for (size_t i = 0; i < count; ++i) {
+                packet.vel[packet.lanes[i]] = packet.stageVel[i];
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const auto l = packet.lanes[i];
+            packet.pos[l] = packet.next[l];
+        }
+
+        remaining = 0;
+        for (size_t i = 0; i < n; ++i) {
+            const auto l = packet.active[i];
+            if (packet.steps[l] == steps) {
+                reasons[l] = TerminationReason::Steps;
+            } else {
+                packet.active[remaining++] = l;
+            }
+        }
+        n = remaining;
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+void IntegralLinePacketTracer<SpatialSampler, TimeDependent>::step(Packet &packet,
+                                                                   size_t count) const {
+    const auto &active = packet.active;
+    for (size_t i = 0; i < count; ++i) packet.accepted[i] = true;
+
+    if (integrationScheme_ == IntegralLineProperties::IntegrationScheme::Euler) {
+        for (size_t i = 0; i < count; ++i) {
+            const auto l = active[i];
+            packet.next[l] = move(packet.pos[l], packet.vel[l], packet.stepSize[l]);
+        }
+        return;
+    }
+
+    // RK4, k[0] is the velocity at the current position
+    auto &k = packet.k;
+    const auto stage = [&](size_t to, size_t from, double fraction) {
+        for (size_t i = 0; i < count; ++i) {
+            const auto l = active[i];
+            const auto &v = from == 0 ? packet.vel[l] : k[from][i];
+            packet.stagePos[i] = move(packet.pos[l], v, packet.stepSize[l] * fraction);
+        }
+        detail::sampleBatch(*sampler_, stagePositions(packet, count),
+                            util::span<DataVector>(k[to].data(), count));
+    };
+    stage(1, 0, 0.5);
+    stage(2, 1, 0.5);
+    stage(3, 2, 1.0);
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto l = active[i];
+        const auto &k1 = packet.vel[l];
+        const auto sum = k1 + k[1][i] + k[1][i] + k[2][i] + k[2][i] + k[3][i];
+        const auto K = normalizeSamples_ ? normalize(sum) : sum * (1.0 / 6.0);
+        packet.next[l] = move(packet.pos[l], K, packet.stepSize[l]);
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+void IntegralLinePacketTracer<SpatialSampler, TimeDependent>::stepRK45(Packet &packet,
+                                                                       size_t count) const {
+    // Dormand-Prince coefficients, the last stage is the fifth order solution
+    static constexpr std::array<double, 7> c{0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0,
+                                             1.0, 1.0};
+    static constexpr std::array<std::array<double, 6>, 7> a{{
+        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {1.0 / 5.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0, 0.0},
+        {44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0, 0.0},
+        {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0.0, 0.0},
+        {9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0, 0.0},
+        {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0},
+    }};
+    // Difference between the fifth and fourth order solutions
+    static constexpr std::array<double, 7> e{
+        71.0 / 57600.0,  0.0, -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0,
+        22.0 / 525.0, -1.0 / 40.0};
+
+    const auto &active = packet.active;
+    auto &k = packet.k;
+    const auto sampleValue = [&](const DataVector &v) {
+        return normalizeSamples_ ? normalize(v) : v;
+    };
+
+    for (size_t i = 0; i < count; ++i) k[0][i] = sampleValue(packet.vel[active[i]]);
+
+    for (size_t s = 1; s < 7; ++s) {
+        for (size_t i = 0; i < count; ++i) {
+            const auto l = active[i];
+            DataVector v{0.0};
+            for (size_t j = 0; j < s; ++j) v += a[s][j] * k[j][i];
+            const auto h = packet.stepSize[l];
+            if constexpr (TimeDependent) {
+                packet.stagePos[i] = packet.pos[l] + SpatialVector(invBasis_ * (v * h), c[s] * h);
+            } else {
+                packet.stagePos[i] = packet.pos[l] + invBasis_ * (v * h);
+            }
+        }
+        detail::sampleBatch(*sampler_, stagePositions(packet, count),
+                            util::span<DataVector>(k[s].data(), count));
+        if (s == 6) {
+            for (size_t i = 0; i < count; ++i) {
+                const auto l = active[i];
+                packet.next[l] = packet.stagePos[i];
+                packet.nextVel[l] = k[s][i];
+            }
+        }
+        for (size_t i = 0; i < count; ++i) k[s][i] = sampleValue(k[s][i]);
+    }
+
+    const double minStep = stepSize_ / adaptiveStepRange;
+    const double maxStep = stepSize_ * adaptiveStepRange;
+    for (size_t i = 0; i < count; ++i) {
+        const auto l = active[i];
+        const auto h = packet.stepSize[l];
+
+        DataVector v{0.0};
+        for (size_t j = 0; j < 7; ++j) v += e[j] * k[j][i];
+        const double error = glm::length(invBasis_ * (v * h));
+
+        packet.accepted[i] = error <= tolerance_ || std::abs(h) <= minStep;
+
+        const double factor =
+            error == 0.0 ? 5.0 : glm::clamp(0.9 * std::pow(tolerance_ / error, 0.2), 0.2, 5.0);
+        packet.stepSize[l] = std::copysign(glm::clamp(std::abs(h) * factor, minStep, maxStep), h);
+    }
+}
+
+using StreamLine2DPacketTracer = IntegralLinePacketTracer<SpatialSampler<2, 2, double>>;
+using StreamLine3DPacketTracer = IntegralLinePacketTracer<SpatialSampler<3, 3, double>>;
+using PathLine3DPacketTracer = IntegralLinePacketTracer<Spatial4DSampler<3, double>>;
+
+}  // namespace inviwo
@@ -116,7 +116,13 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::IntegralLineTracer(
     , sampler_(sampler)
     , invBasis_(glm::inverse(DataMatrix(sampler->getModelMatrix())))
     , seedTransformation_(
-          properties.getSeedPointTransformationMatrix(sampler->getCoordinateTransformer())) {}
+          properties.getSeedPointTransformationMatrix(sampler->getCoordinateTransformer())) {
+    if (integrationScheme_ == IntegralLineProperties::IntegrationScheme::RK45) {
+        LogWarnCustom("IntegralLineTracer",
+                      "The adaptive RK45 scheme is only supported by IntegralLinePacketTracer, "
+                      "using RK4 instead");
+    }
+}
 
 template <typename SpatialSampler, bool TimeDependent>
 typename IntegralLineTracer<SpatialSampler, TimeDependent>::Result
@@ -223,6 +229,7 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::step(const SpatialVector &old
         case inviwo::IntegralLineProperties::IntegrationScheme::Euler:
             return {move(oldPos, k1, stepSize), k1};
         default:
+            // The adaptive RK45 scheme is only available in IntegralLinePacketTracer
             [[fallthrough]];
         case inviwo::IntegralLineProperties::IntegrationScheme::RK4: {
             const auto k2 = sampler_->sample(move(oldPos, k1, stepSize / 2));
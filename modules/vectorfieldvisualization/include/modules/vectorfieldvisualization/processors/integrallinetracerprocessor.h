@@ -40,9 +40,8 @@
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/util/utilities.h>
-#include <inviwo/core/util/foreach.h>
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
-#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <modules/vectorfieldvisualization/integrallinepackettracer.h>
 #include <modules/vectorfieldvisualization/ports/seedpointsport.h>
 
 namespace inviwo {
@@ -115,17 +114,9 @@ void IntegralLineTracerProcessor<Tracer>::process() {
         tracer.addMetaDataSampler(key, meta.second);
     }
 
-    std::mutex mutex;
     size_t startID = 0;
     for (const auto &seeds : seeds_) {
-        util::forEachParallel(*seeds, [&](const auto &p, size_t i) {
-            IntegralLine line = tracer.traceFrom(p);
-            auto size = line.getPositions().size();
-            if (size > 1) {
-                std::lock_guard<std::mutex> lock(mutex);
-                lines->push_back(std::move(line), startID + i);
-            }
-        });
+        tracer.addTo(tracer.traceFrom(*seeds), *lines, startID);
         startID += seeds->size();
     }
 
@@ -139,9 +130,9 @@ void IntegralLineTracerProcessor<Tracer>::process() {
     lines_.setData(lines);
 }
 
-using StreamLines2D = IntegralLineTracerProcessor<StreamLine2DTracer>;
-using StreamLines3D = IntegralLineTracerProcessor<StreamLine3DTracer>;
-using PathLines3D = IntegralLineTracerProcessor<PathLine3DTracer>;
+using StreamLines2D = IntegralLineTracerProcessor<StreamLine2DPacketTracer>;
+using StreamLines3D = IntegralLineTracerProcessor<StreamLine3DPacketTracer>;
+using PathLines3D = IntegralLineTracerProcessor<PathLine3DPacketTracer>;
 
 template <>
 struct ProcessorTraits<StreamLines2D> {
@@ -125,8 +125,8 @@ private:
 
     FloatVec4Property selectedColor_;
 
-    bool isFiltered(const IntegralLine& line, size_t idx) const;
-    bool isSelected(const IntegralLine& line, size_t idx) const;
+    bool isFiltered(const IntegralLineView& line, size_t idx) const;
+    bool isSelected(const IntegralLineView& line, size_t idx) const;
 
     void updateOptions();
 };
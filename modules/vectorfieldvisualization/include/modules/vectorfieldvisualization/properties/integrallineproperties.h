@@ -43,7 +43,7 @@ namespace inviwo {
 
 class IVW_MODULE_VECTORFIELDVISUALIZATION_API IntegralLineProperties : public CompositeProperty {
 public:
-    enum class IntegrationScheme { Euler, RK4 };
+    enum class IntegrationScheme { Euler, RK4, RK45 };
 
     enum class Direction { FWD = 1, BWD = 2, BOTH = 3 };
 
@@ -58,6 +58,10 @@ public:
 
     int getNumberOfSteps() const;
     float getStepSize() const;
+    /**
+     * Error tolerance per step of the adaptive RK45 scheme, in data space units
+     */
+    double getTolerance() const;
 
     IntegralLineProperties::Direction getStepDirection() const;
     IntegralLineProperties::IntegrationScheme getIntegrationScheme() const;
@@ -70,6 +74,7 @@ private:
 public:
     IntProperty numberOfSteps_;
     FloatProperty stepSize_;
+    DoubleProperty tolerance_;
     BoolProperty normalizeSamples_;
 
     TemplateOptionProperty<IntegralLineProperties::Direction> stepDirection_;
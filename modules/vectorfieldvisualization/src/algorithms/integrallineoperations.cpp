@@ -28,9 +28,87 @@
  *********************************************************************************/
 
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
+#include <inviwo/core/util/exception.h>
+
+#include <limits>
 
 namespace inviwo {
 namespace util {
+
+namespace {
+
+dvec3 toWorldPoint(const dmat4 &toWorld, const dvec3 &pos) {
+    dvec4 P = toWorld * dvec4(pos, 1);
+    return dvec3(P) / P.w;
+}
+
+// Curvature of the polyline through the world space positions, written to K.
+void calcCurvature(const std::vector<dvec3> &positions, double *K) {
+    const auto size = positions.size();
+    for (size_t i = 1; i + 1 < size; ++i) {
+        const auto t1 = positions[i - 1] - positions[i];
+        const auto t2 = positions[i] - positions[i + 1];
+
+        auto l1 = glm::length(t1);
+        auto l2 = glm::length(t2);
+        if (l1 == 0 || l2 == 0) {
+            K[i] = 0;
+            LogWarnCustom("util::curvature", "Got zero offset");
+            continue;
+        }
+        const auto nt1 = t1 / l1;  // normalize t1
+        const auto nt2 = t2 / l2;  // normalize t2
+        const auto dot = glm::dot(nt1, nt2);
+        const auto cdot = dot < -1.0 ? -1.0 : (dot > 1.0 ? 1.0 : dot);
+        const auto angle = std::acos(cdot);
+
+        const double meanL = 0.5 * (l1 + l2);
+        K[i] = angle / meanL;
+    }
+    K[size - 1] = size > 2 ? K[size - 2] : 0.0;  // last, copy second to last
+    K[0] = K[1];                                  // first, copy second
+}
+
+// Tortuosity of the polyline through the world space positions, written to K.
+void calcTortuosity(const std::vector<dvec3> &positions, double *K) {
+    auto div = [](auto a, auto b) {
+        if (b == 0) return 1.0;
+        return a / b;
+    };
+
+    double acuDist = 0;
+    const dvec3 start = positions.front();
+    dvec3 prev = start;
+    for (const auto &p : positions) {
+        acuDist += glm::distance(prev, p);
+        prev = p;
+        *K++ = div(acuDist, glm::distance(start, p));
+    }
+}
+
+// Compute a per point measure for all lines in the set into a new meta data channel called name.
+// Lines with less than two points get zeros.
+template <typename Calc>
+void addLineMeasure(IntegralLineSet &lines, const std::string &name, Calc calc) {
+    if (lines.hasMetaData(name)) return;
+    const dmat4 toWorld(lines.getModelMatrix());
+    auto &K = lines.getEditableMetaData<double>(name, true);
+    const auto &positions = lines.getPositions();
+    const auto &offsets = lines.getOffsets();
+
+    std::vector<dvec3> world;
+    for (size_t i = 0; i < lines.size(); ++i) {
+        if (offsets[i + 1] - offsets[i] <= 1) continue;
+        world.clear();
+        std::transform(positions.begin() + offsets[i], positions.begin() + offsets[i + 1],
+                       std::back_inserter(world),
+                       [&](const dvec3 &pos) { return toWorldPoint(toWorld, pos); });
+        calc(world, K.data() + offsets[i]);
+    }
+}
+
+}  // namespace
+
 IntegralLine curvature(const IntegralLine &line, dmat4 toWorld) {
     IntegralLine copy(line);
     curvature(copy, toWorld);
@@ -47,57 +125,14 @@ void curvature(IntegralLine &line, dmat4 toWorld) {
     if (line.getPositions().size() <= 1) return;
     auto positions = line.getPositions();  // note, this creates a copy, we modify it below
 
-    std::transform(positions.begin(), positions.end(), positions.begin(), [&](dvec3 pos) {
-        dvec4 P = toWorld * dvec4(pos, 1);
-        return dvec3(P) / P.w;
-    });
-
-    auto md = line.createMetaData<double>("curvature");
-    auto &K = md->getEditableRAMRepresentation()->getDataContainer();
-    const auto &V = line.getMetaData<dvec3>("velocity");
-
-    auto cur = positions.begin();
-    auto vel = V.begin();
-
-    for (; cur != positions.end() && vel != V.end(); ++cur, ++vel) {
-        if (cur == positions.begin()) {
-            // first
-            K.emplace_back(0);
-        } else if (cur == positions.end() - 1) {
-            // last, copy second to last
-            K.emplace_back(K.back());
-        } else {
-            const auto p = *cur;
-            const auto pm = *(cur - 1);
-            const auto pp = *(cur + 1);
-
-            const auto t1 = pm - p;
-            const auto t2 = p - pp;
-
-            auto l1 = glm::length(t1);
-            auto l2 = glm::length(t2);
-            if (l1 == 0 || l2 == 0) {
-                K.emplace_back(0);
-                LogWarnCustom("util::curvature", "Got zero offset");
-                continue;
-            }
-            const auto nt1 = t1 / l1;  // normalize t1
-            const auto nt2 = t2 / l2;  // normalize t2
-            const auto dot = glm::dot(nt1, nt2);
-            const auto cdot = dot < -1.0 ? -1.0 : (dot > 1.0 ? 1.0 : dot);
-            const auto angle = std::acos(cdot);
-
-            const double meanL = 0.5 * (l1 + l2);
-            K.emplace_back(angle / meanL);
-        }
-    }
-    K[0] = K[1];  // Copy second to first
-}
-void curvature(IntegralLineSet &lines) {
-    for (auto &line : lines) {
-        curvature(line, dmat4(lines.getModelMatrix()));
-    }
+    std::transform(positions.begin(), positions.end(), positions.begin(),
+                   [&](const dvec3 &pos) { return toWorldPoint(toWorld, pos); });
+
+    auto &K = line.getMetaData<double>("curvature", true);
+    K.resize(positions.size());
+    calcCurvature(positions, K.data());
 }
+void curvature(IntegralLineSet &lines) { addLineMeasure(lines, "curvature", calcCurvature); }
 
 IntegralLine tortuosity(const IntegralLine &line, dmat4 toWorld) {
     IntegralLine copy(line);
@@ -114,36 +149,55 @@ void tortuosity(IntegralLine &line, dmat4 toWorld) {
     if (line.hasMetaData("tortuosity")) return;
     auto positions = line.getPositions();  // note, this creates a copy, we modify it below
     if (positions.size() <= 1) return;
-    float dt = static_cast<float>(positions.size() - 1);
-    dt = 1 / dt;
 
-    std::transform(positions.begin(), positions.end(), positions.begin(), [&](dvec3 pos) {
-        dvec4 P = toWorld * dvec4(pos, 1);
-        return dvec3(P) / P.w;
-    });
-
-    auto md = line.createMetaData<double>("tortuosity");
-    auto &K = md->getEditableRAMRepresentation()->getDataContainer();
-    double acuDist = 0;
+    std::transform(positions.begin(), positions.end(), positions.begin(),
+                   [&](const dvec3 &pos) { return toWorldPoint(toWorld, pos); });
 
-    dvec3 start = positions.front();
-    dvec3 prev = start;
+    auto &K = line.getMetaData<double>("tortuosity", true);
+    K.resize(positions.size());
+    calcTortuosity(positions, K.data());
+}
+void tortuosity(IntegralLineSet &lines) { addLineMeasure(lines, "tortuosity", calcTortuosity); }
 
-    for (auto &p : positions) {
-        auto div = [](auto a, auto b) {
-            if (b == 0) return 1.0;
-            return a / b;
-        };
+std::shared_ptr<const Mesh> toMesh(const IntegralLineSet &lines) {
+    if (lines.getNumberOfPoints() > std::numeric_limits<std::uint32_t>::max()) {
+        throw Exception("Too many points in integral line set to index them in a mesh",
+                        IVW_CONTEXT_CUSTOM("util::toMesh"));
+    }
 
-        acuDist += glm::distance(prev, p);
-        prev = p;
-        K.emplace_back(div(acuDist, glm::distance(start, p)));
+    auto mesh = std::make_shared<Mesh>();
+    mesh->setModelMatrix(lines.getModelMatrix());
+    mesh->setWorldMatrix(lines.getWorldMatrix());
+
+    // The buffers share the arrays of the set, they are only read since the mesh is const
+    mesh->addBuffer(BufferType::PositionAttrib,
+                    std::const_pointer_cast<Buffer<dvec3>>(lines.getPositionBuffer()));
+    int location = static_cast<int>(BufferType::NumberOfBufferTypes);
+    for (const auto &key : lines.getMetaDataKeys()) {
+        mesh->addBuffer(Mesh::BufferInfo(BufferType::ScalarMetaAttrib, location++),
+                        std::const_pointer_cast<BufferBase>(lines.getMetaDataBuffer(key)));
     }
-}
-void tortuosity(IntegralLineSet &lines) {
-    for (auto &line : lines) {
-        tortuosity(line, dmat4(lines.getModelMatrix()));
+
+    const auto &offsets = lines.getOffsets();
+    std::vector<std::uint32_t> indices;
+    indices.reserve(4 * lines.getNumberOfPoints());
+    for (size_t i = 0; i < lines.size(); ++i) {
+        const auto first = static_cast<std::uint32_t>(offsets[i]);
+        const auto last = static_cast<std::uint32_t>(offsets[i + 1]);
+        if (last - first < 2) continue;
+        // One segment with adjacency per pair of consecutive points, the end points are repeated
+        // as their own neighbors.
+        for (auto p = first; p + 1 < last; ++p) {
+            indices.push_back(p == first ? p : p - 1);
+            indices.push_back(p);
+            indices.push_back(p + 1);
+            indices.push_back(p + 2 == last ? p + 1 : p + 2);
+        }
     }
+    mesh->addIndices(Mesh::MeshInfo(DrawType::Lines, ConnectivityType::Adjacency),
+                     util::makeIndexBuffer(std::move(indices)));
+
+    return mesh;
 }
 
 }  // namespace util
@@ -85,15 +85,7 @@ std::vector<std::string> IntegralLine::getMetaDataKeys() const {
 
 double IntegralLine::getLength() const {
     if (length_ == -1) {
-        length_ = 0;
-        if (positions_.size() > 1) {
-            auto next = positions_.begin();
-            auto prev = next++;
-            while (next != positions_.end()) {
-                length_ += glm::distance(*prev, *next);
-                prev = next++;
-            }
-        }
+        length_ = detail::lineLength(positions_.begin(), positions_.end());
     }
     return length_;
 }
@@ -101,28 +93,11 @@ double IntegralLine::getLength() const {
 double IntegralLine::distBetweenPoints(size_t a, size_t b) const {
     if (a == b) return 0;
     if (a > b) return distBetweenPoints(b, a);
-    return calcLength(positions_.begin() + a, positions_.begin() + b + 1);
+    return detail::lineLength(positions_.begin() + a, positions_.begin() + b + 1);
 }
 
 dvec3 IntegralLine::getPointAtDistance(double d) const {
-    if (d < 0 || d > getLength()) {
-        return dvec3(0);
-    }
-    if (d == 0) {
-        return positions_.front();
-    }
-
-    double distPrev = 0, distNext = 0;
-    auto next = positions_.begin();
-    auto prev = next;
-    while (distNext < d) {
-        prev = next++;
-        distPrev = distNext;
-        distNext += glm::distance(*prev, *next);
-    }
-
-    double x = (d - distPrev) / (distNext - distPrev);
-    return Interpolation<dvec3, double>::linear(*prev, *next, x);
+    return detail::pointAtDistance(positions_, getLength(), d);
 }
 
 size_t IntegralLine::getIndex() const { return idx_; }
@@ -138,25 +113,11 @@ void IntegralLine::setForwardTerminationReason(TerminationReason terminationReas
 }
 
 IntegralLine::TerminationReason IntegralLine::getBackwardTerminationReason() const {
-    return forwardTerminationReason_;
-}
-
-IntegralLine::TerminationReason IntegralLine::getForwardTerminationReason() const {
     return backwardTerminationReason_;
 }
 
-double IntegralLine::calcLength(std::vector<dvec3>::const_iterator start,
-                                std::vector<dvec3>::const_iterator end) const {
-    auto length = 0.0;
-    if (positions_.size() > 1) {
-        auto next = start;
-        auto prev = next++;
-        while (next != end) {
-            length += glm::distance(*prev, *next);
-            prev = next++;
-        }
-    }
-    return length;
+IntegralLine::TerminationReason IntegralLine::getForwardTerminationReason() const {
+    return forwardTerminationReason_;
 }
 
 }  // namespace inviwo
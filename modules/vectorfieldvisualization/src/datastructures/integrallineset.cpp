@@ -31,56 +31,320 @@
 
 namespace inviwo {
 
+namespace {
+
+/**
+ * Make sure we are the only owner of ram before modifying it, the arrays are shared between
+ * copies of a set and with the buffers handed out by the set.
+ */
+template <typename Ram>
+void detach(std::shared_ptr<Ram>& ram) {
+    if (ram.use_count() > 1) {
+        ram = std::shared_ptr<Ram>(ram->clone());
+    }
+}
+
+}  // namespace
+
+IntegralLineView::IntegralLineView(const IntegralLineSet& set, size_t line)
+    : set_(&set), line_(line) {}
+
+size_t IntegralLineView::size() const {
+    const auto& offsets = set_->getOffsets();
+    return offsets[line_ + 1] - offsets[line_];
+}
+
+util::span<const dvec3> IntegralLineView::getPositions() const {
+    return util::span<const dvec3>(set_->getPositions()).subspan(getOffset(), size());
+}
+
+bool IntegralLineView::hasMetaData(const std::string& name) const {
+    return set_->hasMetaData(name);
+}
+
+std::vector<std::string> IntegralLineView::getMetaDataKeys() const {
+    return set_->getMetaDataKeys();
+}
+
+double IntegralLineView::getLength() const {
+    const auto positions = getPositions();
+    return detail::lineLength(positions.begin(), positions.end());
+}
+
+double IntegralLineView::distBetweenPoints(size_t a, size_t b) const {
+    if (a == b) return 0;
+    if (a > b) return distBetweenPoints(b, a);
+    const auto positions = getPositions();
+    return detail::lineLength(positions.begin() + a, positions.begin() + b + 1);
+}
+
+dvec3 IntegralLineView::getPointAtDistance(double d) const {
+    return detail::pointAtDistance(getPositions(), getLength(), d);
+}
+
+size_t IntegralLineView::getIndex() const { return set_->indices_[line_]; }
+
+IntegralLineView::TerminationReason IntegralLineView::getBackwardTerminationReason() const {
+    return set_->backwardTerminationReasons_[line_];
+}
+
+IntegralLineView::TerminationReason IntegralLineView::getForwardTerminationReason() const {
+    return set_->forwardTerminationReasons_[line_];
+}
+
+size_t IntegralLineView::getOffset() const { return set_->getOffsets()[line_]; }
+
+IntegralLine IntegralLineView::toIntegralLine() const {
+    IntegralLine line;
+    const auto positions = getPositions();
+    line.getPositions().assign(positions.begin(), positions.end());
+    for (const auto& item : set_->metaData_) {
+        const auto& name = item.first;
+        item.second->dispatch<void>([&](auto ram) {
+            using T = util::PrecisionValueType<decltype(ram)>;
+            const auto values = getMetaData<T>(name);
+            line.getMetaData<T>(name, true).assign(values.begin(), values.end());
+        });
+    }
+    line.setIndex(getIndex());
+    line.setBackwardTerminationReason(getBackwardTerminationReason());
+    line.setForwardTerminationReason(getForwardTerminationReason());
+    return line;
+}
+
 IntegralLineSet::IntegralLineSet(mat4 modelMatrix, mat4 worldMatrix)
-    : lines_(), modelMatrix_(modelMatrix), worldMatrix_(worldMatrix) {}
+    : modelMatrix_(modelMatrix)
+    , worldMatrix_(worldMatrix)
+    , offsets_{0}
+    , indices_()
+    , backwardTerminationReasons_()
+    , forwardTerminationReasons_()
+    , positions_(std::make_shared<BufferRAMPrecision<dvec3>>())
+    , metaData_() {}
 
-IntegralLineSet::~IntegralLineSet() {}
+IntegralLineSet::~IntegralLineSet() = default;
 
 mat4 IntegralLineSet::getModelMatrix() const { return modelMatrix_; }
 mat4 IntegralLineSet::getWorldMatrix() const { return worldMatrix_; }
 
-std::vector<IntegralLine>::const_iterator IntegralLineSet::begin() const { return lines_.begin(); }
+IntegralLineSet::const_iterator IntegralLineSet::begin() const {
+    return const_iterator(MakeView{this}, util::sequence<size_t>::iterator(0, size(), 1));
+}
 
-std::vector<IntegralLine>::iterator IntegralLineSet::begin() { return lines_.begin(); }
+IntegralLineSet::const_iterator IntegralLineSet::end() const {
+    return const_iterator(MakeView{this}, util::sequence<size_t>::iterator(size(), size(), 1));
+}
 
-std::vector<IntegralLine>::const_iterator IntegralLineSet::end() const { return lines_.end(); }
+IntegralLineView IntegralLineSet::front() const { return IntegralLineView(*this, 0); }
 
-std::vector<IntegralLine>::iterator IntegralLineSet::end() { return lines_.end(); }
+IntegralLineView IntegralLineSet::back() const { return IntegralLineView(*this, size() - 1); }
 
-size_t IntegralLineSet::size() const { return lines_.size(); }
+size_t IntegralLineSet::size() const { return indices_.size(); }
 
-IntegralLine& IntegralLineSet::operator[](size_t idx) { return lines_[idx]; }
+IntegralLineView IntegralLineSet::operator[](size_t idx) const {
+    return IntegralLineView(*this, idx);
+}
 
-const IntegralLine& IntegralLineSet::operator[](size_t idx) const { return lines_[idx]; }
+IntegralLineView IntegralLineSet::at(size_t idx) const {
+    if (idx >= size()) {
+        throw RangeException("Line index " + std::to_string(idx) + " out of range, set has " +
+                                 std::to_string(size()) + " lines",
+                             IVW_CONTEXT);
+    }
+    return IntegralLineView(*this, idx);
+}
 
-IntegralLine& IntegralLineSet::at(size_t idx) { return lines_.at(idx); }
+void IntegralLineSet::push_back(const IntegralLine& line, SetIndex updateIndex) {
+    push_back(line, updateIndex == SetIndex::Yes ? size() : line.getIndex());
+}
 
-const IntegralLine& IntegralLineSet::at(size_t idx) const { return lines_.at(idx); }
+void IntegralLineSet::push_back(const IntegralLine& line, size_t idx) {
+    // Validate everything before modifying the set, a failing push_back leaves the set untouched
+    const auto points = line.getPositions().size();
+    checkLine(points);
+    for (const auto& item : line.getMetaDataBuffers()) {
+        checkChannel(item.first, item.second->getDataFormat(), item.second->getSize(), points);
+    }
 
-void IntegralLineSet::push_back(const IntegralLine& line, SetIndex updateIndex) {
-    if (updateIndex == SetIndex::No) {
-        lines_.push_back(line);
+    for (const auto& item : line.getMetaDataBuffers()) {
+        const auto src = item.second->getRepresentation<BufferRAM>();
+        auto& dst = getEditableChannel(item.first, src->getDataFormat());
+        src->dispatch<void>([&](auto srcRam) {
+            using T = util::PrecisionValueType<decltype(srcRam)>;
+            const auto& values = srcRam->getDataContainer();
+            auto& data = static_cast<BufferRAMPrecision<T>&>(dst).getDataContainer();
+            data.insert(data.end(), values.begin(), values.end());
+        });
+    }
+    const auto& positions = line.getPositions();
+    auto& data = getEditablePositions();
+    data.insert(data.end(), positions.begin(), positions.end());
+    addLine(idx, line.getBackwardTerminationReason(), line.getForwardTerminationReason());
+}
+
+void IntegralLineSet::push_back(const IntegralLineView& line, SetIndex updateIndex) {
+    push_back(line, updateIndex == SetIndex::Yes ? size() : line.getIndex());
+}
+
+void IntegralLineSet::push_back(const IntegralLineView& line, size_t idx) {
+    if (line.set_ == this) {
+        // Appending a line of this set to itself would read from the arrays while they grow
+        push_back(line.toIntegralLine(), idx);
+        return;
+    }
+
+    const auto& set = *line.set_;
+    const auto begin = static_cast<std::ptrdiff_t>(line.getOffset());
+    const auto end = static_cast<std::ptrdiff_t>(line.getOffset() + line.size());
+
+    checkLine(line.size());
+    for (const auto& item : set.metaData_) {
+        checkChannel(item.first, item.second->getDataFormat(), line.size(), line.size());
+    }
+
+    for (const auto& item : set.metaData_) {
+        auto& dst = getEditableChannel(item.first, item.second->getDataFormat());
+        item.second->dispatch<void>([&](auto srcRam) {
+            using T = util::PrecisionValueType<decltype(srcRam)>;
+            const auto& values = srcRam->getDataContainer();
+            auto& data = static_cast<BufferRAMPrecision<T>&>(dst).getDataContainer();
+            data.insert(data.end(), values.begin() + begin, values.begin() + end);
+        });
+    }
+    const auto& positions = set.getPositions();
+    auto& data = getEditablePositions();
+    data.insert(data.end(), positions.begin() + begin, positions.begin() + end);
+    addLine(idx, line.getBackwardTerminationReason(), line.getForwardTerminationReason());
+}
+
+size_t IntegralLineSet::getNumberOfPoints() const { return offsets_.back(); }
+
+const std::vector<size_t>& IntegralLineSet::getOffsets() const { return offsets_; }
+
+const std::vector<dvec3>& IntegralLineSet::getPositions() const {
+    return positions_->getDataContainer();
+}
+
+bool IntegralLineSet::hasMetaData(const std::string& name) const {
+    return metaData_.find(name) != metaData_.end();
+}
+
+std::vector<std::string> IntegralLineSet::getMetaDataKeys() const {
+    std::vector<std::string> keys;
+    for (auto& m : metaData_) {
+        keys.push_back(m.first);
+    }
+    return keys;
+}
+
+const BufferRAM& IntegralLineSet::getMetaDataRAM(const std::string& name) const {
+    auto it = metaData_.find(name);
+    if (it == metaData_.end()) {
+        throw Exception("No meta data with name: " + name, IVW_CONTEXT);
+    }
+    return *it->second;
+}
+
+std::shared_ptr<const Buffer<dvec3>> IntegralLineSet::getPositionBuffer() const {
+    return std::make_shared<Buffer<dvec3>>(positions_);
+}
+
+std::shared_ptr<const BufferBase> IntegralLineSet::getMetaDataBuffer(
+    const std::string& name) const {
+    auto it = metaData_.find(name);
+    if (it == metaData_.end()) {
+        throw Exception("No meta data with name: " + name, IVW_CONTEXT);
+    }
+    const auto& ram = it->second;
+    return ram->dispatch<std::shared_ptr<const BufferBase>>([&](auto typed) {
+        using RamType = util::PrecisionType<decltype(typed)>;
+        using T = util::PrecisionValueType<decltype(typed)>;
+        return std::make_shared<Buffer<T>>(std::static_pointer_cast<RamType>(ram));
+    });
+}
+
+std::vector<dvec3>& IntegralLineSet::getEditablePositions() {
+    detach(positions_);
+    return positions_->getDataContainer();
+}
+
+void IntegralLineSet::addLine(size_t idx, TerminationReason backward, TerminationReason forward) {
+    const auto points = positions_->getSize();
+    for (auto& item : metaData_) {
+        const auto channelSize = item.second->getSize();
+        if (channelSize > points) {
+            throw Exception("Meta data " + item.first + " has " + std::to_string(channelSize) +
+                                " values but the set only has " + std::to_string(points) +
+                                " points",
+                            IVW_CONTEXT);
+        } else if (channelSize < points) {
+            detach(item.second);
+            item.second->setSize(points);
+        }
+    }
+    offsets_.push_back(points);
+    indices_.push_back(idx);
+    backwardTerminationReasons_.push_back(backward);
+    forwardTerminationReasons_.push_back(forward);
+}
+
+BufferRAM& IntegralLineSet::getEditableChannel(const std::string& name,
+                                               const DataFormatBase* format) {
+    auto it = metaData_.find(name);
+    if (it == metaData_.end()) {
+        auto ram = createBufferRAM(getNumberOfPoints(), format, BufferUsage::Static);
+        if (!ram) {
+            throw Exception("Unsupported dataformat for meta data " + name, IVW_CONTEXT);
+        }
+        it = metaData_.emplace(name, std::move(ram)).first;
     } else {
-        push_back(line, lines_.size());
+        checkFormat(name, *it->second, format);
     }
+    detach(it->second);
+    return *it->second;
 }
 
-void IntegralLineSet::push_back(const IntegralLine& line, size_t idx) {
-    IntegralLine copy(line);
-    copy.setIndex(idx);
-    lines_.push_back(std::move(copy));
+void IntegralLineSet::checkFormat(const std::string& name, const BufferRAM& ram,
+                                  const DataFormatBase* format) const {
+    if (ram.getDataFormat() != format) {
+        std::ostringstream oss;
+        oss << "Incorrect dataformat for meta data " << name << " asking for "
+            << format->getString() << " but is " << ram.getDataFormat()->getString();
+        throw Exception(oss.str(), IVW_CONTEXT);
+    }
 }
 
-void IntegralLineSet::push_back(IntegralLine&& line, SetIndex updateIndex) {
-    if (updateIndex == SetIndex::Yes) {
-        line.setIndex(lines_.size());
+void IntegralLineSet::checkLine(size_t points) const {
+    const auto total = positions_->getSize() + points;
+    for (const auto& item : metaData_) {
+        const auto channelSize = item.second->getSize();
+        if (channelSize > total) {
+            throw Exception("Meta data " + item.first + " has " + std::to_string(channelSize) +
+                                " values but the set would only have " + std::to_string(total) +
+                                " points",
+                            IVW_CONTEXT);
+        }
     }
-    lines_.push_back(line);
 }
 
-void IntegralLineSet::push_back(IntegralLine&& line, size_t idx) {
-    line.setIndex(idx);
-    lines_.push_back(line);
+void IntegralLineSet::checkChannel(const std::string& name, const DataFormatBase* format,
+                                   size_t values, size_t points) const {
+    if (values > points) {
+        throw Exception("Meta data " + name + " has " + std::to_string(values) +
+                            " values but the line only has " + std::to_string(points) + " points",
+                        IVW_CONTEXT);
+    }
+    auto it = metaData_.find(name);
+    if (it == metaData_.end()) return;
+
+    checkFormat(name, *it->second, format);
+    const auto channelSize = it->second->getSize() + values;
+    const auto total = positions_->getSize() + points;
+    if (channelSize > total) {
+        throw Exception("Meta data " + name + " would have " + std::to_string(channelSize) +
+                            " values but the set only has " + std::to_string(total) + " points",
+                        IVW_CONTEXT);
+    }
 }
 
 }  // namespace inviwo
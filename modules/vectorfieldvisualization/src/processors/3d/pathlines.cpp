@@ -34,7 +34,7 @@
 #include <inviwo/core/io/serialization/versionconverter.h>
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
 #include <inviwo/core/util/zip.h>
-#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <modules/vectorfieldvisualization/integrallinepackettracer.h>
 
 namespace inviwo {
 
@@ -136,7 +136,7 @@ void PathLinesDeprecated::process() {
         pathLineProperties_.getSeedPointTransformationMatrix(sampler->getCoordinateTransformer());
 
     float maxVelocity = 0;
-    PathLine3DTracer tracer(sampler, pathLineProperties_);
+    PathLine3DPacketTracer tracer(sampler, pathLineProperties_);
 
     bool hasColors = colors_.hasData();
 
@@ -146,23 +146,18 @@ void PathLinesDeprecated::process() {
     auto lines = std::make_shared<IntegralLineSet>(sampler->getModelMatrix());
     std::vector<BasicMesh::Vertex> vertices;
     size_t startID = 0;
+    std::vector<dvec4> transformed;
     for (const auto &seeds : seedPoints_) {
-#pragma omp parallel for
-        for (long long j = 0; j < static_cast<long long>(seeds->size()); j++) {
-            const auto &p = (*seeds)[j];
+        transformed.clear();
+        for (const auto &p : *seeds) {
             vec4 P = m * vec4(p, 1.0f);
-            IntegralLine line = tracer.traceFrom(vec4(vec3(P), pathLineProperties_.getStartT()));
-            auto size = line.getPositions().size();
-            if (size > 1) {
-#pragma omp critical
-                // lines->push_back(line, startID + j);
-                lines->push_back(line, lines->size());
-            };
+            transformed.emplace_back(vec4(vec3(P), pathLineProperties_.getStartT()));
         }
+        tracer.addTo(tracer.traceFrom(transformed), *lines, startID);
         startID += seeds->size();
     }
 
-    for (auto &line : *lines) {
+    for (const auto &line : *lines) {
         auto size = line.getPositions().size();
         if (size <= 1) continue;
 
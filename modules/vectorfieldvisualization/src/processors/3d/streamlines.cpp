@@ -38,11 +38,10 @@
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/imagesampler.h>
 #include <inviwo/core/util/volumesampler.h>
-#include <inviwo/core/util/foreach.h>
 
 #include <modules/vectorfieldvisualization/processors/integrallinetracerprocessor.h>
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
-#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <modules/vectorfieldvisualization/integrallinepackettracer.h>
 
 #include <bitset>
 
@@ -134,44 +133,23 @@ void StreamLinesDeprecated::process() {
 
     float maxVelocity = 0;
 
-    StreamLine3DTracer tracer(sampler, streamLineProperties_);
+    StreamLine3DPacketTracer tracer(sampler, streamLineProperties_);
     auto lines = std::make_shared<IntegralLineSet>(sampler->getModelMatrix());
 
     std::vector<BasicMesh::Vertex> vertices;
 
-    std::mutex mutex;
-
-    if (useMutliThreading_) {
-        size_t startID = 0;
-
-        for (const auto &seeds : seedPoints_) {
-            util::forEachParallel(*seeds, [&](const auto &p, size_t i) {
-                vec4 P = m * vec4(p, 1.0f);
-                IntegralLine line = tracer.traceFrom(vec3(P));
-                auto size = line.getPositions().size();
-                if (size > 1) {
-                    std::lock_guard<std::mutex> lock(mutex);
-                    lines->push_back(line, startID + i);
-                };
-            });
-            startID += seeds->size();
-        }
-    } else {
-        size_t startID = 0;
-        for (const auto &seeds : seedPoints_) {
-            for (const auto &p : *seeds.get()) {
-                vec4 P = m * vec4(p, 1.0f);
-                IntegralLine line = tracer.traceFrom(vec3(P));
-                auto size = line.getPositions().size();
-                if (size > 1) {
-                    lines->push_back(line, startID);
-                }
-                startID++;
-            }
+    size_t startID = 0;
+    std::vector<dvec3> transformed;
+    for (const auto &seeds : seedPoints_) {
+        transformed.clear();
+        for (const auto &p : *seeds) {
+            transformed.emplace_back(vec3(m * vec4(p, 1.0f)));
         }
+        tracer.addTo(tracer.traceFrom(transformed, useMutliThreading_ ? 0 : 1), *lines, startID);
+        startID += seeds->size();
     }
 
-    for (auto &line : *lines) {
+    for (const auto &line : *lines) {
         auto position = line.getPositions().begin();
         auto velocity = line.getMetaData<dvec3>("velocity").begin();
 
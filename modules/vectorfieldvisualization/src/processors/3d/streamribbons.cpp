@@ -34,7 +34,7 @@
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
 #include <inviwo/core/util/imagesampler.h>
 #include <inviwo/core/util/zip.h>
-#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <modules/vectorfieldvisualization/integrallinepackettracer.h>
 #include <inviwo/core/util/volumesampler.h>
 
 namespace inviwo {
@@ -123,7 +123,7 @@ void StreamRibbonsDeprecated::process() {
             return std::make_shared<VolumeDoubleSampler<3>>(volume_.getData());
     }();
 
-    auto vorticitySampler = [&]() -> std::shared_ptr<const StreamLine3DTracer::Sampler> {
+    auto vorticitySampler = [&]() -> std::shared_ptr<const StreamLine3DPacketTracer::Sampler> {
         if (vorticitySampler_.isConnected())
             return vorticitySampler_.getData();
         else
@@ -138,7 +138,7 @@ void StreamRibbonsDeprecated::process() {
         streamLineProperties_.getSeedPointTransformationMatrix(sampler->getCoordinateTransformer());
     double maxVelocity = 0;
     double maxVorticity = 0;
-    StreamLine3DTracer tracer(sampler, streamLineProperties_);
+    StreamLine3DPacketTracer tracer(sampler, streamLineProperties_);
     ImageSampler tf(tf_.get().getData());
     tracer.addMetaDataSampler("vorticity", vorticitySampler);
     //  mat3 invBasis = glm::inverse(vectorVolume_.getData()->getBasis());
@@ -148,16 +148,21 @@ void StreamRibbonsDeprecated::process() {
     bool hasColors = colors_.hasData();
     size_t lineId = 0;
 
+    std::vector<dvec3> transformed;
     for (const auto &seeds : seedPoints_) {
-        for (auto &p : (*seeds)) {
-            vec4 P = m * vec4(p, 1.0f);
-            IntegralLine line = tracer.traceFrom(vec3(P));
+        transformed.clear();
+        for (const auto &p : *seeds) {
+            transformed.emplace_back(vec3(m * vec4(p, 1.0f)));
+        }
+        const auto lines = tracer.traceFrom(transformed);
 
-            auto position = line.getPositions().begin();
-            auto velocity = line.getMetaData<dvec3>("velocity").begin();
-            auto vorticity = line.getMetaData<dvec3>("vorticity").begin();
+        for (size_t line = 0; line < lines.size(); ++line) {
+            const auto begin = lines.offsets[line];
+            auto position = lines.positions.begin() + begin;
+            auto velocity = lines.velocities.begin() + begin;
+            auto vorticity = lines.metaData[0].begin() + begin;
 
-            auto size = line.getPositions().size();
+            auto size = lines.size(line);
             if (size <= 1) continue;
             auto indexBuffer = mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::Strip);
             indexBuffer->getDataContainer().reserve(size);
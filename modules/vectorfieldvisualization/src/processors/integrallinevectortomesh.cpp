@@ -32,7 +32,6 @@
 #include <modules/vectorfieldvisualization/processors/3d/streamlines.h>
 #include <inviwo/core/datastructures/geometry/basicmesh.h>
 #include <inviwo/core/network/networklock.h>
-#include <inviwo/core/util/zip.h>
 #include <inviwo/core/util/raiiutils.h>
 
 namespace inviwo {
@@ -131,7 +130,7 @@ const ProcessorInfo IntegralLineVectorToMesh::processorInfo_{
     Tags::CPU,                              // Tags
 };
 
-bool IntegralLineVectorToMesh::isFiltered(const IntegralLine &line, size_t idx) const {
+bool IntegralLineVectorToMesh::isFiltered(const IntegralLineView &line, size_t idx) const {
     switch (brushBy_.get()) {
         case BrushBy::LineIndex:
             return brushingList_.isFiltered(line.getIndex());
@@ -143,7 +142,7 @@ bool IntegralLineVectorToMesh::isFiltered(const IntegralLine &line, size_t idx)
     }
 }
 
-bool IntegralLineVectorToMesh::isSelected(const IntegralLine &line, size_t idx) const {
+bool IntegralLineVectorToMesh::isSelected(const IntegralLineView &line, size_t idx) const {
     switch (brushBy_.get()) {
         case BrushBy::LineIndex:
             return brushingList_.isSelected(line.getIndex());
@@ -161,7 +160,7 @@ void IntegralLineVectorToMesh::updateOptions() {
 
     std::vector<OptionPropertyStringOption> options = {{"constant", "constant color"}};
 
-    for (const auto &key : lines->front().getMetaDataKeys()) {
+    for (const auto &key : lines->getMetaDataKeys()) {
         options.emplace_back(key, key);
 
         if (!getPropertyByIdentifier(key)) {
@@ -245,9 +244,9 @@ IntegralLineVectorToMesh::IntegralLineVectorToMesh()
             double maxT = std::numeric_limits<double>::lowest();
 
             size_t idx = 0;
-            for (auto &line : (*lines_.getData())) {
+            for (const auto &line : (*lines_.getData())) {
                 util::OnScopeExit incIdx([&idx]() { idx++; });
-                auto size = line.getPositions().size();
+                auto size = line.size();
                 if (size == 0) continue;
 
                 if (this->isFiltered(line, idx)) {
@@ -284,17 +283,23 @@ void IntegralLineVectorToMesh::process() {
         updateOptions();
     }
     auto mesh = std::make_shared<BasicMesh>();
-    if (lines_.getData()->size() == 0) {
+    const auto &lines = *lines_.getData();
+    if (lines.size() == 0) {
         mesh_.setData(mesh);
         return;
     }
 
-    mesh->setModelMatrix(lines_.getData()->getModelMatrix());
-    mesh->setWorldMatrix(lines_.getData()->getWorldMatrix());
+    mesh->setModelMatrix(lines.getModelMatrix());
+    mesh->setWorldMatrix(lines.getWorldMatrix());
+
+    Output output = output_.get();
 
     std::vector<BasicMesh::Vertex> vertices;
+    vertices.reserve(lines.getNumberOfPoints() * (output == Output::Ribbons ? 2 : 1));
 
-    vertices.reserve(lines_.getData()->size() * 2000);
+    // All lines go into one index buffer, as a list of segments with adjacency for lines and as a
+    // list of triangles for ribbons
+    std::vector<std::uint32_t> indices;
 
     auto metaDataKey = colorBy_.get();
 
@@ -325,131 +330,129 @@ void IntegralLineVectorToMesh::process() {
 
     bool colorWarningOnce = true;
 
-    Output output = output_.get();
-
-    size_t lineIdx = 0;
-    for (auto &line : (*lines_.getData())) {
-        util::OnScopeExit incIdx([&lineIdx]() { lineIdx++; });
-        auto size = line.getPositions().size();
-
-        if (size == 0 || isFiltered(line, lineIdx)) continue;
-
-        auto indexBuffer = [&]() -> std::shared_ptr<IndexBufferRAM> {
-            if (output == Output::Lines) {
-                auto ib = mesh->addIndexBuffer(DrawType::Lines, ConnectivityType::StripAdjacency);
-                ib->getDataContainer().reserve(size + 2);
-                return ib;
-            } else if (output == Output::Ribbons) {
-                auto ib = mesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::Strip);
-                ib->getDataContainer().reserve(size * 2);
-                return ib;
-            }
-            throw Exception("Unsupported output type", IVW_CONTEXT);
-        }();
+    auto coloring = [&, this](const auto &mdValue, bool selected, size_t lineIndex,
+                              size_t lineNumber) -> vec4 {
+        if (constantColor || selected) {
+            return selectedColor_.get();
+        }
 
-        auto coloring = [&, this](auto sample, size_t lineIndex, size_t lineNumber) -> vec4 {
-            if (constantColor || this->isSelected(line, lineIdx)) {
-                return selectedColor_.get();
+        if (colorByPort) {
+            auto colors = colors_.getData();
+            size_t index = 0;
+            if (colorByPortNumber) {
+                index = lineNumber;
+            } else if (colorByPortIndex) {
+                index = lineIndex;
             }
 
-            if (colorByPort) {
-                auto colors = colors_.getData();
-                size_t index = 0;
-                if (colorByPortNumber) {
-                    index = lineNumber;
-                } else if (colorByPortIndex) {
-                    index = lineIndex;
+            if (index >= colors->size()) {
+                if (colorWarningOnce) {
+                    colorWarningOnce = false;
+                    LogWarn("Line index for color is out of range");
                 }
+                index %= colors->size();
+            }
+            return colors->at(index);
+        } else {
+            double md = detail::norm(mdValue);
+            minMetaData = std::min(minMetaData, md);
+            maxMetaData = std::max(maxMetaData, md);
+
+            md -= mdProp->scaleBy_.get().x;
+            md /= mdProp->scaleBy_.get().y - mdProp->scaleBy_.get().x;
+            if (mdProp->loopTF_) {
+                md -= std::floor(md);
+            }
 
-                if (index >= colors->size()) {
-                    if (colorWarningOnce) {
-                        colorWarningOnce = false;
-                        LogWarn("Line index for color is out of range");
-                    }
-                    index %= colors->size();
-                }
-                return colors->at(index);
-            } else {
-                auto &mdValue = get<2>(sample);
-                double md = detail::norm(mdValue);
-                minMetaData = std::min(minMetaData, md);
-                maxMetaData = std::max(maxMetaData, md);
-
-                md -= mdProp->scaleBy_.get().x;
-                md /= mdProp->scaleBy_.get().y - mdProp->scaleBy_.get().x;
-                if (mdProp->loopTF_) {
-                    md -= std::floor(md);
-                }
+            return mdProp->tf_.get().sample(md);
+        }
+    };
 
-                return mdProp->tf_.get().sample(md);
-            }
-        };
-
-        auto lineLoop = [&coloring, &vertices, &indexBuffer, &lineIdx, this](
-                            const IntegralLine &line, auto mdContainter) {
-            size_t pointIdx = 0;
-            for (auto &&sample : util::zip(line.getPositions(), line.getMetaData<dvec3>("velocity"),
-                                           mdContainter)) {
-                util::OnScopeExit incPointIdx([&pointIdx]() { pointIdx++; });
+    const auto &offsets = lines.getOffsets();
+    const auto &positions = lines.getPositions();
+    const auto &velocities = lines.getMetaData<dvec3>("velocity");
+    const auto *vorticities =
+        output == Output::Ribbons ? &lines.getMetaData<dvec3>("vorticity") : nullptr;
+
+    // metaData(i) gives the value used for coloring of point i in the set
+    auto addLines = [&](auto metaData) {
+        std::vector<std::uint32_t> strip;
+        for (size_t lineIdx = 0; lineIdx < lines.size(); ++lineIdx) {
+            const auto line = lines[lineIdx];
+            const auto begin = offsets[lineIdx];
+            const auto size = offsets[lineIdx + 1] - begin;
+
+            if (size == 0 || isFiltered(line, lineIdx)) continue;
+            const bool selected = isSelected(line, lineIdx);
+
+            strip.clear();
+            for (size_t pointIdx = 0; pointIdx < size; ++pointIdx) {
                 bool first = pointIdx <= 1;
-                bool last = pointIdx >= line.getPositions().size() - 2;
+                bool last = pointIdx + 2 >= size;
                 // need to keep the two first and two last when using adjendency information
-                if (!first && !last && pointIdx % stride_.get() != 0) {
+                if (output == Output::Lines && !first && !last &&
+                    pointIdx % stride_.get() != 0) {
                     continue;
                 }
 
-                vec3 pos = get<0>(sample);
-                vec3 vel = get<1>(sample);
+                const auto i = begin + pointIdx;
+                vec3 pos = positions[i];
+                vec3 vel = velocities[i];
+                vec4 color = coloring(metaData(i), selected, line.getIndex(), lineIdx);
 
-                vec4 color = coloring(sample, line.getIndex(), lineIdx);
-
-                indexBuffer->add(static_cast<std::uint32_t>(vertices.size()));
-                vertices.push_back({pos, glm::normalize(vel), pos, color});
-            }
-        };
-
-        auto ribbonLoop = [&coloring, &vertices, &indexBuffer, &lineIdx, this](
-                              const IntegralLine &line, auto mdContainter) {
-            for (auto &&sample : util::zip(line.getPositions(), line.getMetaData<dvec3>("velocity"),
-                                           mdContainter, line.getMetaData<dvec3>("vorticity"))) {
-                vec3 pos = get<0>(sample);
-                vec3 vel = get<1>(sample);
-                vec3 vor = get<3>(sample);
-
-                vec4 color = coloring(sample, line.getIndex(), lineIdx);
-
-                auto N = glm::normalize(glm::cross(vor, vel));
-
-                auto off = glm::normalize(vor) * (ribbonWidth_.get() / 2.0f);
-                auto pos1 = pos - off;
-                auto pos2 = pos + off;
-                indexBuffer->add(static_cast<std::uint32_t>(vertices.size()));
-                vertices.push_back({pos1, N, pos1, color});
-                indexBuffer->add(static_cast<std::uint32_t>(vertices.size()));
-                vertices.push_back({pos2, N, pos2, color});
+                if (output == Output::Lines) {
+                    strip.push_back(static_cast<std::uint32_t>(vertices.size()));
+                    vertices.push_back({pos, glm::normalize(vel), pos, color});
+                } else {
+                    vec3 vor = (*vorticities)[i];
+                    auto N = glm::normalize(glm::cross(vor, vel));
+
+                    auto off = glm::normalize(vor) * (ribbonWidth_.get() / 2.0f);
+                    auto pos1 = pos - off;
+                    auto pos2 = pos + off;
+                    strip.push_back(static_cast<std::uint32_t>(vertices.size()));
+                    vertices.push_back({pos1, N, pos1, color});
+                    strip.push_back(static_cast<std::uint32_t>(vertices.size()));
+                    vertices.push_back({pos2, N, pos2, color});
+                }
             }
-        };
-
-        if (mdProp) {
-            line.getMetaDataBuffer(metaDataKey)
-                ->getRepresentation<BufferRAM>()
-                ->dispatch<void>([&](auto mdBuf) {
-                    if (output == Output::Lines)
-                        lineLoop(line, mdBuf->getDataContainer());
-                    else {
-                        ribbonLoop(line, mdBuf->getDataContainer());
+
+            if (output == Output::Lines) {
+                // line strip with adjacency to segments with adjacency
+                for (size_t j = 1; j + 2 < strip.size(); ++j) {
+                    indices.insert(indices.end(), {strip[j - 1], strip[j], strip[j + 1],
+                                                   strip[j + 2]});
+                }
+            } else {
+                // triangle strip to triangles, keeping the winding of the strip
+                for (size_t j = 2; j < strip.size(); ++j) {
+                    if (j % 2 == 0) {
+                        indices.insert(indices.end(), {strip[j - 2], strip[j - 1], strip[j]});
+                    } else {
+                        indices.insert(indices.end(), {strip[j - 1], strip[j - 2], strip[j]});
                     }
-                });
-        } else {
-            if (output == Output::Lines)
-                lineLoop(line, std::vector<int>(line.getPositions().size()));
-            else {
-                ribbonLoop(line, std::vector<int>(line.getPositions().size()));
+                }
             }
         }
+    };
+
+    if (mdProp) {
+        lines.getMetaDataRAM(metaDataKey).dispatch<void>([&](auto mdBuf) {
+            const auto &data = mdBuf->getDataContainer();
+            addLines([&data](size_t i) { return data[i]; });
+        });
+    } else {
+        addLines([](size_t) { return 0; });
     }
 
     mesh->addVertices(vertices);
+    if (output == Output::Lines) {
+        mesh->addIndices(Mesh::MeshInfo(DrawType::Lines, ConnectivityType::Adjacency),
+                         util::makeIndexBuffer(std::move(indices)));
+    } else {
+        mesh->addIndices(Mesh::MeshInfo(DrawType::Triangles, ConnectivityType::None),
+                         util::makeIndexBuffer(std::move(indices)));
+    }
 
     mesh_.setData(mesh);
     if (mdProp) {
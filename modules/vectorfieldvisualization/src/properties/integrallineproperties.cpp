@@ -35,6 +35,7 @@ IntegralLineProperties::IntegralLineProperties(std::string identifier, std::stri
     : CompositeProperty(identifier, displayName)
     , numberOfSteps_("steps", "Number of Steps", 100, 1, 1000)
     , stepSize_("stepSize", "Step size", 0.001f, 0.001f, 1.0f, 0.001f)
+    , tolerance_("tolerance", "Error Tolerance", 1e-5, 1e-10, 1e-2, 1e-6)
     , normalizeSamples_("normalizeSamples", "Normalize Samples", true)
     , stepDirection_("stepDirection", "Step Direction")
     , integrationScheme_("integrationScheme", "Integration Scheme")
@@ -46,6 +47,7 @@ IntegralLineProperties::IntegralLineProperties(const IntegralLineProperties& rhs
     : CompositeProperty(rhs)
     , numberOfSteps_(rhs.numberOfSteps_)
     , stepSize_(rhs.stepSize_)
+    , tolerance_(rhs.tolerance_)
     , normalizeSamples_(rhs.normalizeSamples_)
     , stepDirection_(rhs.stepDirection_)
     , integrationScheme_(rhs.integrationScheme_)
@@ -63,6 +65,8 @@ int IntegralLineProperties::getNumberOfSteps() const { return numberOfSteps_.get
 
 float IntegralLineProperties::getStepSize() const { return stepSize_.get(); }
 
+double IntegralLineProperties::getTolerance() const { return tolerance_.get(); }
+
 IntegralLineProperties::Direction IntegralLineProperties::getStepDirection() const {
     return stepDirection_.get();
 }
@@ -86,6 +90,8 @@ void IntegralLineProperties::setUpProperties() {
                                  IntegralLineProperties::IntegrationScheme::Euler);
     integrationScheme_.addOption("rk4", "Runge-Kutta (RK4)",
                                  IntegralLineProperties::IntegrationScheme::RK4);
+    integrationScheme_.addOption("rk45", "Adaptive Runge-Kutta (RK45)",
+                                 IntegralLineProperties::IntegrationScheme::RK45);
     integrationScheme_.setSelectedValue(IntegralLineProperties::IntegrationScheme::RK4);
 
     seedPointsSpace_.addOption("data", "Data", CoordinateSpace::Data);
@@ -96,9 +102,14 @@ void IntegralLineProperties::setUpProperties() {
     addProperty(stepSize_);
     addProperty(stepDirection_);
     addProperty(integrationScheme_);
+    addProperty(tolerance_);
     addProperty(seedPointsSpace_);
     addProperty(normalizeSamples_);
 
+    tolerance_.visibilityDependsOn(integrationScheme_, [](const auto& p) {
+        return p.get() == IntegralLineProperties::IntegrationScheme::RK45;
+    });
+
     setAllPropertiesCurrentStateAsDefault();
 }
 
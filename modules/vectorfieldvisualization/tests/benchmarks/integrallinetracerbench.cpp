@@ -0,0 +1,174 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumesampler.h>
+#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <modules/vectorfieldvisualization/integrallinepackettracer.h>
+#include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+constexpr int steps = 50;
+
+/**
+ * A 64^3 float volume with a helix, a rotation around the z axis with a constant upward flow
+ */
+std::shared_ptr<const StreamLine3DPacketTracer::Sampler> makeSampler() {
+    const size3_t dims{64};
+    auto ram = std::make_shared<VolumeRAMPrecision<vec3>>(dims);
+    auto data = ram->getDataTyped();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                const vec3 p = (vec3{x, y, z} + 0.5f) / vec3{dims};
+                data[x + dims.x * (y + dims.y * z)] = vec3{-(p.y - 0.5f), p.x - 0.5f, 0.1f};
+            }
+        }
+    }
+    auto volume = std::make_shared<Volume>(ram);
+    return std::make_shared<VolumeDoubleSampler<3>>(volume);
+}
+
+std::vector<dvec3> makeSeeds(size_t count) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.05, 0.95);
+    std::vector<dvec3> seeds(count);
+    for (auto& seed : seeds) seed = dvec3{dist(gen), dist(gen), dist(gen)};
+    return seeds;
+}
+
+IntegralLineProperties makeProperties(IntegralLineProperties::IntegrationScheme scheme) {
+    IntegralLineProperties properties("properties", "Properties");
+    properties.numberOfSteps_.set(steps);
+    properties.stepSize_.set(0.01f);
+    properties.integrationScheme_.setSelectedValue(scheme);
+    return properties;
+}
+
+void setCounters(benchmark::State& state, size_t points) {
+    const auto seeds = static_cast<double>(state.range(0));
+    state.counters["Seeds"] = seeds;
+    state.counters["Points"] = static_cast<double>(points);
+    state.counters["Rate"] = benchmark::Counter(seeds * static_cast<double>(state.iterations()),
+                                                benchmark::Counter::kIsRate);
+}
+
+/**
+ * The previous way of tracing, one IntegralLine per seed with IntegralLineTracer
+ */
+void scalar(benchmark::State& state) {
+    const auto sampler = makeSampler();
+    const auto seeds = makeSeeds(static_cast<size_t>(state.range(0)));
+    const auto properties = makeProperties(IntegralLineProperties::IntegrationScheme::RK4);
+    StreamLine3DTracer tracer(sampler, properties);
+
+    size_t points = 0;
+    for (auto _ : state) {
+        points = 0;
+        for (const auto& seed : seeds) points += tracer.traceFrom(seed).line.getPositions().size();
+        benchmark::DoNotOptimize(points);
+    }
+    setCounters(state, points);
+}
+
+template <IntegralLineProperties::IntegrationScheme Scheme>
+void packet(benchmark::State& state) {
+    const auto sampler = makeSampler();
+    const auto seeds = makeSeeds(static_cast<size_t>(state.range(0)));
+    const auto properties = makeProperties(Scheme);
+    StreamLine3DPacketTracer tracer(sampler, properties);
+
+    size_t points = 0;
+    for (auto _ : state) {
+        const auto lines = tracer.traceFrom(seeds);
+        points = lines.positions.size();
+        benchmark::DoNotOptimize(lines.positions.data());
+    }
+    setCounters(state, points);
+}
+
+/**
+ * Tracing and emitting the lines into an IntegralLineSet
+ */
+void packetToSet(benchmark::State& state) {
+    const auto sampler = makeSampler();
+    const auto seeds = makeSeeds(static_cast<size_t>(state.range(0)));
+    const auto properties = makeProperties(IntegralLineProperties::IntegrationScheme::RK4);
+    StreamLine3DPacketTracer tracer(sampler, properties);
+
+    size_t points = 0;
+    for (auto _ : state) {
+        IntegralLineSet set(sampler->getModelMatrix());
+        tracer.addTo(tracer.traceFrom(seeds), set, 0);
+        points = set.getNumberOfPoints();
+        benchmark::DoNotOptimize(set.getPositions().data());
+    }
+    setCounters(state, points);
+}
+
+}  // namespace
+
+BENCHMARK(scalar)
+    ->RangeMultiplier(8)
+    ->Range(1 << 12, 1 << 18)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(packet, IntegralLineProperties::IntegrationScheme::Euler)
+    ->RangeMultiplier(8)
+    ->Range(1 << 12, 1 << 21)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(packet, IntegralLineProperties::IntegrationScheme::RK4)
+    ->RangeMultiplier(8)
+    ->Range(1 << 12, 1 << 21)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(packet, IntegralLineProperties::IntegrationScheme::RK45)
+    ->RangeMultiplier(8)
+    ->Range(1 << 12, 1 << 21)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(packetToSet)
+    ->RangeMultiplier(8)
+    ->Range(1 << 12, 1 << 21)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+#include <warn/pop>
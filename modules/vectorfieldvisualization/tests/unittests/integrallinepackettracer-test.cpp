@@ -0,0 +1,241 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <modules/vectorfieldvisualization/integrallinepackettracer.h>
+#include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+
+#include <cmath>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+class UnitCube : public SpatialEntity<3> {
+public:
+    virtual UnitCube* clone() const override { return new UnitCube(*this); }
+};
+
+/**
+ * Rotation with angular speed 1 around the line x = y = 0.5 of the unit cube
+ */
+class RotationSampler : public SpatialSampler<3, 3, double> {
+public:
+    RotationSampler(const SpatialEntity<3>& entity) : SpatialSampler<3, 3, double>(entity) {}
+
+protected:
+    virtual dvec3 sampleDataSpace(const dvec3& pos) const override {
+        return dvec3{-(pos.y - 0.5), pos.x - 0.5, 0.0};
+    }
+    virtual bool withinBoundsDataSpace(const dvec3& pos) const override {
+        return glm::all(glm::greaterThanEqual(pos, dvec3{0.0})) &&
+               glm::all(glm::lessThanEqual(pos, dvec3{1.0}));
+    }
+};
+
+const UnitCube& unitCube() {
+    static const UnitCube cube;
+    return cube;
+}
+
+/**
+ * Seeds at several radii around the axis, including one on the axis with zero velocity and some
+ * close to the boundary. More than one packet, with the last one partially filled.
+ */
+std::vector<dvec3> seeds() {
+    std::vector<dvec3> seeds{dvec3{0.5, 0.5, 0.5}};
+    for (size_t i = 0; i < 150; ++i) {
+        const double r = 0.02 + 0.47 * static_cast<double>(i % 10) / 9.0;
+        const double angle = 0.37 * static_cast<double>(i);
+        seeds.emplace_back(0.5 + r * std::cos(angle), 0.5 + r * std::sin(angle),
+                           static_cast<double>(i) / 150.0);
+    }
+    return seeds;
+}
+
+void setProperties(IntegralLineProperties& properties,
+                   IntegralLineProperties::IntegrationScheme scheme,
+                   IntegralLineProperties::Direction direction, bool normalize) {
+    properties.numberOfSteps_.set(200);
+    properties.stepSize_.set(0.05f);
+    properties.integrationScheme_.setSelectedValue(scheme);
+    properties.stepDirection_.setSelectedValue(direction);
+    properties.normalizeSamples_.set(normalize);
+}
+
+void compareWithIntegralLineTracer(IntegralLineProperties::IntegrationScheme scheme) {
+    auto sampler = std::make_shared<RotationSampler>(unitCube());
+    auto vorticity = std::make_shared<RotationSampler>(unitCube());
+    const auto points = seeds();
+
+    for (auto direction :
+         {IntegralLineProperties::Direction::FWD, IntegralLineProperties::Direction::BWD,
+          IntegralLineProperties::Direction::BOTH}) {
+        for (bool normalize : {true, false}) {
+            IntegralLineProperties properties("properties", "Properties");
+            setProperties(properties, scheme, direction, normalize);
+
+            StreamLine3DTracer tracer(sampler, properties);
+            tracer.addMetaDataSampler("vorticity", vorticity);
+            StreamLine3DPacketTracer packetTracer(sampler, properties);
+            packetTracer.addMetaDataSampler("vorticity", vorticity);
+
+            const auto lines = packetTracer.traceFrom(points, 1);
+            ASSERT_EQ(points.size(), lines.size());
+            EXPECT_EQ(0, lines.size(0)) << "zero velocity at the seed gives an empty line";
+
+            for (size_t i = 0; i < points.size(); ++i) {
+                const auto res = tracer.traceFrom(points[i]);
+                const auto& line = res.line;
+                ASSERT_EQ(line.getPositions().size(), lines.size(i)) << "line " << i;
+                EXPECT_EQ(res.seedIndex, lines.seedIndices[i]);
+                EXPECT_EQ(line.getBackwardTerminationReason(),
+                          lines.backwardTerminationReasons[i]);
+                EXPECT_EQ(line.getForwardTerminationReason(), lines.forwardTerminationReasons[i]);
+
+                if (lines.size(i) == 0) continue;
+                const auto& velocities = line.getMetaData<dvec3>("velocity");
+                const auto& vorticities = line.getMetaData<dvec3>("vorticity");
+                for (size_t j = 0; j < lines.size(i); ++j) {
+                    const auto k = lines.offsets[i] + j;
+                    EXPECT_EQ(line.getPositions()[j], lines.positions[k]);
+                    EXPECT_EQ(velocities[j], lines.velocities[k]);
+                    EXPECT_EQ(vorticities[j], lines.metaData[0][k]);
+                }
+            }
+        }
+    }
+}
+
+}  // namespace
+
+TEST(IntegralLinePacketTracer, EulerMatchesIntegralLineTracer) {
+    compareWithIntegralLineTracer(IntegralLineProperties::IntegrationScheme::Euler);
+}
+
+TEST(IntegralLinePacketTracer, RK4MatchesIntegralLineTracer) {
+    compareWithIntegralLineTracer(IntegralLineProperties::IntegrationScheme::RK4);
+}
+
+TEST(IntegralLinePacketTracer, RK45Tolerance) {
+    auto sampler = std::make_shared<RotationSampler>(unitCube());
+    const std::vector<dvec3> points{dvec3{0.9, 0.5, 0.5}, dvec3{0.6, 0.5, 0.2},
+                                    dvec3{0.5, 0.75, 0.8}};
+
+    // The exact lines are circles around the axis, measure the largest deviation of the radius
+    const auto maxError = [&](const StreamLine3DPacketTracer::Lines& lines) {
+        double error = 0.0;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            const auto r = glm::length(dvec2{points[i]} - dvec2{0.5});
+            for (size_t k = lines.offsets[i]; k < lines.offsets[i + 1]; ++k) {
+                const auto p = dvec2{lines.positions[k]} - dvec2{0.5};
+                error = std::max(error, std::abs(glm::length(p) - r));
+            }
+        }
+        return error;
+    };
+
+    IntegralLineProperties properties("properties", "Properties");
+    setProperties(properties, IntegralLineProperties::IntegrationScheme::RK45,
+                  IntegralLineProperties::Direction::FWD, false);
+
+    std::vector<double> errors;
+    for (double tolerance : {1e-4, 1e-6, 1e-8}) {
+        properties.tolerance_.set(tolerance);
+        StreamLine3DPacketTracer tracer(sampler, properties);
+        const auto lines = tracer.traceFrom(points, 1);
+        ASSERT_EQ(points.size(), lines.size());
+        for (size_t i = 0; i < lines.size(); ++i) {
+            // Like IntegralLineTracer, one backward step, the seed, and steps + 1 forward steps
+            EXPECT_EQ(203, lines.size(i));
+            EXPECT_EQ(1, lines.seedIndices[i]);
+            EXPECT_EQ(IntegralLine::TerminationReason::Steps, lines.forwardTerminationReasons[i]);
+            EXPECT_EQ(points[i], lines.positions[lines.offsets[i] + 1]);
+        }
+        const auto error = maxError(lines);
+        EXPECT_LE(error, 200 * tolerance) << "tolerance " << tolerance;
+        errors.push_back(error);
+    }
+    EXPECT_LT(errors[2], errors[0]);
+}
+
+TEST(IntegralLinePacketTracer, JobsGiveSameLines) {
+    auto sampler = std::make_shared<RotationSampler>(unitCube());
+    IntegralLineProperties properties("properties", "Properties");
+    setProperties(properties, IntegralLineProperties::IntegrationScheme::RK4,
+                  IntegralLineProperties::Direction::BOTH, true);
+    StreamLine3DPacketTracer tracer(sampler, properties);
+    tracer.addMetaDataSampler("vorticity", sampler);
+
+    const auto points = seeds();
+    const auto single = tracer.traceFrom(points, 1);
+    const auto split = tracer.traceFrom(points, 3);
+    EXPECT_EQ(single.offsets, split.offsets);
+    EXPECT_EQ(single.positions, split.positions);
+    EXPECT_EQ(single.velocities, split.velocities);
+    EXPECT_EQ(single.metaData, split.metaData);
+    EXPECT_EQ(single.seedIndices, split.seedIndices);
+    EXPECT_EQ(single.backwardTerminationReasons, split.backwardTerminationReasons);
+    EXPECT_EQ(single.forwardTerminationReasons, split.forwardTerminationReasons);
+}
+
+TEST(IntegralLinePacketTracer, AddToSet) {
+    auto sampler = std::make_shared<RotationSampler>(unitCube());
+    IntegralLineProperties properties("properties", "Properties");
+    setProperties(properties, IntegralLineProperties::IntegrationScheme::RK4,
+                  IntegralLineProperties::Direction::BOTH, true);
+    StreamLine3DPacketTracer tracer(sampler, properties);
+    tracer.addMetaDataSampler("vorticity", sampler);
+
+    const auto points = seeds();
+    const auto lines = tracer.traceFrom(points, 1);
+
+    IntegralLineSet set(sampler->getModelMatrix());
+    tracer.addTo(lines, set, 10);
+
+    // The empty line of the seed on the axis is skipped
+    ASSERT_EQ(points.size() - 1, set.size());
+    EXPECT_EQ(lines.positions.size(), set.getNumberOfPoints());
+    EXPECT_EQ(lines.positions, set.getPositions());
+    EXPECT_EQ(lines.velocities, set.getMetaData<dvec3>("velocity"));
+    EXPECT_EQ(lines.metaData[0], set.getMetaData<dvec3>("vorticity"));
+    for (size_t i = 0; i < set.size(); ++i) {
+        EXPECT_EQ(10 + i + 1, set[i].getIndex());
+        EXPECT_EQ(lines.size(i + 1), set[i].size());
+        EXPECT_EQ(lines.forwardTerminationReasons[i + 1], set[i].getForwardTerminationReason());
+    }
+}
+
+}  // namespace inviwo
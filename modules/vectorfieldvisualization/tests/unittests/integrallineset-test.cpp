@@ -0,0 +1,317 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/datastructures/integrallineset.h>
+#include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
+#include <modules/vectorfieldvisualization/processors/discardshortlines.h>
+#include <modules/vectorfieldvisualization/processors/integrallinevectortomesh.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+/**
+ * A straight line along x with the given number of points, spaced by step, with velocity and an
+ * index meta data channel
+ */
+IntegralLine makeLine(size_t points, double step, size_t idx) {
+    IntegralLine line;
+    auto& velocities = line.getMetaData<dvec3>("velocity", true);
+    auto& ids = line.getMetaData<int>("id", true);
+    for (size_t i = 0; i < points; ++i) {
+        line.getPositions().emplace_back(static_cast<double>(i) * step, 0.0, 0.0);
+        velocities.emplace_back(1.0, 0.0, 0.0);
+        ids.push_back(static_cast<int>(10 * idx + i));
+    }
+    line.setIndex(idx);
+    line.setBackwardTerminationReason(IntegralLine::TerminationReason::OutOfBounds);
+    line.setForwardTerminationReason(IntegralLine::TerminationReason::Steps);
+    return line;
+}
+
+void expectEqual(const IntegralLine& line, const IntegralLineView& view) {
+    ASSERT_EQ(line.getPositions().size(), view.size());
+    for (size_t i = 0; i < view.size(); ++i) {
+        EXPECT_EQ(line.getPositions()[i], view.getPositions()[i]);
+        EXPECT_EQ(line.getMetaData<dvec3>("velocity")[i], view.getMetaData<dvec3>("velocity")[i]);
+        EXPECT_EQ(line.getMetaData<int>("id")[i], view.getMetaData<int>("id")[i]);
+    }
+    EXPECT_EQ(line.getBackwardTerminationReason(), view.getBackwardTerminationReason());
+    EXPECT_EQ(line.getForwardTerminationReason(), view.getForwardTerminationReason());
+}
+
+std::vector<std::uint32_t> indices(const Mesh& mesh) {
+    return mesh.getIndices(0)->getRAMRepresentation()->getDataContainer();
+}
+
+}  // namespace
+
+TEST(IntegralLineSet, PushBackLine) {
+    IntegralLineSet set(mat4(1));
+    const auto a = makeLine(3, 1.0, 0);
+    const auto b = makeLine(5, 1.0, 1);
+    set.push_back(a, IntegralLineSet::SetIndex::No);
+    set.push_back(b, 7);
+
+    ASSERT_EQ(2, set.size());
+    EXPECT_EQ(8, set.getNumberOfPoints());
+    EXPECT_EQ((std::vector<size_t>{0, 3, 8}), set.getOffsets());
+    EXPECT_EQ(0, set[0].getIndex());
+    EXPECT_EQ(7, set[1].getIndex());
+    expectEqual(a, set[0]);
+    expectEqual(b, set[1]);
+    expectEqual(b, set.back());
+
+    const auto copy = set[1].toIntegralLine();
+    expectEqual(b, set[1]);
+    expectEqual(copy, set[1]);
+    EXPECT_EQ(7, copy.getIndex());
+}
+
+TEST(IntegralLineSet, PushBackView) {
+    IntegralLineSet src(mat4(1));
+    src.push_back(makeLine(3, 1.0, 0), IntegralLineSet::SetIndex::No);
+    src.push_back(makeLine(4, 1.0, 1), IntegralLineSet::SetIndex::No);
+
+    IntegralLineSet dst(mat4(1));
+    dst.push_back(src[1], IntegralLineSet::SetIndex::Yes);
+    dst.push_back(src[0], IntegralLineSet::SetIndex::No);
+
+    ASSERT_EQ(2, dst.size());
+    EXPECT_EQ(0, dst[0].getIndex());
+    EXPECT_EQ(0, dst[1].getIndex());
+    expectEqual(src[1].toIntegralLine(), dst[0]);
+    expectEqual(src[0].toIntegralLine(), dst[1]);
+}
+
+TEST(IntegralLineSet, PushBackSelf) {
+    IntegralLineSet set(mat4(1));
+    const auto a = makeLine(3, 1.0, 0);
+    const auto b = makeLine(4, 1.0, 1);
+    set.push_back(a, IntegralLineSet::SetIndex::No);
+    set.push_back(b, IntegralLineSet::SetIndex::No);
+
+    set.push_back(set[0], IntegralLineSet::SetIndex::Yes);
+    set.push_back(set[1], IntegralLineSet::SetIndex::No);
+    set.push_back(set.back(), IntegralLineSet::SetIndex::No);
+
+    ASSERT_EQ(5, set.size());
+    EXPECT_EQ(2, set[2].getIndex());
+    expectEqual(a, set[2]);
+    expectEqual(b, set[3]);
+    expectEqual(b, set[4]);
+}
+
+TEST(IntegralLineSet, MetaDataPadding) {
+    IntegralLineSet set(mat4(1));
+
+    IntegralLine first;
+    first.getPositions() = {dvec3{0.0}, dvec3{1.0}};
+    first.getMetaData<double>("a", true) = {1.0, 2.0};
+    set.push_back(first, 0);
+
+    IntegralLine second;
+    second.getPositions() = {dvec3{2.0}, dvec3{3.0}, dvec3{4.0}};
+    second.getMetaData<double>("b", true) = {3.0, 4.0};
+    set.push_back(second, 1);
+
+    EXPECT_EQ((std::vector<double>{1.0, 2.0, 0.0, 0.0, 0.0}), set.getMetaData<double>("a"));
+    EXPECT_EQ((std::vector<double>{0.0, 0.0, 3.0, 4.0, 0.0}), set.getMetaData<double>("b"));
+
+    auto& positions = set.getEditablePositions();
+    positions.emplace_back(5.0);
+    positions.emplace_back(6.0);
+    set.getEditableMetaData<double>("c", true).push_back(5.0);
+    set.addLine(2);
+
+    ASSERT_EQ(3, set.size());
+    EXPECT_EQ(7, set.getNumberOfPoints());
+    EXPECT_EQ(7, set.getMetaData<double>("a").size());
+    EXPECT_EQ(7, set.getMetaData<double>("b").size());
+    EXPECT_EQ((std::vector<double>{0.0, 0.0, 0.0, 0.0, 0.0, 5.0, 0.0}),
+              set.getMetaData<double>("c"));
+}
+
+TEST(IntegralLineSet, InvalidLineLeavesSetUnchanged) {
+    IntegralLineSet set(mat4(1));
+    set.push_back(makeLine(3, 1.0, 0), IntegralLineSet::SetIndex::No);
+
+    // "aaa" comes before the mismatching "id" and must not be added to the set
+    IntegralLine wrongFormat;
+    wrongFormat.getPositions() = {dvec3{0.0}, dvec3{1.0}};
+    wrongFormat.getMetaData<double>("aaa", true) = {1.0, 2.0};
+    wrongFormat.getMetaData<float>("id", true) = {1.0f, 2.0f};
+    EXPECT_THROW(set.push_back(wrongFormat, 1), Exception);
+
+    IntegralLineSet other(mat4(1));
+    other.push_back(wrongFormat, 0);
+    EXPECT_THROW(set.push_back(other[0], 1), Exception);
+
+    auto tooLong = makeLine(2, 1.0, 1);
+    tooLong.getMetaData<double>("aaa", true) = {1.0, 2.0, 3.0};
+    EXPECT_THROW(set.push_back(tooLong, 1), Exception);
+
+    ASSERT_EQ(1, set.size());
+    EXPECT_EQ(3, set.getNumberOfPoints());
+    EXPECT_EQ(3, set.getPositions().size());
+    EXPECT_EQ((std::vector<std::string>{"id", "velocity"}), set.getMetaDataKeys());
+    EXPECT_EQ(3, set.getMetaData<int>("id").size());
+    EXPECT_EQ(3, set.getMetaData<dvec3>("velocity").size());
+}
+
+TEST(IntegralLineSet, CopyOnWrite) {
+    IntegralLineSet set(mat4(1));
+    set.push_back(makeLine(3, 1.0, 0), IntegralLineSet::SetIndex::No);
+
+    const IntegralLineSet copy(set);
+    EXPECT_EQ(&set.getPositions(), &copy.getPositions());
+    EXPECT_EQ(&set.getMetaData<int>("id"), &copy.getMetaData<int>("id"));
+
+    set.getEditableMetaData<int>("id")[0] = 42;
+    set.push_back(makeLine(2, 1.0, 1), IntegralLineSet::SetIndex::No);
+
+    EXPECT_NE(&set.getPositions(), &copy.getPositions());
+    ASSERT_EQ(1, copy.size());
+    EXPECT_EQ(3, copy.getPositions().size());
+    EXPECT_EQ(0, copy.getMetaData<int>("id")[0]);
+    EXPECT_EQ(42, set.getMetaData<int>("id")[0]);
+    EXPECT_EQ(5, set.getNumberOfPoints());
+}
+
+TEST(IntegralLineSet, BuffersShareData) {
+    IntegralLineSet set(mat4(1));
+    set.push_back(makeLine(3, 1.0, 0), IntegralLineSet::SetIndex::No);
+
+    auto positions = set.getPositionBuffer();
+    auto ids = std::static_pointer_cast<const Buffer<int>>(set.getMetaDataBuffer("id"));
+    EXPECT_EQ(set.getPositions().data(), positions->getRAMRepresentation()->getData());
+    EXPECT_EQ(set.getMetaData<int>("id").data(), ids->getRAMRepresentation()->getData());
+
+    // The set copies the arrays before modifying them while the buffers refer to them
+    set.getEditablePositions()[1] = dvec3{6.0};
+    set.getEditableMetaData<int>("id")[1] = 6;
+    EXPECT_NE(set.getPositions().data(), positions->getRAMRepresentation()->getData());
+    EXPECT_EQ(dvec3(1.0, 0.0, 0.0), positions->getRAMRepresentation()->get(1));
+    EXPECT_EQ(1, ids->getRAMRepresentation()->get(1));
+    EXPECT_EQ(dvec3{6.0}, set.getPositions()[1]);
+    EXPECT_EQ(6, set.getMetaData<int>("id")[1]);
+}
+
+TEST(IntegralLineSet, AtRange) {
+    IntegralLineSet set(mat4(1));
+    EXPECT_THROW(set.at(0), RangeException);
+
+    set.push_back(makeLine(3, 1.0, 0), IntegralLineSet::SetIndex::No);
+    EXPECT_NO_THROW(set.at(0));
+    EXPECT_THROW(set.at(1), RangeException);
+    EXPECT_THROW(set.at(std::numeric_limits<size_t>::max()), RangeException);
+}
+
+TEST(IntegralLineSet, DiscardShortLines) {
+    auto set = std::make_shared<IntegralLineSet>(mat4(1));
+    set->push_back(makeLine(3, 0.2, 0), IntegralLineSet::SetIndex::No);  // length 0.4
+    set->push_back(makeLine(2, 0.1, 1), IntegralLineSet::SetIndex::No);  // length 0.1
+    set->push_back(makeLine(4, 0.3, 2), IntegralLineSet::SetIndex::No);  // length 0.9
+
+    IntegralLineSetOutport outport("outport");
+    DiscardShortLines processor;
+    processor.getInport("linesIn")->connectTo(&outport);
+    outport.setData(set);
+    static_cast<DoubleProperty*>(processor.getPropertyByIdentifier("minLength"))->set(0.3);
+    processor.process();
+
+    const auto kept = static_cast<IntegralLineSetOutport*>(processor.getOutport("linesOut"));
+    const auto removed = static_cast<IntegralLineSetOutport*>(
+        processor.getOutport("removedLines"));
+    ASSERT_TRUE(kept->hasData());
+    ASSERT_TRUE(removed->hasData());
+
+    const auto& keptLines = *kept->getData();
+    ASSERT_EQ(2, keptLines.size());
+    EXPECT_EQ(0, keptLines[0].getIndex());
+    EXPECT_EQ(2, keptLines[1].getIndex());
+    expectEqual((*set)[0].toIntegralLine(), keptLines[0]);
+    expectEqual((*set)[2].toIntegralLine(), keptLines[1]);
+
+    const auto& removedLines = *removed->getData();
+    ASSERT_EQ(1, removedLines.size());
+    EXPECT_EQ(1, removedLines[0].getIndex());
+    expectEqual((*set)[1].toIntegralLine(), removedLines[0]);
+}
+
+TEST(IntegralLineSet, ToMeshAdjacency) {
+    IntegralLineSet set(mat4(1));
+    set.push_back(makeLine(3, 1.0, 0), IntegralLineSet::SetIndex::No);
+    set.push_back(makeLine(1, 1.0, 1), IntegralLineSet::SetIndex::No);
+    set.push_back(makeLine(2, 1.0, 2), IntegralLineSet::SetIndex::No);
+
+    const auto mesh = util::toMesh(set);
+    EXPECT_EQ(set.getPositions().data(),
+              mesh->getBuffer(0)->getRepresentation<BufferRAM>()->getData())
+        << "The positions should be shared with the mesh";
+    EXPECT_EQ(DrawType::Lines, mesh->getIndexMeshInfo(0).dt);
+    EXPECT_EQ(ConnectivityType::Adjacency, mesh->getIndexMeshInfo(0).ct);
+    EXPECT_EQ((std::vector<std::uint32_t>{0, 0, 1, 2, 0, 1, 2, 2, 4, 4, 5, 5}), indices(*mesh));
+}
+
+TEST(IntegralLineSet, IntegralLineVectorToMeshAdjacency) {
+    auto set = std::make_shared<IntegralLineSet>(mat4(1));
+    set->push_back(makeLine(4, 1.0, 0), IntegralLineSet::SetIndex::No);
+    set->push_back(makeLine(0, 1.0, 1), IntegralLineSet::SetIndex::No);
+    set->push_back(makeLine(5, 1.0, 2), IntegralLineSet::SetIndex::No);
+
+    IntegralLineSetOutport outport("outport");
+    IntegralLineVectorToMesh processor;
+    processor.getInport("lines")->connectTo(&outport);
+    outport.setData(set);
+    processor.process();
+
+    const auto meshPort = static_cast<MeshOutport*>(processor.getOutport("mesh"));
+    ASSERT_TRUE(meshPort->hasData());
+    const auto mesh = meshPort->getData();
+    ASSERT_EQ(1, mesh->getIndexBuffers().size());
+    EXPECT_EQ(DrawType::Lines, mesh->getIndexMeshInfo(0).dt);
+    EXPECT_EQ(ConnectivityType::Adjacency, mesh->getIndexMeshInfo(0).ct);
+    EXPECT_EQ(9, mesh->getBuffer(0)->getSize());
+    // One segment with adjacency per point with two neighbors, the empty line is skipped
+    EXPECT_EQ((std::vector<std::uint32_t>{0, 1, 2, 3, 4, 5, 6, 7, 5, 6, 7, 8}), indices(*mesh));
+}
+
+}  // namespace inviwo
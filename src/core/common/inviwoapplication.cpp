@@ -67,6 +67,7 @@
 #include <inviwo/core/util/consolelogger.h>
 #include <inviwo/core/util/filelogger.h>
 #include <inviwo/core/util/timer.h>
+#include <inviwo/core/util/tracing.h>
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <inviwo/core/util/commandlineparser.h>
 
@@ -170,6 +171,13 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
         systemSettings_->poolSize_.onChange([this]() { resizePool(systemSettings_->poolSize_); });
     }
 
+    processorNetworkEvaluator_->setParallelEvaluation(
+        systemSettings_->parallelNetworkEvaluation_.get());
+    systemSettings_->parallelNetworkEvaluation_.onChange([this]() {
+        processorNetworkEvaluator_->setParallelEvaluation(
+            systemSettings_->parallelNetworkEvaluation_.get());
+    });
+
     resourceManager_->setEnabled(systemSettings_->enableResourceManager_.get());
     systemSettings_->enableResourceManager_.onChange(
         [this]() { resourceManager_->setEnabled(systemSettings_->enableResourceManager_.get()); });
@@ -177,6 +185,20 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
         resourceManager_->setEnabled(false);
     }
 
+    tracing::setThreadName("Inviwo Main Thread");
+    tracing::setEnabled(systemSettings_->enableTracing_.get());
+    systemSettings_->enableTracing_.onChange(
+        [this]() { tracing::setEnabled(systemSettings_->enableTracing_.get()); });
+    systemSettings_->exportTrace_.onChange([]() {
+        const auto filename = filesystem::getPath(PathType::Settings, "/inviwo-trace.json");
+        try {
+            tracing::writeChromeTrace(filename);
+            LogInfoCustom("Tracing", "Trace written to: " << filename);
+        } catch (const Exception& e) {
+            util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+        }
+    });
+
     moduleManager_.onModulesDidRegister([this]() {
         if (resourceManager_->isEnabled() && resourceManager_->numberOfResources() > 0) {
             LogWarn(
@@ -29,10 +29,76 @@
 
 #include <inviwo/core/datastructures/histogramtools.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
 #include <inviwo/core/common/inviwoapplication.h>
 
+#include <array>
+
 namespace inviwo {
 
+namespace {
+
+// Chunks smaller than this are not worth a task of their own
+constexpr size_t minChunkSize = size_t{1} << 16;
+
+// Volumes larger than this are first sampled sparsely, with the given strides, before the full
+// histogram is calculated
+constexpr size_t progressiveSize = size_t{1} << 24;
+constexpr std::array<size_t, 3> progressiveStrides = {64, 8, 1};
+
+// Iterates over every stride-th element of data
+template <typename T>
+class StridedIterator {
+public:
+    StridedIterator(const T* data, size_t index, size_t stride)
+        : data_{data}, index_{index}, stride_{stride} {}
+
+    const T& operator*() const { return data_[index_]; }
+    StridedIterator& operator++() {
+        index_ += stride_;
+        return *this;
+    }
+    bool operator!=(const StridedIterator& rhs) const { return index_ != rhs.index_; }
+
+private:
+    const T* data_;
+    size_t index_;
+    size_t stride_;
+};
+
+template <typename T>
+void accumulate(HistogramAccumulator<T>& accumulator, const T* data, size_t first, size_t last,
+                size_t stride) {
+    if (stride == 1) {
+        accumulator.add(data + first, data + last);
+    } else {
+        accumulator.add(StridedIterator<T>(data, first * stride, stride),
+                        StridedIterator<T>(data, last * stride, stride));
+    }
+}
+
+template <typename T>
+HistogramContainer calculateHistogramsParallel(const T* data, size_t size, dvec2 dataRange,
+                                               size_t bins, size_t stride) {
+    stride = std::max(stride, size_t{1});
+    const size_t samples = (size + stride - 1) / stride;
+
+    auto app = InviwoApplication::getPtr();
+    const size_t jobs = std::max(size_t{1}, std::min(app->getPoolSize(), samples / minChunkSize));
+
+    std::vector<HistogramAccumulator<T>> accumulators(jobs, {dataRange, bins});
+    util::forEachTask(jobs, [&](size_t job) {
+        accumulate(accumulators[job], data, (samples * job) / jobs, (samples * (job + 1)) / jobs,
+                   stride);
+    });
+    for (size_t job = 1; job < jobs; ++job) {
+        accumulators[0].merge(accumulators[job]);
+    }
+    return HistogramContainer(accumulators[0]);
+}
+
+}  // namespace
+
 void HistogramCalculationState::whenDone(std::function<void(const HistogramContainer&)> callback) {
     if (auto container = container_.lock(); container && done) {
         callback(*container);
@@ -41,6 +107,11 @@ void HistogramCalculationState::whenDone(std::function<void(const HistogramConta
     }
 }
 
+void HistogramCalculationState::whenUpdated(
+    std::function<void(const HistogramContainer&)> callback) {
+    if (!done) callbackHandles_.push_back(updateCallbacks_.add(callback));
+}
+
 HistogramSupplier::HistogramSupplier() : histograms_{std::make_shared<HistogramContainer>()} {}
 
 HistogramSupplier::HistogramSupplier(const HistogramSupplier& rhs)
@@ -63,16 +134,22 @@ std::shared_ptr<HistogramCalculationState> HistogramSupplier::startCalculation(
 
         dispatchPool([weakState = std::weak_ptr<HistogramCalculationState>(calculation_),
                       stop = calculation_->stop_, volumeRam, dataRange, bins]() {
-            auto histograms = volumeRam->dispatch<HistogramContainer>([&](auto vr) {
-                return HistogramContainer(dataRange, bins, vr->getDataTyped(),
-                                          vr->getDataTyped() + glm::compMul(vr->getDimensions()));
-            });
-            if (*stop) return;
-            dispatchFrontAndForget([hist = std::move(histograms), weakState]() {
-                if (auto s = weakState.lock()) {
-                    done(s, std::move(hist));
-                }
-            });
+            const auto size = glm::compMul(volumeRam->getDimensions());
+            for (auto stride : progressiveStrides) {
+                if (stride != 1 && size <= progressiveSize) continue;
+                if (*stop) return;
+                auto histograms = util::calculateHistograms(*volumeRam, dataRange, bins, stride);
+                if (*stop) return;
+                dispatchFrontAndForget([hist = std::move(histograms), weakState, stride]() {
+                    if (auto s = weakState.lock()) {
+                        if (stride == 1) {
+                            done(s, std::move(hist));
+                        } else if (!s->done) {
+                            s->updateCallbacks_.invoke(hist);
+                        }
+                    }
+                });
+            }
         });
     }
     return calculation_;
@@ -87,4 +164,20 @@ void HistogramSupplier::done(std::shared_ptr<HistogramCalculationState> state,
     }
 }
 
+HistogramContainer util::calculateHistograms(const VolumeRAM& volume, dvec2 dataRange,
+                                             size_t bins, size_t stride) {
+    return volume.dispatch<HistogramContainer>([&](auto vr) {
+        return calculateHistogramsParallel(vr->getDataTyped(), glm::compMul(vr->getDimensions()),
+                                           dataRange, bins, stride);
+    });
+}
+
+HistogramContainer util::calculateHistograms(const LayerRAM& layer, dvec2 dataRange, size_t bins,
+                                             size_t stride) {
+    return layer.dispatch<HistogramContainer>([&](auto lr) {
+        return calculateHistogramsParallel(lr->getDataTyped(), glm::compMul(lr->getDimensions()),
+                                           dataRange, bins, stride);
+    });
+}
+
 }  // namespace inviwo
@@ -187,6 +187,9 @@ std::unique_ptr<std::vector<unsigned char>> Layer::getAsCodedBuffer(
     return std::unique_ptr<std::vector<unsigned char>>();
 }
 
+const std::string Layer::classIdentifier = "org.inviwo.Layer";
+const std::string Layer::dataName = "Layer";
+
 template class IVW_CORE_TMPL_INST DataReaderType<Layer>;
 template class IVW_CORE_TMPL_INST DataWriterType<Layer>;
 
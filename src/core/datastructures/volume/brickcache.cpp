@@ -0,0 +1,100 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/brickcache.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+
+namespace inviwo {
+
+BrickCache::BrickCache(size_t maxBytes) : maxBytes_{maxBytes} {}
+
+std::shared_ptr<const VolumeRAM> BrickCache::get(size_t index, const Loader& load) {
+    if (auto brick = find(index)) return brick;
+
+    auto brick = load();
+
+    std::lock_guard<std::mutex> lock{mutex_};
+    // Someone else might have loaded the same brick while we where loading
+    auto it = entries_.find(index);
+    if (it != entries_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return it->second->second;
+    }
+    lru_.emplace_front(index, brick);
+    entries_.emplace(index, lru_.begin());
+    bytes_ += brick->getNumberOfBytes();
+    evict();
+    return brick;
+}
+
+std::shared_ptr<const VolumeRAM> BrickCache::find(size_t index) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    auto it = entries_.find(index);
+    if (it == entries_.end()) return nullptr;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->second;
+}
+
+void BrickCache::setMaxBytes(size_t maxBytes) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    maxBytes_ = maxBytes;
+    evict();
+}
+
+size_t BrickCache::getMaxBytes() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return maxBytes_;
+}
+
+size_t BrickCache::getBytes() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return bytes_;
+}
+
+size_t BrickCache::size() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return lru_.size();
+}
+
+void BrickCache::clear() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    lru_.clear();
+    entries_.clear();
+    bytes_ = 0;
+}
+
+void BrickCache::evict() {
+    while (bytes_ > maxBytes_ && !lru_.empty()) {
+        bytes_ -= lru_.back().second->getNumberOfBytes();
+        entries_.erase(lru_.back().first);
+        lru_.pop_back();
+    }
+}
+
+}  // namespace inviwo
@@ -0,0 +1,105 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/minmaxblockindex.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumeramutils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+
+constexpr double inf = std::numeric_limits<double>::infinity();
+
+void merge(dvec2& range, const dvec2& other) {
+    range.x = std::min(range.x, other.x);
+    range.y = std::max(range.y, other.y);
+}
+
+}  // namespace
+
+MinMaxBlockIndex::MinMaxBlockIndex(const VolumeRAM& volume, size_t blockSize)
+    : dims_{volume.getDimensions()}
+    , blockSize_{std::max(size_t{1}, blockSize)}
+    , numBlocks_{glm::max(size3_t{1}, (dims_ - size3_t{1} + size3_t{blockSize_ - 1}) /
+                                          size3_t{blockSize_})}
+    , index_{numBlocks_}
+    , ranges_(glm::compMul(numBlocks_), dvec2{inf, -inf})
+    , range_{inf, -inf} {
+
+    volume.dispatch<void>([&](auto vr) {
+        using ValueType = util::PrecisionValueType<decltype(vr)>;
+        const ValueType* data = vr->getDataTyped();
+        const util::IndexMapper3D im(dims_);
+        const size_t bs = blockSize_;
+
+        // Each job handles one layer of blocks, reading the voxels row by row. Voxels on a block
+        // boundary belong to the blocks on both sides.
+        util::forEachVoxelParallel(size3_t{1, 1, numBlocks_.z}, [&](const size3_t& layer) {
+            const size_t bz = layer.z;
+            const size_t zEnd = std::min((bz + 1) * bs, dims_.z - 1);
+            for (size_t z = bz * bs; z <= zEnd; ++z) {
+                for (size_t y = 0; y < dims_.y; ++y) {
+                    const ValueType* row = data + im(0, y, z);
+                    for (size_t bx = 0; bx < numBlocks_.x; ++bx) {
+                        dvec2 r{inf, -inf};
+                        const size_t xEnd = std::min((bx + 1) * bs, dims_.x - 1);
+                        for (size_t x = bx * bs; x <= xEnd; ++x) {
+                            const auto v = util::glm_convert<double>(util::glmcomp(row[x], 0));
+                            if (std::isnan(v)) {
+                                r = dvec2{-inf, inf};
+                                break;
+                            }
+                            r.x = std::min(r.x, v);
+                            r.y = std::max(r.y, v);
+                        }
+                        merge(ranges_[index_(bx, std::min(y / bs, numBlocks_.y - 1), bz)], r);
+                        if (y > 0 && y % bs == 0) {
+                            merge(ranges_[index_(bx, y / bs - 1, bz)], r);
+                        }
+                    }
+                }
+            }
+        });
+    });
+
+    for (const auto& r : ranges_) merge(range_, r);
+}
+
+std::pair<size3_t, size3_t> MinMaxBlockIndex::getVoxelRange(const size3_t& block) const {
+    const size3_t lower = block * blockSize_;
+    const size3_t upper = glm::min(lower + size3_t{blockSize_}, dims_ - size3_t{1});
+    return {lower, upper};
+}
+
+}  // namespace inviwo
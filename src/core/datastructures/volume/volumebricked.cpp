@@ -0,0 +1,354 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volumebricked.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/bytereaderutil.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/datawriterexception.h>
+#include <inviwo/core/util/brickiterator.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/formatdispatching.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+// The on disk header, stored little endian. The bricks start at dataOffset which is aligned to
+// 4096 bytes.
+struct BrickedHeader {
+    char magic[8];
+    std::uint64_t version;
+    std::uint64_t dimensions[3];
+    std::uint64_t brickDimensions[3];
+    std::uint64_t dataOffset;
+    char format[32];
+};
+static_assert(sizeof(BrickedHeader) == 104, "Unexpected padding in BrickedHeader");
+
+constexpr char brickedMagic[8] = {'I', 'V', 'W', 'B', 'R', 'I', 'C', 'K'};
+constexpr std::uint64_t brickedVersion = 1;
+constexpr std::uint64_t brickedDataOffset = 4096;
+
+size3_t toSize3(const std::uint64_t (&v)[3]) {
+    return size3_t{static_cast<size_t>(v[0]), static_cast<size_t>(v[1]),
+                   static_cast<size_t>(v[2])};
+}
+
+size3_t brickCount(const size3_t& dims, const size3_t& brickDims) {
+    return (dims + brickDims - size3_t{1}) / brickDims;
+}
+
+struct BrickWriter {
+    template <typename Result, typename Format>
+    void operator()(const void* data, const size3_t& dims, const size3_t& brickDims,
+                    std::ostream& out) {
+        using T = typename Format::type;
+        const auto src = static_cast<const T*>(data);
+        const auto count = brickCount(dims, brickDims);
+        std::vector<T> brick(glm::compMul(brickDims));
+
+        for (size_t z = 0; z < count.z; ++z) {
+            for (size_t y = 0; y < count.y; ++y) {
+                for (size_t x = 0; x < count.x; ++x) {
+                    const size3_t offset = size3_t{x, y, z} * brickDims;
+                    const size3_t extent = glm::min(brickDims, dims - offset);
+                    std::memset(brick.data(), 0, brick.size() * sizeof(T));
+
+                    auto srcIt = util::BrickIterator{src, dims, offset, extent};
+                    auto dstIt = util::BrickIterator{brick.data(), brickDims, size3_t{0}, extent};
+                    std::copy(srcIt, srcIt.end(), dstIt);
+
+                    out.write(reinterpret_cast<const char*>(brick.data()),
+                              brick.size() * sizeof(T));
+                }
+            }
+        }
+    }
+};
+
+}  // namespace
+
+VolumeBricked::VolumeBricked(const std::string& file, size_t cacheSize,
+                             const SwizzleMask& swizzleMask, InterpolationType interpolation,
+                             const Wrapping3D& wrapping)
+    : VolumeRepresentation()
+    , file_{file}
+    , cache_{std::make_shared<BrickCache>(cacheSize)}
+    , swizzleMask_{swizzleMask}
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {
+
+    auto in = filesystem::ifstream(file, std::ios::in | std::ios::binary);
+    if (!in) {
+        throw DataReaderException("Error: Could not open bricked volume file: " + file,
+                                  IVW_CONTEXT);
+    }
+    BrickedHeader header;
+    in.read(reinterpret_cast<char*>(&header), sizeof(BrickedHeader));
+    if (!in || std::memcmp(header.magic, brickedMagic, sizeof(brickedMagic)) != 0) {
+        throw DataReaderException("Error: Not a bricked volume file: " + file, IVW_CONTEXT);
+    }
+    if (header.version != brickedVersion) {
+        throw DataReaderException(
+            "Error: Unsupported bricked volume version " + toString(header.version), IVW_CONTEXT);
+    }
+    header.format[sizeof(header.format) - 1] = '\0';
+    setDataFormat(DataFormatBase::get(std::string{header.format}));
+    dimensions_ = toSize3(header.dimensions);
+    brickDimensions_ = toSize3(header.brickDimensions);
+    dataOffset_ = static_cast<size_t>(header.dataOffset);
+    if (glm::any(glm::equal(brickDimensions_, size3_t{0}))) {
+        throw DataReaderException("Error: Invalid brick dimensions in: " + file, IVW_CONTEXT);
+    }
+}
+
+VolumeBricked* VolumeBricked::clone() const { return new VolumeBricked(*this); }
+
+std::type_index VolumeBricked::getTypeIndex() const {
+    return std::type_index(typeid(VolumeBricked));
+}
+
+void VolumeBricked::setDimensions(size3_t) {
+    throw Exception("Can not set dimension of a bricked volume", IVW_CONTEXT);
+}
+
+const size3_t& VolumeBricked::getDimensions() const { return dimensions_; }
+
+void VolumeBricked::setSwizzleMask(const SwizzleMask& mask) { swizzleMask_ = mask; }
+
+SwizzleMask VolumeBricked::getSwizzleMask() const { return swizzleMask_; }
+
+void VolumeBricked::setInterpolation(InterpolationType interpolation) {
+    interpolation_ = interpolation;
+}
+
+InterpolationType VolumeBricked::getInterpolation() const { return interpolation_; }
+
+void VolumeBricked::setWrapping(const Wrapping3D& wrapping) { wrapping_ = wrapping; }
+
+Wrapping3D VolumeBricked::getWrapping() const { return wrapping_; }
+
+const std::string& VolumeBricked::getFileName() const { return file_; }
+
+const size3_t& VolumeBricked::getBrickDimensions() const { return brickDimensions_; }
+
+size3_t VolumeBricked::getBrickCount() const { return brickCount(dimensions_, brickDimensions_); }
+
+std::shared_ptr<const VolumeRAM> VolumeBricked::getBrick(const size3_t& brick) const {
+    const auto index = util::IndexMapper3D(getBrickCount())(brick);
+    return cache_->get(index, [&]() -> std::shared_ptr<const VolumeRAM> {
+        auto ram = createVolumeRAM(brickDimensions_, getDataFormat(), nullptr, swizzleMask_,
+                                   interpolation_, wrapping_);
+        const auto bytes = ram->getNumberOfBytes();
+        util::readBytesIntoBuffer(file_, dataOffset_ + index * bytes, bytes, true,
+                                  getDataFormat()->getSize(), ram->getData());
+        return ram;
+    });
+}
+
+std::shared_ptr<VolumeRAM> VolumeBricked::getRegion(const size3_t& offset,
+                                                    const size3_t& extent) const {
+    if (glm::any(glm::greaterThan(offset + extent, dimensions_))) {
+        throw RangeException("Region is outside of the volume", IVW_CONTEXT);
+    }
+
+    auto region =
+        createVolumeRAM(extent, getDataFormat(), nullptr, swizzleMask_, interpolation_, wrapping_);
+    if (glm::compMul(extent) == 0) return region;
+
+    const auto elementSize = getDataFormat()->getSize();
+    const util::IndexMapper3D dstIndex(extent);
+    const util::IndexMapper3D srcIndex(brickDimensions_);
+    auto dst = static_cast<char*>(region->getData());
+
+    const size3_t first = offset / brickDimensions_;
+    const size3_t last = (offset + extent - size3_t{1}) / brickDimensions_;
+    for (size_t bz = first.z; bz <= last.z; ++bz) {
+        for (size_t by = first.y; by <= last.y; ++by) {
+            for (size_t bx = first.x; bx <= last.x; ++bx) {
+                const size3_t brickPos{bx, by, bz};
+                const auto brick = getBrick(brickPos);
+                const auto src = static_cast<const char*>(brick->getData());
+
+                const size3_t brickStart = brickPos * brickDimensions_;
+                const size3_t lo = glm::max(offset, brickStart);
+                const size3_t hi = glm::min(offset + extent, brickStart + brickDimensions_);
+                const size_t rowBytes = (hi.x - lo.x) * elementSize;
+
+                for (size_t z = lo.z; z < hi.z; ++z) {
+                    for (size_t y = lo.y; y < hi.y; ++y) {
+                        std::memcpy(dst + dstIndex(lo.x - offset.x, y - offset.y, z - offset.z) *
+                                              elementSize,
+                                    src + srcIndex(lo.x - brickStart.x, y - brickStart.y,
+                                                   z - brickStart.z) *
+                                              elementSize,
+                                    rowBytes);
+                    }
+                }
+            }
+        }
+    }
+    return region;
+}
+
+double VolumeBricked::getAsDouble(const size3_t& pos) const {
+    return getBrick(pos / brickDimensions_)->getAsDouble(pos % brickDimensions_);
+}
+dvec2 VolumeBricked::getAsDVec2(const size3_t& pos) const {
+    return getBrick(pos / brickDimensions_)->getAsDVec2(pos % brickDimensions_);
+}
+dvec3 VolumeBricked::getAsDVec3(const size3_t& pos) const {
+    return getBrick(pos / brickDimensions_)->getAsDVec3(pos % brickDimensions_);
+}
+dvec4 VolumeBricked::getAsDVec4(const size3_t& pos) const {
+    return getBrick(pos / brickDimensions_)->getAsDVec4(pos % brickDimensions_);
+}
+
+double VolumeBricked::getAsNormalizedDouble(const size3_t& pos) const {
+    return getBrick(pos / brickDimensions_)->getAsNormalizedDouble(pos % brickDimensions_);
+}
+dvec2 VolumeBricked::getAsNormalizedDVec2(const size3_t& pos) const {
+    return getBrick(pos / brickDimensions_)->getAsNormalizedDVec2(pos % brickDimensions_);
+}
+dvec3 VolumeBricked::getAsNormalizedDVec3(const size3_t& pos) const {
+    return getBrick(pos / brickDimensions_)->getAsNormalizedDVec3(pos % brickDimensions_);
+}
+dvec4 VolumeBricked::getAsNormalizedDVec4(const size3_t& pos) const {
+    return getBrick(pos / brickDimensions_)->getAsNormalizedDVec4(pos % brickDimensions_);
+}
+
+BrickCache& VolumeBricked::getCache() const { return *cache_; }
+
+VolumeBricked::Accessor::Accessor(const VolumeBricked& volume)
+    : volume_{&volume}, current_{std::numeric_limits<size_t>::max()}, brick_{} {}
+
+const VolumeRAM& VolumeBricked::Accessor::brick(size3_t& pos) {
+    const auto& brickDims = volume_->getBrickDimensions();
+    const size3_t brickPos = pos / brickDims;
+    if (brickPos != current_ || !brick_) {
+        brick_ = volume_->getBrick(brickPos);
+        current_ = brickPos;
+    }
+    pos %= brickDims;
+    return *brick_;
+}
+
+double VolumeBricked::Accessor::getAsDouble(const size3_t& pos) {
+    auto local = pos;
+    return brick(local).getAsDouble(local);
+}
+dvec2 VolumeBricked::Accessor::getAsDVec2(const size3_t& pos) {
+    auto local = pos;
+    return brick(local).getAsDVec2(local);
+}
+dvec3 VolumeBricked::Accessor::getAsDVec3(const size3_t& pos) {
+    auto local = pos;
+    return brick(local).getAsDVec3(local);
+}
+dvec4 VolumeBricked::Accessor::getAsDVec4(const size3_t& pos) {
+    auto local = pos;
+    return brick(local).getAsDVec4(local);
+}
+
+double VolumeBricked::Accessor::getAsNormalizedDouble(const size3_t& pos) {
+    auto local = pos;
+    return brick(local).getAsNormalizedDouble(local);
+}
+dvec2 VolumeBricked::Accessor::getAsNormalizedDVec2(const size3_t& pos) {
+    auto local = pos;
+    return brick(local).getAsNormalizedDVec2(local);
+}
+dvec3 VolumeBricked::Accessor::getAsNormalizedDVec3(const size3_t& pos) {
+    auto local = pos;
+    return brick(local).getAsNormalizedDVec3(local);
+}
+dvec4 VolumeBricked::Accessor::getAsNormalizedDVec4(const size3_t& pos) {
+    auto local = pos;
+    return brick(local).getAsNormalizedDVec4(local);
+}
+
+void util::writeBrickedVolume(const void* data, const size3_t& dimensions,
+                              const DataFormatBase* format, const std::string& file,
+                              const size3_t& brickDimensions) {
+    if (glm::any(glm::equal(brickDimensions, size3_t{0}))) {
+        throw DataWriterException("Error: Brick dimensions must be larger than zero",
+                                  IVW_CONTEXT_CUSTOM("writeBrickedVolume"));
+    }
+    if (!format || format->getId() == DataFormatId::NotSpecialized) {
+        throw DataWriterException("Error: Unsupported data format",
+                                  IVW_CONTEXT_CUSTOM("writeBrickedVolume"));
+    }
+    const auto formatName = std::string{format->getString()};
+    BrickedHeader header{};
+    if (formatName.size() >= sizeof(header.format)) {
+        throw DataWriterException("Error: Format name too long: " + formatName,
+                                  IVW_CONTEXT_CUSTOM("writeBrickedVolume"));
+    }
+    std::copy(std::begin(brickedMagic), std::end(brickedMagic), header.magic);
+    header.version = brickedVersion;
+    for (int i = 0; i < 3; ++i) {
+        header.dimensions[i] = dimensions[i];
+        header.brickDimensions[i] = brickDimensions[i];
+    }
+    header.dataOffset = brickedDataOffset;
+    std::copy(formatName.begin(), formatName.end(), header.format);
+
+    auto out = filesystem::ofstream(file, std::ios::out | std::ios::binary);
+    if (!out) {
+        throw DataWriterException("Error: Could not write to file: " + file,
+                                  IVW_CONTEXT_CUSTOM("writeBrickedVolume"));
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(BrickedHeader));
+    const std::vector<char> padding(brickedDataOffset - sizeof(BrickedHeader), 0);
+    out.write(padding.data(), padding.size());
+
+    dispatching::dispatch<void, dispatching::filter::All>(format->getId(), BrickWriter{}, data,
+                                                          dimensions, brickDimensions, out);
+    if (!out) {
+        throw DataWriterException("Error: Could not write to file: " + file,
+                                  IVW_CONTEXT_CUSTOM("writeBrickedVolume"));
+    }
+}
+
+void util::writeBrickedVolume(const VolumeRAM& volume, const std::string& file,
+                              const size3_t& brickDimensions) {
+    writeBrickedVolume(volume.getData(), volume.getDimensions(), volume.getDataFormat(), file,
+                       brickDimensions);
+}
+
+}  // namespace inviwo
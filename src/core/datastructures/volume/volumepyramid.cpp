@@ -0,0 +1,260 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/volumeramutils.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+
+// Combine the voxels in [lo, hi) using the kernel
+template <typename P, typename T>
+P combine(const T* src, const util::IndexMapper3D& index, const size3_t& lo, const size3_t& hi,
+          DownsamplingKernel kernel) {
+    P val = util::glm_convert<P>(src[index(lo)]);
+    if (kernel == DownsamplingKernel::Nearest) return val;
+
+    P sum{0.0};
+    size_t count = 0;
+    for (size_t z = lo.z; z < hi.z; ++z) {
+        for (size_t y = lo.y; y < hi.y; ++y) {
+            for (size_t x = lo.x; x < hi.x; ++x) {
+                const auto v = util::glm_convert<P>(src[index(x, y, z)]);
+                sum += v;
+                val = kernel == DownsamplingKernel::Minimum ? glm::min(val, v) : glm::max(val, v);
+                ++count;
+            }
+        }
+    }
+    if (kernel != DownsamplingKernel::Average) return val;
+
+    const P avg = sum / static_cast<double>(count);
+    if constexpr (util::is_floating_point<typename util::value_type<T>::type>::value) {
+        return avg;
+    } else {
+        return glm::round(avg);
+    }
+}
+
+}  // namespace
+
+VolumePyramid::VolumePyramid(std::vector<std::shared_ptr<VolumeRAM>> levels,
+                             DownsamplingKernel kernel, const SwizzleMask& swizzleMask,
+                             InterpolationType interpolation, const Wrapping3D& wrapping)
+    : VolumeRepresentation(levels.at(0)->getDataFormat())
+    , kernel_{kernel}
+    , levels_{}
+    , swizzleMask_{swizzleMask}
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {
+
+    for (auto& ram : levels) {
+        if (ram->getDataFormat() != getDataFormat()) {
+            throw Exception("All pyramid levels must have the same format", IVW_CONTEXT);
+        }
+        levels_.push_back({ram->getDimensions(), nullptr, std::move(ram)});
+    }
+}
+
+VolumePyramid::VolumePyramid(const DataFormatBase* format, std::vector<size3_t> levelDimensions,
+                             std::vector<Loader> loaders, DownsamplingKernel kernel,
+                             const SwizzleMask& swizzleMask, InterpolationType interpolation,
+                             const Wrapping3D& wrapping)
+    : VolumeRepresentation(format)
+    , kernel_{kernel}
+    , levels_{}
+    , swizzleMask_{swizzleMask}
+    , interpolation_{interpolation}
+    , wrapping_{wrapping} {
+
+    if (levelDimensions.empty() || levelDimensions.size() != loaders.size()) {
+        throw Exception("Expected one loader for each level", IVW_CONTEXT);
+    }
+    for (size_t i = 0; i < loaders.size(); ++i) {
+        levels_.push_back({levelDimensions[i], std::move(loaders[i]), nullptr});
+    }
+}
+
+VolumePyramid::VolumePyramid(const VolumePyramid& rhs)
+    : VolumeRepresentation(rhs)
+    , kernel_{rhs.kernel_}
+    , levels_{rhs.copyLevels()}
+    , swizzleMask_{rhs.swizzleMask_}
+    , interpolation_{rhs.interpolation_}
+    , wrapping_{rhs.wrapping_} {}
+
+VolumePyramid& VolumePyramid::operator=(const VolumePyramid& that) {
+    if (this != &that) {
+        VolumeRepresentation::operator=(that);
+        auto levels = that.copyLevels();
+        std::lock_guard<std::mutex> lock{mutex_};
+        kernel_ = that.kernel_;
+        levels_ = std::move(levels);
+        swizzleMask_ = that.swizzleMask_;
+        interpolation_ = that.interpolation_;
+        wrapping_ = that.wrapping_;
+    }
+    return *this;
+}
+
+VolumePyramid* VolumePyramid::clone() const { return new VolumePyramid(*this); }
+
+std::vector<VolumePyramid::Level> VolumePyramid::copyLevels() const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return levels_;
+}
+
+std::type_index VolumePyramid::getTypeIndex() const {
+    return std::type_index(typeid(VolumePyramid));
+}
+
+void VolumePyramid::setDimensions(size3_t) {
+    throw Exception("Can not set dimension of a volume pyramid", IVW_CONTEXT);
+}
+
+const size3_t& VolumePyramid::getDimensions() const { return levels_.front().dimensions; }
+
+void VolumePyramid::setSwizzleMask(const SwizzleMask& mask) { swizzleMask_ = mask; }
+
+SwizzleMask VolumePyramid::getSwizzleMask() const { return swizzleMask_; }
+
+void VolumePyramid::setInterpolation(InterpolationType interpolation) {
+    interpolation_ = interpolation;
+}
+
+InterpolationType VolumePyramid::getInterpolation() const { return interpolation_; }
+
+void VolumePyramid::setWrapping(const Wrapping3D& wrapping) { wrapping_ = wrapping; }
+
+Wrapping3D VolumePyramid::getWrapping() const { return wrapping_; }
+
+size_t VolumePyramid::getNumberOfLevels() const { return levels_.size(); }
+
+const size3_t& VolumePyramid::getLevelDimensions(size_t level) const {
+    return levels_.at(level).dimensions;
+}
+
+DownsamplingKernel VolumePyramid::getKernel() const { return kernel_; }
+
+std::shared_ptr<const VolumeRAM> VolumePyramid::getLevel(size_t level) const {
+    Loader loader;
+    size3_t dimensions;
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        const auto& l = levels_.at(level);
+        if (l.ram) return l.ram;
+        loader = l.loader;
+        dimensions = l.dimensions;
+    }
+
+    // Load without holding the lock, loading might be slow and other levels can be used meanwhile
+    std::shared_ptr<const VolumeRAM> ram = loader();
+    if (!ram || ram->getDimensions() != dimensions) {
+        throw Exception("Loaded pyramid level " + toString(level) + " does not match",
+                        IVW_CONTEXT);
+    }
+
+    std::lock_guard<std::mutex> lock{mutex_};
+    // Someone else might have loaded the same level while we where loading
+    const auto& l = levels_.at(level);
+    if (!l.ram) l.ram = std::move(ram);
+    return l.ram;
+}
+
+bool VolumePyramid::isLevelLoaded(size_t level) const {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return levels_.at(level).ram != nullptr;
+}
+
+std::shared_ptr<VolumeRAM> util::downsample(const VolumeRAM& volume, DownsamplingKernel kernel) {
+    return volume.dispatch<std::shared_ptr<VolumeRAM>>(
+        [kernel](auto srcVol) -> std::shared_ptr<VolumeRAM> {
+            using ValueType = util::PrecisionValueType<decltype(srcVol)>;
+            // Use a double type to perform the computations
+            using P = typename util::same_extent<ValueType, double>::type;
+
+            const size3_t srcDims{srcVol->getDimensions()};
+            const size3_t dstDims{(srcDims + size3_t{1}) / size3_t{2}};
+
+            auto dstVol = std::make_shared<VolumeRAMPrecision<ValueType>>(
+                dstDims, srcVol->getSwizzleMask(), srcVol->getInterpolation(),
+                srcVol->getWrapping());
+
+            const auto src = srcVol->getDataTyped();
+            auto dst = dstVol->getDataTyped();
+            const util::IndexMapper3D srcIndex(srcDims);
+            const util::IndexMapper3D dstIndex(dstDims);
+
+            // Parallelize over the slices of the destination
+            util::forEachVoxelParallel(size3_t{1, 1, dstDims.z}, [&](const size3_t& slice) {
+                const size_t z = slice.z;
+                for (size_t y = 0; y < dstDims.y; ++y) {
+                    for (size_t x = 0; x < dstDims.x; ++x) {
+                        const size3_t lo{2 * x, 2 * y, 2 * z};
+                        const size3_t hi = glm::min(lo + size3_t{2}, srcDims);
+                        dst[dstIndex(x, y, z)] = util::glm_convert<ValueType>(
+                            combine<P>(src, srcIndex, lo, hi, kernel));
+                    }
+                }
+            });
+
+            return dstVol;
+        });
+}
+
+std::vector<std::shared_ptr<VolumeRAM>> util::createPyramidLevels(const VolumeRAM& volume,
+                                                                DownsamplingKernel kernel,
+                                                                size_t minDimension) {
+    std::vector<std::shared_ptr<VolumeRAM>> levels;
+    const VolumeRAM* current = &volume;
+    const size3_t minDims{std::max(minDimension, size_t{1})};
+    while (glm::any(glm::greaterThan(current->getDimensions(), minDims))) {
+        levels.push_back(downsample(*current, kernel));
+        current = levels.back().get();
+    }
+    return levels;
+}
+
+std::shared_ptr<VolumePyramid> util::createVolumePyramid(std::shared_ptr<VolumeRAM> volume,
+                                                         DownsamplingKernel kernel,
+                                                         size_t minDimension) {
+    auto levels = createPyramidLevels(*volume, kernel, minDimension);
+    levels.insert(levels.begin(), volume);
+    return std::make_shared<VolumePyramid>(std::move(levels), kernel, volume->getSwizzleMask(),
+                                           volume->getInterpolation(), volume->getWrapping());
+}
+
+}  // namespace inviwo
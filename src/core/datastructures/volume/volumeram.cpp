@@ -36,4 +36,15 @@ VolumeRAM::VolumeRAM(const DataFormatBase* format) : VolumeRepresentation(format
 
 std::type_index VolumeRAM::getTypeIndex() const { return std::type_index(typeid(VolumeRAM)); }
 
+std::shared_ptr<const MinMaxBlockIndex> VolumeRAM::getMinMaxBlockIndex(size_t blockSize) const {
+    std::unique_lock<std::mutex> lock{minMaxBlockIndex_.mutex};
+    auto& cache = minMaxBlockIndex_;
+    if (!cache.index || cache.version != getVersion() || cache.index->getBlockSize() != blockSize ||
+        cache.index->getVolumeDimensions() != getDimensions()) {
+        cache.index = std::make_shared<MinMaxBlockIndex>(*this, blockSize);
+        cache.version = getVersion();
+    }
+    return cache.index;
+}
+
 }  // namespace inviwo
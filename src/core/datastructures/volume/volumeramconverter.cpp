@@ -30,6 +30,8 @@
 #include <inviwo/core/datastructures/volume/volumeramconverter.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 
+#include <cstring>
+
 namespace inviwo {
 
 std::shared_ptr<VolumeRAM> VolumeDisk2RAMConverter::createFrom(
@@ -42,4 +44,43 @@ void VolumeDisk2RAMConverter::update(std::shared_ptr<const VolumeDisk> source,
     source->updateRepresentation(destination);
 }
 
+std::shared_ptr<VolumeRAM> VolumeBricked2RAMConverter::createFrom(
+    std::shared_ptr<const VolumeBricked> source) const {
+    return source->getRegion(size3_t{0}, source->getDimensions());
+}
+
+void VolumeBricked2RAMConverter::update(std::shared_ptr<const VolumeBricked> source,
+                                        std::shared_ptr<VolumeRAM> destination) const {
+    auto region = source->getRegion(size3_t{0}, source->getDimensions());
+    if (destination->getDimensions() != source->getDimensions()) {
+        destination->setDimensions(source->getDimensions());
+    }
+    std::memcpy(destination->getData(), region->getData(), region->getNumberOfBytes());
+    destination->setSwizzleMask(source->getSwizzleMask());
+    destination->setInterpolation(source->getInterpolation());
+    destination->setWrapping(source->getWrapping());
+}
+
+std::shared_ptr<VolumeRAM> VolumePyramid2RAMConverter::createFrom(
+    std::shared_ptr<const VolumePyramid> source) const {
+    // Copy level 0, the levels are shared between pyramids and must never be modified
+    auto ram = std::shared_ptr<VolumeRAM>(source->getLevel(0)->clone());
+    ram->setSwizzleMask(source->getSwizzleMask());
+    ram->setInterpolation(source->getInterpolation());
+    ram->setWrapping(source->getWrapping());
+    return ram;
+}
+
+void VolumePyramid2RAMConverter::update(std::shared_ptr<const VolumePyramid> source,
+                                        std::shared_ptr<VolumeRAM> destination) const {
+    auto level = source->getLevel(0);
+    if (destination->getDimensions() != level->getDimensions()) {
+        destination->setDimensions(level->getDimensions());
+    }
+    std::memcpy(destination->getData(), level->getData(), level->getNumberOfBytes());
+    destination->setSwizzleMask(source->getSwizzleMask());
+    destination->setInterpolation(source->getInterpolation());
+    destination->setWrapping(source->getWrapping());
+}
+
 }  // namespace inviwo
@@ -0,0 +1,143 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/memorymappedfile.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/raiiutils.h>
+
+#ifdef WIN32
+struct IUnknown;  // Workaround for "combaseapi.h(229): error C2187: syntax error: 'identifier' was
+                  // unexpected here" when using /permissive-
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace inviwo {
+
+#ifdef WIN32
+
+size_t MemoryMappedFile::allocationGranularity() {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwAllocationGranularity);
+}
+
+MemoryMappedFile::MemoryMappedFile(const std::string& file, size_t offset, size_t size) {
+    HANDLE fileHandle = CreateFileW(util::toWstring(file).c_str(), GENERIC_READ,
+                                    FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        throw FileException("Could not open file: " + file, IVW_CONTEXT);
+    }
+    util::OnScopeExit closeFile{[fileHandle]() { CloseHandle(fileHandle); }};
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) ||
+        static_cast<size_t>(fileSize.QuadPart) < offset + size) {
+        throw FileException("File is smaller than expected: " + file, IVW_CONTEXT);
+    }
+
+    // The mapping handle can be closed once the view is created, the view keeps it alive.
+    HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        throw FileException("Could not create file mapping for: " + file, IVW_CONTEXT);
+    }
+    util::OnScopeExit closeMapping{[mappingHandle]() { CloseHandle(mappingHandle); }};
+
+    const auto alignedOffset = offset - offset % allocationGranularity();
+    mappingSize_ = size + (offset - alignedOffset);
+    mapping_ = MapViewOfFile(mappingHandle, FILE_MAP_COPY,
+                             static_cast<DWORD>(static_cast<uint64_t>(alignedOffset) >> 32),
+                             static_cast<DWORD>(alignedOffset & 0xFFFFFFFF), mappingSize_);
+    if (!mapping_) {
+        throw FileException("Could not map file: " + file, IVW_CONTEXT);
+    }
+    data_ = static_cast<char*>(mapping_) + (offset - alignedOffset);
+    size_ = size;
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (mapping_) UnmapViewOfFile(mapping_);
+}
+
+void MemoryMappedFile::prefetch(size_t offset, size_t size) const {
+    WIN32_MEMORY_RANGE_ENTRY range{static_cast<char*>(data_) + offset, size};
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+#else
+
+size_t MemoryMappedFile::allocationGranularity() {
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+MemoryMappedFile::MemoryMappedFile(const std::string& file, size_t offset, size_t size) {
+    const int fd = open(file.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw FileException("Could not open file: " + file, IVW_CONTEXT);
+    }
+    // The file descriptor can be closed once the mapping is created.
+    util::OnScopeExit closeFile{[fd]() { close(fd); }};
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || static_cast<size_t>(fileStat.st_size) < offset + size) {
+        throw FileException("File is smaller than expected: " + file, IVW_CONTEXT);
+    }
+
+    const auto alignedOffset = offset - offset % allocationGranularity();
+    mappingSize_ = size + (offset - alignedOffset);
+    mapping_ = mmap(nullptr, mappingSize_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+                    static_cast<off_t>(alignedOffset));
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        throw FileException("Could not map file: " + file, IVW_CONTEXT);
+    }
+    data_ = static_cast<char*>(mapping_) + (offset - alignedOffset);
+    size_ = size;
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    if (mapping_) munmap(mapping_, mappingSize_);
+}
+
+void MemoryMappedFile::prefetch(size_t offset, size_t size) const {
+    // madvise requires a page aligned address
+    auto begin = reinterpret_cast<uintptr_t>(static_cast<char*>(data_) + offset);
+    const auto aligned = begin - begin % allocationGranularity();
+    madvise(reinterpret_cast<void*>(aligned), size + (begin - aligned), MADV_WILLNEED);
+}
+
+#endif
+
+}  // namespace inviwo
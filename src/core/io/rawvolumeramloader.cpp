@@ -30,6 +30,8 @@
 #include <inviwo/core/io/rawvolumeramloader.h>
 
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/memorymappedfile.h>
+#include <inviwo/core/util/logcentral.h>
 
 namespace inviwo {
 
@@ -38,9 +40,37 @@ RawVolumeRAMLoader::RawVolumeRAMLoader(const std::string& rawFile, size_t offset
 
 RawVolumeRAMLoader* RawVolumeRAMLoader::clone() const { return new RawVolumeRAMLoader(*this); }
 
+bool RawVolumeRAMLoader::canMap(const DataFormatBase* format) const {
+    // The byte order of the file has to match the (little endian) in memory layout
+    if (!littleEndian_ && format->getSize() != 1) return false;
+    // The mapped data is used as an array of the component type, an unaligned offset would give
+    // misaligned pointers. Use the read path instead.
+    const auto alignment = format->getSize() / format->getComponents();
+    return offset_ % alignment == 0;
+}
+
+std::shared_ptr<MemoryMappedFile> RawVolumeRAMLoader::map(size_t bytes) const {
+    try {
+        return std::make_shared<MemoryMappedFile>(rawFile_, offset_, bytes);
+    } catch (const FileException& e) {
+        LogWarn("Falling back to reading the whole file into memory: " << e.getMessage());
+        return nullptr;
+    }
+}
+
 std::shared_ptr<VolumeRepresentation> RawVolumeRAMLoader::createRepresentation(
     const VolumeRepresentation& src) const {
 
+    if (canMap(src.getDataFormat())) {
+        const auto bytes = glm::compMul(src.getDimensions()) * src.getDataFormat()->getSize();
+        if (auto file = map(bytes)) {
+            auto data = file->data();
+            return createVolumeRAM(src.getDimensions(), src.getDataFormat(), data,
+                                   std::move(file), src.getSwizzleMask(),
+                                   src.getInterpolation(), src.getWrapping());
+        }
+    }
+
     const auto size = glm::compMul(src.getDimensions()) * src.getDataFormat()->getSize();
     auto data = std::make_unique<char[]>(size);
     util::readBytesIntoBuffer(rawFile_, offset_, size, littleEndian_,
@@ -58,6 +88,21 @@ void RawVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentati
                                               const VolumeRepresentation& src) const {
     auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
 
+    if (canMap(src.getDataFormat())) {
+        const auto bytes = glm::compMul(src.getDimensions()) * src.getDataFormat()->getSize();
+        if (auto file = map(bytes)) {
+            volumeDst->dispatch<void>([&](auto vrprecision) {
+                using ValueType = util::PrecisionValueType<decltype(vrprecision)>;
+                auto data = static_cast<ValueType*>(file->data());
+                vrprecision->setData(data, std::move(file), src.getDimensions());
+            });
+            volumeDst->setSwizzleMask(src.getSwizzleMask());
+            volumeDst->setInterpolation(src.getInterpolation());
+            volumeDst->setWrapping(src.getWrapping());
+            return;
+        }
+    }
+
     if (src.getDimensions() != volumeDst->getDimensions()) {
         volumeDst->setDimensions(src.getDimensions());
     }
@@ -0,0 +1,287 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/serialization/binaryserialization.h>
+#include <inviwo/core/io/serialization/serializationexception.h>
+#include <inviwo/core/io/serialization/ticpp.h>
+
+#include <array>
+#include <cctype>
+#include <deque>
+#include <istream>
+#include <string>
+#include <ostream>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace {
+
+/*
+ * Layout: the magic bytes and a format version followed by a sequence of records. Every record
+ * starts with a tag, an element record is followed by the records of its children and an end
+ * record. The document is closed by a final end record.
+ *
+ *   element: Tag::Element, name, attribute count, (name, value) * attribute count
+ *   text:    Tag::Text, value
+ *   end:     Tag::End
+ *
+ * Integers are stored as LEB128 varints. A string is a varint code followed by optional data:
+ * StringCode::Intern and StringCode::Literal are followed by the length and the bytes, where the
+ * interned ones are assigned the next index in the string table. Codes from StringCode::Table and
+ * up refer to entry (code - StringCode::Table) of the table.
+ */
+constexpr std::array<char, 5> magic{'\x89', 'I', 'V', 'W', 'B'};
+constexpr char formatVersion = 1;
+
+enum Tag : std::uint64_t { End = 0, Element = 1, Text = 2 };
+enum StringCode : std::uint64_t { Intern = 0, Literal = 1, Table = 2 };
+
+// Values longer than this are rarely repeated, keep them out of the string table.
+constexpr size_t maxInternedLength = 64;
+
+// Numbers are almost never repeated, interning them only grows the string table and slows down
+// both writing and reading. Intern the short non-numeric values, like types and identifiers.
+bool internValue(const std::string& str) {
+    if (str.empty() || str.size() > maxInternedLength) return false;
+    const auto c = str.front();
+    return !(std::isdigit(static_cast<unsigned char>(c)) || c == '-' || c == '+' || c == '.');
+}
+
+class BinaryWriter : public TiXmlVisitor {
+public:
+    BinaryWriter(std::ostream& stream) : stream_{stream} {
+        write(magic.data(), magic.size());
+        write(&formatVersion, 1);
+    }
+
+    virtual bool VisitExit(const TiXmlDocument&) override {
+        writeVarint(Tag::End);
+        flush();
+        return true;
+    }
+
+    virtual bool VisitEnter(const TiXmlElement& element,
+                            const TiXmlAttribute* firstAttribute) override {
+        writeVarint(Tag::Element);
+        writeString(element.ValueStr(), true);
+
+        size_t count = 0;
+        for (auto attr = firstAttribute; attr; attr = attr->Next()) ++count;
+        writeVarint(count);
+        for (auto attr = firstAttribute; attr; attr = attr->Next()) {
+            writeString(attr->NameTStr(), true);
+            writeString(attr->ValueStr(), internValue(attr->ValueStr()));
+        }
+        return true;
+    }
+
+    virtual bool VisitExit(const TiXmlElement&) override {
+        writeVarint(Tag::End);
+        return true;
+    }
+
+    virtual bool Visit(const TiXmlText& text) override {
+        writeVarint(Tag::Text);
+        writeString(text.ValueStr(), false);
+        return true;
+    }
+
+private:
+    void writeString(const std::string& str, bool intern) {
+        if (intern) {
+            auto it = table_.find(str);
+            if (it != table_.end()) {
+                writeVarint(StringCode::Table + it->second);
+                return;
+            }
+            table_.emplace(str, table_.size());
+        }
+        writeVarint(intern ? StringCode::Intern : StringCode::Literal);
+        writeVarint(str.size());
+        write(str.data(), str.size());
+    }
+
+    void writeVarint(std::uint64_t value) {
+        if (size_ + 10 > buffer_.size()) flush();
+        while (value >= 0x80) {
+            buffer_[size_++] = static_cast<char>((value & 0x7f) | 0x80);
+            value >>= 7;
+        }
+        buffer_[size_++] = static_cast<char>(value);
+    }
+
+    void write(const char* data, size_t size) {
+        if (size_ + size > buffer_.size()) {
+            flush();
+            if (size > buffer_.size()) {
+                stream_.write(data, size);
+                return;
+            }
+        }
+        std::copy(data, data + size, buffer_.data() + size_);
+        size_ += size;
+    }
+
+    void flush() {
+        stream_.write(buffer_.data(), size_);
+        size_ = 0;
+    }
+
+    std::ostream& stream_;
+    std::array<char, 1 << 16> buffer_;
+    size_t size_ = 0;
+    std::unordered_map<std::string, size_t> table_;
+};
+
+class BinaryReader {
+public:
+    BinaryReader(std::istream& stream) : buf_{stream.rdbuf()} {
+        std::array<char, magic.size() + 1> header;
+        read(header.data(), header.size());
+        if (!std::equal(magic.begin(), magic.end(), header.begin())) {
+            throw SerializationException("Not a binary serialization", IVW_CONTEXT);
+        }
+        if (header.back() != formatVersion) {
+            throw SerializationException(
+                "Unsupported binary serialization version: " + std::to_string(header.back()),
+                IVW_CONTEXT);
+        }
+    }
+
+    std::uint64_t readVarint() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const auto byte = static_cast<unsigned char>(get());
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) return value;
+        }
+        throw SerializationException("Corrupt binary serialization, invalid integer",
+                                     IVW_CONTEXT);
+    }
+
+    // The returned reference stays valid until the next call for literals, and for the lifetime
+    // of the reader for interned strings.
+    const std::string& readString() {
+        const auto code = readVarint();
+        if (code >= StringCode::Table) {
+            const auto index = code - StringCode::Table;
+            if (index >= table_.size()) {
+                throw SerializationException("Corrupt binary serialization, invalid string",
+                                             IVW_CONTEXT);
+            }
+            return table_[index];
+        }
+        auto& str = code == StringCode::Intern ? table_.emplace_back() : literal_;
+        str.resize(readVarint());
+        read(str.data(), str.size());
+        return str;
+    }
+
+private:
+    // Read straight from the stream buffer, which does the buffering, so that nothing after the
+    // end of the serialization is consumed from the stream.
+    char get() {
+        const auto c = buf_->sbumpc();
+        if (c == std::char_traits<char>::eof()) {
+            throw SerializationException("Unexpected end of binary serialization", IVW_CONTEXT);
+        }
+        return std::char_traits<char>::to_char_type(c);
+    }
+
+    void read(char* data, size_t size) {
+        if (buf_->sgetn(data, static_cast<std::streamsize>(size)) !=
+            static_cast<std::streamsize>(size)) {
+            throw SerializationException("Unexpected end of binary serialization", IVW_CONTEXT);
+        }
+    }
+
+    std::streambuf* buf_;
+    std::deque<std::string> table_;
+    std::string literal_;
+};
+
+}  // namespace
+
+void util::writeBinarySerialization(const TxDocument& doc, std::ostream& stream) {
+    BinaryWriter writer{stream};
+    doc.Accept(&writer);
+    if (!stream) {
+        throw SerializationException("Could not write binary serialization",
+                                     IVW_CONTEXT_CUSTOM("Serializer"));
+    }
+}
+
+bool util::isBinarySerialization(std::istream& stream) {
+    return stream.peek() == static_cast<unsigned char>(magic.front());
+}
+
+void util::readBinarySerialization(std::istream& stream, TxDocument& doc) {
+    BinaryReader reader{stream};
+
+    // The open elements, the document is the parent of the outermost ones.
+    std::vector<std::unique_ptr<TxElement>> stack;
+    const auto parent = [&]() -> TxNode* {
+        return stack.empty() ? static_cast<TxNode*>(&doc) : stack.back().get();
+    };
+
+    try {
+        for (;;) {
+            switch (reader.readVarint()) {
+                case Tag::Element: {
+                    auto element = std::make_unique<TxElement>(reader.readString());
+                    for (auto count = reader.readVarint(); count > 0; --count) {
+                        const std::string name = reader.readString();
+                        element->SetAttribute(name, reader.readString());
+                    }
+                    parent()->LinkEndChild(element.get());
+                    stack.push_back(std::move(element));
+                    break;
+                }
+                case Tag::Text: {
+                    auto text = std::make_unique<ticpp::Text>(reader.readString());
+                    parent()->LinkEndChild(text.get());
+                    break;
+                }
+                case Tag::End: {
+                    if (stack.empty()) return;
+                    stack.pop_back();
+                    break;
+                }
+                default:
+                    throw SerializationException("Corrupt binary serialization, unknown record",
+                                                 IVW_CONTEXT_CUSTOM("Deserializer"));
+            }
+        }
+    } catch (TxException& e) {
+        throw SerializationException(e.what(), IVW_CONTEXT_CUSTOM("Deserializer"));
+    }
+}
+
+}  // namespace inviwo
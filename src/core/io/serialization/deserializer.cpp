@@ -38,6 +38,8 @@
 #include <inviwo/core/util/factory.h>
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/io/serialization/binaryserialization.h>
 
 #include <inviwo/core/io/serialization/ticpp.h>
 
@@ -46,7 +48,12 @@ namespace inviwo {
 Deserializer::Deserializer(std::string fileName, bool allowReference)
     : SerializeBase(fileName, allowReference) {
     try {
-        doc_->LoadFile();
+        auto stream = filesystem::ifstream(fileName, std::ios::in | std::ios::binary);
+        if (stream.is_open() && util::isBinarySerialization(stream)) {
+            util::readBinarySerialization(stream, *doc_);
+        } else {
+            doc_->LoadFile();
+        }
         rootElement_ = doc_->FirstChildElement();
         storeReferences(rootElement_);
         rootElement_->GetAttribute(SerializeConstants::VersionAttribute, &inviwoWorkspaceVersion_,
@@ -31,6 +31,7 @@
 #include <inviwo/core/io/serialization/serializer.h>
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/io/serialization/ticpp.h>
+#include <inviwo/core/io/serialization/binaryserialization.h>
 
 namespace inviwo {
 
@@ -114,4 +115,16 @@ void Serializer::writeFile(std::ostream& stream, bool format) {
     }
 }
 
+void Serializer::writeFile(std::ostream& stream, SerializationFormat format) {
+    switch (format) {
+        case SerializationFormat::Xml:
+            writeFile(stream, true);
+            break;
+        case SerializationFormat::Binary:
+            refDataContainer_.setReferenceAttributes();
+            util::writeBinarySerialization(*doc_, stream);
+            break;
+    }
+}
+
 }  // namespace inviwo
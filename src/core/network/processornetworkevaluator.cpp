@@ -30,18 +30,47 @@
 #include <inviwo/core/network/processornetworkevaluator.h>
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/processors/processor.h>
+#include <inviwo/core/ports/inport.h>
+#include <inviwo/core/ports/outport.h>
+#include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/network/networkutils.h>
 #include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/portconnection.h>
 #include <inviwo/core/util/clock.h>
+#include <inviwo/core/util/rendercontext.h>
+#include <inviwo/core/util/tracing.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 
 namespace inviwo {
 
+namespace {
+
+// Only processors that explicitly opt in are processed on the pool, since process() of most
+// processors sets properties or otherwise expects to run on the main thread.
+bool isConcurrent(const Processor* processor) {
+    const auto tags = processor->getTags();
+    return tags.getMatches(Tags::Concurrent) > 0 && tags.getMatches(Tags::GL) == 0 &&
+           tags.getMatches(Tags::CL) == 0 && tags.getMatches(Tags::PY) == 0;
+}
+
+}  // namespace
+
 ProcessorNetworkEvaluator::ProcessorNetworkEvaluator(ProcessorNetwork* processorNetwork)
     : processorNetwork_(processorNetwork)
-    , processorsSorted_(util::topologicalSortFiltered(processorNetwork_))
+    , order_()
+    , orderDirty_(true)
+    , processorsSorted_()
+    , sortedDirty_(true)
     , evaulationQueued_(false)
+    , parallel_(false)
     , exceptionHandler_(StandardEvaluationErrorHandler()) {
 
     processorNetwork_->addObserver(this);
@@ -51,6 +80,21 @@ void ProcessorNetworkEvaluator::setExceptionHandler(EvaluationErrorHandler handl
     exceptionHandler_ = handler;
 }
 
+void ProcessorNetworkEvaluator::setParallelEvaluation(bool parallel) {
+    parallel_ = parallel;
+    timing_ = EvaluationTiming{};
+}
+
+bool ProcessorNetworkEvaluator::getParallelEvaluation() const { return parallel_; }
+
+const EvaluationTiming& ProcessorNetworkEvaluator::getLastEvaluationTiming() const {
+    return timing_;
+}
+
+ProcessorStatistics& ProcessorNetworkEvaluator::getStatistics() { return statistics_; }
+
+const ProcessorStatistics& ProcessorNetworkEvaluator::getStatistics() const { return statistics_; }
+
 void ProcessorNetworkEvaluator::onProcessorNetworkEvaluateRequest() {
     // Direct request, thus we don't want to queue the evaluation anymore
     evaulationQueued_ = false;
@@ -101,86 +145,329 @@ void ProcessorNetworkEvaluator::evaluate() {
 
     IVW_CPU_PROFILING_IF(500, "Evaluated Processor Network");
 
+    updateSorted();
+
+    if (parallel_) {
+        evaluateParallel();
+    } else {
+        evaluateSerial();
+    }
+
+    notifyObserversProcessorNetworkEvaluationEnd();
+}
+
+void ProcessorNetworkEvaluator::updateSorted() {
+    if (orderDirty_) {
+        order_.rebuild(processorNetwork_->getProcessors());
+        orderDirty_ = false;
+        sortedDirty_ = true;
+    }
+    if (sortedDirty_) {
+        processorsSorted_ = order_.getSinkConnectedProcessors();
+        sortedDirty_ = false;
+    }
+}
+
+void ProcessorNetworkEvaluator::evaluateSerial() {
     for (auto processor : processorsSorted_) {
         if (!processor->isValid()) {
             if (processor->isReady()) {
-                try {
-                    // re-initialize resources (e.g., shaders) if necessary
-                    if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
-                        processor->initializeResources();
+                if (!prepare(processor)) continue;
+                processor->notifyObserversAboutToProcess(processor);
+                process(processor);
+                finish(processor);
+            } else {
+                notReady(processor);
+            }
+        }
+    }
+}
+
+void ProcessorNetworkEvaluator::evaluateParallel() {
+    using clock = std::chrono::high_resolution_clock;
+
+    timing_ = EvaluationTiming{};
+    evaluationStart_ = clock::now();
+
+    const auto preds = predecessors();
+    const auto count = processorsSorted_.size();
+
+    std::vector<std::vector<size_t>> successors(count);
+    std::vector<size_t> missing(count, 0);  // number of predecessors not yet done
+    for (size_t i = 0; i < count; ++i) {
+        missing[i] = preds[i].size();
+        for (auto pred : preds[i]) successors[pred].push_back(i);
+    }
+
+    // Processors with all predecessors done, ordered by their topological index to match the
+    // serial evaluation order as far as possible
+    std::set<size_t> ready;
+    for (size_t i = 0; i < count; ++i) {
+        if (missing[i] == 0) ready.insert(i);
+    }
+    const auto done = [&](size_t i) {
+        for (auto succ : successors[i]) {
+            if (--missing[succ] == 0) ready.insert(succ);
+        }
+    };
+
+    struct Result {
+        size_t index;
+        std::exception_ptr exception;
+        clock::time_point start;
+        clock::time_point end;
+    };
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<Result> results;
+    size_t running = 0;
+
+    auto& pool = processorNetwork_->getApplication()->getThreadPool();
+
+    while (!ready.empty() || running > 0) {
+        while (!ready.empty()) {
+            // Dispatch concurrent processors first so that they overlap with the ones that have
+            // to run on this thread.
+            auto it = std::find_if(ready.begin(), ready.end(),
+                                   [&](size_t i) { return isConcurrent(processorsSorted_[i]); });
+            if (it == ready.end()) it = ready.begin();
+            const auto index = *it;
+            ready.erase(it);
+
+            auto processor = processorsSorted_[index];
+            if (processor->isValid()) {
+                done(index);
+                continue;
+            }
+            if (!processor->isReady()) {
+                notReady(processor);
+                done(index);
+                continue;
+            }
+            if (!prepare(processor)) {
+                done(index);
+                continue;
+            }
+
+            processor->notifyObserversAboutToProcess(processor);
+
+            if (isConcurrent(processor)) {
+                ++running;
+                pool.enqueueTask([&, index, processor]() {
+                    Result result{index, nullptr, clock::now(), {}};
+                    try {
+                        // Representation conversions of the inputs might need a GL context
+                        auto context = RenderContext::getPtr();
+                        if (context->getDefaultRenderContext()) {
+                            context->activateLocalRenderContext();
+                        }
+                        IVW_TRACE_SCOPE_DETAIL("processor", "process", processor->getIdentifier());
+                        ProcessorStatistics::ProcessScope statistics{statistics_, processor};
+                        processor->process();
+                    } catch (...) {
+                        result.exception = std::current_exception();
                     }
+                    result.end = clock::now();
 
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
-                    processor->setValid();
-                    continue;
-                }
+                    std::unique_lock<std::mutex> lock{mutex};
+                    results.push_back(result);
+                    condition.notify_one();
+                });
+            } else {
+                process(processor);
+                finish(processor);
+                done(index);
+            }
+        }
 
-                try {
-                    // call onChange for all invalid inports
-                    for (auto inport : processor->getInports()) {
-                        inport->callOnChangeIfChanged();
+        if (running > 0) {
+            std::vector<Result> finished;
+            {
+                std::unique_lock<std::mutex> lock{mutex};
+                condition.wait(lock, [&]() { return !results.empty(); });
+                std::swap(finished, results);
+            }
+            for (auto& result : finished) {
+                --running;
+                auto processor = processorsSorted_[result.index];
+                if (result.exception) {
+                    try {
+                        std::rethrow_exception(result.exception);
+                    } catch (...) {
+                        exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
                     }
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::PortOnChange, IVW_CONTEXT);
-                    processor->setValid();
-                    continue;
                 }
+                timing_.processors.push_back({processor, result.start - evaluationStart_,
+                                              result.end - evaluationStart_, true});
+                finish(processor);
+                done(result.index);
+            }
+        }
+    }
 
-                processor->notifyObserversAboutToProcess(processor);
+    timing_.total = clock::now() - evaluationStart_;
+    if (!timing_.processors.empty()) updateCriticalPath(preds);
+}
 
-                try {
-                    IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
-                    // do the actual processing
-                    processor->process();
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
-                }
+bool ProcessorNetworkEvaluator::prepare(Processor* processor) {
+    try {
+        // re-initialize resources (e.g., shaders) if necessary
+        if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
+            IVW_TRACE_SCOPE_DETAIL("processor", "initializeResources",
+                                   processor->getIdentifier());
+            processor->initializeResources();
+        }
 
-                // Set processor as valid only if we still are ready.
-                // Callbacks might have made our inports invalid, if so abort
-                // the evaluation by not setting the processor valid.
-                if (processor->isReady()) processor->setValid();
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::InitResource, IVW_CONTEXT);
+        processor->setValid();
+        return false;
+    }
 
-                processor->notifyObserversFinishedProcess(processor);
+    try {
+        // call onChange for all invalid inports
+        for (auto inport : processor->getInports()) {
+            inport->callOnChangeIfChanged();
+        }
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::PortOnChange, IVW_CONTEXT);
+        processor->setValid();
+        return false;
+    }
+    return true;
+}
 
-            } else {
-                try {
-                    processor->doIfNotReady();
-                } catch (...) {
-                    exceptionHandler_(processor, EvaluationType::NotReady, IVW_CONTEXT);
+void ProcessorNetworkEvaluator::process(Processor* processor) {
+    // Timings are only needed for the critical path of the parallel evaluation
+    const auto start = parallel_ ? std::chrono::high_resolution_clock::now()
+                                 : std::chrono::high_resolution_clock::time_point{};
+    try {
+        IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+        IVW_TRACE_SCOPE_DETAIL("processor", "process", processor->getIdentifier());
+        ProcessorStatistics::ProcessScope statistics{statistics_, processor};
+        // do the actual processing
+        processor->process();
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::Process, IVW_CONTEXT);
+    }
+    if (parallel_) {
+        const auto end = std::chrono::high_resolution_clock::now();
+        timing_.processors.push_back(
+            {processor, start - evaluationStart_, end - evaluationStart_, false});
+    }
+}
+
+void ProcessorNetworkEvaluator::finish(Processor* processor) {
+    // Set processor as valid only if we still are ready.
+    // Callbacks might have made our inports invalid, if so abort
+    // the evaluation by not setting the processor valid.
+    if (processor->isReady()) processor->setValid();
+
+    processor->notifyObserversFinishedProcess(processor);
+}
+
+void ProcessorNetworkEvaluator::notReady(Processor* processor) {
+    try {
+        processor->doIfNotReady();
+    } catch (...) {
+        exceptionHandler_(processor, EvaluationType::NotReady, IVW_CONTEXT);
+    }
+}
+
+std::vector<std::vector<size_t>> ProcessorNetworkEvaluator::predecessors() const {
+    std::unordered_map<Processor*, size_t> indices;
+    for (size_t i = 0; i < processorsSorted_.size(); ++i) indices[processorsSorted_[i]] = i;
+
+    std::vector<std::vector<size_t>> preds(processorsSorted_.size());
+    for (size_t i = 0; i < processorsSorted_.size(); ++i) {
+        auto processor = processorsSorted_[i];
+        for (auto inport : processor->getInports()) {
+            for (auto outport : inport->getConnectedOutports()) {
+                if (!processor->isConnectionActive(inport, outport)) continue;
+                auto it = indices.find(outport->getProcessor());
+                if (it != indices.end() && !util::contains(preds[i], it->second)) {
+                    preds[i].push_back(it->second);
                 }
             }
         }
     }
+    return preds;
+}
 
-    notifyObserversProcessorNetworkEvaluationEnd();
+void ProcessorNetworkEvaluator::updateCriticalPath(
+    const std::vector<std::vector<size_t>>& predecessors) {
+    using duration = EvaluationTiming::duration;
+    const auto count = processorsSorted_.size();
+
+    std::unordered_map<Processor*, duration> processTime;
+    for (const auto& entry : timing_.processors) {
+        processTime[entry.processor] += entry.end - entry.start;
+    }
+
+    // Longest accumulated process time of any chain ending in each processor, processorsSorted_
+    // is in topological order, so all predecessors are visited before their successors.
+    std::vector<duration> pathTime(count, duration{0});
+    std::vector<size_t> parent(count, count);
+    for (size_t i = 0; i < count; ++i) {
+        for (auto pred : predecessors[i]) {
+            if (parent[i] == count || pathTime[pred] > pathTime[parent[i]]) parent[i] = pred;
+        }
+        if (parent[i] != count) pathTime[i] = pathTime[parent[i]];
+        auto it = processTime.find(processorsSorted_[i]);
+        if (it != processTime.end()) pathTime[i] += it->second;
+    }
+
+    const auto last = std::max_element(pathTime.begin(), pathTime.end());
+    timing_.criticalPathTime = *last;
+    for (auto i = static_cast<size_t>(std::distance(pathTime.begin(), last)); i != count;
+         i = parent[i]) {
+        if (processTime.count(processorsSorted_[i]) != 0) {
+            timing_.criticalPath.push_back(processorsSorted_[i]);
+        }
+    }
+    std::reverse(timing_.criticalPath.begin(), timing_.criticalPath.end());
 }
 
-void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor*) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::onProcessorInvalidationBegin(Processor* p) {
+    statistics_.addInvalidation(p);
 }
 
+void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor*) { sortedDirty_ = true; }
+
 void ProcessorNetworkEvaluator::onProcessorActiveConnectionsChanged(Processor*) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    sortedDirty_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidAddProcessor(Processor* p) {
     p->ProcessorObservable::addObserver(this);
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    // Batch the updates while deserializing, the order is rebuilt once before the next evaluation
+    if (processorNetwork_->isDeserializing()) orderDirty_ = true;
+    if (!orderDirty_) order_.addProcessor(p);
+    sortedDirty_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveProcessor(Processor* p) {
     p->ProcessorObservable::removeObserver(this);
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    timing_ = EvaluationTiming{};
+    if (!orderDirty_) order_.removeProcessor(p);
+    // Make sure we never keep a pointer to a removed processor
+    util::erase_remove(processorsSorted_, p);
+    sortedDirty_ = true;
 }
 
-void ProcessorNetworkEvaluator::onProcessorNetworkDidAddConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+void ProcessorNetworkEvaluator::onProcessorNetworkDidAddConnection(
+    const PortConnection& connection) {
+    if (processorNetwork_->isDeserializing()) orderDirty_ = true;
+    if (!orderDirty_) {
+        order_.addConnection(connection.getOutport()->getProcessor(),
+                             connection.getInport()->getProcessor());
+    }
+    sortedDirty_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    // Removing a connection never invalidates the order
+    sortedDirty_ = true;
 }
 
 }  // namespace inviwo
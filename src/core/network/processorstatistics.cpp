@@ -0,0 +1,212 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/network/processorstatistics.h>
+#include <inviwo/core/processors/processor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+
+namespace inviwo {
+
+namespace {
+
+size_t histogramBin(ProcessorStatistics::duration time) {
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+    size_t bin = 0;
+    while (us > 0 && bin < ProcessorStatistics::histogramBins - 1) {
+        us >>= 1;
+        ++bin;
+    }
+    return bin;
+}
+
+double toMs(ProcessorStatistics::duration time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+void writeQuoted(std::ostream& os, const std::string& str, char escape) {
+    os << '"';
+    for (auto c : str) {
+        if (c == '"') {
+            os << escape << c;
+        } else if (c == '\\' && escape == '\\') {
+            os << "\\\\";
+        } else {
+            os << c;
+        }
+    }
+    os << '"';
+}
+
+}  // namespace
+
+auto ProcessorStatistics::Entry::meanProcessTime() const -> duration {
+    if (processCount == 0) return duration{0};
+    return processTime / static_cast<duration::rep>(processCount);
+}
+
+auto ProcessorStatistics::Entry::processTimeQuantile(double q) const -> duration {
+    if (processCount == 0) return duration{0};
+    const auto target = static_cast<size_t>(std::ceil(std::clamp(q, 0.0, 1.0) * processCount));
+    size_t count = 0;
+    for (size_t i = 0; i < histogramBins - 1; ++i) {
+        count += histogram[i];
+        if (count >= std::max(target, size_t{1})) {
+            const auto upper = std::chrono::duration_cast<duration>(
+                std::chrono::microseconds{std::int64_t{1} << i});
+            return std::clamp(upper, minProcessTime, maxProcessTime);
+        }
+    }
+    return maxProcessTime;
+}
+
+void ProcessorStatistics::setEnabled(bool enabled) { enabled_ = enabled; }
+
+bool ProcessorStatistics::isEnabled() const { return enabled_; }
+
+void ProcessorStatistics::reset() {
+    std::scoped_lock lock{mutex_};
+    entries_.clear();
+}
+
+std::vector<ProcessorStatistics::Entry> ProcessorStatistics::getEntries() const {
+    std::vector<Entry> entries;
+    {
+        std::scoped_lock lock{mutex_};
+        entries.reserve(entries_.size());
+        for (const auto& item : entries_) entries.push_back(item.second);
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.processTime != b.processTime ? a.processTime > b.processTime
+                                              : a.identifier < b.identifier;
+    });
+    return entries;
+}
+
+std::optional<ProcessorStatistics::Entry> ProcessorStatistics::getEntry(
+    const std::string& identifier) const {
+    std::scoped_lock lock{mutex_};
+    auto it = entries_.find(identifier);
+    if (it == entries_.end()) return std::nullopt;
+    return it->second;
+}
+
+void ProcessorStatistics::writeJson(std::ostream& os) const {
+    const auto entries = getEntries();
+    os << "{\"processors\":[";
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        const auto& e = *it;
+        os << (it == entries.begin() ? "\n" : ",\n") << "{\"identifier\":";
+        writeQuoted(os, e.identifier, '\\');
+        os << ",\"classIdentifier\":";
+        writeQuoted(os, e.classIdentifier, '\\');
+        os << ",\"processCount\":" << e.processCount
+           << ",\"processTime\":" << toMs(e.processTime)
+           << ",\"meanProcessTime\":" << toMs(e.meanProcessTime())
+           << ",\"minProcessTime\":" << toMs(e.processCount > 0 ? e.minProcessTime : duration{0})
+           << ",\"maxProcessTime\":" << toMs(e.maxProcessTime) << ",\"histogram\":[";
+        for (size_t i = 0; i < histogramBins; ++i) os << (i == 0 ? "" : ",") << e.histogram[i];
+        os << "],\"invalidationCount\":" << e.invalidationCount
+           << ",\"conversionCount\":" << e.conversionCount
+           << ",\"conversionTime\":" << toMs(e.conversionTime)
+           << ",\"bytesAllocated\":" << e.bytesAllocated << "}";
+    }
+    os << "\n],\"timeUnit\":\"ms\"}\n";
+}
+
+void ProcessorStatistics::writeCsv(std::ostream& os) const {
+    os << "identifier,classIdentifier,processCount,processTime,meanProcessTime,minProcessTime,"
+          "maxProcessTime,medianProcessTime,p95ProcessTime,invalidationCount,conversionCount,"
+          "conversionTime,bytesAllocated\n";
+    for (const auto& e : getEntries()) {
+        writeQuoted(os, e.identifier, '"');
+        os << ',';
+        writeQuoted(os, e.classIdentifier, '"');
+        os << ',' << e.processCount << ',' << toMs(e.processTime) << ','
+           << toMs(e.meanProcessTime()) << ','
+           << toMs(e.processCount > 0 ? e.minProcessTime : duration{0}) << ','
+           << toMs(e.maxProcessTime) << ',' << toMs(e.processTimeQuantile(0.5)) << ','
+           << toMs(e.processTimeQuantile(0.95)) << ',' << e.invalidationCount << ','
+           << e.conversionCount << ',' << toMs(e.conversionTime) << ',' << e.bytesAllocated
+           << '\n';
+    }
+}
+
+void ProcessorStatistics::addInvalidation(Processor* processor) {
+    if (!enabled_) return;
+    std::scoped_lock lock{mutex_};
+    ++entry(processor).invalidationCount;
+}
+
+ProcessorStatistics::Entry& ProcessorStatistics::entry(Processor* processor) {
+    auto& e = entries_[processor->getIdentifier()];
+    if (e.identifier.empty()) {
+        e.identifier = processor->getIdentifier();
+        e.classIdentifier = processor->getClassIdentifier();
+    }
+    return e;
+}
+
+ProcessorStatistics::ProcessScope::ProcessScope(ProcessorStatistics& statistics,
+                                                Processor* processor)
+    : statistics_{statistics.isEnabled() ? &statistics : nullptr}, processor_{processor} {
+    if (statistics_) {
+        previous_ = ConversionStatistics::setCurrent(this);
+        start_ = clock::now();
+    }
+}
+
+ProcessorStatistics::ProcessScope::~ProcessScope() {
+    if (!statistics_) return;
+    const auto time = clock::now() - start_;
+    ConversionStatistics::setCurrent(previous_);
+
+    std::scoped_lock lock{statistics_->mutex_};
+    auto& e = statistics_->entry(processor_);
+    ++e.processCount;
+    e.processTime += time;
+    e.minProcessTime = std::min(e.minProcessTime, time);
+    e.maxProcessTime = std::max(e.maxProcessTime, time);
+    ++e.histogram[histogramBin(time)];
+    e.conversionCount += conversionCount_;
+    e.conversionTime += conversionTime_;
+    e.bytesAllocated += bytesAllocated_;
+}
+
+void ProcessorStatistics::ProcessScope::addConversion(clock::duration time) {
+    ++conversionCount_;
+    conversionTime_ += time;
+}
+
+void ProcessorStatistics::ProcessScope::addAllocation(size_t bytes) { bytesAllocated_ += bytes; }
+
+}  // namespace inviwo
@@ -0,0 +1,213 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/network/topologicalorder.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/ports/inport.h>
+#include <inviwo/core/ports/outport.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+
+template <typename F>
+void forEachSuccessor(Processor* processor, F&& func) {
+    for (auto outport : processor->getOutports()) {
+        for (auto inport : outport->getConnectedInports()) {
+            func(inport->getProcessor());
+        }
+    }
+}
+
+template <typename F>
+void forEachPredecessor(Processor* processor, F&& func) {
+    for (auto inport : processor->getInports()) {
+        for (auto outport : inport->getConnectedOutports()) {
+            func(outport->getProcessor());
+        }
+    }
+}
+
+}  // namespace
+
+void TopologicalOrder::rebuild(const std::vector<Processor*>& processors) {
+    order_.clear();
+    index_.clear();
+    removed_ = 0;
+
+    // Kahn's algorithm, counting every connection
+    std::unordered_map<Processor*, size_t> inDegree;
+    for (auto processor : processors) {
+        auto& degree = inDegree[processor];
+        forEachPredecessor(processor, [&](Processor*) { ++degree; });
+    }
+
+    order_.reserve(processors.size());
+    for (auto processor : processors) {
+        if (inDegree[processor] == 0) order_.push_back(processor);
+    }
+    for (size_t i = 0; i < order_.size(); ++i) {
+        forEachSuccessor(order_[i], [&](Processor* succ) {
+            auto it = inDegree.find(succ);
+            if (it != inDegree.end() && --(it->second) == 0) order_.push_back(succ);
+        });
+    }
+
+    for (size_t i = 0; i < order_.size(); ++i) index_[order_[i]] = i;
+}
+
+void TopologicalOrder::addProcessor(Processor* processor) {
+    if (contains(processor)) return;
+    index_[processor] = order_.size();
+    order_.push_back(processor);
+}
+
+void TopologicalOrder::removeProcessor(Processor* processor) {
+    auto it = index_.find(processor);
+    if (it == index_.end()) return;
+    order_[it->second] = nullptr;
+    index_.erase(it);
+    if (++removed_ > order_.size() / 2) compact();
+}
+
+void TopologicalOrder::addConnection(Processor* from, Processor* to) {
+    auto fromIt = index_.find(from);
+    auto toIt = index_.find(to);
+    if (fromIt == index_.end() || toIt == index_.end()) return;
+
+    const auto upper = fromIt->second;
+    const auto lower = toIt->second;
+    if (upper < lower) return;  // The order is still valid
+
+    // Find the processors in the affected region [lower, upper] that are reachable from "to"
+    // (forward) and those that can reach "from" (backward). The network has no cycles so the two
+    // sets are disjoint.
+    std::vector<size_t> forward;
+    std::vector<size_t> backward;
+    std::vector<Processor*> stack;
+
+    std::vector<bool> visited(upper - lower + 1, false);
+    const auto visit = [&](Processor* p, bool isForward) {
+        auto it = index_.find(p);
+        if (it == index_.end()) return;
+        const auto i = it->second;
+        if (i < lower || i > upper || visited[i - lower]) return;
+        // forward search stays below upper, backward search stays above lower
+        if ((isForward && i == upper) || (!isForward && i == lower)) return;
+        visited[i - lower] = true;
+        (isForward ? forward : backward).push_back(i);
+        stack.push_back(p);
+    };
+
+    visit(to, true);
+    while (!stack.empty()) {
+        auto p = stack.back();
+        stack.pop_back();
+        forEachSuccessor(p, [&](Processor* succ) { visit(succ, true); });
+    }
+    visit(from, false);
+    while (!stack.empty()) {
+        auto p = stack.back();
+        stack.pop_back();
+        forEachPredecessor(p, [&](Processor* pred) { visit(pred, false); });
+    }
+
+    // Reassign the occupied slots, first all of the backward set, then the forward set, both
+    // keeping their relative order.
+    std::sort(forward.begin(), forward.end());
+    std::sort(backward.begin(), backward.end());
+    std::vector<Processor*> processors;
+    processors.reserve(forward.size() + backward.size());
+    for (auto i : backward) processors.push_back(order_[i]);
+    for (auto i : forward) processors.push_back(order_[i]);
+
+    std::vector<size_t> slots;
+    slots.reserve(forward.size() + backward.size());
+    std::merge(backward.begin(), backward.end(), forward.begin(), forward.end(),
+               std::back_inserter(slots));
+
+    for (size_t i = 0; i < slots.size(); ++i) {
+        order_[slots[i]] = processors[i];
+        index_[processors[i]] = slots[i];
+    }
+}
+
+bool TopologicalOrder::contains(Processor* processor) const {
+    return index_.find(processor) != index_.end();
+}
+
+std::vector<Processor*> TopologicalOrder::getProcessors() const {
+    std::vector<Processor*> processors;
+    processors.reserve(index_.size());
+    std::copy_if(order_.begin(), order_.end(), std::back_inserter(processors),
+                 [](Processor* p) { return p != nullptr; });
+    return processors;
+}
+
+std::vector<Processor*> TopologicalOrder::getSinkConnectedProcessors() const {
+    // Visit the processors in reverse order, all successors are then visited before their
+    // predecessors.
+    std::vector<bool> connected(order_.size(), false);
+    for (size_t i = order_.size(); i-- > 0;) {
+        auto processor = order_[i];
+        if (!processor) continue;
+        if (processor->isSink()) {
+            connected[i] = true;
+            continue;
+        }
+        for (auto outport : processor->getOutports()) {
+            for (auto inport : outport->getConnectedInports()) {
+                auto succ = inport->getProcessor();
+                auto it = index_.find(succ);
+                if (it != index_.end() && connected[it->second] &&
+                    succ->isConnectionActive(inport, outport)) {
+                    connected[i] = true;
+                    break;
+                }
+            }
+            if (connected[i]) break;
+        }
+    }
+
+    std::vector<Processor*> processors;
+    for (size_t i = 0; i < order_.size(); ++i) {
+        if (connected[i]) processors.push_back(order_[i]);
+    }
+    return processors;
+}
+
+void TopologicalOrder::compact() {
+    order_.erase(std::remove(order_.begin(), order_.end(), nullptr), order_.end());
+    for (size_t i = 0; i < order_.size(); ++i) index_[order_[i]] = i;
+    removed_ = 0;
+}
+
+}  // namespace inviwo
@@ -35,6 +35,7 @@
 #include <inviwo/core/util/inviwosetupinfo.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/io/serialization/serialization.h>
+#include <inviwo/core/io/serialization/binaryserialization.h>
 
 #include <fmt/format.h>
 #include <fmt/ostream.h>
@@ -148,7 +149,9 @@ void WorkspaceManager::save(std::ostream& stream, const std::string& refPath,
     }
 
     serializers_.invoke(serializer, exceptionHandler, mode);
-    serializer.writeFile(stream, true);
+    // Undo states are never read by a human, use the much faster binary encoding for those.
+    serializer.writeFile(stream, mode == WorkspaceSaveMode::Undo ? SerializationFormat::Binary
+                                                                 : SerializationFormat::Xml);
 }
 
 void WorkspaceManager::load(std::istream& stream, const std::string& refPath,
@@ -166,7 +169,8 @@ void WorkspaceManager::load(std::istream& stream, const std::string& refPath,
 
 void WorkspaceManager::save(const std::string& path, const ExceptionHandler& exceptionHandler,
                             WorkspaceSaveMode mode) {
-    auto ostream = filesystem::ofstream(path);
+    auto ostream = filesystem::ofstream(
+        path, mode == WorkspaceSaveMode::Undo ? std::ios::out | std::ios::binary : std::ios::out);
     if (ostream.is_open()) {
         save(ostream, path, exceptionHandler, mode);
     } else {
@@ -175,7 +179,11 @@ void WorkspaceManager::save(const std::string& path, const ExceptionHandler& exc
 }
 
 void WorkspaceManager::load(const std::string& path, const ExceptionHandler& exceptionHandler) {
-    auto istream = filesystem::ifstream(path);
+    auto istream = filesystem::ifstream(path, std::ios::in | std::ios::binary);
+    if (istream.is_open() && !util::isBinarySerialization(istream)) {
+        // Xml workspaces are read in text mode to get the platform line endings translated
+        istream = filesystem::ifstream(path);
+    }
     if (istream.is_open()) {
         load(istream, path, exceptionHandler);
     } else {
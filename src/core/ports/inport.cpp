@@ -31,6 +31,7 @@
 #include <inviwo/core/ports/outport.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/tracing.h>
 
 namespace inviwo {
 
@@ -146,6 +147,7 @@ const std::vector<Outport*>& Inport::getConnectedOutports() const { return conne
 
 void Inport::callOnChangeIfChanged() const {
     if (isChanged()) {
+        IVW_TRACE_SCOPE_DETAIL("inport", "onChange", identifier_);
         onChangeCallback_.invokeAll();
     }
 }
@@ -48,6 +48,7 @@ const Tag Tag::GL("GL");
 const Tag Tag::CL("CL");
 const Tag Tag::CPU("CPU");
 const Tag Tag::PY("PY");
+const Tag Tag::Concurrent("Concurrent");
 
 Tags::Tags(const Tag& tag) : tags_{tag} {}
 
@@ -126,6 +127,7 @@ const Tags Tags::GL{Tag::GL};
 const Tags Tags::CL{Tag::CL};
 const Tags Tags::CPU{Tag::CPU};
 const Tags Tags::PY{Tag::PY};
+const Tags Tags::Concurrent{Tag::Concurrent};
 
 namespace util {
 
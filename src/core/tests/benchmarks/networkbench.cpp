@@ -0,0 +1,213 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/processorfactory.h>
+#include <inviwo/core/processors/processorfactoryobject.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/workspacemanager.h>
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/core/ports/dataoutport.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <sstream>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+class BenchFilter : public Processor {
+public:
+    BenchFilter(const std::string& id, const std::string& name) : Processor(id, name) {
+        addPort(inport_);
+        addPort(outport_);
+        inport_.setOptional(true);
+    }
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    virtual void process() override { outport_.setData(std::make_shared<int>(0)); }
+
+    static const ProcessorInfo processorInfo_;
+
+private:
+    DataInport<int, 0> inport_{"inport"};
+    DataOutport<int> outport_{"outport"};
+};
+
+const ProcessorInfo BenchFilter::processorInfo_{
+    "org.inviwo.BenchFilter",  // Class identifier
+    "Bench Filter",            // Display name
+    "Benchmark",               // Category
+    CodeState::Stable,         // Code state
+    Tags::CPU,                 // Tags
+};
+
+class BenchSink : public Processor {
+public:
+    BenchSink(const std::string& id, const std::string& name) : Processor(id, name) {
+        addPort(inport_);
+    }
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    virtual void process() override {}
+
+    static const ProcessorInfo processorInfo_;
+
+private:
+    DataInport<int, 0> inport_{"inport"};
+};
+
+const ProcessorInfo BenchSink::processorInfo_{
+    "org.inviwo.BenchSink",  // Class identifier
+    "Bench Sink",            // Display name
+    "Benchmark",             // Category
+    CodeState::Stable,       // Code state
+    Tags::CPU,               // Tags
+};
+
+void registerProcessors(InviwoApplication* app) {
+    static auto filter = [&]() {
+        auto pfo = std::make_unique<ProcessorFactoryObjectTemplate<BenchFilter>>();
+        app->getProcessorFactory()->registerObject(pfo.get());
+        return pfo;
+    }();
+    static auto sink = [&]() {
+        auto pfo = std::make_unique<ProcessorFactoryObjectTemplate<BenchSink>>();
+        app->getProcessorFactory()->registerObject(pfo.get());
+        return pfo;
+    }();
+}
+
+/**
+ * Build a layered network with "width" processors per layer, where every processor is connected
+ * to "fanIn" random processors of the previous layer, and the last layer consists of sinks.
+ * Processors and connections are added in a random order.
+ */
+void buildNetwork(ProcessorNetwork* network, size_t processors, size_t width, size_t fanIn,
+                  bool lock) {
+    std::mt19937 rand(42);
+    const size_t layers = std::max(size_t{2}, processors / width);
+
+    std::vector<std::vector<Processor*>> layer(layers);
+    std::vector<std::pair<size_t, size_t>> order;
+    for (size_t l = 0; l < layers; ++l) {
+        for (size_t i = 0; i < width; ++i) order.emplace_back(l, i);
+    }
+    std::shuffle(order.begin(), order.end(), rand);
+
+    NetworkLock networkLock(lock ? network : nullptr);
+    for (size_t l = 0; l < layers; ++l) layer[l].resize(width);
+    for (auto [l, i] : order) {
+        std::unique_ptr<Processor> p;
+        if (l + 1 == layers) {
+            p = std::make_unique<BenchSink>("sink", "sink");
+        } else {
+            p = std::make_unique<BenchFilter>("filter", "filter");
+        }
+        layer[l][i] = network->addProcessor(std::move(p));
+    }
+
+    std::vector<std::pair<Outport*, Inport*>> connections;
+    std::uniform_int_distribution<size_t> dist(0, width - 1);
+    for (size_t l = 1; l < layers; ++l) {
+        for (auto p : layer[l]) {
+            for (size_t i = 0; i < fanIn; ++i) {
+                connections.emplace_back(layer[l - 1][dist(rand)]->getOutports()[0],
+                                         p->getInports()[0]);
+            }
+        }
+    }
+    std::shuffle(connections.begin(), connections.end(), rand);
+    for (auto [outport, inport] : connections) {
+        if (!outport->isConnectedTo(inport)) network->addConnection(outport, inport);
+    }
+}
+
+}  // namespace
+
+/**
+ * Load a synthetic workspace, this adds all processors and connections while deserializing.
+ * range(0): number of processors
+ */
+static void LoadWorkspace(benchmark::State& state) {
+    auto app = InviwoApplication::getPtr();
+    registerProcessors(app);
+    auto wm = app->getWorkspaceManager();
+    const auto processors = static_cast<size_t>(state.range(0));
+
+    wm->clear();
+    buildNetwork(app->getProcessorNetwork(), processors, 16, 2, true);
+    std::stringstream workspace;
+    wm->save(workspace, "");
+    wm->clear();
+
+    for (auto _ : state) {
+        workspace.clear();
+        workspace.seekg(0);
+        wm->load(workspace, "");
+
+        state.PauseTiming();
+        wm->clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * processors);
+}
+
+/**
+ * Build a synthetic network processor by processor and connection by connection, every change
+ * is done while the network is unlocked.
+ * range(0): number of processors
+ */
+static void BuildNetwork(benchmark::State& state) {
+    auto app = InviwoApplication::getPtr();
+    registerProcessors(app);
+    auto wm = app->getWorkspaceManager();
+    const auto processors = static_cast<size_t>(state.range(0));
+
+    wm->clear();
+    for (auto _ : state) {
+        buildNetwork(app->getProcessorNetwork(), processors, 16, 2, false);
+
+        state.PauseTiming();
+        wm->clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * processors);
+}
+
+BENCHMARK(LoadWorkspace)->RangeMultiplier(4)->Range(64, 4096)->Unit(benchmark::kMillisecond);
+BENCHMARK(BuildNetwork)->RangeMultiplier(4)->Range(64, 1024)->Unit(benchmark::kMillisecond);
+
+#include <warn/pop>
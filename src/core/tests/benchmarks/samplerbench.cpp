@@ -0,0 +1,118 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumesampler.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+template <typename T>
+std::shared_ptr<Volume> makeVolume() {
+    const size3_t dims{128, 128, 128};
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(dims);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.0, 100.0);
+    auto data = ram->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        data[i] = util::glm_convert<T>(dvec4{dist(gen), dist(gen), dist(gen), dist(gen)});
+    }
+    return std::make_shared<Volume>(ram);
+}
+
+std::vector<dvec3> makePositions(size_t count) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<dvec3> positions(count);
+    for (auto& p : positions) p = dvec3{dist(gen), dist(gen), dist(gen)};
+    return positions;
+}
+
+}  // namespace
+
+/**
+ * Sample random positions one at a time, through the virtual sample() and getAsDVec calls.
+ * range(0): number of positions
+ * items per second: samples per second
+ */
+template <typename T, unsigned int DataDims>
+static void SampleScalar(benchmark::State& state) {
+    const auto volume = makeVolume<T>();
+    const auto positions = makePositions(static_cast<size_t>(state.range(0)));
+    VolumeDoubleSampler<DataDims> sampler{volume};
+    std::vector<Vector<DataDims, double>> result(positions.size());
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < positions.size(); ++i) result[i] = sampler.sample(positions[i]);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+/**
+ * Sample random positions with the batched sample(), using util::sampleTrilinear.
+ * range(0): number of positions
+ * items per second: samples per second
+ */
+template <typename T, unsigned int DataDims>
+static void SampleBatched(benchmark::State& state) {
+    const auto volume = makeVolume<T>();
+    const auto positions = makePositions(static_cast<size_t>(state.range(0)));
+    VolumeDoubleSampler<DataDims> sampler{volume};
+    std::vector<Vector<DataDims, double>> result(positions.size());
+
+    for (auto _ : state) {
+        sampler.sample(positions, result);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(SampleScalar, float, 1)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(SampleBatched, float, 1)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(SampleScalar, f16, 1)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(SampleBatched, f16, 1)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(SampleScalar, glm::u16, 1)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(SampleBatched, glm::u16, 1)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(SampleScalar, vec3, 3)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(SampleBatched, vec3, 3)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(SampleScalar, glm::u8vec4, 4)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(SampleBatched, glm::u8vec4, 4)->Arg(1 << 16);
+
+#include <warn/pop>
@@ -0,0 +1,290 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/io/serialization/serialization.h>
+#include <inviwo/core/io/serialization/binaryserialization.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <sstream>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+struct BenchProperty : Serializable {
+    std::string identifier;
+    std::string displayName;
+    double value = 0.0;
+    dvec2 range{0.0, 1.0};
+    bool readOnly = false;
+
+    virtual void serialize(Serializer& s) const override {
+        s.serialize("type", std::string{"org.inviwo.DoubleProperty"},
+                    SerializationTarget::Attribute);
+        s.serialize("identifier", identifier, SerializationTarget::Attribute);
+        s.serialize("displayName", displayName);
+        s.serialize("value", value);
+        s.serialize("range", range);
+        s.serialize("readonly", readOnly);
+    }
+    virtual void deserialize(Deserializer& d) override {
+        d.deserialize("identifier", identifier, SerializationTarget::Attribute);
+        d.deserialize("displayName", displayName);
+        d.deserialize("value", value);
+        d.deserialize("range", range);
+        d.deserialize("readonly", readOnly);
+    }
+};
+
+struct BenchListItem : Serializable {
+    std::vector<BenchProperty> properties;
+
+    virtual void serialize(Serializer& s) const override {
+        s.serialize("Properties", properties, "Property");
+    }
+    virtual void deserialize(Deserializer& d) override {
+        d.deserialize("Properties", properties, "Property");
+    }
+};
+
+struct BenchProcessor : Serializable {
+    std::string identifier;
+    std::vector<BenchProperty> properties;
+    std::vector<vec4> transferFunction;
+    std::vector<BenchListItem> list;
+
+    virtual void serialize(Serializer& s) const override {
+        s.serialize("type", std::string{"org.inviwo.BenchProcessor"},
+                    SerializationTarget::Attribute);
+        s.serialize("identifier", identifier, SerializationTarget::Attribute);
+        s.serialize("Properties", properties, "Property");
+        s.serialize("TransferFunction", transferFunction, "Point");
+        s.serialize("List", list, "Item");
+    }
+    virtual void deserialize(Deserializer& d) override {
+        d.deserialize("identifier", identifier, SerializationTarget::Attribute);
+        d.deserialize("Properties", properties, "Property");
+        d.deserialize("TransferFunction", transferFunction, "Point");
+        d.deserialize("List", list, "Item");
+    }
+};
+
+/**
+ * Generate a workspace like tree of "processors" with 32 properties each, every 8th with a large
+ * transfer function and every 4th with a list of nested properties.
+ */
+std::vector<BenchProcessor> generateWorkspace(size_t processors) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+    const auto property = [&](size_t i) {
+        BenchProperty p;
+        p.identifier = "property" + std::to_string(i);
+        p.displayName = "Property " + std::to_string(i);
+        p.value = dist(gen);
+        p.range = dvec2{0.0, 1.0 + i};
+        p.readOnly = i % 7 == 0;
+        return p;
+    };
+
+    std::vector<BenchProcessor> workspace(processors);
+    for (size_t i = 0; i < processors; ++i) {
+        auto& p = workspace[i];
+        p.identifier = "processor" + std::to_string(i);
+        for (size_t j = 0; j < 32; ++j) p.properties.push_back(property(j));
+        if (i % 8 == 0) {
+            for (size_t j = 0; j < 1024; ++j) {
+                p.transferFunction.emplace_back(dist(gen), dist(gen), dist(gen), dist(gen));
+            }
+        }
+        if (i % 4 == 0) {
+            for (size_t j = 0; j < 8; ++j) {
+                auto& item = p.list.emplace_back();
+                for (size_t k = 0; k < 4; ++k) item.properties.push_back(property(k));
+            }
+        }
+    }
+    return workspace;
+}
+
+/*
+ * Allocation statistics collected by the replaced global operator new and delete below. Every
+ * block gets a header with its size and the measurement it was allocated in, zero if none, so
+ * that only blocks allocated and freed within the same measurement are counted.
+ */
+std::atomic<size_t> measurement{0};
+std::atomic<size_t> measurements{0};
+std::atomic<size_t> allocatedBytes{0};
+std::atomic<size_t> liveBytes{0};
+std::atomic<size_t> peakBytes{0};
+
+constexpr size_t headerSize = std::max(alignof(std::max_align_t), 2 * sizeof(size_t));
+
+void* allocate(size_t size) {
+    auto block = static_cast<char*>(std::malloc(size + headerSize));
+    if (!block) throw std::bad_alloc{};
+    const auto current = measurement.load(std::memory_order_relaxed);
+    reinterpret_cast<size_t*>(block)[0] = size;
+    reinterpret_cast<size_t*>(block)[1] = current;
+    if (current != 0) {
+        allocatedBytes += size;
+        const auto live = liveBytes += size;
+        auto peak = peakBytes.load();
+        while (live > peak && !peakBytes.compare_exchange_weak(peak, live)) {
+        }
+    }
+    return block + headerSize;
+}
+
+void deallocate(void* ptr) noexcept {
+    if (!ptr) return;
+    auto block = static_cast<char*>(ptr) - headerSize;
+    const auto size = reinterpret_cast<size_t*>(block)[0];
+    const auto allocatedIn = reinterpret_cast<size_t*>(block)[1];
+    if (allocatedIn != 0 && allocatedIn == measurement.load(std::memory_order_relaxed)) {
+        liveBytes -= size;
+    }
+    std::free(block);
+}
+
+/**
+ * Run \p func once outside of the timed loop and report the number of bytes allocated in total
+ * and the peak of the bytes allocated at the same time.
+ */
+template <typename F>
+void measureMemory(benchmark::State& state, F&& func) {
+    allocatedBytes = 0;
+    liveBytes = 0;
+    peakBytes = 0;
+    measurement = ++measurements;
+    func();
+    measurement = 0;
+
+    const auto bytes = [](size_t value) {
+        return benchmark::Counter(static_cast<double>(value), benchmark::Counter::kDefaults,
+                                  benchmark::Counter::OneK::kIs1024);
+    };
+    state.counters["Allocated"] = bytes(allocatedBytes);
+    state.counters["PeakMemory"] = bytes(peakBytes);
+}
+
+void write(const std::vector<BenchProcessor>& workspace, SerializationFormat format,
+           std::ostream& stream) {
+    Serializer s("");
+    s.serialize("Processors", workspace, "Processor");
+    s.writeFile(stream, format);
+}
+
+}  // namespace
+
+void* operator new(size_t size) { return allocate(size); }
+void operator delete(void* ptr) noexcept { deallocate(ptr); }
+void operator delete(void* ptr, size_t) noexcept { deallocate(ptr); }
+
+/**
+ * Serialize a generated workspace and write it using the given encoding.
+ * range(0): number of processors
+ * Bytes: the size of the encoded workspace
+ * Allocated, PeakMemory: the bytes allocated in total and at most at the same time while saving
+ */
+template <SerializationFormat Format>
+static void SaveWorkspace(benchmark::State& state) {
+    const auto workspace = generateWorkspace(static_cast<size_t>(state.range(0)));
+
+    size_t bytes = 0;
+    for (auto _ : state) {
+        std::stringstream stream;
+        write(workspace, Format, stream);
+        bytes = static_cast<size_t>(stream.tellp());
+    }
+    measureMemory(state, [&]() {
+        std::stringstream stream;
+        write(workspace, Format, stream);
+    });
+    state.counters["Bytes"] = static_cast<double>(bytes);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+/**
+ * Read a generated workspace written using the given encoding and deserialize it.
+ * range(0): number of processors
+ * Bytes: the size of the encoded workspace
+ * Allocated, PeakMemory: the bytes allocated in total and at most at the same time while loading
+ */
+template <SerializationFormat Format>
+static void LoadWorkspace(benchmark::State& state) {
+    std::stringstream stream;
+    write(generateWorkspace(static_cast<size_t>(state.range(0))), Format, stream);
+    const auto bytes = static_cast<size_t>(stream.tellp());
+
+    const auto load = [&]() {
+        stream.clear();
+        stream.seekg(0);
+        Deserializer d(stream, "");
+        std::vector<BenchProcessor> workspace;
+        d.deserialize("Processors", workspace, "Processor");
+        benchmark::DoNotOptimize(workspace.data());
+    };
+    for (auto _ : state) {
+        load();
+    }
+    measureMemory(state, load);
+    state.counters["Bytes"] = static_cast<double>(bytes);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+BENCHMARK_TEMPLATE(SaveWorkspace, SerializationFormat::Xml)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(SaveWorkspace, SerializationFormat::Binary)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(LoadWorkspace, SerializationFormat::Xml)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(LoadWorkspace, SerializationFormat::Binary)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->Unit(benchmark::kMillisecond);
+
+#include <warn/pop>
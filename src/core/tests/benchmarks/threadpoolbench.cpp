@@ -0,0 +1,191 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/threadpool.h>
+
+#include <benchmark/benchmark.h>
+
+#include <queue>
+#include <algorithm>
+
+#include <warn/push>
+#include <warn/ignore/unused-function>
+
+using namespace inviwo;
+
+namespace {
+
+/**
+ * The previous single queue thread pool, one mutex and condition variable shared by all workers
+ * and a heap allocated packaged_task per job. Kept here as a reference.
+ */
+class SingleQueuePool {
+public:
+    SingleQueuePool(size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers_.emplace_back([this]() {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        condition_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                        if (stop_ && tasks_.empty()) return;
+                        task = std::move(tasks_.front());
+                        tasks_.pop();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+    ~SingleQueuePool() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        condition_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    template <class F>
+    auto enqueue(F&& f) -> std::future<std::invoke_result_t<F>> {
+        using return_type = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<return_type()>>(std::forward<F>(f));
+        auto res = task->get_future();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            tasks_.emplace([task]() { (*task)(); });
+        }
+        condition_.notify_one();
+        return res;
+    }
+
+    template <typename T>
+    void wait(const std::future<T>& future) {
+        future.wait();
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stop_ = false;
+};
+
+size_t poolSize() { return std::max(4u, std::thread::hardware_concurrency()); }
+
+size_t work(size_t n) {
+    size_t sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += i * i;
+        benchmark::DoNotOptimize(sum);
+    }
+    return sum;
+}
+
+}  // namespace
+
+/**
+ * Many small independent jobs enqueued from the calling thread, like forEachParallelAsync
+ * range(0): number of jobs, range(1): amount of work per job
+ */
+template <typename Pool>
+static void FanOut(benchmark::State& state) {
+    Pool pool(poolSize());
+    const auto jobs = static_cast<size_t>(state.range(0));
+    const auto load = static_cast<size_t>(state.range(1));
+
+    std::vector<std::future<size_t>> futures;
+    futures.reserve(jobs);
+    for (auto _ : state) {
+        futures.clear();
+        for (size_t i = 0; i < jobs; ++i) {
+            futures.push_back(pool.enqueue([load]() { return work(load); }));
+        }
+        for (auto& f : futures) benchmark::DoNotOptimize(f.get());
+    }
+    state.SetItemsProcessed(state.iterations() * jobs);
+}
+
+/**
+ * Jobs that in turn enqueue nested jobs and wait for them
+ * range(0): number of outer jobs, range(1): number of nested jobs per outer job
+ */
+template <typename Pool>
+static void Nested(benchmark::State& state) {
+    Pool pool(poolSize());
+    const auto jobs = static_cast<size_t>(state.range(0));
+    const auto nested = static_cast<size_t>(state.range(1));
+
+    std::vector<std::future<size_t>> futures;
+    futures.reserve(jobs);
+    for (auto _ : state) {
+        futures.clear();
+        for (size_t i = 0; i < jobs; ++i) {
+            futures.push_back(pool.enqueue([&pool, nested]() {
+                std::vector<std::future<size_t>> inner;
+                inner.reserve(nested);
+                for (size_t j = 0; j < nested; ++j) {
+                    inner.push_back(pool.enqueue([]() { return work(100); }));
+                }
+                size_t sum = 0;
+                for (auto& f : inner) {
+                    pool.wait(f);
+                    sum += f.get();
+                }
+                return sum;
+            }));
+        }
+        for (auto& f : futures) benchmark::DoNotOptimize(f.get());
+    }
+    state.SetItemsProcessed(state.iterations() * jobs * (nested + 1));
+}
+
+BENCHMARK_TEMPLATE(FanOut, SingleQueuePool)
+    ->Args({1 << 10, 0})
+    ->Args({1 << 10, 10000})
+    ->Args({1 << 14, 0})
+    ->Args({1 << 14, 100})
+    ->Args({1 << 17, 0})
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(FanOut, ThreadPool)
+    ->Args({1 << 10, 0})
+    ->Args({1 << 10, 10000})
+    ->Args({1 << 14, 0})
+    ->Args({1 << 14, 100})
+    ->Args({1 << 17, 0})
+    ->UseRealTime();
+
+// The outer jobs block the workers of the single queue pool while waiting for the nested jobs,
+// hence keep the number of outer jobs below the pool size for it.
+BENCHMARK_TEMPLATE(Nested, SingleQueuePool)->Args({2, 1 << 10})->UseRealTime();
+BENCHMARK_TEMPLATE(Nested, ThreadPool)->Args({2, 1 << 10})->Args({256, 64})->UseRealTime();
+
+#include <warn/pop>
@@ -0,0 +1,152 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/serialization/serialization.h>
+#include <inviwo/core/io/serialization/binaryserialization.h>
+#include <inviwo/core/io/serialization/ticpp.h>
+#include <inviwo/core/util/filesystem.h>
+
+namespace inviwo {
+
+namespace {
+
+void fill(Serializer& serializer) {
+    serializer.serialize("string", std::string{"a \"quoted\" <string> & more\nlines"});
+    serializer.serialize("attribute", std::string{"value"}, SerializationTarget::Attribute);
+    serializer.serialize("vector", std::vector<vec4>(100, vec4{0.1f, 0.2f, 0.3f, 0.4f}));
+    serializer.serialize("long", std::string(1000, 'x'));
+    serializer.serialize("utf8", std::string{u8"åäö"});
+}
+
+}  // namespace
+
+TEST(BinarySerializationTest, Detect) {
+    const std::string refpath = filesystem::findBasePath();
+    Serializer serializer(refpath);
+    fill(serializer);
+
+    std::stringstream xml;
+    serializer.writeFile(xml, SerializationFormat::Xml);
+    EXPECT_FALSE(util::isBinarySerialization(xml));
+
+    std::stringstream binary;
+    serializer.writeFile(binary, SerializationFormat::Binary);
+    EXPECT_TRUE(util::isBinarySerialization(binary));
+    EXPECT_LT(binary.str().size(), xml.str().size());
+}
+
+TEST(BinarySerializationTest, RoundTrip) {
+    const std::string refpath = filesystem::findBasePath();
+    Serializer serializer(refpath);
+    fill(serializer);
+
+    std::stringstream ss;
+    serializer.writeFile(ss, SerializationFormat::Binary);
+    Deserializer deserializer(ss, refpath);
+
+    std::string str;
+    deserializer.deserialize("string", str);
+    EXPECT_EQ("a \"quoted\" <string> & more\nlines", str);
+
+    std::string attribute;
+    deserializer.deserialize("attribute", attribute, SerializationTarget::Attribute);
+    EXPECT_EQ("value", attribute);
+
+    std::vector<vec4> vector;
+    deserializer.deserialize("vector", vector);
+    ASSERT_EQ(size_t{100}, vector.size());
+    EXPECT_EQ(vec4(0.1f, 0.2f, 0.3f, 0.4f), vector.back());
+
+    std::string longStr;
+    deserializer.deserialize("long", longStr);
+    EXPECT_EQ(std::string(1000, 'x'), longStr);
+
+    std::string utf8;
+    deserializer.deserialize("utf8", utf8);
+    EXPECT_EQ(std::string{u8"åäö"}, utf8);
+}
+
+TEST(BinarySerializationTest, SameTree) {
+    const std::string refpath = filesystem::findBasePath();
+    Serializer serializer(refpath);
+    fill(serializer);
+
+    std::stringstream ss;
+    serializer.writeFile(ss, SerializationFormat::Binary);
+    TxDocument doc;
+    util::readBinarySerialization(ss, doc);
+
+    Serializer reference(refpath);
+    fill(reference);
+    std::stringstream xml;
+    reference.writeFile(xml, SerializationFormat::Xml);
+    TxDocument referenceDoc;
+    xml >> referenceDoc;
+
+    EXPECT_EQ(SerializeBase::nodeToString(*referenceDoc.FirstChildElement()),
+              SerializeBase::nodeToString(*doc.FirstChildElement()));
+}
+
+TEST(BinarySerializationTest, TrailingData) {
+    const std::string refpath = filesystem::findBasePath();
+    Serializer serializer(refpath);
+    fill(serializer);
+
+    std::stringstream ss;
+    serializer.writeFile(ss, SerializationFormat::Binary);
+    ss << "trailing";
+
+    TxDocument doc;
+    util::readBinarySerialization(ss, doc);
+    std::string trailing;
+    ss >> trailing;
+    EXPECT_EQ("trailing", trailing);
+}
+
+TEST(BinarySerializationTest, Truncated) {
+    const std::string refpath = filesystem::findBasePath();
+    Serializer serializer(refpath);
+    fill(serializer);
+
+    std::stringstream ss;
+    serializer.writeFile(ss, SerializationFormat::Binary);
+    auto data = ss.str();
+    data.resize(data.size() / 2);
+    std::stringstream truncated(data);
+
+    TxDocument doc;
+    EXPECT_THROW(util::readBinarySerialization(truncated, doc), SerializationException);
+}
+
+}  // namespace inviwo
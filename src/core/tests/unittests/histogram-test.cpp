@@ -0,0 +1,159 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/datastructures/histogramtools.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+template <typename T>
+std::vector<T> randomData(size_t size, T min, T max) {
+    std::mt19937 gen(42);
+    std::vector<T> data(size);
+    if constexpr (std::is_integral<T>::value) {
+        std::uniform_int_distribution<T> dist(min, max);
+        std::generate(data.begin(), data.end(), [&]() { return dist(gen); });
+    } else {
+        std::uniform_real_distribution<T> dist(min, max);
+        std::generate(data.begin(), data.end(), [&]() { return dist(gen); });
+    }
+    return data;
+}
+
+void expectEqual(const HistogramContainer& expected, const HistogramContainer& result) {
+    ASSERT_EQ(expected.size(), result.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].getData(), result[i].getData());
+        EXPECT_DOUBLE_EQ(expected[i].getMaximumBinValue(), result[i].getMaximumBinValue());
+        EXPECT_DOUBLE_EQ(expected[i].stats_.min, result[i].stats_.min);
+        EXPECT_DOUBLE_EQ(expected[i].stats_.max, result[i].stats_.max);
+        EXPECT_NEAR(expected[i].stats_.mean, result[i].stats_.mean,
+                    1e-9 * std::abs(expected[i].stats_.mean));
+        EXPECT_NEAR(expected[i].stats_.standardDeviation, result[i].stats_.standardDeviation,
+                    1e-9 * std::abs(expected[i].stats_.standardDeviation));
+    }
+}
+
+// Compare against the generic path using the same values as doubles
+template <typename T>
+void testFastPath(const std::vector<T>& data, dvec2 range, size_t bins) {
+    const std::vector<double> reference(data.begin(), data.end());
+    const HistogramContainer expected(range, bins, reference.begin(), reference.end());
+    const HistogramContainer result(range, bins, data.data(), data.data() + data.size());
+    expectEqual(expected, result);
+}
+
+}  // namespace
+
+TEST(Histogram, UInt8) {
+    const auto data = randomData<unsigned short>(10001, 0, 255);
+    std::vector<unsigned char> data8(data.begin(), data.end());
+    testFastPath(data8, dvec2{0.0, 255.0}, 256);
+    testFastPath(data8, dvec2{0.0, 255.0}, 100);
+    testFastPath(data8, dvec2{10.0, 200.0}, 64);
+}
+
+TEST(Histogram, Int16) {
+    const auto data = randomData<short>(100003, -1000, 30000);
+    testFastPath(data, dvec2{-1000.0, 30000.0}, 2048);
+    testFastPath(data, dvec2{0.0, 20000.0}, 1024);
+}
+
+TEST(Histogram, Float) {
+    const auto data = randomData<float>(100003, -1.0f, 2.0f);
+    testFastPath(data, dvec2{-1.0, 2.0}, 2048);
+    testFastPath(data, dvec2{0.0, 1.0}, 100);
+}
+
+TEST(Histogram, Merge) {
+    const auto data = randomData<float>(1000, 0.0f, 1.0f);
+    const dvec2 range{0.0, 1.0};
+
+    HistogramAccumulator<float> first(range, 32);
+    HistogramAccumulator<float> second(range, 32);
+    first.add(data.data(), data.data() + 300);
+    second.add(data.data() + 300, data.data() + data.size());
+    first.merge(second);
+    EXPECT_EQ(data.size(), first.getCount());
+
+    expectEqual(HistogramContainer(range, 32, data.begin(), data.end()), HistogramContainer(first));
+}
+
+TEST(Histogram, CalculateVolume) {
+    const size3_t dims{64, 64, 48};
+    const auto data = randomData<unsigned short>(glm::compMul(dims), 0, 4095);
+    VolumeRAMPrecision<unsigned short> volume(dims);
+    std::copy(data.begin(), data.end(), volume.getDataTyped());
+
+    const dvec2 range{0.0, 4095.0};
+    expectEqual(HistogramContainer(range, 512, data.begin(), data.end()),
+                util::calculateHistograms(volume, range, 512));
+}
+
+TEST(Histogram, CalculateVolumeStrided) {
+    const size3_t dims{128, 128, 128};
+    const auto data = randomData<unsigned short>(glm::compMul(dims), 0, 4095);
+    VolumeRAMPrecision<unsigned short> volume(dims);
+    std::copy(data.begin(), data.end(), volume.getDataTyped());
+
+    const dvec2 range{0.0, 4095.0};
+    for (size_t stride : {3, 64}) {
+        std::vector<unsigned short> sampled;
+        for (size_t i = 0; i < data.size(); i += stride) sampled.push_back(data[i]);
+
+        expectEqual(HistogramContainer(range, 512, sampled.begin(), sampled.end()),
+                    util::calculateHistograms(volume, range, 512, stride));
+    }
+}
+
+TEST(Histogram, CalculateVolumeVec) {
+    const size3_t dims{32, 32, 32};
+    const auto data = randomData<float>(2 * glm::compMul(dims), 0.0f, 1.0f);
+    VolumeRAMPrecision<vec2> volume(dims);
+    std::copy(data.begin(), data.end(), glm::value_ptr(*volume.getDataTyped()));
+
+    const dvec2 range{0.0, 1.0};
+    const auto result = util::calculateHistograms(volume, range, 256);
+    ASSERT_EQ(2u, result.size());
+    const HistogramContainer expected(range, 256, volume.getDataTyped(),
+                                      volume.getDataTyped() + glm::compMul(dims));
+    expectEqual(expected, result);
+}
+
+}  // namespace inviwo
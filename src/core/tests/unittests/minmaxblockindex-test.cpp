@@ -0,0 +1,112 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/minmaxblockindex.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <limits>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<VolumeRAMPrecision<float>> makeVolume(size3_t dims) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    const util::IndexMapper3D im(dims);
+    auto data = ram->getDataTyped();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                data[im(x, y, z)] = static_cast<float>(x + 10 * y + 100 * z);
+            }
+        }
+    }
+    return ram;
+}
+
+}  // namespace
+
+TEST(MinMaxBlockIndex, BlockRanges) {
+    auto ram = makeVolume(size3_t{10, 10, 10});
+    const MinMaxBlockIndex index(*ram, 4);
+
+    // 9 cells along each axis need 3 blocks of 4 cells
+    EXPECT_EQ(size3_t(3, 3, 3), index.getNumberOfBlocks());
+    EXPECT_EQ(size3_t(1, 1, 1), index.getBlock(size3_t{4, 7, 5}));
+
+    // The blocks include the voxels shared with the next block
+    EXPECT_EQ(dvec2(0.0, 444.0), index.getRange(size3_t{0, 0, 0}));
+    EXPECT_EQ(dvec2(444.0, 888.0), index.getRange(size3_t{1, 1, 1}));
+    EXPECT_EQ(dvec2(888.0, 999.0), index.getRange(size3_t{2, 2, 2}));
+    EXPECT_EQ(dvec2(0.0, 999.0), index.getRange());
+
+    const auto voxels = index.getVoxelRange(size3_t{2, 0, 1});
+    EXPECT_EQ(size3_t(8, 0, 4), voxels.first);
+    EXPECT_EQ(size3_t(9, 4, 8), voxels.second);
+
+    EXPECT_TRUE(index.contains(size3_t{1, 1, 1}, 444.0));
+    EXPECT_FALSE(index.contains(size3_t{1, 1, 1}, 443.0));
+    EXPECT_FALSE(index.crosses(size3_t{1, 1, 1}, 444.0));
+    EXPECT_TRUE(index.crosses(size3_t{1, 1, 1}, 888.0));
+    EXPECT_TRUE(index.crosses(size3_t{1, 1, 1}, 444.0, true));
+    EXPECT_FALSE(index.crosses(size3_t{1, 1, 1}, 888.0, true));
+}
+
+TEST(MinMaxBlockIndex, NaN) {
+    auto ram = makeVolume(size3_t{9, 9, 9});
+    ram->setFromDouble(size3_t{1, 2, 3}, std::numeric_limits<double>::quiet_NaN());
+    const MinMaxBlockIndex index(*ram, 4);
+
+    EXPECT_TRUE(index.contains(size3_t{0, 0, 0}, -1000.0));
+    EXPECT_TRUE(index.contains(size3_t{0, 0, 0}, 1000.0));
+    EXPECT_FALSE(index.contains(size3_t{1, 1, 1}, 1000.0));
+}
+
+TEST(MinMaxBlockIndex, CachedUntilEdited) {
+    auto volume = std::make_shared<Volume>(makeVolume(size3_t{9, 9, 9}));
+
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+    const auto index = ram->getMinMaxBlockIndex();
+    EXPECT_EQ(index, ram->getMinMaxBlockIndex());
+    EXPECT_NE(index, ram->getMinMaxBlockIndex(4));
+
+    auto editable = volume->getEditableRepresentation<VolumeRAM>();
+    editable->setFromDouble(size3_t{0, 0, 0}, -1.0);
+    const auto updated = editable->getMinMaxBlockIndex();
+    EXPECT_NE(index, updated);
+    EXPECT_EQ(dvec2(-1.0, 888.0), updated->getRange());
+}
+
+}  // namespace inviwo
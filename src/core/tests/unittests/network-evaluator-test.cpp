@@ -39,11 +39,15 @@
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/network/processornetworkevaluator.h>
 #include <inviwo/core/network/networklock.h>
+#include <inviwo/core/util/conversionstatistics.h>
 
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/properties/ordinalproperty.h>
 
 #include <functional>
+#include <sstream>
+#include <thread>
 
 namespace inviwo {
 
@@ -52,7 +56,10 @@ namespace {
 struct TestProcessor : Processor {
     TestProcessor(const std::string& id) : Processor(id, id) {}
 
-    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    virtual const ProcessorInfo getProcessorInfo() const override {
+        return ProcessorInfo{processorInfo_.classIdentifier, processorInfo_.displayName,
+                             processorInfo_.category, processorInfo_.codeState, tags};
+    }
 
     static const ProcessorInfo processorInfo_;
 
@@ -69,6 +76,7 @@ struct TestProcessor : Processor {
     std::function<void(TestProcessor&)> onInitializeResources;
     std::function<void(TestProcessor&)> onProcess;
     std::function<void(TestProcessor&)> onDoIfNotReady;
+    Tags tags = Tags::CPU;
 };
 
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
@@ -257,4 +265,205 @@ TEST(NetworkEvaluator, Error) {
     }
 }
 
+TEST(NetworkEvaluator, Parallel) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    evaluator.setParallelEvaluation(true);
+    EXPECT_TRUE(evaluator.getParallelEvaluation());
+
+    auto at = createA();
+    auto a = at.get();
+    a->tags = Tags::CPU | Tags::Concurrent;
+    Instrument ai(*a);
+
+    unsigned int throwCount = 0;
+    evaluator.setExceptionHandler(
+        [&throwCount](Processor*, EvaluationType, ExceptionContext) { ++throwCount; });
+
+    bool shouldThrow = false;
+    a->onProcess = [func = a->onProcess, &shouldThrow](TestProcessor& p) {
+        func(p);
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(0));
+        if (shouldThrow) {
+            throw Exception("Error", IVW_CONTEXT_CUSTOM("TestProcessor"));
+        }
+    };
+    network.addProcessor(std::move(at));
+
+    auto bt = createB();
+    auto b = bt.get();
+    Instrument bi(*b);
+    network.addProcessor(std::move(bt));
+
+    auto ct = createB();
+    ct->setIdentifier("c");
+    auto c = ct.get();
+    Instrument ci(*c);
+    network.addProcessor(std::move(ct));
+
+    bi.checkAndReset(0, 0, 1);
+    ci.checkAndReset(0, 0, 1);
+
+    {
+        SCOPED_TRACE("Add connections");
+        NetworkLock lock(&network);
+        network.addConnection(a->getOutports()[0], b->getInports()[0]);
+        network.addConnection(a->getOutports()[0], c->getInports()[0]);
+    }
+    ai.checkAndReset(1, 1, 0);
+    bi.checkAndReset(1, 1, 0);
+    ci.checkAndReset(1, 1, 0);
+    EXPECT_TRUE(a->isValid());
+    EXPECT_TRUE(b->isValid());
+    EXPECT_TRUE(c->isValid());
+
+    {
+        SCOPED_TRACE("Timing");
+        const auto& timing = evaluator.getLastEvaluationTiming();
+        ASSERT_EQ(3, timing.processors.size());
+        EXPECT_EQ(a, timing.processors.front().processor);
+        ASSERT_EQ(2, timing.criticalPath.size());
+        EXPECT_EQ(a, timing.criticalPath.front());
+        EXPECT_LE(timing.criticalPathTime, timing.total);
+    }
+
+    {
+        SCOPED_TRACE("Invalid output with throw");
+        shouldThrow = true;
+        a->invalidate(InvalidationLevel::InvalidOutput);
+        EXPECT_EQ(throwCount, 1);
+        ai.checkAndReset(0, 1, 0);
+        bi.checkAndReset(0, 1, 0);
+        ci.checkAndReset(0, 1, 0);
+    }
+}
+
+TEST(NetworkEvaluator, ParallelPropertyWrite) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    evaluator.setParallelEvaluation(true);
+
+    const auto mainThread = std::this_thread::get_id();
+
+    auto at = createA();
+    auto a = at.get();
+    a->tags = Tags::CPU | Tags::Concurrent;
+    a->onProcess = [](TestProcessor& p) {
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(1));
+    };
+    network.addProcessor(std::move(at));
+
+    // A plain CPU processor that modifies a property in process(), like most processors do, has
+    // to be processed on the main thread
+    auto bt = createB();
+    auto b = bt.get();
+    auto count = new IntProperty("count", "Count", 0, 0, 100, 1, InvalidationLevel::Valid);
+    b->addProperty(count);
+    std::thread::id processThread;
+    int processCount = 0;
+    b->onProcess = [&](TestProcessor&) {
+        processThread = std::this_thread::get_id();
+        ++processCount;
+        count->set(count->get() + 1);
+    };
+    network.addProcessor(std::move(bt));
+    network.addConnection(a->getOutports()[0], b->getInports()[0]);
+
+    EXPECT_EQ(processCount, 1);
+    EXPECT_EQ(processThread, mainThread);
+    EXPECT_EQ(count->get(), 1);
+    EXPECT_TRUE(b->isValid());
+
+    a->invalidate(InvalidationLevel::InvalidOutput);
+    EXPECT_EQ(processCount, 2);
+    EXPECT_EQ(processThread, mainThread);
+    EXPECT_EQ(count->get(), 2);
+    EXPECT_TRUE(b->isValid());
+
+    const auto& timing = evaluator.getLastEvaluationTiming();
+    ASSERT_EQ(2, timing.processors.size());
+    EXPECT_FALSE(timing.processors.back().concurrent);
+}
+
+TEST(NetworkEvaluator, SerialTiming) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+
+    auto at = createA();
+    auto a = at.get();
+    a->onProcess = [](TestProcessor& p) {
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(1));
+    };
+    network.addProcessor(std::move(at));
+    auto bt = createB();
+    auto b = bt.get();
+    network.addProcessor(std::move(bt));
+    network.addConnection(a->getOutports()[0], b->getInports()[0]);
+
+    // No scheduling bookkeeping is done in serial mode
+    EXPECT_TRUE(evaluator.getLastEvaluationTiming().processors.empty());
+    EXPECT_TRUE(evaluator.getLastEvaluationTiming().criticalPath.empty());
+}
+
+TEST(NetworkEvaluator, Statistics) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    auto& statistics = evaluator.getStatistics();
+
+    auto at = createA();
+    auto a = at.get();
+    a->onProcess = [](TestProcessor& p) {
+        ConversionStatistics::Scope conversion;
+        if (auto collector = ConversionStatistics::current()) collector->addAllocation(100);
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(0));
+    };
+    network.addProcessor(std::move(at));
+
+    auto bt = createB();
+    auto b = bt.get();
+    network.addProcessor(std::move(bt));
+    network.addConnection(a->getOutports()[0], b->getInports()[0]);
+
+    statistics.reset();
+    a->invalidate(InvalidationLevel::InvalidOutput);
+    a->invalidate(InvalidationLevel::InvalidOutput);
+
+    const auto aStats = statistics.getEntry("a");
+    ASSERT_TRUE(aStats);
+    EXPECT_EQ(aStats->classIdentifier, "a");
+    EXPECT_EQ(aStats->processCount, 2);
+    EXPECT_EQ(aStats->invalidationCount, 2);
+    EXPECT_EQ(aStats->conversionCount, 2);
+    EXPECT_EQ(aStats->bytesAllocated, 200);
+    EXPECT_FALSE(ConversionStatistics::current());
+    EXPECT_LE(aStats->minProcessTime, aStats->maxProcessTime);
+    size_t histogramCount = 0;
+    for (auto count : aStats->histogram) histogramCount += count;
+    EXPECT_EQ(histogramCount, 2);
+
+    const auto bStats = statistics.getEntry("b");
+    ASSERT_TRUE(bStats);
+    EXPECT_EQ(bStats->processCount, 2);
+    EXPECT_EQ(bStats->conversionCount, 0);
+    EXPECT_EQ(statistics.getEntries().size(), 2);
+
+    std::stringstream json;
+    statistics.writeJson(json);
+    EXPECT_NE(json.str().find("\"identifier\":\"a\""), std::string::npos);
+
+    std::stringstream csv;
+    statistics.writeCsv(csv);
+    std::string line;
+    size_t lines = 0;
+    while (std::getline(csv, line)) ++lines;
+    EXPECT_EQ(lines, 3);
+
+    statistics.setEnabled(false);
+    a->invalidate(InvalidationLevel::InvalidOutput);
+    EXPECT_EQ(statistics.getEntry("a")->processCount, 2);
+
+    statistics.reset();
+    EXPECT_FALSE(statistics.getEntry("a"));
+}
+
 }  // namespace inviwo
@@ -0,0 +1,115 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <cstdio>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+std::vector<std::uint16_t> writeRawFile(util::TempFileHandle& file, size_t header, size3_t dims) {
+    std::vector<char> headerBytes(header, 'x');
+    std::vector<std::uint16_t> data(glm::compMul(dims));
+    std::iota(data.begin(), data.end(), std::uint16_t{1});
+    std::fwrite(headerBytes.data(), 1, headerBytes.size(), file);
+    std::fwrite(data.data(), sizeof(std::uint16_t), data.size(), file);
+    std::fflush(file);
+    return data;
+}
+
+}  // namespace
+
+TEST(RawVolumeRAMLoader, MemoryMapped) {
+    util::TempFileHandle file{"", ".raw"};
+    const size3_t dims{7, 5, 3};
+    const auto data = writeRawFile(file, 13, dims);
+
+    VolumeDisk disk{dims, DataUInt16::get()};
+    RawVolumeRAMLoader loader{file.getFileName(), 13, true};
+    auto rep = std::dynamic_pointer_cast<VolumeRAMPrecision<std::uint16_t>>(
+        loader.createRepresentation(disk));
+    ASSERT_TRUE(rep);
+    EXPECT_EQ(dims, rep->getDimensions());
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), rep->getDataTyped()));
+
+    // Writes go to private pages and must not reach the file.
+    rep->getDataTyped()[0] = 42;
+    auto copy = std::unique_ptr<VolumeRAMPrecision<std::uint16_t>>(rep->clone());
+    EXPECT_EQ(42, copy->getDataTyped()[0]);
+    rep.reset();
+
+    auto reloaded = std::dynamic_pointer_cast<VolumeRAMPrecision<std::uint16_t>>(
+        loader.createRepresentation(disk));
+    ASSERT_TRUE(reloaded);
+    EXPECT_EQ(data[0], reloaded->getDataTyped()[0]);
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), copy->getDataTyped()));
+}
+
+TEST(RawVolumeRAMLoader, BigEndianIsSwapped) {
+    util::TempFileHandle file{"", ".raw"};
+    const size3_t dims{4, 4, 4};
+    const auto data = writeRawFile(file, 0, dims);
+
+    VolumeDisk disk{dims, DataUInt16::get()};
+    RawVolumeRAMLoader loader{file.getFileName(), 0, false};
+    auto rep = std::dynamic_pointer_cast<VolumeRAMPrecision<std::uint16_t>>(
+        loader.createRepresentation(disk));
+    ASSERT_TRUE(rep);
+    for (size_t i = 0; i < data.size(); ++i) {
+        const std::uint16_t swapped = static_cast<std::uint16_t>((data[i] >> 8) | (data[i] << 8));
+        EXPECT_EQ(swapped, rep->getDataTyped()[i]);
+    }
+}
+
+TEST(RawVolumeRAMLoader, UpdateRepresentation) {
+    util::TempFileHandle file{"", ".raw"};
+    const size3_t dims{6, 6, 2};
+    const auto data = writeRawFile(file, 0, dims);
+
+    VolumeDisk disk{dims, DataUInt16::get()};
+    RawVolumeRAMLoader loader{file.getFileName(), 0, true};
+    auto dest = std::make_shared<VolumeRAMPrecision<std::uint16_t>>(size3_t{2, 2, 2});
+    loader.updateRepresentation(dest, disk);
+    EXPECT_EQ(dims, dest->getDimensions());
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), dest->getDataTyped()));
+}
+
+}  // namespace inviwo
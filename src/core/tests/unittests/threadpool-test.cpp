@@ -0,0 +1,132 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/threadpool.h>
+
+#include <atomic>
+#include <numeric>
+#include <string>
+#include <thread>
+
+namespace inviwo {
+
+TEST(ThreadPoolTests, Enqueue) {
+    ThreadPool pool(4);
+    std::vector<std::future<size_t>> futures;
+    for (size_t i = 0; i < 1000; ++i) {
+        futures.push_back(pool.enqueue([](size_t a) { return 2 * a; }, i));
+    }
+    size_t sum = 0;
+    for (auto& f : futures) sum += f.get();
+    EXPECT_EQ(999 * 1000, sum);
+}
+
+TEST(ThreadPoolTests, NoWorkers) {
+    ThreadPool pool(0);
+    auto f = pool.enqueue([]() { return 42; });
+    EXPECT_EQ(std::future_status::ready, f.wait_for(std::chrono::seconds::zero()));
+    EXPECT_EQ(42, f.get());
+}
+
+TEST(ThreadPoolTests, NestedTasks) {
+    ThreadPool pool(2);
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; ++i) {
+        futures.push_back(pool.enqueue([&pool, i]() {
+            EXPECT_TRUE(pool.isWorkerThread());
+            std::vector<std::future<int>> nested;
+            for (int j = 0; j < 10; ++j) {
+                nested.push_back(pool.enqueue([i, j]() { return i + j; }));
+            }
+            int sum = 0;
+            for (auto& f : nested) {
+                pool.wait(f);
+                sum += f.get();
+            }
+            return sum;
+        }));
+    }
+    int sum = 0;
+    for (auto& f : futures) sum += f.get();
+    EXPECT_EQ(10 * 99 * 100 / 2 + 100 * 45, sum);
+    EXPECT_FALSE(pool.isWorkerThread());
+}
+
+TEST(ThreadPoolTests, WaitForTaskOfOtherWorker) {
+    ThreadPool pool(2);
+    std::atomic<bool> running{false};
+    auto slow = pool.enqueue([&running]() {
+        running = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return 1;
+    });
+    while (!running) std::this_thread::yield();
+
+    // Nothing is pending, the waiting worker sleeps until the slow task has finished
+    auto waiter = pool.enqueue([&pool, &slow]() {
+        pool.wait(slow);
+        return slow.get() + 1;
+    });
+    EXPECT_EQ(2, waiter.get());
+}
+
+TEST(ThreadPoolTests, Resize) {
+    ThreadPool pool(4);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 1000; ++i) pool.enqueueRaw([&count]() { ++count; });
+
+    while (pool.trySetSize(0) != 0) {
+    }
+    EXPECT_EQ(1000, count);
+    EXPECT_EQ(0, pool.getQueueSize());
+
+    EXPECT_EQ(3, pool.trySetSize(3));
+    auto f = pool.enqueue([]() { return 1; });
+    EXPECT_EQ(1, f.get());
+}
+
+TEST(ThreadPoolTests, LargeFunctor) {
+    ThreadPool pool(2);
+    const std::string str(4 * ThreadPool::Task::bufferSize, 'a');
+    auto f = pool.enqueue([str]() { return str.size(); });
+    EXPECT_EQ(str.size(), f.get());
+}
+
+TEST(ThreadPoolTests, Exception) {
+    ThreadPool pool(2);
+    auto f = pool.enqueue([]() -> int { throw std::runtime_error("error"); });
+    EXPECT_THROW(f.get(), std::runtime_error);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,128 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwo.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/topologicalorder.h>
+#include <inviwo/core/network/networkutils.h>
+
+#include <inviwo/core/ports/datainport.h>
+#include <inviwo/core/ports/dataoutport.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+
+struct OrderTestProcessor : Processor {
+    OrderTestProcessor(const std::string& id, bool sink) : Processor(id, id) {
+        addPort(std::make_unique<DataInport<int, 0>>("in"));
+        if (!sink) addPort(std::make_unique<DataOutport<int>>("out"));
+    }
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+};
+
+const ProcessorInfo OrderTestProcessor::processorInfo_{
+    "org.inviwo.OrderTestProcessor",  // Class identifier
+    "OrderTestProcessor",             // Display name
+    "Testing",                        // Category
+    CodeState::Stable,                // Code state
+    Tags::CPU,                        // Tags
+};
+
+void checkOrder(const std::vector<Processor*>& order) {
+    const auto pos = [&](Processor* p) {
+        return std::distance(order.begin(), std::find(order.begin(), order.end(), p));
+    };
+    for (auto p : order) {
+        for (auto pred : util::getDirectPredecessors(p)) {
+            EXPECT_LT(pos(pred), pos(p))
+                << pred->getIdentifier() << " should be before " << p->getIdentifier();
+        }
+    }
+}
+
+}  // namespace
+
+TEST(TopologicalOrder, Incremental) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+
+    // Add the processors in reverse order, every connection will need a reordering
+    auto d = network.addProcessor(std::make_unique<OrderTestProcessor>("d", true));
+    auto c = network.addProcessor(std::make_unique<OrderTestProcessor>("c", false));
+    auto b = network.addProcessor(std::make_unique<OrderTestProcessor>("b", false));
+    auto a = network.addProcessor(std::make_unique<OrderTestProcessor>("a", false));
+    auto e = network.addProcessor(std::make_unique<OrderTestProcessor>("e", false));
+
+    TopologicalOrder order;
+    for (auto p : {d, c, b, a, e}) order.addProcessor(p);
+
+    const auto connect = [&](Processor* from, Processor* to) {
+        network.addConnection(from->getOutports()[0], to->getInports()[0]);
+        order.addConnection(from, to);
+        checkOrder(order.getProcessors());
+    };
+
+    connect(c, d);
+    connect(b, c);
+    connect(a, b);
+    connect(a, d);
+    EXPECT_EQ((std::vector<Processor*>{a, b, c, d, e}), order.getProcessors());
+
+    // e is not connected to any sink
+    EXPECT_EQ((std::vector<Processor*>{a, b, c, d}), order.getSinkConnectedProcessors());
+
+    connect(e, a);
+    EXPECT_EQ((std::vector<Processor*>{e, a, b, c, d}), order.getSinkConnectedProcessors());
+
+    network.removeProcessor(b);
+    order.removeProcessor(b);
+    EXPECT_FALSE(order.contains(b));
+    EXPECT_EQ((std::vector<Processor*>{e, a, c, d}), order.getProcessors());
+    EXPECT_EQ((std::vector<Processor*>{e, a, c, d}), order.getSinkConnectedProcessors());
+    delete b;
+
+    TopologicalOrder rebuilt;
+    rebuilt.rebuild(network.getProcessors());
+    checkOrder(rebuilt.getProcessors());
+    EXPECT_EQ(order.getSinkConnectedProcessors().size(),
+              rebuilt.getSinkConnectedProcessors().size());
+}
+
+}  // namespace inviwo
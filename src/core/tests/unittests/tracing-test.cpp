@@ -0,0 +1,105 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/tracing.h>
+
+#include <sstream>
+#include <thread>
+
+namespace inviwo {
+
+TEST(TracingTest, Disabled) {
+    const auto wasEnabled = tracing::isEnabled();
+    tracing::setEnabled(false);
+    tracing::clear();
+    { IVW_TRACE_SCOPE("test", "disabledScope"); }
+    tracing::setEnabled(wasEnabled);
+
+    std::stringstream ss;
+    tracing::writeChromeTrace(ss);
+    EXPECT_EQ(ss.str().find("disabledScope"), std::string::npos);
+}
+
+TEST(TracingTest, ChromeTrace) {
+    const auto wasEnabled = tracing::isEnabled();
+    tracing::setEnabled(true);
+    tracing::clear();
+    std::thread thread{[]() {
+        tracing::setThreadName("Tracing Test Thread");
+        IVW_TRACE_SCOPE_DETAIL("test", "threadScope", "a \"quoted\" detail");
+    }};
+    thread.join();
+    { IVW_TRACE_SCOPE("test", "mainScope"); }
+    tracing::setEnabled(wasEnabled);
+
+    std::stringstream ss;
+    tracing::writeChromeTrace(ss);
+    const auto trace = ss.str();
+    EXPECT_NE(trace.find("\"name\":\"threadScope\",\"cat\":\"test\",\"ph\":\"X\""),
+              std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"mainScope\""), std::string::npos);
+    EXPECT_NE(trace.find("\"args\":{\"detail\":\"a \\\"quoted\\\" detail\"}"), std::string::npos);
+    EXPECT_NE(trace.find("\"args\":{\"name\":\"Tracing Test Thread\"}"), std::string::npos);
+
+    tracing::clear();
+    std::stringstream cleared;
+    tracing::writeChromeTrace(cleared);
+    EXPECT_EQ(cleared.str().find("threadScope"), std::string::npos);
+}
+
+TEST(TracingTest, ExitedThreads) {
+    const auto wasEnabled = tracing::isEnabled();
+    tracing::setEnabled(true);
+    tracing::clear();
+    std::thread thread{[]() {
+        tracing::setThreadName("Exited Test Thread");
+        IVW_TRACE_SCOPE("test", "exitedScope");
+    }};
+    thread.join();
+    tracing::setEnabled(wasEnabled);
+
+    // The events of an exited thread are exported until they are cleared
+    std::stringstream before;
+    tracing::writeChromeTrace(before);
+    EXPECT_NE(before.str().find("Exited Test Thread"), std::string::npos);
+    EXPECT_NE(before.str().find("exitedScope"), std::string::npos);
+
+    // Then its buffer is dropped
+    tracing::clear();
+    std::stringstream after;
+    tracing::writeChromeTrace(after);
+    EXPECT_EQ(after.str().find("Exited Test Thread"), std::string::npos);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,201 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumebricked.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/volumesampler.h>
+
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<VolumeRAMPrecision<float>> makeVolume(size3_t dims) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    auto data = ram->getDataTyped();
+    std::iota(data, data + glm::compMul(dims), 0.0f);
+    return ram;
+}
+
+}  // namespace
+
+TEST(VolumeBricked, WriteAndRead) {
+    util::TempFileHandle file{"", ".ivb"};
+    const size3_t dims{13, 7, 9};
+    auto ram = makeVolume(dims);
+    util::writeBrickedVolume(*ram, file.getFileName(), size3_t{4, 4, 4});
+
+    VolumeBricked bricked{file.getFileName()};
+    EXPECT_EQ(dims, bricked.getDimensions());
+    EXPECT_EQ(DataFloat32::get(), bricked.getDataFormat());
+    EXPECT_EQ(size3_t(4, 4, 4), bricked.getBrickDimensions());
+    EXPECT_EQ(size3_t(4, 2, 3), bricked.getBrickCount());
+
+    const util::IndexMapper3D im(dims);
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                EXPECT_EQ(static_cast<double>(im(x, y, z)), bricked.getAsDouble({x, y, z}));
+            }
+        }
+    }
+}
+
+TEST(VolumeBricked, Region) {
+    util::TempFileHandle file{"", ".ivb"};
+    const size3_t dims{10, 11, 12};
+    auto ram = makeVolume(dims);
+    util::writeBrickedVolume(*ram, file.getFileName(), size3_t{3, 5, 4});
+    VolumeBricked bricked{file.getFileName()};
+
+    const size3_t offset{2, 4, 3};
+    const size3_t extent{7, 6, 9};
+    auto region =
+        std::dynamic_pointer_cast<VolumeRAMPrecision<float>>(bricked.getRegion(offset, extent));
+    ASSERT_TRUE(region);
+    EXPECT_EQ(extent, region->getDimensions());
+
+    const util::IndexMapper3D im(dims);
+    const util::IndexMapper3D rim(extent);
+    for (size_t z = 0; z < extent.z; ++z) {
+        for (size_t y = 0; y < extent.y; ++y) {
+            for (size_t x = 0; x < extent.x; ++x) {
+                EXPECT_EQ(ram->getDataTyped()[im(size3_t{x, y, z} + offset)],
+                          region->getDataTyped()[rim(x, y, z)]);
+            }
+        }
+    }
+
+    EXPECT_THROW(bricked.getRegion(offset, dims), RangeException);
+}
+
+TEST(VolumeBricked, CacheBudget) {
+    util::TempFileHandle file{"", ".ivb"};
+    const size3_t dims{16, 16, 16};
+    auto ram = makeVolume(dims);
+    util::writeBrickedVolume(*ram, file.getFileName(), size3_t{8, 8, 8});
+
+    const size_t brickBytes = 8 * 8 * 8 * sizeof(float);
+    VolumeBricked bricked{file.getFileName(), 2 * brickBytes};
+
+    auto first = bricked.getBrick(size3_t{0, 0, 0});
+    bricked.getBrick(size3_t{1, 0, 0});
+    bricked.getBrick(size3_t{0, 1, 0});
+    EXPECT_EQ(size_t{2}, bricked.getCache().size());
+    EXPECT_LE(bricked.getCache().getBytes(), 2 * brickBytes);
+    // The least recently used brick was dropped, but stays valid while in use
+    EXPECT_FALSE(bricked.getCache().find(0));
+    EXPECT_EQ(0.0, first->getAsDouble(size3_t{0}));
+
+    const auto whole = bricked.getRegion(size3_t{0}, dims);
+    EXPECT_LE(bricked.getCache().getBytes(), 2 * brickBytes);
+    EXPECT_EQ(0, std::memcmp(ram->getData(), whole->getData(), ram->getNumberOfBytes()));
+}
+
+TEST(VolumeBricked, Volume) {
+    util::TempFileHandle file{"", ".ivb"};
+    const size3_t dims{5, 6, 7};
+    auto ram = makeVolume(dims);
+    util::writeBrickedVolume(*ram, file.getFileName(), size3_t{2, 2, 2});
+
+    Volume volume{std::make_shared<VolumeBricked>(file.getFileName())};
+    EXPECT_EQ(dims, volume.getDimensions());
+
+    VolumeSampler sampler{volume};
+    EXPECT_EQ(ram->getAsDVec4(size3_t{4, 5, 6}), sampler.sample(dvec3{1.0}));
+    EXPECT_FALSE(volume.hasRepresentation<VolumeRAM>());
+
+    auto converted = volume.getRepresentation<VolumeRAM>();
+    EXPECT_EQ(0, std::memcmp(ram->getData(), converted->getData(), ram->getNumberOfBytes()));
+}
+
+TEST(VolumeBricked, Accessor) {
+    util::TempFileHandle file{"", ".ivb"};
+    const size3_t dims{9, 7, 5};
+    auto ram = makeVolume(dims);
+    util::writeBrickedVolume(*ram, file.getFileName(), size3_t{4, 3, 2});
+    VolumeBricked bricked{file.getFileName()};
+
+    VolumeBricked::Accessor accessor{bricked};
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                const size3_t pos{x, y, z};
+                EXPECT_EQ(ram->getAsDouble(pos), accessor.getAsDouble(pos));
+                EXPECT_EQ(ram->getAsNormalizedDVec4(pos), accessor.getAsNormalizedDVec4(pos));
+            }
+        }
+    }
+}
+
+TEST(VolumeBricked, Sampler) {
+    util::TempFileHandle file{"", ".ivb"};
+    const size3_t dims{9, 7, 5};
+    auto ram = makeVolume(dims);
+    util::writeBrickedVolume(*ram, file.getFileName(), size3_t{4, 3, 2});
+
+    Volume bricked{std::make_shared<VolumeBricked>(file.getFileName())};
+    Volume reference{ram};
+    VolumeDoubleSampler<1> brickedSampler{bricked};
+    VolumeDoubleSampler<1> referenceSampler{reference};
+
+    std::vector<dvec3> positions;
+    for (size_t i = 0; i < 200; ++i) {
+        const auto t = static_cast<double>(i) / 199.0;
+        positions.emplace_back(t, 0.5 + 0.5 * std::sin(7.0 * t), t * t);
+    }
+    positions.emplace_back(1.5, 0.5, 0.5);  // outside
+
+    std::vector<Vector<1, double>> brickedBatch(positions.size());
+    std::vector<Vector<1, double>> referenceBatch(positions.size());
+    brickedSampler.sample(positions, brickedBatch, CoordinateSpace::Data);
+    referenceSampler.sample(positions, referenceBatch, CoordinateSpace::Data);
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const auto expected = referenceSampler.sample(positions[i], CoordinateSpace::Data);
+        EXPECT_DOUBLE_EQ(expected, brickedSampler.sample(positions[i], CoordinateSpace::Data));
+        EXPECT_DOUBLE_EQ(expected, brickedBatch[i]);
+        EXPECT_DOUBLE_EQ(expected, referenceBatch[i]);
+    }
+    EXPECT_FALSE(bricked.hasRepresentation<VolumeRAM>());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,196 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/exception.h>
+
+#include <cstring>
+#include <numeric>
+
+namespace inviwo {
+
+namespace {
+
+std::shared_ptr<VolumeRAMPrecision<float>> makeVolume(size3_t dims) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(dims);
+    auto data = ram->getDataTyped();
+    std::iota(data, data + glm::compMul(dims), 0.0f);
+    return ram;
+}
+
+}  // namespace
+
+TEST(VolumePyramid, DownsampleKernels) {
+    auto ram = makeVolume(size3_t{3, 3, 3});
+
+    // The first voxel covers the 2x2x2 voxels in the corner, the last only the last voxel
+    const std::vector<std::pair<DownsamplingKernel, double>> expected{
+        {DownsamplingKernel::Nearest, 0.0},
+        {DownsamplingKernel::Average, 6.5},
+        {DownsamplingKernel::Minimum, 0.0},
+        {DownsamplingKernel::Maximum, 13.0}};
+
+    for (const auto& item : expected) {
+        auto res = util::downsample(*ram, item.first);
+        EXPECT_EQ(size3_t(2, 2, 2), res->getDimensions());
+        EXPECT_EQ(DataFloat32::get(), res->getDataFormat());
+        EXPECT_DOUBLE_EQ(item.second, res->getAsDouble(size3_t{0, 0, 0})) << item.first;
+        EXPECT_DOUBLE_EQ(26.0, res->getAsDouble(size3_t{1, 1, 1})) << item.first;
+    }
+}
+
+TEST(VolumePyramid, DownsampleRounding) {
+    auto ram = std::make_shared<VolumeRAMPrecision<unsigned char>>(size3_t{2, 2, 2});
+    auto data = ram->getDataTyped();
+    std::fill(data, data + 8, static_cast<unsigned char>(10));
+    data[0] = 13;  // The average 10.375 rounds down
+    auto res = util::downsample(*ram, DownsamplingKernel::Average);
+    EXPECT_DOUBLE_EQ(10.0, res->getAsDouble(size3_t{0, 0, 0}));
+
+    std::fill(data, data + 8, static_cast<unsigned char>(10));
+    data[0] = 15;
+    data[1] = 15;
+    data[2] = 15;  // The average 11.875 rounds up, truncation would give 11
+    res = util::downsample(*ram, DownsamplingKernel::Average);
+    EXPECT_DOUBLE_EQ(12.0, res->getAsDouble(size3_t{0, 0, 0}));
+}
+
+TEST(VolumePyramid, LevelDimensions) {
+    auto ram = makeVolume(size3_t{65, 20, 9});
+    auto pyramid = util::createVolumePyramid(ram, DownsamplingKernel::Average, 8);
+
+    ASSERT_EQ(5u, pyramid->getNumberOfLevels());
+    EXPECT_EQ(size3_t(65, 20, 9), pyramid->getLevelDimensions(0));
+    EXPECT_EQ(size3_t(33, 10, 5), pyramid->getLevelDimensions(1));
+    EXPECT_EQ(size3_t(17, 5, 3), pyramid->getLevelDimensions(2));
+    EXPECT_EQ(size3_t(9, 3, 2), pyramid->getLevelDimensions(3));
+    EXPECT_EQ(size3_t(5, 2, 1), pyramid->getLevelDimensions(4));
+    EXPECT_EQ(pyramid->getLevelDimensions(0), pyramid->getDimensions());
+
+    for (size_t level = 0; level < pyramid->getNumberOfLevels(); ++level) {
+        EXPECT_EQ(pyramid->getLevelDimensions(level), pyramid->getLevel(level)->getDimensions());
+    }
+}
+
+TEST(VolumePyramid, LazyLoading) {
+    auto ram = makeVolume(size3_t{16, 16, 16});
+    auto levels = util::createPyramidLevels(*ram, DownsamplingKernel::Average, 4);
+    levels.insert(levels.begin(), ram);
+
+    std::vector<size3_t> dims;
+    std::vector<VolumePyramid::Loader> loaders;
+    std::vector<int> loads(levels.size(), 0);
+    for (size_t level = 0; level < levels.size(); ++level) {
+        dims.push_back(levels[level]->getDimensions());
+        loaders.push_back([&levels, &loads, level]() {
+            ++loads[level];
+            return levels[level];
+        });
+    }
+
+    VolumePyramid pyramid(DataFloat32::get(), dims, loaders, DownsamplingKernel::Average);
+    ASSERT_EQ(3u, pyramid.getNumberOfLevels());
+    EXPECT_FALSE(pyramid.isLevelLoaded(2));
+
+    EXPECT_EQ(levels[2], pyramid.getLevel(2));
+    EXPECT_EQ(levels[2], pyramid.getLevel(2));
+    EXPECT_TRUE(pyramid.isLevelLoaded(2));
+    EXPECT_FALSE(pyramid.isLevelLoaded(0));
+    EXPECT_EQ(std::vector<int>({0, 0, 1}), loads);
+}
+
+TEST(VolumePyramid, LoadingWithoutLock) {
+    auto ram = makeVolume(size3_t{8, 8, 8});
+    auto coarse = util::downsample(*ram, DownsamplingKernel::Average);
+
+    // The coarse level is computed from the fine one, which requires the pyramid to be unlocked
+    // while loading
+    const VolumePyramid* self = nullptr;
+    std::vector<VolumePyramid::Loader> loaders{
+        [ram]() { return ram; },
+        [&self]() { return util::downsample(*self->getLevel(0), DownsamplingKernel::Average); }};
+    VolumePyramid pyramid(DataFloat32::get(), {ram->getDimensions(), coarse->getDimensions()},
+                          loaders, DownsamplingKernel::Average);
+    self = &pyramid;
+
+    auto level = pyramid.getLevel(1);
+    EXPECT_TRUE(pyramid.isLevelLoaded(0));
+    EXPECT_TRUE(pyramid.isLevelLoaded(1));
+    EXPECT_EQ(level, pyramid.getLevel(1));
+    ASSERT_EQ(coarse->getDimensions(), level->getDimensions());
+    EXPECT_EQ(0, std::memcmp(coarse->getData(), level->getData(), coarse->getNumberOfBytes()));
+}
+
+TEST(VolumePyramid, LoadingWrongDimensions) {
+    auto ram = makeVolume(size3_t{8, 8, 8});
+    std::vector<VolumePyramid::Loader> loaders{[ram]() { return ram; }};
+    VolumePyramid pyramid(DataFloat32::get(), {size3_t{4, 4, 4}}, loaders,
+                          DownsamplingKernel::Average);
+
+    EXPECT_THROW(pyramid.getLevel(0), Exception);
+    EXPECT_FALSE(pyramid.isLevelLoaded(0));
+}
+
+TEST(VolumePyramid, ConvertToRAM) {
+    const size3_t dims{10, 6, 4};
+    auto ram = makeVolume(dims);
+    Volume volume(util::createVolumePyramid(ram, DownsamplingKernel::Maximum, 2));
+
+    auto res = volume.getRepresentation<VolumeRAM>();
+    ASSERT_EQ(dims, res->getDimensions());
+    ASSERT_EQ(DataFloat32::get(), res->getDataFormat());
+    auto data = static_cast<const float*>(res->getData());
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        EXPECT_EQ(static_cast<float>(i), data[i]);
+    }
+}
+
+TEST(VolumePyramid, ConvertedRAMIsACopy) {
+    const size3_t dims{4, 4, 4};
+    auto ram = makeVolume(dims);
+    auto pyramid = util::createVolumePyramid(ram, DownsamplingKernel::Average, 2);
+    std::shared_ptr<VolumePyramid> clone(pyramid->clone());
+
+    Volume volume(pyramid);
+    auto editable = volume.getEditableRepresentation<VolumeRAM>();
+    editable->setFromDouble(size3_t{0, 0, 0}, 100.0);
+
+    EXPECT_DOUBLE_EQ(0.0, pyramid->getLevel(0)->getAsDouble(size3_t{0, 0, 0}));
+    EXPECT_DOUBLE_EQ(0.0, clone->getLevel(0)->getAsDouble(size3_t{0, 0, 0}));
+    EXPECT_DOUBLE_EQ(0.0, ram->getAsDouble(size3_t{0, 0, 0}));
+}
+
+}  // namespace inviwo
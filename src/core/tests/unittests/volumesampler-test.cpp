@@ -0,0 +1,115 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumesampler.h>
+
+#include <random>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+template <typename T>
+std::shared_ptr<Volume> makeRandomVolume(size3_t dims) {
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(dims);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.0, 100.0);
+    auto data = ram->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) {
+        data[i] = util::glm_convert<T>(dvec4{dist(gen), dist(gen), dist(gen), dist(gen)});
+    }
+    auto volume = std::make_shared<Volume>(ram);
+    volume->setBasis(mat3(2.0f));
+    volume->setOffset(vec3(-1.0f));
+    return volume;
+}
+
+std::vector<dvec3> randomPositions(size_t count, double min, double max) {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> dist(min, max);
+    std::vector<dvec3> positions(count);
+    for (auto& p : positions) p = dvec3{dist(gen), dist(gen), dist(gen)};
+    // the corners and edges of the volume
+    positions[0] = dvec3{0.0};
+    positions[1] = dvec3{1.0};
+    positions[2] = dvec3{1.0, 0.0, 0.5};
+    return positions;
+}
+
+template <unsigned int DataDims, typename T>
+void compareBatchedToScalar(CoordinateSpace space) {
+    auto volume = makeRandomVolume<T>(size3_t{13, 7, 9});
+    VolumeDoubleSampler<DataDims> sampler{volume, space};
+
+    const auto positions = space == CoordinateSpace::Data ? randomPositions(1000, -0.1, 1.1)
+                                                          : randomPositions(1000, -1.2, 1.2);
+    std::vector<Vector<DataDims, double>> result(positions.size());
+    sampler.sample(positions, result);
+
+    for (size_t i = 0; i < positions.size(); ++i) {
+        const auto expected = sampler.sample(positions[i]);
+        for (unsigned int k = 0; k < DataDims; ++k) {
+            EXPECT_NEAR(util::glmcomp(expected, k), util::glmcomp(result[i], k), 1e-9)
+                << "position " << i;
+        }
+    }
+}
+
+}  // namespace
+
+TEST(VolumeSampler, BatchedFloat) {
+    compareBatchedToScalar<1, float>(CoordinateSpace::Data);
+    compareBatchedToScalar<4, float>(CoordinateSpace::Data);
+}
+
+TEST(VolumeSampler, BatchedHalfAndUnsigned) {
+    compareBatchedToScalar<1, f16>(CoordinateSpace::Data);
+    compareBatchedToScalar<2, glm::u8vec2>(CoordinateSpace::Data);
+    compareBatchedToScalar<3, glm::u16vec3>(CoordinateSpace::Data);
+    compareBatchedToScalar<4, unsigned int>(CoordinateSpace::Data);
+}
+
+TEST(VolumeSampler, BatchedFallback) {
+    compareBatchedToScalar<1, double>(CoordinateSpace::Data);
+    compareBatchedToScalar<3, glm::i16vec3>(CoordinateSpace::Data);
+}
+
+TEST(VolumeSampler, BatchedWorldSpace) {
+    compareBatchedToScalar<3, vec3>(CoordinateSpace::World);
+}
+
+}  // namespace inviwo
@@ -41,6 +41,7 @@ SystemSettings::SystemSettings(InviwoApplication* app)
                              {"developerMode", "Developer Mode", UsageMode::Development}},
                             1)
     , poolSize_("poolSize", "Pool Size", defaultPoolSize(), 0, 32)
+    , parallelNetworkEvaluation_("parallelNetworkEvaluation", "Parallel Network Evaluation", false)
     , enablePortInspectors_("enablePortInspectors", "Enable port inspectors", true)
     , portInspectorSize_("portInspectorSize", "Port inspector size", 128, 1, 1024)
 #if __APPLE__
@@ -61,11 +62,14 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     , breakOnException_{"breakOnException", "Break on Exception", false}
     , stackTraceInException_{"stackTraceInException", "Create Stack Trace for Exceptions", false}
     , redirectCout_{"redirectCout", "Redirect cout to LogCentral", false}
-    , redirectCerr_{"redirectCerr", "Redirect cerr to LogCentral", false} {
+    , redirectCerr_{"redirectCerr", "Redirect cerr to LogCentral", false}
+    , enableTracing_{"enableTracing", "Enable Tracing", false}
+    , exportTrace_{"exportTrace", "Export Trace"} {
 
     addProperty(workspaceAuthor_);
     addProperty(applicationUsageMode_);
     addProperty(poolSize_);
+    addProperty(parallelNetworkEvaluation_);
     addProperty(enablePortInspectors_);
     addProperty(portInspectorSize_);
     addProperty(enableTouchProperty_);
@@ -79,6 +83,8 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     addProperty(stackTraceInException_);
     addProperty(redirectCout_);
     addProperty(redirectCerr_);
+    addProperty(enableTracing_);
+    addProperty(exportTrace_);
 
     logStackTraceProperty_.onChange(
         [this]() { LogCentral::getPtr()->setLogStacktrace(logStackTraceProperty_.get()); });
@@ -31,21 +31,73 @@
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/threadutil.h>
+#include <inviwo/core/util/tracing.h>
+
+#include <cstdint>
 
 namespace inviwo {
 
+namespace {
+
+struct CurrentWorker {
+    const ThreadPool* pool = nullptr;
+    void* worker = nullptr;
+    uint32_t seed = 0;  // state for picking steal victims
+};
+thread_local CurrentWorker currentWorker;
+
+uint32_t nextRandom(uint32_t& state) {
+    // xorshift32
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+}  // namespace
+
+ThreadPool::Task::Task(Task&& rhs) noexcept : ops_{rhs.ops_} {
+    if (ops_) {
+        ops_->move(&buffer_, &rhs.buffer_);
+        rhs.ops_ = nullptr;
+    }
+}
+
+ThreadPool::Task& ThreadPool::Task::operator=(Task&& rhs) noexcept {
+    if (this != &rhs) {
+        if (ops_) ops_->destroy(&buffer_);
+        ops_ = rhs.ops_;
+        if (ops_) {
+            ops_->move(&buffer_, &rhs.buffer_);
+            rhs.ops_ = nullptr;
+        }
+    }
+    return *this;
+}
+
+ThreadPool::Task::~Task() {
+    if (ops_) ops_->destroy(&buffer_);
+}
+
 // the constructor just launches some amount of workers
 ThreadPool::ThreadPool(size_t threads, std::function<void()> onThreadStart,
                        std::function<void()> onThreadStop)
-    : onThreadStart_{std::move(onThreadStart)}, onThreadStop_{std::move(onThreadStop)} {
-    while (workers.size() < threads) {
-        workers.push_back(std::make_unique<Worker>(*this));
-    }
+    : queues_{std::make_shared<const Queues>()}
+    , pending_{0}
+    , sleeping_{0}
+    , finished_{0}
+    , waiting_{0}
+    , onThreadStart_{std::move(onThreadStart)}
+    , onThreadStop_{std::move(onThreadStop)} {
+    trySetSize(threads);
 }
 
 size_t ThreadPool::trySetSize(size_t size) {
-    while (workers.size() < size) {
-        workers.push_back(std::make_unique<Worker>(*this));
+    if (workers.size() < size) {
+        while (workers.size() < size) {
+            workers.push_back(std::make_unique<Worker>(*this));
+        }
+        publishQueues();
     }
 
     if (workers.size() > size) {
@@ -60,51 +112,84 @@ size_t ThreadPool::trySetSize(size_t size) {
             if (active <= size) break;
         }
 
-        condition.notify_all();
+        notifySleeping(true);
 
+        const auto oldSize = workers.size();
         util::erase_remove_if(
             workers, [](std::unique_ptr<Worker>& worker) { return worker->state == State::Done; });
+        if (oldSize != workers.size()) publishQueues();
+
+        if (workers.empty()) {
+            // Run any task that was enqueued while the last workers were stopping.
+            std::unique_lock<std::mutex> lock(injection_.mutex);
+            while (!injection_.tasks.empty()) {
+                auto task = std::move(injection_.tasks.front());
+                injection_.tasks.pop_front();
+                --pending_;
+                lock.unlock();
+                task();
+                lock.lock();
+            }
+        }
     }
     return workers.size();
 }
 
 size_t ThreadPool::getSize() const { return workers.size(); }
 
-size_t ThreadPool::getQueueSize() {
-    std::unique_lock<std::mutex> lock(queue_mutex);
-    return tasks.size();
-}
+size_t ThreadPool::getQueueSize() { return pending_; }
+
+bool ThreadPool::isWorkerThread() const { return currentWorker.pool == this; }
 
 ThreadPool::~ThreadPool() {
     for (auto& worker : workers) worker->state = State::Abort;
-    condition.notify_all();
+    notifySleeping(true);
     workers.clear();  // this will join all threads.
 }
 
 ThreadPool::Worker::~Worker() { thread.join(); }
 
 ThreadPool::Worker::Worker(ThreadPool& pool)
-    : state{State::Free}, thread{[this, &pool]() {
+    : state{State::Free}, queue{std::make_shared<TaskQueue>()}, thread{[this, &pool]() {
+        currentWorker.pool = &pool;
+        currentWorker.worker = this;
+        currentWorker.seed =
+            static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1u;
+
+        tracing::setThreadName("Inviwo Worker Thread");
         pool.onThreadStart_();
-        util::OnScopeExit cleanup{[&pool]() { pool.onThreadStop_(); }};
+        util::OnScopeExit cleanup{[&pool]() {
+            pool.onThreadStop_();
+            currentWorker = CurrentWorker{};
+        }};
 
         for (;;) {
-            std::function<void()> task;
-            state = State::Free;
-            {
-                std::unique_lock<std::mutex> lock(pool.queue_mutex);
-                pool.condition.wait(lock, [this, &pool] {
-                    return state == State::Abort || state == State::Stop || !pool.tasks.empty();
-                });
-                if (state == State::Abort || (state == State::Stop && pool.tasks.empty())) break;
-                task = std::move(pool.tasks.front());
-                pool.tasks.pop();
-            }
-            state = State::Working;
-            try {
-                task();
-            } catch (...) {  // Make sure we don't leak any exceptions.
+            const auto current = state.load();
+            if (current == State::Abort) break;
+
+            if (auto task = pool.pop(*this)) {
+                auto expected = State::Free;
+                state.compare_exchange_strong(expected, State::Working);
+                try {
+                    IVW_TRACE_SCOPE("pool", "task");
+                    task();
+                } catch (...) {  // Make sure we don't leak any exceptions.
+                }
+                pool.taskFinished();
+                expected = State::Working;
+                state.compare_exchange_strong(expected, State::Free);
+                continue;
             }
+            // Our own queue and the injection queue are empty, and there was nothing to steal.
+            if (current == State::Stop) break;
+
+            std::unique_lock<std::mutex> lock(pool.sleep_mutex);
+            ++pool.sleeping_;
+            pool.condition.wait(lock, [this, &pool] {
+                const auto s = state.load();
+                return s == State::Abort || s == State::Stop || pool.pending_ > 0;
+            });
+            --pool.sleeping_;
         }
         state = State::Done;
     }} {
@@ -112,14 +197,120 @@ ThreadPool::Worker::Worker(ThreadPool& pool)
     util::setThreadDescription(thread, "Inviwo Worker Thread");
 }
 
-void ThreadPool::enqueueRaw(std::function<void()> task) {
-    if (workers.empty()) {
+void ThreadPool::enqueueRaw(std::function<void()> task) { enqueueTask(Task{std::move(task)}); }
+
+void ThreadPool::enqueueTask(Task task) {
+    const bool nested = currentWorker.pool == this;
+    if (!nested && std::atomic_load(&queues_)->empty()) {
         task();  // No worker threads, just run the task.
+        return;
+    }
+
+    // Count the task before it becomes visible, pop() decrements the count.
+    ++pending_;
+    if (nested) {
+        // Push to the back of the calling worker's own queue.
+        auto& queue = *static_cast<Worker*>(currentWorker.worker)->queue;
+        std::unique_lock<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    } else {
+        std::unique_lock<std::mutex> lock(injection_.mutex);
+        injection_.tasks.push_back(std::move(task));
+    }
+    if (sleeping_ > 0) notifySleeping(false);
+    if (waiting_ > 0) {
+        { std::unique_lock<std::mutex> lock(sleep_mutex); }
+        finishedCondition_.notify_all();
+    }
+}
+
+ThreadPool::Task ThreadPool::pop(Worker& worker) {
+    Task task;
+    const auto tryPop = [&](TaskQueue& queue, bool back) {
+        std::unique_lock<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        if (back) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        --pending_;
+        return true;
+    };
+
+    // Newest task from our own queue first, then the oldest of the injection queue
+    if (tryPop(*worker.queue, true) || tryPop(injection_, false)) return task;
+
+    // Try to steal the oldest task from an other worker, starting at a random victim.
+    const auto queues = std::atomic_load(&queues_);
+    const auto count = queues->size();
+    if (count > 1) {
+        const auto start = nextRandom(currentWorker.seed) % count;
+        for (size_t i = 0; i < count; ++i) {
+            auto& victim = (*queues)[(start + i) % count];
+            if (victim == worker.queue) continue;
+            if (tryPop(*victim, false)) return task;
+        }
+    }
+    return task;
+}
+
+bool ThreadPool::runPendingTask() {
+    if (currentWorker.pool != this) return false;
+    if (auto task = pop(*static_cast<Worker*>(currentWorker.worker))) {
+        try {
+            IVW_TRACE_SCOPE("pool", "task");
+            task();
+        } catch (...) {  // Make sure we don't leak any exceptions.
+        }
+        taskFinished();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::sleepUntilProgress(const std::function<bool()>& isReady) {
+    std::unique_lock<std::mutex> lock(sleep_mutex);
+    ++waiting_;
+    // Read the count after announcing that we wait, then taskFinished() either sees the waiter or
+    // the result of its task is visible to isReady() below.
+    const auto finished = finished_.load();
+    if (!isReady()) {
+        // The future is normally fulfilled by a task of this pool. The timeout only matters for
+        // futures fulfilled elsewhere, which do not notify us.
+        finishedCondition_.wait_for(lock, std::chrono::milliseconds(10), [&]() {
+            return pending_ > 0 || finished_ != finished;
+        });
+    }
+    --waiting_;
+}
+
+void ThreadPool::taskFinished() {
+    ++finished_;
+    if (waiting_ > 0) {
+        { std::unique_lock<std::mutex> lock(sleep_mutex); }
+        finishedCondition_.notify_all();
+    }
+}
+
+void ThreadPool::publishQueues() {
+    auto queues = std::make_shared<Queues>();
+    queues->reserve(workers.size());
+    for (auto& worker : workers) queues->push_back(worker->queue);
+    std::atomic_store(&queues_, std::shared_ptr<const Queues>{std::move(queues)});
+}
+
+void ThreadPool::notifySleeping(bool all) {
+    // Taking the lock makes sure that a worker that just evaluated its wait predicate has
+    // started waiting before we notify, otherwise the notification could be lost.
+    { std::unique_lock<std::mutex> lock(sleep_mutex); }
+    if (all) {
+        condition.notify_all();
     } else {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        tasks.emplace(std::move(task));
+        condition.notify_one();
     }
-    condition.notify_one();
 }
 
 }  // namespace inviwo
@@ -0,0 +1,240 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2020 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/tracing.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/stdextensions.h>
+
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace inviwo {
+
+namespace tracing {
+
+namespace detail {
+std::atomic<bool> enabled{false};
+}  // namespace detail
+
+namespace {
+
+struct ThreadBuffer {
+    ThreadBuffer(int aTid) : events{std::make_unique<Event[]>(bufferCapacity)}, tid{aTid} {}
+    // Taken by the owning thread to write an event and by the export to copy the events, hence
+    // only contended while exporting
+    std::mutex mutex;
+    std::unique_ptr<Event[]> events;  // guarded by mutex
+    size_t head = 0;                  // guarded by mutex
+    const int tid;
+    std::string name;  // guarded by the registry mutex
+    std::atomic<bool> alive{true};
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    int nextTid = 1;
+    std::atomic<std::int64_t> clearedAt{0};
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+Registry& registry() {
+    static Registry registry;
+    return registry;
+}
+
+struct Local {
+    ~Local() {
+        if (buffer) buffer->alive = false;
+    }
+    std::shared_ptr<ThreadBuffer> buffer;
+    std::string name;
+};
+thread_local Local local;
+
+// The buffer is only allocated once the thread records its first event. The registry keeps the
+// buffers alive after the thread has exited such that they still can be exported, until they no
+// longer hold any events that have not been cleared.
+ThreadBuffer& localBuffer() {
+    if (!local.buffer) {
+        auto& reg = registry();
+        std::scoped_lock lock{reg.mutex};
+        local.buffer = std::make_shared<ThreadBuffer>(reg.nextTid++);
+        local.buffer->name = local.name;
+        reg.buffers.push_back(local.buffer);
+    }
+    return *local.buffer;
+}
+
+void writeJsonString(std::ostream& os, const char* str) {
+    os << '"';
+    for (; *str != '\0'; ++str) {
+        const auto c = *str;
+        switch (c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            case '\t':
+                os << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                       << static_cast<int>(c) << std::dec << std::setfill(' ');
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+}  // namespace
+
+std::int64_t detail::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                registry().epoch)
+        .count();
+}
+
+void detail::record(const char* category, const char* name, std::int64_t start, std::int64_t end,
+                    const char* detail) {
+    auto& buffer = localBuffer();
+    std::scoped_lock lock{buffer.mutex};
+    auto& event = buffer.events[buffer.head++ % bufferCapacity];
+    event.category = category;
+    event.name = name;
+    event.start = start;
+    event.duration = end - start;
+    std::strcpy(event.detail, detail);
+}
+
+void setEnabled(bool enabled) { detail::enabled.store(enabled, std::memory_order_relaxed); }
+
+void clear() {
+    auto& reg = registry();
+    std::scoped_lock lock{reg.mutex};
+    reg.clearedAt.store(detail::now());
+    // All events of exited threads are cleared now
+    util::erase_remove_if(reg.buffers, [](const auto& buffer) { return !buffer->alive; });
+}
+
+void setThreadName(std::string_view name) {
+    local.name = name;
+    if (local.buffer) {
+        std::scoped_lock lock{registry().mutex};
+        local.buffer->name = local.name;
+    }
+}
+
+void writeChromeTrace(std::ostream& os) {
+    auto& reg = registry();
+    std::scoped_lock lock{reg.mutex};
+    const auto clearedAt = reg.clearedAt.load();
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    const auto separator = [&]() {
+        if (!first) os << ",";
+        first = false;
+        os << "\n";
+    };
+
+    os << std::fixed << std::setprecision(3);
+    std::vector<Event> events;
+    std::vector<const ThreadBuffer*> exited;
+    for (const auto& buffer : reg.buffers) {
+        const bool alive = buffer->alive;
+
+        // Snapshot the events, the owning thread waits for the copy before recording more
+        events.clear();
+        {
+            std::scoped_lock bufferLock{buffer->mutex};
+            const auto begin = buffer->head > bufferCapacity ? buffer->head - bufferCapacity : 0;
+            for (auto i = begin; i < buffer->head; ++i) {
+                const auto& event = buffer->events[i % bufferCapacity];
+                if (event.start >= clearedAt) events.push_back(event);
+            }
+        }
+        // An exited thread will not record any more events, drop its buffer once it has none left
+        if (!alive && events.empty()) {
+            exited.push_back(buffer.get());
+            continue;
+        }
+
+        separator();
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+           << ",\"args\":{\"name\":";
+        const auto name =
+            buffer->name.empty() ? "Thread " + std::to_string(buffer->tid) : buffer->name;
+        writeJsonString(os, name.c_str());
+        os << "}}";
+
+        for (const auto& event : events) {
+            separator();
+            os << "{\"name\":";
+            writeJsonString(os, event.name);
+            os << ",\"cat\":";
+            writeJsonString(os, event.category);
+            os << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+               << ",\"ts\":" << static_cast<double>(event.start) / 1000.0
+               << ",\"dur\":" << static_cast<double>(event.duration) / 1000.0;
+            if (event.detail[0] != '\0') {
+                os << ",\"args\":{\"detail\":";
+                writeJsonString(os, event.detail);
+                os << "}";
+            }
+            os << "}";
+        }
+    }
+    os << "\n]}\n";
+
+    util::erase_remove_if(reg.buffers,
+                          [&](const auto& buffer) { return util::contains(exited, buffer.get()); });
+}
+
+void writeChromeTrace(const std::string& filename) {
+    auto os = filesystem::ofstream(filename);
+    if (!os) throw FileException("Could not open file \"" + filename + "\" for writing",
+                                 IVW_CONTEXT_CUSTOM("tracing"));
+    writeChromeTrace(os);
+}
+
+}  // namespace tracing
+
+}  // namespace inviwo
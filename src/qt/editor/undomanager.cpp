@@ -57,11 +57,15 @@ public:
     AutoSaver()
         : path_{filesystem::getPath(PathType::Settings)}
         , restored_{[this]() -> std::optional<std::string> {
-            if (filesystem::fileExists(path_ + "/autosave.inv")) {
-                auto ifstream = filesystem::ifstream(path_ + "/autosave.inv");
-                std::stringstream buffer;
-                buffer << ifstream.rdbuf();
-                return std::move(buffer).str();
+            // Fall back to the XML autosave of older versions, load() detects the encoding
+            for (auto file : {binaryFile, xmlFile}) {
+                if (filesystem::fileExists(path_ + file)) {
+                    auto ifstream =
+                        filesystem::ifstream(path_ + file, std::ios::in | std::ios::binary);
+                    std::stringstream buffer;
+                    buffer << ifstream.rdbuf();
+                    return std::move(buffer).str();
+                }
             }
 
             return std::nullopt;
@@ -86,9 +90,10 @@ public:
                 }
 
                 if (str) {
-                    auto ofstream = filesystem::ofstream(path_ + "/autosave.inv.tmp");
+                    const auto tmp = path_ + binaryFile + ".tmp";
+                    auto ofstream = filesystem::ofstream(tmp, std::ios::out | std::ios::binary);
                     ofstream << *str;
-                    filesystem::copyFile(path_ + "/autosave.inv.tmp", path_ + "/autosave.inv");
+                    filesystem::copyFile(tmp, path_ + binaryFile);
                 }
             }
         }} {}
@@ -110,6 +115,10 @@ public:
     }
 
 private:
+    // The autosave uses the binary encoding, keep it out of the file older versions restore from
+    static constexpr const char* binaryFile = "/autosave.invb";
+    static constexpr const char* xmlFile = "/autosave.inv";
+
     std::string path_;
     std::optional<std::string> restored_;
     std::atomic<bool> quit_;